@@ -0,0 +1,113 @@
+import argparse
+import os
+import shlex
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+# Encode a sequence as independent segments cut at intra period boundaries, run the
+# segment encodes concurrently and stitch the results with parcat (JVET-B0036).
+#
+# Segment k covers source frames [k * IntraPeriod, (k + 1) * IntraPeriod], i.e. consecutive
+# segments overlap by one frame. That frame is the CRA closing segment k and the IDR opening
+# segment k + 1; intra pictures are coded identically in both cases, so parcat drops the IDR
+# (and the parameter sets preceding it) from every segment but the first and shifts the POCs
+# of the remaining pictures. The reconstructions are joined in the same way.
+
+
+def make_segments(num_frames, intra_period):
+    segments = []
+    start = 0
+    while True:
+        length = min(intra_period + 1, num_frames - start)
+        segments.append((start, length))
+        start += intra_period
+        if start + 1 >= num_frames:
+            break
+    return segments
+
+
+def encode_segment(args, idx, start, length):
+    bitstream = os.path.join(args.workdir, f'seg_{idx:03d}.bin')
+    recon = os.path.join(args.workdir, f'seg_{idx:03d}.yuv') if args.recon else ''
+    log = os.path.join(args.workdir, f'seg_{idx:03d}.txt')
+
+    cmd = [args.encoder]
+    for cfg in args.cfg:
+        cmd += ['-c', cfg]
+    cmd += [f'--InputFile={args.input}',
+            f'--BitstreamFile={bitstream}',
+            f'--ReconFile={recon if recon else "/dev/null"}',
+            f'--IntraPeriod={args.intra_period}',
+            '--DecodingRefreshType=1',
+            f'--FrameSkip={args.frame_skip + start}',
+            f'--FramesToBeEncoded={length}',
+            # let the temporal filter see the same frames as in a sequential encoding
+            f'--FirstValidFrame={args.frame_skip}',
+            f'--LastValidFrame={args.frame_skip + args.frames - 1}']
+    cmd += args.extra
+
+    with open(log, 'w') as f:
+        f.write(' '.join(shlex.quote(c) for c in cmd) + '\n')
+        f.flush()
+        ret = subprocess.call(cmd, stdout=f, stderr=subprocess.STDOUT)
+    if ret != 0:
+        raise RuntimeError(f'segment {idx} failed with exit code {ret}, see {log}')
+    print(f'segment {idx}: frames {start}..{start + length - 1} done')
+    return bitstream, recon, length
+
+
+def join_recon(segments, output):
+    with open(output, 'wb') as out:
+        for idx, (recon, length) in enumerate(segments):
+            frame_size = os.path.getsize(recon) // length
+            with open(recon, 'rb') as f:
+                if idx > 0:
+                    # first frame duplicates the last frame of the previous segment
+                    f.seek(frame_size)
+                while True:
+                    data = f.read(1 << 24)
+                    if not data:
+                        break
+                    out.write(data)
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Parallel segment encoding with bitstream stitching.',
+                                     epilog='Arguments after "--" are passed to every encoder run.')
+    parser.add_argument('--encoder', type=str, default='./bin/EncoderAppStatic', help='EncoderApp executable')
+    parser.add_argument('--parcat', type=str, default='./bin/parcatStatic', help='parcat executable')
+    parser.add_argument('-c', '--cfg', type=str, action='append', default=[], help='encoder configuration file(s)')
+    parser.add_argument('--input', type=str, required=True, help='input YUV file')
+    parser.add_argument('--frames', type=int, required=True, help='number of frames to be encoded')
+    parser.add_argument('--frame-skip', type=int, default=0, help='number of frames to skip at the start of the input')
+    parser.add_argument('--intra-period', type=int, required=True, help='intra period, i.e. segment length')
+    parser.add_argument('--bitstream', type=str, required=True, help='output bitstream')
+    parser.add_argument('--recon', type=str, default='', help='output reconstruction (optional)')
+    parser.add_argument('--workdir', type=str, default='segments', help='directory for segment outputs and logs')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='number of concurrent encodes')
+    parser.add_argument('extra', nargs=argparse.REMAINDER, help='additional encoder arguments')
+    args = parser.parse_args()
+
+    if args.extra and args.extra[0] == '--':
+        args.extra = args.extra[1:]
+    if args.intra_period <= 0:
+        sys.exit('Error: segments are cut at intra period boundaries, IntraPeriod must be positive')
+
+    os.makedirs(args.workdir, exist_ok=True)
+    segments = make_segments(args.frames, args.intra_period)
+    print(f'{len(segments)} segments, {args.jobs} concurrent encodes')
+
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(encode_segment, args, idx, start, length)
+                   for idx, (start, length) in enumerate(segments)]
+        results = [f.result() for f in futures]
+
+    ret = subprocess.call([args.parcat] + [r[0] for r in results] + [args.bitstream])
+    if ret != 0:
+        sys.exit(f'Error: parcat failed with exit code {ret}')
+
+    if args.recon:
+        join_recon([(r[1], r[2]) for r in results], args.recon)
+
+    print(f'written {args.bitstream}' + (f' and {args.recon}' if args.recon else ''))
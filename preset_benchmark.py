@@ -0,0 +1,180 @@
+import argparse
+import csv
+import os
+import random
+import re
+import shlex
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+from bjontegaard_metric import BD_RATE
+
+# Measure the speed/efficiency ladder of the encoder speed presets (--Preset).
+#
+# Every clip is encoded with every preset at every QP. The speed of a preset is reported in frames
+# per second of encoder CPU time, which is not affected by running several encodes concurrently, and
+# its efficiency as BD-rate (luma and YUV PSNR) against the anchor preset, by default the slowest one.
+#
+# Clips are given as FILE:WIDTHxHEIGHT:FRAMERATE[:BITDEPTH] (8 bit 4:2:0 if no bit depth is given).
+# Without clips, a synthetic clip with a panning texture and a moving object is generated from a fixed
+# seed, so that runs are reproducible on any machine.
+
+PRESETS = ['slow', 'medium', 'fast', 'faster', 'veryfast']
+
+SUMMARY_RE = re.compile(r'^\s*(\d+)\s+a\s+([\d.]+)\s+([\d.]+)\s+([\d.]+)\s+([\d.]+)\s+([\d.]+)', re.MULTILINE)
+TIME_RE = re.compile(r'Total Time:\s+([\d.]+) sec\. \[user\]\s+([\d.]+) sec\. \[elapsed\]')
+
+
+class Clip:
+    def __init__(self, spec):
+        fields = spec.split(':')
+        if len(fields) not in (3, 4):
+            raise ValueError(f'invalid clip "{spec}", expected FILE:WIDTHxHEIGHT:FRAMERATE[:BITDEPTH]')
+        self.path = fields[0]
+        self.width, self.height = (int(v) for v in fields[1].lower().split('x'))
+        self.frame_rate = int(fields[2])
+        self.bit_depth = int(fields[3]) if len(fields) == 4 else 8
+        self.name = os.path.splitext(os.path.basename(self.path))[0]
+
+
+def generate_synthetic_clip(path, width, height, frames, seed):
+    # value noise texture on a canvas large enough for the whole pan, bilinearly interpolated from an 8x8 grid
+    pan_x, pan_y = 6, 2
+    obj_size, obj_x, obj_y = height // 3, -7, 3
+    rng = random.Random(seed)
+    canvas_w = width + pan_x * frames + 8
+    canvas_h = height + pan_y * frames + 8
+    grid_w, grid_h = canvas_w // 8 + 2, canvas_h // 8 + 2
+    grid = [[rng.randint(16, 235) for _ in range(grid_w)] for _ in range(grid_h)]
+    fine = [[rng.randint(-12, 12) for _ in range(canvas_w)] for _ in range(canvas_h)]
+
+    def texture(x, y):
+        gx, gy = x >> 3, y >> 3
+        fx, fy = x & 7, y & 7
+        top = grid[gy][gx] * (8 - fx) + grid[gy][gx + 1] * fx
+        bottom = grid[gy + 1][gx] * (8 - fx) + grid[gy + 1][gx + 1] * fx
+        return min(255, max(0, ((top * (8 - fy) + bottom * fy + 32) >> 6) + fine[y][x]))
+
+    background = [bytes(texture(x, y) for x in range(canvas_w)) for y in range(canvas_h)]
+    pattern = [bytes((((x >> 2) ^ (y >> 2)) & 1) * 160 + 48 for x in range(obj_size)) for y in range(obj_size)]
+
+    with open(path, 'wb') as f:
+        for t in range(frames):
+            luma = [bytearray(background[y + pan_y * t][pan_x * t:pan_x * t + width]) for y in range(height)]
+            ox = (width // 2 + obj_x * t) % (width - obj_size)
+            oy = (height // 4 + obj_y * t) % (height - obj_size)
+            for y in range(obj_size):
+                luma[oy + y][ox:ox + obj_size] = pattern[y]
+            for row in luma:
+                f.write(row)
+            # chroma follows the luma structure at reduced amplitude
+            for offset in (0, 64):
+                for y in range(0, height, 2):
+                    row = luma[y]
+                    f.write(bytes(min(255, max(0, 128 + ((row[x] - 128 + offset) >> 2))) for x in range(0, width, 2)))
+
+
+def encode(args, clip, preset, qp):
+    stem = os.path.join(args.workdir, f'{clip.name}_{preset}_{qp}')
+    cmd = [args.encoder]
+    for cfg in args.cfg:
+        cmd += ['-c', cfg]
+    cmd += [f'--Preset={preset}',
+            f'--InputFile={clip.path}',
+            f'--SourceWidth={clip.width}',
+            f'--SourceHeight={clip.height}',
+            f'--FrameRate={clip.frame_rate}',
+            f'--InputBitDepth={clip.bit_depth}',
+            f'--FramesToBeEncoded={args.frames}',
+            f'--QP={qp}',
+            f'--BitstreamFile={stem}.bin']
+    cmd += args.extra
+
+    with open(stem + '.txt', 'w') as f:
+        f.write(' '.join(shlex.quote(c) for c in cmd) + '\n')
+        f.flush()
+        ret = subprocess.call(cmd, stdout=f, stderr=subprocess.STDOUT)
+    if ret != 0:
+        raise RuntimeError(f'{clip.name} {preset} QP {qp} failed with exit code {ret}, see {stem}.txt')
+
+    with open(stem + '.txt') as f:
+        log = f.read()
+    summary = SUMMARY_RE.search(log)
+    times = TIME_RE.search(log)
+    if not summary or not times:
+        raise RuntimeError(f'no summary found in {stem}.txt')
+    print(f'{clip.name} {preset} QP {qp} done')
+    return {'frames': int(summary.group(1)), 'bitrate': float(summary.group(2)), 'y_psnr': float(summary.group(3)),
+            'yuv_psnr': float(summary.group(6)), 'user': float(times.group(1)), 'elapsed': float(times.group(2))}
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Speed/efficiency benchmark of the encoder speed presets.',
+                                     epilog='Arguments after "--" are passed to every encoder run.')
+    parser.add_argument('--encoder', type=str, default='./bin/EncoderAppStatic', help='EncoderApp executable')
+    parser.add_argument('-c', '--cfg', type=str, action='append', default=[], help='encoder configuration file(s)')
+    parser.add_argument('--clip', type=str, action='append', default=[],
+                        help='input clip FILE:WIDTHxHEIGHT:FRAMERATE[:BITDEPTH], default: synthetic clip')
+    parser.add_argument('--frames', type=int, default=17, help='number of frames to be encoded per clip')
+    parser.add_argument('--preset', type=str, action='append', default=[], help='preset(s) to run, default: all')
+    parser.add_argument('--anchor', type=str, default='', help='anchor preset of the BD-rates, default: first preset')
+    parser.add_argument('--qp', type=int, nargs='+', default=[22, 27, 32, 37], help='QPs of each rate-distortion curve')
+    parser.add_argument('--seed', type=int, default=1, help='seed of the synthetic clip')
+    parser.add_argument('--workdir', type=str, default='preset_benchmark', help='directory for bitstreams and logs')
+    parser.add_argument('--csv', type=str, default='', help='output CSV file, default: WORKDIR/presets.csv')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='number of concurrent encodes')
+    parser.add_argument('extra', nargs=argparse.REMAINDER, help='additional encoder arguments')
+    args = parser.parse_args()
+
+    if args.extra and args.extra[0] == '--':
+        args.extra = args.extra[1:]
+    presets = args.preset if args.preset else PRESETS
+    anchor = args.anchor if args.anchor else presets[0]
+    if anchor not in presets:
+        sys.exit(f'Error: anchor preset {anchor} is not benchmarked')
+    if len(args.qp) < 4:
+        sys.exit('Error: BD-rate computation needs at least four QPs')
+
+    os.makedirs(args.workdir, exist_ok=True)
+    if args.clip:
+        clips = [Clip(spec) for spec in args.clip]
+    else:
+        path = os.path.join(args.workdir, f'synthetic_416x240_{args.frames}_{args.seed}.yuv')
+        if not os.path.exists(path):
+            generate_synthetic_clip(path, 416, 240, args.frames, args.seed)
+        clips = [Clip(f'{path}:416x240:30')]
+
+    jobs = [(clip, preset, qp) for clip in clips for preset in presets for qp in args.qp]
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        results = list(pool.map(lambda job: encode(args, *job), jobs))
+    runs = {job: result for job, result in zip(jobs, results)}
+
+    rows = []
+    for clip in clips:
+        curves = {}
+        for preset in presets:
+            points = [runs[(clip, preset, qp)] for qp in args.qp]
+            curves[preset] = {key: [p[key] for p in points] for key in points[0]}
+        anchor_curve = curves[anchor]
+        for preset in presets:
+            curve = curves[preset]
+            rows.append({'clip': clip.name, 'preset': preset,
+                         'fps': sum(curve['frames']) / sum(curve['user']),
+                         'speedup': sum(anchor_curve['user']) / sum(curve['user']),
+                         'bdrate_y': BD_RATE(anchor_curve['bitrate'], anchor_curve['y_psnr'],
+                                             curve['bitrate'], curve['y_psnr']),
+                         'bdrate_yuv': BD_RATE(anchor_curve['bitrate'], anchor_curve['yuv_psnr'],
+                                               curve['bitrate'], curve['yuv_psnr'])})
+
+    csv_name = args.csv if args.csv else os.path.join(args.workdir, 'presets.csv')
+    with open(csv_name, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=list(rows[0]))
+        writer.writeheader()
+        writer.writerows(rows)
+
+    print(f'\n{"clip":<24} {"preset":<10} {"fps":>8} {"speedup":>8} {"BD-rate Y":>10} {"BD-rate YUV":>12}')
+    for row in rows:
+        print(f'{row["clip"]:<24} {row["preset"]:<10} {row["fps"]:8.3f} {row["speedup"]:7.2f}x '
+              f'{row["bdrate_y"]:9.2f}% {row["bdrate_yuv"]:11.2f}%')
+    print(f'\nresults written to {csv_name} (BD-rates against preset {anchor})')
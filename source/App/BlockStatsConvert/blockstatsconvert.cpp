@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     blockstatsconvert.cpp
+ *  \brief    Converts binary block statistics traces to the text format
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/dtrace_blockstatistics_binary.h"
+
+int main(int argc, char *argv[])
+{
+  bool asCsv  = false;
+  int  argIdx = 1;
+  if (argc > 1 && strcmp(argv[1], "--csv") == 0)
+  {
+    asCsv = true;
+    argIdx++;
+  }
+  if (argc - argIdx != 2)
+  {
+    printf("BlockStatsConvert version VTM %s\n", VTM_VERSION);
+    printf("usage: %s [--csv] <input%s> <output>\n", argv[0], BLOCK_STATS_BINARY_EXTENSION);
+    return -1;
+  }
+
+  BlockStatBinaryReader reader;
+  if (!reader.open(argv[argIdx]))
+  {
+    fprintf(stderr, "Error: could not open binary block statistics file: %s\n", argv[argIdx]);
+    exit(1);
+  }
+  FILE *fdo = fopen(argv[argIdx + 1], "w");
+  if (fdo == nullptr)
+  {
+    fprintf(stderr, "Error: could not open output file: %s\n", argv[argIdx + 1]);
+    exit(1);
+  }
+
+  std::vector<std::string> statNames;
+  BlockStatRecord          rec;
+  std::string              text;
+  uint64_t                 numRecords = 0;
+  while (reader.read(rec, text))
+  {
+    if (rec.kind == BlockStatRecordKind::Text)
+    {
+      fwrite(text.data(), 1, text.size(), fdo);
+      continue;
+    }
+    if (rec.kind == BlockStatRecordKind::StatName)
+    {
+      statNames.resize(std::max<size_t>(statNames.size(), rec.statId + 1));
+      statNames[rec.statId] = text;
+      continue;
+    }
+    if (rec.statId >= statNames.size())
+    {
+      fprintf(stderr, "Error: undefined statistic id %d in %s\n", rec.statId, argv[argIdx]);
+      exit(1);
+    }
+    const std::string line = formatBlockStatRecord(rec, statNames[rec.statId], asCsv);
+    fwrite(line.data(), 1, line.size(), fdo);
+    numRecords++;
+  }
+
+  fclose(fdo);
+  if (reader.isCorrupt())
+  {
+    fprintf(stderr, "Error: invalid record after %llu block statistics in %s\n", (unsigned long long) numRecords,
+            argv[argIdx]);
+    exit(1);
+  }
+  printf("%llu block statistics written to %s\n", (unsigned long long) numRecords, argv[argIdx + 1]);
+  return 0;
+}
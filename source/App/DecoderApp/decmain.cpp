@@ -68,6 +68,9 @@ int main(int argc, char* argv[])
 #endif
 #if ENABLE_TRACING
   fprintf( stdout, "[ENABLE_TRACING] " );
+#endif
+#if ENABLE_STAGE_PROFILING
+  fprintf( stdout, "[ENABLE_STAGE_PROFILING] " );
 #endif
   fprintf( stdout, "\n" );
 
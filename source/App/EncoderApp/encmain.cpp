@@ -39,6 +39,7 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <deque>
 
 #include "EncoderLib/EncLibCommon.h"
 #include "EncApp.h"
@@ -123,14 +124,19 @@ int main(int argc, char* argv[])
 #endif
 #if ENABLE_TRACING
   fprintf( stdout, "[ENABLE_TRACING] " );
+#endif
+#if ENABLE_STAGE_PROFILING
+  fprintf( stdout, "[ENABLE_STAGE_PROFILING] " );
 #endif
   fprintf( stdout, "\n" );
 
-  std::fstream bitstream;
-  EncLibCommon encLibCommon;
+  // multi-rate encoding uses one bitstream and EncLibCommon per rate, layers share them
+  std::deque<std::fstream> bitstream( 1 );
+  std::deque<EncLibCommon> encLibCommon( 1 );
 
   std::vector<EncApp*> pcEncApp(1);
   bool resized = false;
+  bool multiRate = false;
   int layerIdx = 0;
 
   initROM();
@@ -139,9 +145,11 @@ int main(int argc, char* argv[])
 
   do
   {
-    pcEncApp[layerIdx] = new EncApp( bitstream, &encLibCommon );
+    const int rateIdx = multiRate ? layerIdx : 0;
+    pcEncApp[layerIdx] = new EncApp( bitstream[rateIdx], &encLibCommon[rateIdx] );
     // create application encoder class per layer
     pcEncApp[layerIdx]->create();
+    pcEncApp[layerIdx]->setMultiRateIdx( rateIdx );
 
     // parse configuration per layer
     try
@@ -168,7 +176,7 @@ int main(int argc, char* argv[])
             numParams++;
           }
           // check if correct layer index
-          if( argv[i][2] == std::to_string( layerIdx ).c_str()[0] )
+          if( argv[i][2] == std::to_string( multiRate ? 0 : layerIdx ).c_str()[0] )
           {
             layerArgv[j] = argv[i + 1];
             if (numParams > 1)
@@ -198,7 +206,24 @@ int main(int argc, char* argv[])
       return 1;
     }
 
-    pcEncApp[layerIdx]->createLib( layerIdx );
+    if( !resized && !pcEncApp[0]->getMultiRateQPs().empty() )
+    {
+      // multi-rate encoding: one encoder instance per QP, all fed from the same input reader
+      multiRate = true;
+      pcEncApp.resize( pcEncApp[0]->getMultiRateQPs().size() );
+      for( int i = 1; i < pcEncApp.size(); i++ )
+      {
+        bitstream.emplace_back();
+        encLibCommon.emplace_back();
+      }
+      resized = true;
+    }
+    if( multiRate )
+    {
+      pcEncApp[layerIdx]->setMultiRate( rateIdx > 0 ? pcEncApp[0] : nullptr );
+    }
+
+    pcEncApp[layerIdx]->createLib( multiRate ? 0 : layerIdx );
 
     if( !resized )
     {
@@ -211,7 +236,7 @@ int main(int argc, char* argv[])
 
   delete[] layerArgv;
 
-  if (layerIdx > 1)
+  if (layerIdx > 1 && !multiRate)
   {
     int nbLayersUsingAlf = 0;
     int totalUsedAPSIDs = 0;
@@ -287,6 +312,16 @@ int main(int argc, char* argv[])
   // call encoding function per layer
   bool eos = false;
 
+  if( pcEncApp[0]->getTemporalFilterPrefilterOnly() )
+  {
+    // only fill the temporal filter cache for later encodings
+    for( auto & encApp : pcEncApp )
+    {
+      encApp->prefilterTemporal();
+    }
+    eos = true;
+  }
+
   while( !eos )
   {
     // read GOP
@@ -0,0 +1,1054 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchApp.cpp
+    \brief    Kernel benchmark application class
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "KernelBenchApp.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/Slice.h"
+
+//! \ingroup KernelBenchApp
+//! \{
+
+static const char *const s_levelNames[] = { "SCALAR", "SSE41", "SSE42", "AVX", "AVX2", "AVX512" };
+
+static std::string sizeName(const int width, const int height)
+{
+  return std::to_string(width) + "x" + std::to_string(height);
+}
+
+// FNV-1a hash of the kernel outputs, compared against the one of the C kernels
+static uint64_t hashOutput(const std::vector<int64_t> &values)
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (const int64_t value: values)
+  {
+    hash = (hash ^ uint64_t(value)) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KernelBenchApp::KernelBenchApp()
+  : m_trQuant(new TransformKernels)
+  , m_sps(new SPS)
+  , m_slice(new Slice)
+  , m_cs(new CodingStructure(g_xuPool))
+{
+  for (auto &buf: m_pelBuf)
+  {
+    buf.resize(STRIDE * STRIDE);
+  }
+  for (auto &buf: m_gradBuf)
+  {
+    buf.resize((MAX_BLK + 2 * BIO_EXTEND_SIZE) * (MAX_BLK + 2 * BIO_EXTEND_SIZE));
+  }
+  for (auto &buf: m_intBuf)
+  {
+    buf.resize(MAX_BLK * MAX_BLK);
+  }
+  for (auto &buf: m_coeffBuf)
+  {
+    buf.resize(MAX_TB_SIZEY * MAX_TB_SIZEY);
+  }
+  m_quantCoeff.resize(MAX_TB_SIZEY * MAX_TB_SIZEY);
+  m_errScale.resize(MAX_TB_SIZEY * MAX_TB_SIZEY);
+  m_levelCands = std::make_unique<RdoqLevelCands>();
+  m_sums.resize(MAX_BLK * MAX_BLK);
+
+  m_classifierBuf.resize(MAX_BLK * MAX_BLK);
+  m_classifier.resize(MAX_BLK);
+  for (int y = 0; y < MAX_BLK; y++)
+  {
+    m_classifier[y] = m_classifierBuf.data() + y * MAX_BLK;
+  }
+  m_alfCoeff.resize(MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF);
+  m_alfClip.resize(MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF);
+
+  for (int dir = 0; dir < NUM_DIRECTIONS; dir++)
+  {
+    m_laplacian[dir] = m_laplacianPtr[dir];
+    for (int y = 0; y < AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5; y++)
+    {
+      m_laplacianPtr[dir][y] = m_laplacianData[dir][y];
+    }
+  }
+
+  m_sps->setChromaFormatIdc(ChromaFormat::_420);
+  m_slice->setSPS(m_sps.get());
+  m_cs->slice = m_slice.get();
+}
+
+KernelBenchApp::~KernelBenchApp()
+{
+  m_cs->slice = nullptr;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+ClpRng KernelBenchApp::xClpRng() const
+{
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = (1 << m_bitDepth) - 1;
+  clpRng.bd  = m_bitDepth;
+  return clpRng;
+}
+
+void KernelBenchApp::xFill(Pel *dst, const ptrdiff_t stride, const int width, const int height, const int minVal,
+                           const int maxVal, std::mt19937 &rng) const
+{
+  std::uniform_int_distribution<int> dist(minVal, maxVal);
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[y * stride + x] = dist(rng);
+    }
+  }
+}
+
+// samples at the internal precision of the interpolation filter output
+void KernelBenchApp::xFillPred(Pel *dst, const ptrdiff_t stride, const int width, const int height,
+                               std::mt19937 &rng) const
+{
+  xFill(dst, stride, width, height, 0, (1 << m_bitDepth) - 1, rng);
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[y * stride + x] = (dst[y * stride + x] << IF_INTERNAL_FRAC_BITS(m_bitDepth)) - IF_INTERNAL_OFFS;
+    }
+  }
+}
+
+void KernelBenchApp::xFillPlane(const int idx, const int minVal, const int maxVal, std::mt19937 &rng)
+{
+  xFill(m_pelBuf[idx].data(), STRIDE, STRIDE, STRIDE, minVal, maxVal, rng);
+}
+
+void KernelBenchApp::xCollect(std::vector<int64_t> &out, const Pel *src, const ptrdiff_t stride, const int width,
+                              const int height) const
+{
+  for (int y = 0; y < height; y++)
+  {
+    out.insert(out.end(), src + y * stride, src + y * stride + width);
+  }
+}
+
+/** Reset all kernel tables to the C implementation and install the SIMD kernels of the given extension.
+ *  The constructors of the kernel classes only install the C kernels, as the process wide extension is fixed to
+ *  SCALAR by main().
+ */
+void KernelBenchApp::xSelectLevel(const int level)
+{
+  m_bufOps = PelBufferOps();
+  m_rdCost.init();
+  m_if = std::make_unique<InterpolationFilter>();
+  m_trQuant->selectScalar();
+  m_rdoq   = std::make_unique<QuantRDOQ>(nullptr);
+  m_alf    = std::make_unique<AdaptiveLoopFilter>();
+  m_affine = std::make_unique<AffineGradientSearch>();
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+  switch (level)
+  {
+  case AVX512:
+  case AVX2:
+    xSelectX86<AVX2>();
+    break;
+  case AVX:
+    xSelectX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    xSelectX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+#endif
+}
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+template<X86_VEXT vext> void KernelBenchApp::xSelectX86()
+{
+#if ENABLE_SIMD_OPT_BUFFER
+  m_bufOps._initPelBufOpsX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_DIST
+  m_rdCost._initRdCostX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+  m_if->_initInterpolationFilterX86<vext>();
+#endif
+  m_trQuant->selectX86<vext>();
+#if ENABLE_SIMD_OPT_RDOQ
+  m_rdoq->_initQuantRDOQX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_ALF
+  m_alf->_initAdaptiveLoopFilterX86<vext>();
+#endif
+#if ENABLE_SIMD_OPT_AFFINE_ME
+  m_affine->_initAffineGradientSearchX86<vext>();
+#endif
+}
+#endif
+
+void KernelBenchApp::xAddRdCostCases()
+{
+  static const int sizes[][2] = { { 4, 4 },   { 8, 8 },  { 16, 16 }, { 32, 32 }, { 64, 64 }, { 128, 128 },
+                                  { 16, 8 },  { 8, 16 }, { 32, 16 }, { 16, 32 }, { 12, 16 }, { 24, 32 }, { 48, 64 } };
+  static const struct
+  {
+    const char *name;
+    DFunc       distFunc;
+  } distFuncs[] = { { "RdCost::SAD", DFunc::SAD }, { "RdCost::SSE", DFunc::SSE }, { "RdCost::HAD", DFunc::HAD } };
+
+  for (const auto &distFunc: distFuncs)
+  {
+    for (const auto &size: sizes)
+    {
+      const int   width  = size[0];
+      const int   height = size[1];
+      const bool  isSad  = distFunc.distFunc == DFunc::SAD;
+      const DFunc dFunc  = distFunc.distFunc;
+      if (!isPowerOf2(width) && !isSad)
+      {
+        continue;
+      }
+
+      m_cases.push_back({ distFunc.name, sizeName(width, height), width * height,
+                          [this]()
+                          {
+                            std::mt19937 rng(m_seed);
+                            xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+                            xFillPlane(1, 0, (1 << m_bitDepth) - 1, rng);
+                          },
+                          [this, width, height, isSad, dFunc]()
+                          {
+                            const CPelBuf org(xPel(0), STRIDE, width, height);
+                            const CPelBuf cur(xPel(1), STRIDE, width, height);
+                            if (isSad)
+                            {
+                              // dispatched like the motion search, including the SAD functions of odd widths
+                              DistParam distParam;
+                              m_rdCost.setDistParam(distParam, org, cur, m_bitDepth, COMPONENT_Y, false);
+                              m_sums[0] = distParam.distFunc(distParam);
+                            }
+                            else
+                            {
+                              m_sums[0] = m_rdCost.getDistPart(org, cur, m_bitDepth, COMPONENT_Y, dFunc);
+                            }
+                          },
+                          [this](std::vector<int64_t> &out) { out.push_back(m_sums[0]); } });
+    }
+  }
+
+  for (const int size: { 8, 16 })
+  {
+    m_cases.push_back({ "RdCost::DmvrSadGrid", sizeName(size, size), size * size * DMVR_AREA,
+                        [this]()
+                        {
+                          std::mt19937 rng(m_seed);
+                          xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+                          xFillPlane(1, 0, (1 << m_bitDepth) - 1, rng);
+                        },
+                        [this, size]()
+                        {
+                          Distortion sads[DMVR_AREA];
+                          m_rdCost.getDmvrSadGrid(xPel(0), STRIDE, xPel(1), STRIDE, size, size, m_bitDepth, sads);
+                          std::copy(sads, sads + DMVR_AREA, m_sums.begin());
+                        },
+                        [this](std::vector<int64_t> &out) { out.insert(out.end(), m_sums.begin(), m_sums.begin() + DMVR_AREA); } });
+  }
+
+  for (const int numCand: { 4, 8 })
+  {
+    for (const auto &size: sizes)
+    {
+      const int width  = size[0];
+      const int height = size[1];
+
+      m_cases.push_back({ numCand == 4 ? "RdCost::SADx4" : "RdCost::SADx8", sizeName(width, height), width * height * numCand,
+                          [this]()
+                          {
+                            std::mt19937 rng(m_seed);
+                            xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+                            xFillPlane(1, 0, (1 << m_bitDepth) - 1, rng);
+                          },
+                          [this, width, height, numCand]()
+                          {
+                            // square pattern around the co-located block, as submitted by the TZ search
+                            static const int offsets[8][2] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 },
+                                                               { 1, 0 },   { -1, 1 }, { 0, 1 },  { 1, 1 } };
+                            const CPelBuf org(xPel(0), STRIDE, width, height);
+                            const Pel    *cur[8];
+                            Distortion    sads[8];
+                            for (int i = 0; i < numCand; i++)
+                            {
+                              cur[i] = xPel(1) + offsets[i][1] * STRIDE + offsets[i][0];
+                            }
+                            DistParam distParam;
+                            m_rdCost.setDistParam(distParam, org, xPel(1), STRIDE, m_bitDepth, COMPONENT_Y, 0);
+                            m_rdCost.getSADs(distParam, cur, numCand, sads);
+                            std::copy(sads, sads + numCand, m_sums.begin());
+                          },
+                          [this, numCand](std::vector<int64_t> &out) { out.insert(out.end(), m_sums.begin(), m_sums.begin() + numCand); } });
+    }
+  }
+}
+
+void KernelBenchApp::xAddInterpolationCases()
+{
+  using Filter = InterpolationFilter::Filter;
+
+  for (const int size: { 4, 8, 16, 32, 64, 128 })
+  {
+    const int numTaps = NTAPS_LUMA;
+
+    for (const ComponentID compID: { COMPONENT_Y, COMPONENT_Cb })
+    {
+      // half sample position, in units of 1/16 luma or 1/32 chroma samples
+      const int         frac  = isLuma(compID) ? 8 : 16;
+      const std::string label = isLuma(compID) ? " luma" : " chroma";
+      if (isChroma(compID) && size > MAX_BLK / 2)
+      {
+        continue;
+      }
+
+      const auto init = [this]()
+      {
+        std::mt19937 rng(m_seed);
+        xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+        std::fill(m_pelBuf[2].begin(), m_pelBuf[2].end(), 0);
+      };
+      const auto output = [this, size](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, size, size); };
+
+      m_cases.push_back({ "IF::filterHor" + label, sizeName(size, size), size * size, init,
+                          [this, size, compID, frac]()
+                          {
+                            m_if->filterHor(compID, xPel(0), STRIDE, xPel(2), STRIDE, size, size, frac, true,
+                                            xClpRng(), Filter::DEFAULT);
+                          },
+                          output });
+
+      m_cases.push_back({ "IF::filterVer" + label, sizeName(size, size), size * size, init,
+                          [this, size, compID, frac]()
+                          {
+                            m_if->filterVer(compID, xPel(0), STRIDE, xPel(2), STRIDE, size, size, frac, true, true,
+                                            xClpRng(), Filter::DEFAULT);
+                          },
+                          output });
+    }
+
+    // two-dimensional interpolation through the intermediate buffer, as used for fractional motion vectors
+    m_cases.push_back({ "IF::filterHor+Ver luma", sizeName(size, size), size * size,
+                        [this]()
+                        {
+                          std::mt19937 rng(m_seed);
+                          xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+                          std::fill(m_pelBuf[2].begin(), m_pelBuf[2].end(), 0);
+                        },
+                        [this, size, numTaps]()
+                        {
+                          const int rowsAbove = (numTaps >> 1) - 1;
+                          Pel      *tmp       = xPel(3);
+                          m_if->filterHor(COMPONENT_Y, xPel(0) - rowsAbove * STRIDE, STRIDE, tmp - rowsAbove * STRIDE,
+                                          STRIDE, size, size + numTaps - 1, 4, false, xClpRng(), Filter::DEFAULT);
+                          m_if->filterVer(COMPONENT_Y, tmp, STRIDE, xPel(2), STRIDE, size, size, 12, false, true,
+                                          xClpRng(), Filter::DEFAULT);
+                        },
+                        [this, size](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, size, size); } });
+  }
+}
+
+void KernelBenchApp::xAddBufferCases()
+{
+  for (const int size: { 4, 8, 16, 32, 64, 128 })
+  {
+    const auto output = [this, size](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, size, size); };
+
+    m_cases.push_back({ "PelBufferOps::addAvg", sizeName(size, size), size * size,
+                        [this]()
+                        {
+                          std::mt19937 rng(m_seed);
+                          xFillPred(m_pelBuf[0].data(), STRIDE, STRIDE, STRIDE, rng);
+                          xFillPred(m_pelBuf[1].data(), STRIDE, STRIDE, STRIDE, rng);
+                        },
+                        [this, size]()
+                        {
+                          const int shiftNum = IF_INTERNAL_FRAC_BITS(m_bitDepth) + 1;
+                          const int offset   = (1 << (shiftNum - 1)) + 2 * IF_INTERNAL_OFFS;
+                          const auto addAvg  = (size & 7) == 0 ? m_bufOps.addAvg8 : m_bufOps.addAvg4;
+                          addAvg(xPel(0), STRIDE, xPel(1), STRIDE, xPel(2), STRIDE, size, size, shiftNum, offset,
+                                 xClpRng());
+                        },
+                        output });
+
+    m_cases.push_back({ "PelBufferOps::reco", sizeName(size, size), size * size,
+                        [this]()
+                        {
+                          std::mt19937 rng(m_seed);
+                          const int    maxVal = (1 << m_bitDepth) - 1;
+                          xFillPlane(0, 0, maxVal, rng);
+                          xFillPlane(1, -maxVal, maxVal, rng);
+                        },
+                        [this, size]()
+                        {
+                          const auto reco = (size & 7) == 0 ? m_bufOps.reco8 : m_bufOps.reco4;
+                          reco(xPel(0), STRIDE, xPel(1), STRIDE, xPel(2), STRIDE, size, size, xClpRng());
+                        },
+                        output });
+
+    m_cases.push_back({ "PelBufferOps::calcSsd", sizeName(size, size), size * size,
+                        [this]()
+                        {
+                          std::mt19937 rng(m_seed);
+                          xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+                          xFillPlane(1, 0, (1 << m_bitDepth) - 1, rng);
+                        },
+                        [this, size]() { m_sums[0] = m_bufOps.calcSsd(xPel(0), STRIDE, xPel(1), STRIDE, size, size); },
+                        [this](std::vector<int64_t> &out) { out.push_back(m_sums[0]); } });
+  }
+
+  // bi-directional optical flow on the sub-blocks of at most 16x16 luma samples
+  for (const int size: { 8, 16 })
+  {
+    const int widthG  = size + 2 * BIO_EXTEND_SIZE;
+    const int heightG = size + 2 * BIO_EXTEND_SIZE;
+    const int numSbs  = (size >> 2) * (size >> 2);
+
+    // prediction signals of both lists and, unless computed by the benchmarked kernel, their gradients
+    const auto initBdof = [this, widthG, heightG](const bool withGradients)
+    {
+      std::mt19937 rng(m_seed);
+      xFillPred(m_pelBuf[0].data(), STRIDE, STRIDE, STRIDE, rng);
+      xFillPred(m_pelBuf[1].data(), STRIDE, STRIDE, STRIDE, rng);
+      for (auto &buf: m_gradBuf)
+      {
+        std::fill(buf.begin(), buf.end(), 0);
+      }
+      if (withGradients)
+      {
+        for (int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++)
+        {
+          m_scalarBufOps.bioGradFilter(xPel(refList), STRIDE, widthG, heightG, widthG, m_gradBuf[refList].data(),
+                                       m_gradBuf[2 + refList].data(), m_bitDepth);
+        }
+      }
+      for (int i = 0; i < 2 * MAX_BLK; i++)
+      {
+        m_intBuf[0][i] = std::uniform_int_distribution<int>(-15, 15)(rng);
+      }
+    };
+
+    m_cases.push_back({ "PelBufferOps::bioGradFilter", sizeName(size, size), 2 * widthG * heightG,
+                        [initBdof]() { initBdof(false); },
+                        [this, widthG, heightG]()
+                        {
+                          for (int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++)
+                          {
+                            m_bufOps.bioGradFilter(xPel(refList), STRIDE, widthG, heightG, widthG,
+                                                   m_gradBuf[refList].data(), m_gradBuf[2 + refList].data(),
+                                                   m_bitDepth);
+                          }
+                        },
+                        [this, widthG, heightG](std::vector<int64_t> &out)
+                        {
+                          for (const auto &buf: m_gradBuf)
+                          {
+                            out.insert(out.end(), buf.begin(), buf.begin() + widthG * heightG);
+                          }
+                        } });
+
+    m_cases.push_back({ "PelBufferOps::calcBIOSums", sizeName(size, size), size * size,
+                        [initBdof]() { initBdof(true); },
+                        [this, size, widthG]()
+                        {
+                          for (int yu = 0; yu < (size >> 2); yu++)
+                          {
+                            for (int xu = 0; xu < (size >> 2); xu++)
+                            {
+                              const ptrdiff_t srcOffset  = (xu << 2) + (yu << 2) * STRIDE;
+                              const ptrdiff_t gradOffset = (xu << 2) + (yu << 2) * widthG;
+                              int             sums[5]   = { 0, 0, 0, 0, 0 };
+                              m_bufOps.calcBIOSums(xPel(0) + srcOffset, xPel(1) + srcOffset,
+                                                   m_gradBuf[0].data() + gradOffset, m_gradBuf[1].data() + gradOffset,
+                                                   m_gradBuf[2].data() + gradOffset, m_gradBuf[3].data() + gradOffset,
+                                                   xu, yu, STRIDE, STRIDE, widthG, m_bitDepth, &sums[0], &sums[1],
+                                                   &sums[2], &sums[3], &sums[4]);
+                              std::copy(sums, sums + 5, m_sums.begin() + 5 * (yu * (size >> 2) + xu));
+                            }
+                          }
+                        },
+                        [this, numSbs](std::vector<int64_t> &out)
+                        { out.insert(out.end(), m_sums.begin(), m_sums.begin() + 5 * numSbs); } });
+
+    m_cases.push_back({ "PelBufferOps::addBIOAvg4", sizeName(size, size), size * size,
+                        [initBdof]() { initBdof(true); },
+                        [this, size, widthG]()
+                        {
+                          const int       shiftNum  = IF_INTERNAL_FRAC_BITS(m_bitDepth) + 1;
+                          const int       offset    = (1 << (shiftNum - 1)) + 2 * IF_INTERNAL_OFFS;
+                          const ptrdiff_t offsetPos = widthG * BIO_EXTEND_SIZE + BIO_EXTEND_SIZE;
+                          for (int yu = 0; yu < (size >> 2); yu++)
+                          {
+                            for (int xu = 0; xu < (size >> 2); xu++)
+                            {
+                              const ptrdiff_t srcOffset  = STRIDE + 1 + ((yu * STRIDE + xu) << 2);
+                              const ptrdiff_t gradOffset = offsetPos + ((yu * widthG + xu) << 2);
+                              const int       sbIdx      = yu * (size >> 2) + xu;
+                              m_bufOps.addBIOAvg4(xPel(0) + srcOffset, STRIDE, xPel(1) + srcOffset, STRIDE,
+                                                  xPel(2) + ((yu * STRIDE + xu) << 2), STRIDE,
+                                                  m_gradBuf[0].data() + gradOffset, m_gradBuf[1].data() + gradOffset,
+                                                  m_gradBuf[2].data() + gradOffset, m_gradBuf[3].data() + gradOffset,
+                                                  widthG, 4, 4, m_intBuf[0][2 * sbIdx], m_intBuf[0][2 * sbIdx + 1],
+                                                  shiftNum, offset, xClpRng());
+                            }
+                          }
+                        },
+                        [this, size](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, size, size); } });
+  }
+
+  // prediction refinement with optical flow, applied per affine sub-block
+  {
+    const int sbSize     = AFFINE_SUBBLOCK_SIZE;
+    const int extSize    = AFFINE_SUBBLOCK_SIZE + 2 * PROF_BORDER_EXT_W;
+    const int gradOffset = PROF_BORDER_EXT_H * extSize + PROF_BORDER_EXT_W;
+    const int dmvLimit   = (1 << 5) - 1;
+
+    const auto initProf = [this, extSize, dmvLimit](const bool withGradients)
+    {
+      std::mt19937 rng(m_seed);
+      xFillPred(m_pelBuf[0].data(), STRIDE, STRIDE, STRIDE, rng);
+      std::fill(m_gradBuf[0].begin(), m_gradBuf[0].end(), 0);
+      std::fill(m_gradBuf[1].begin(), m_gradBuf[1].end(), 0);
+      if (withGradients)
+      {
+        m_scalarBufOps.profGradFilter(xPel(0) - STRIDE - 1, STRIDE, extSize, extSize, extSize, m_gradBuf[0].data(),
+                                      m_gradBuf[1].data(), m_bitDepth);
+      }
+      for (int i = 0; i < AFFINE_SUBBLOCK_SIZE * AFFINE_SUBBLOCK_SIZE; i++)
+      {
+        m_intBuf[0][i] = std::uniform_int_distribution<int>(-dmvLimit, dmvLimit)(rng);
+        m_intBuf[1][i] = std::uniform_int_distribution<int>(-dmvLimit, dmvLimit)(rng);
+      }
+      std::fill(m_pelBuf[2].begin(), m_pelBuf[2].end(), 0);
+    };
+
+    m_cases.push_back({ "PelBufferOps::profGradFilter", sizeName(extSize, extSize), extSize * extSize,
+                        [initProf]() { initProf(false); },
+                        [this, extSize]()
+                        {
+                          m_bufOps.profGradFilter(xPel(0) - STRIDE - 1, STRIDE, extSize, extSize, extSize,
+                                                  m_gradBuf[0].data(), m_gradBuf[1].data(), m_bitDepth);
+                        },
+                        [this, extSize](std::vector<int64_t> &out)
+                        {
+                          out.insert(out.end(), m_gradBuf[0].begin(), m_gradBuf[0].begin() + extSize * extSize);
+                          out.insert(out.end(), m_gradBuf[1].begin(), m_gradBuf[1].begin() + extSize * extSize);
+                        } });
+
+    for (const bool bi: { false, true })
+    {
+      m_cases.push_back({ bi ? "PelBufferOps::applyPROF bi" : "PelBufferOps::applyPROF uni",
+                          sizeName(sbSize, sbSize), sbSize * sbSize, [initProf]() { initProf(true); },
+                          [this, sbSize, extSize, gradOffset, bi]()
+                          {
+                            const int shift  = IF_INTERNAL_FRAC_BITS(m_bitDepth);
+                            const Pel offset = (1 << shift >> 1) + IF_INTERNAL_OFFS;
+                            m_bufOps.applyPROF(xPel(2), STRIDE, xPel(0), STRIDE, sbSize, sbSize,
+                                               m_gradBuf[0].data() + gradOffset, m_gradBuf[1].data() + gradOffset,
+                                               extSize, m_intBuf[0].data(), m_intBuf[1].data(), sbSize, bi, shift,
+                                               offset, xClpRng());
+                          },
+                          [this, sbSize](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, sbSize, sbSize); } });
+    }
+  }
+}
+
+void KernelBenchApp::xAddTransformCases()
+{
+  static const struct
+  {
+    const char *name;
+    TransType   trType;
+    int         maxLog2Size;
+  } trTypes[] = { { "DCT2", TransType::DCT2, 6 }, { "DST7", TransType::DST7, 5 }, { "DCT8", TransType::DCT8, 5 } };
+
+  for (const auto &tr: trTypes)
+  {
+    for (int log2Size = 2; log2Size <= tr.maxLog2Size; log2Size++)
+    {
+      const int       size       = 1 << log2Size;
+      const TransType trType     = tr.trType;
+      const int       skip       = (trType != TransType::DCT2 && size == 32) ? 16 : std::max(size - MAX_NONZERO_TU_SIZE, 0);
+      const int       maxLog2TrDynamicRange = std::max<int>(15, m_bitDepth + 6);
+
+      m_cases.push_back({ std::string("TrQuant::fwd") + tr.name, sizeName(size, size), size * size,
+                          [this, size]()
+                          {
+                            std::mt19937                       rng(m_seed);
+                            std::uniform_int_distribution<int> dist(-(1 << m_bitDepth) + 1, (1 << m_bitDepth) - 1);
+                            for (int i = 0; i < size * size; i++)
+                            {
+                              m_coeffBuf[0][i] = dist(rng);
+                            }
+                            std::fill(m_coeffBuf[2].begin(), m_coeffBuf[2].end(), 0);
+                          },
+                          [this, size, log2Size, trType, skip, maxLog2TrDynamicRange]()
+                          {
+                            const int trMatrixShift = g_transformMatrixShift[TRANSFORM_FORWARD];
+                            const int shift1st =
+                              log2Size + m_bitDepth + trMatrixShift - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
+                            const int shift2nd = log2Size + trMatrixShift + COM16_C806_TRANS_PREC;
+                            FwdTrans *fwdTx    = m_trQuant->fwdTx(trType, log2Size);
+                            fwdTx(m_coeffBuf[0].data(), m_coeffBuf[1].data(), shift1st, size, 0, skip);
+                            fwdTx(m_coeffBuf[1].data(), m_coeffBuf[2].data(), shift2nd, size, skip, skip);
+                          },
+                          [this, size](std::vector<int64_t> &out)
+                          { out.insert(out.end(), m_coeffBuf[2].begin(), m_coeffBuf[2].begin() + size * size); } });
+
+      m_cases.push_back({ std::string("TrQuant::inv") + tr.name, sizeName(size, size), size * size,
+                          [this, size, skip]()
+                          {
+                            std::mt19937                       rng(m_seed);
+                            std::uniform_int_distribution<int> dist(-(1 << 12), 1 << 12);
+                            for (int y = 0; y < size; y++)
+                            {
+                              for (int x = 0; x < size; x++)
+                              {
+                                m_coeffBuf[0][y * size + x] = x < size - skip && y < size - skip ? dist(rng) : 0;
+                              }
+                            }
+                            std::fill(m_coeffBuf[2].begin(), m_coeffBuf[2].end(), 0);
+                          },
+                          [this, size, log2Size, trType, skip, maxLog2TrDynamicRange]()
+                          {
+                            const int trMatrixShift = g_transformMatrixShift[TRANSFORM_INVERSE];
+                            const int shift1st      = trMatrixShift + 1 + COM16_C806_TRANS_PREC;
+                            const int shift2nd =
+                              (trMatrixShift + maxLog2TrDynamicRange - 1) - m_bitDepth + COM16_C806_TRANS_PREC;
+                            InvTrans *invTx = m_trQuant->invTx(trType, log2Size);
+                            invTx(m_coeffBuf[0].data(), m_coeffBuf[1].data(), shift1st, size, skip, skip,
+                                  -(1 << maxLog2TrDynamicRange), (1 << maxLog2TrDynamicRange) - 1);
+                            invTx(m_coeffBuf[1].data(), m_coeffBuf[2].data(), shift2nd, size, 0, skip,
+                                  std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max());
+                          },
+                          [this, size](std::vector<int64_t> &out)
+                          { out.insert(out.end(), m_coeffBuf[2].begin(), m_coeffBuf[2].begin() + size * size); } });
+    }
+  }
+}
+
+void KernelBenchApp::xAddQuantCases()
+{
+  for (const int size: { 4, 8, 16, 32 })
+  {
+    for (const bool scalingList: { false, true })
+    {
+      m_cases.push_back({ scalingList ? "QuantRDOQ::LevelCands scaling list" : "QuantRDOQ::LevelCands", sizeName(size, size),
+                          size * size,
+                          [this, size]()
+                          {
+                            // mostly small coefficients, and large ones whose scaled levels are clipped
+                            std::mt19937                       rng(m_seed);
+                            std::uniform_int_distribution<int> coeff(-(1 << 15), 1 << 15);
+                            std::uniform_int_distribution<int> quantCoeff(g_quantScales[0][5], 16 * g_quantScales[0][0]);
+                            std::uniform_real_distribution<double> errScale(0.5, 2.0);
+                            for (int i = 0; i < size * size; i++)
+                            {
+                              m_coeffBuf[0][i] = coeff(rng) >> (i % 3 == 0 ? 0 : 9);
+                              m_quantCoeff[i]  = quantCoeff(rng);
+                              m_errScale[i]    = errScale(rng);
+                            }
+                            *m_levelCands = RdoqLevelCands();
+                          },
+                          [this, size, scalingList]()
+                          {
+                            const int qBits = QUANT_SHIFT + 4;
+                            m_anyLevel      = m_rdoq->m_quantLevelCands(
+                              m_coeffBuf[0].data(), size, size, size, scalingList ? m_quantCoeff.data() : nullptr,
+                              g_quantScales[0][2], scalingList ? m_errScale.data() : nullptr, 1.25, qBits,
+                              (1 << 15) - 1, *m_levelCands);
+                          },
+                          [this, size](std::vector<int64_t> &out)
+                          {
+                            const RdoqLevelCands &cands = *m_levelCands;
+                            out.push_back(m_anyLevel);
+                            out.insert(out.end(), cands.levelDouble, cands.levelDouble + size * size);
+                            out.insert(out.end(), cands.maxAbsLevel, cands.maxAbsLevel + size * size);
+                            for (const double *cost: { cands.costZero, cands.costMax, cands.costMaxM1 })
+                            {
+                              for (int i = 0; i < size * size; i++)
+                              {
+                                int64_t bits;
+                                memcpy(&bits, &cost[i], sizeof(bits));
+                                out.push_back(bits);
+                              }
+                            }
+                          } });
+    }
+  }
+}
+
+void KernelBenchApp::xAddAlfCases()
+{
+  const int ctuSize    = MAX_BLK;
+  const int vbPosLuma  = ctuSize - ALF_VB_POS_ABOVE_CTUROW_LUMA;
+  const int ctuSizeC   = ctuSize >> 1;
+  const int vbPosChroma = ctuSizeC - ALF_VB_POS_ABOVE_CTUROW_CHMA;
+  const int blkSize    = AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE;
+
+  // random classes, filters and clipping values within the ranges allowed by the standard
+  const auto initAlf = [this]()
+  {
+    std::mt19937 rng(m_seed);
+    xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+    xFillPlane(1, 0, (1 << m_bitDepth) - 1, rng);
+    std::fill(m_pelBuf[2].begin(), m_pelBuf[2].end(), 0);
+    for (auto &cl: m_classifierBuf)
+    {
+      cl = AlfClassifier(rng() % MAX_NUM_ALF_CLASSES, rng() % 4);
+    }
+    for (auto &coeff: m_alfCoeff)
+    {
+      coeff = std::uniform_int_distribution<int>(-64, 63)(rng);
+    }
+    for (auto &clip: m_alfClip)
+    {
+      const int clipIdx = rng() % AdaptiveLoopFilter::MAX_ALF_NUM_CLIP_VALS;
+      clip              = clipIdx == 0 ? 1 << m_bitDepth : 1 << (m_bitDepth - 1 - 2 * clipIdx);
+    }
+  };
+
+  m_cases.push_back({ "ALF::deriveClassificationBlk", sizeName(ctuSize, ctuSize), ctuSize * ctuSize,
+                      [this]()
+                      {
+                        std::mt19937 rng(m_seed);
+                        xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+                        std::fill(m_classifierBuf.begin(), m_classifierBuf.end(), AlfClassifier(0, 0));
+                      },
+                      [this, ctuSize, vbPosLuma, blkSize]()
+                      {
+                        const CPelBuf srcLuma(xPel(0), STRIDE, ctuSize, ctuSize);
+                        for (int y = 0; y < ctuSize; y += blkSize)
+                        {
+                          for (int x = 0; x < ctuSize; x += blkSize)
+                          {
+                            const Area blk(x, y, blkSize, blkSize);
+                            m_alf->m_deriveClassificationBlk(m_classifier.data(), m_laplacian, srcLuma, blk, blk,
+                                                             m_bitDepth + 4, ctuSize, vbPosLuma);
+                          }
+                        }
+                      },
+                      [this](std::vector<int64_t> &out)
+                      {
+                        for (const auto &cl: m_classifierBuf)
+                        {
+                          out.push_back(cl.classIdx);
+                          out.push_back(cl.transposeIdx);
+                        }
+                      } });
+
+  m_cases.push_back({ "ALF::filter7x7Blk", sizeName(ctuSize, ctuSize), ctuSize * ctuSize, initAlf,
+                      [this, ctuSize, vbPosLuma]()
+                      {
+                        const Area blk(0, 0, ctuSize, ctuSize);
+                        m_alf->m_filter7x7Blk(m_classifier.data(),
+                                              PelUnitBuf(ChromaFormat::_400, PelBuf(xPel(2), STRIDE, ctuSize, ctuSize)),
+                                              CPelUnitBuf(ChromaFormat::_400, CPelBuf(xPel(0), STRIDE, ctuSize, ctuSize)),
+                                              blk, blk, COMPONENT_Y, m_alfCoeff.data(), m_alfClip.data(), xClpRng(),
+                                              *m_cs, ctuSize, vbPosLuma);
+                      },
+                      [this, ctuSize](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, ctuSize, ctuSize); } });
+
+  m_cases.push_back({ "ALF::filter5x5Blk", sizeName(ctuSizeC, ctuSizeC), ctuSizeC * ctuSizeC, initAlf,
+                      [this, ctuSizeC, vbPosChroma]()
+                      {
+                        const Area   blk(0, 0, ctuSizeC, ctuSizeC);
+                        const PelBuf dstLuma(xPel(3), STRIDE, 2 * ctuSizeC, 2 * ctuSizeC);
+                        const PelBuf dstChroma(xPel(2), STRIDE, ctuSizeC, ctuSizeC);
+                        const CPelBuf srcLuma(xPel(1), STRIDE, 2 * ctuSizeC, 2 * ctuSizeC);
+                        const CPelBuf srcChroma(xPel(0), STRIDE, ctuSizeC, ctuSizeC);
+                        m_alf->m_filter5x5Blk(m_classifier.data(), PelUnitBuf(ChromaFormat::_420, dstLuma, dstChroma, dstChroma),
+                                              CPelUnitBuf(ChromaFormat::_420, srcLuma, srcChroma, srcChroma), blk, blk,
+                                              COMPONENT_Cb, m_alfCoeff.data(), m_alfClip.data(), xClpRng(), *m_cs,
+                                              ctuSizeC, vbPosChroma);
+                      },
+                      [this, ctuSizeC](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, ctuSizeC, ctuSizeC); } });
+
+  m_cases.push_back({ "ALF::filterCcAlf", sizeName(ctuSizeC, ctuSizeC), ctuSizeC * ctuSizeC,
+                      [this, initAlf]()
+                      {
+                        initAlf();
+                        std::mt19937 rng(m_seed + 1);
+                        xFillPlane(2, 0, (1 << m_bitDepth) - 1, rng);
+                      },
+                      [this, ctuSize, ctuSizeC, vbPosLuma]()
+                      {
+                        ClpRngs clpRngs;
+                        for (auto &clpRng: clpRngs.comp)
+                        {
+                          clpRng = xClpRng();
+                        }
+                        const CPelBuf srcLuma(xPel(0), STRIDE, ctuSize, ctuSize);
+                        const CPelBuf srcChroma(xPel(1), STRIDE, ctuSizeC, ctuSizeC);
+                        m_alf->m_filterCcAlf(PelBuf(xPel(2), STRIDE, ctuSizeC, ctuSizeC),
+                                             CPelUnitBuf(ChromaFormat::_420, srcLuma, srcChroma, srcChroma),
+                                             Area(0, 0, ctuSizeC, ctuSizeC), Area(0, 0, ctuSize, ctuSize), COMPONENT_Cb,
+                                             m_alfCoeff.data(), clpRngs, *m_cs, ctuSize, vbPosLuma);
+                      },
+                      [this, ctuSizeC](std::vector<int64_t> &out) { xCollect(out, xPel(2), STRIDE, ctuSizeC, ctuSizeC); } });
+}
+
+void KernelBenchApp::xAddAffineCases()
+{
+  for (const int size: { 8, 16, 32, 64, 128 })
+  {
+    const auto initSobel = [this]()
+    {
+      std::mt19937 rng(m_seed);
+      xFillPlane(0, 0, (1 << m_bitDepth) - 1, rng);
+      std::fill(m_intBuf[0].begin(), m_intBuf[0].end(), 0);
+    };
+    const auto outputSobel = [this, size](std::vector<int64_t> &out)
+    { out.insert(out.end(), m_intBuf[0].begin(), m_intBuf[0].begin() + size * size); };
+
+    m_cases.push_back({ "AffineGradientSearch::HorizontalSobel", sizeName(size, size), size * size, initSobel,
+                        [this, size]()
+                        { m_affine->m_HorizontalSobelFilter(xPel(0), STRIDE, m_intBuf[0].data(), size, size, size); },
+                        outputSobel });
+
+    m_cases.push_back({ "AffineGradientSearch::VerticalSobel", sizeName(size, size), size * size, initSobel,
+                        [this, size]()
+                        { m_affine->m_VerticalSobelFilter(xPel(0), STRIDE, m_intBuf[0].data(), size, size, size); },
+                        outputSobel });
+
+    for (const bool b6Param: { false, true })
+    {
+      m_cases.push_back({ b6Param ? "AffineGradientSearch::EqualCoeff 6-param" : "AffineGradientSearch::EqualCoeff 4-param",
+                          sizeName(size, size), size * size,
+                          [this]()
+                          {
+                            std::mt19937 rng(m_seed);
+                            const int    maxVal = (1 << m_bitDepth) - 1;
+                            xFillPlane(1, -maxVal, maxVal, rng);
+                            std::uniform_int_distribution<int> dist(-8 * maxVal, 8 * maxVal);
+                            for (int i = 0; i < MAX_BLK * MAX_BLK; i++)
+                            {
+                              m_intBuf[0][i] = dist(rng);
+                              m_intBuf[1][i] = dist(rng);
+                            }
+                          },
+                          [this, size, b6Param]()
+                          {
+                            int *derivate[2] = { m_intBuf[0].data(), m_intBuf[1].data() };
+                            std::fill(&m_equalCoeff[0][0], &m_equalCoeff[0][0] + 7 * 7, 0);
+                            // the residual is stored with the stride of the gradients, as in the affine motion search
+                            m_affine->m_EqualCoeffComputer(m_pelBuf[1].data(), size, derivate, size, m_equalCoeff, size,
+                                                           size, b6Param);
+                          },
+                          [this](std::vector<int64_t> &out)
+                          { out.insert(out.end(), &m_equalCoeff[0][0], &m_equalCoeff[0][0] + 7 * 7); } });
+    }
+  }
+}
+
+double KernelBenchApp::xTime(const BenchCase &bc) const
+{
+  using Clock = std::chrono::steady_clock;
+
+  const double minTime  = m_minTime * 1e-3;
+  double       elapsed  = 0.0;
+  int64_t      numCalls = 0;
+
+  for (int64_t batch = 1; elapsed < minTime; batch = std::min<int64_t>(2 * batch, 1 << 20))
+  {
+    const auto start = Clock::now();
+    for (int64_t i = 0; i < batch; i++)
+    {
+      bc.exec();
+    }
+    elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+    numCalls += batch;
+  }
+
+  return 1e9 * elapsed / numCalls;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+int KernelBenchApp::run()
+{
+  m_levels.push_back(0);
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+  int maxLevel = _get_x86_extensions();
+  if (!m_simdLevel.empty())
+  {
+    const auto it = std::find(std::begin(s_levelNames), std::end(s_levelNames), m_simdLevel);
+    CHECK(it == std::end(s_levelNames), "Unknown SIMD extension " << m_simdLevel);
+    maxLevel = std::min<int>(maxLevel, int(it - std::begin(s_levelNames)));
+  }
+  // SSE4.2 and AVX-512 kernels are the SSE4.1 and AVX2 ones
+  for (const int level: { SSE41, AVX, AVX2 })
+  {
+    if (level <= maxLevel)
+    {
+      m_levels.push_back(level);
+    }
+  }
+#endif
+
+  xAddRdCostCases();
+  xAddInterpolationCases();
+  xAddBufferCases();
+  xAddTransformCases();
+  xAddQuantCases();
+  xAddAlfCases();
+  xAddAffineCases();
+
+  if (!m_kernelFilter.empty())
+  {
+    m_cases.erase(std::remove_if(m_cases.begin(), m_cases.end(),
+                                 [this](const BenchCase &bc) { return bc.name.find(m_kernelFilter) == std::string::npos; }),
+                  m_cases.end());
+  }
+
+  std::vector<std::vector<BenchResult>> results(m_cases.size(), std::vector<BenchResult>(m_levels.size()));
+  std::vector<uint64_t>                 refHash(m_cases.size());
+  std::vector<int64_t>                  values;
+  int                                   numFailures = 0;
+
+  for (size_t levelIdx = 0; levelIdx < m_levels.size(); levelIdx++)
+  {
+    xSelectLevel(m_levels[levelIdx]);
+
+    for (size_t caseIdx = 0; caseIdx < m_cases.size(); caseIdx++)
+    {
+      const BenchCase &bc  = m_cases[caseIdx];
+      BenchResult     &res = results[caseIdx][levelIdx];
+
+      bc.init();
+      bc.exec();
+      values.clear();
+      bc.output(values);
+
+      const uint64_t hash = hashOutput(values);
+      if (levelIdx == 0)
+      {
+        refHash[caseIdx] = hash;
+      }
+      else if (hash != refHash[caseIdx])
+      {
+        res.bitExact = false;
+        numFailures++;
+        msg(WARNING, "%s %s: %s output differs from the C kernel\n", bc.name.c_str(), bc.size.c_str(),
+            s_levelNames[m_levels[levelIdx]]);
+      }
+
+      if (!m_verifyOnly)
+      {
+        res.nsPerCall = xTime(bc);
+      }
+    }
+  }
+
+  // throughput in mega samples per second, and the speed-up over the C kernel
+  msg(INFO, "\n%-42s %-8s", "Kernel", "Size");
+  for (const int level: m_levels)
+  {
+    msg(INFO, " %17s", s_levelNames[level]);
+  }
+  msg(INFO, "\n");
+
+  std::ofstream csvFile;
+  if (!m_csvFileName.empty())
+  {
+    csvFile.open(m_csvFileName);
+    CHECK(!csvFile.is_open(), "Cannot open CSV file " << m_csvFileName);
+    csvFile << "kernel,size,simd,ns_per_call,msamples_per_s,speedup,bit_exact\n";
+  }
+
+  for (size_t caseIdx = 0; caseIdx < m_cases.size(); caseIdx++)
+  {
+    const BenchCase &bc = m_cases[caseIdx];
+    msg(INFO, "%-42s %-8s", bc.name.c_str(), bc.size.c_str());
+    for (size_t levelIdx = 0; levelIdx < m_levels.size(); levelIdx++)
+    {
+      const BenchResult &res        = results[caseIdx][levelIdx];
+      const double       throughput = res.nsPerCall > 0 ? 1e3 * bc.numSamples / res.nsPerCall : 0.0;
+      const double       speedup    = res.nsPerCall > 0 ? results[caseIdx][0].nsPerCall / res.nsPerCall : 0.0;
+      if (!res.bitExact)
+      {
+        msg(INFO, " %17s", "MISMATCH");
+      }
+      else if (m_verifyOnly)
+      {
+        msg(INFO, " %17s", "OK");
+      }
+      else
+      {
+        msg(INFO, " %9.1f (x%5.2f)", throughput, speedup);
+      }
+      if (csvFile.is_open())
+      {
+        csvFile << bc.name << "," << bc.size << "," << s_levelNames[m_levels[levelIdx]] << "," << res.nsPerCall << ","
+                << throughput << "," << speedup << "," << (res.bitExact ? 1 : 0) << "\n";
+      }
+    }
+    msg(INFO, "\n");
+  }
+
+  msg(INFO, "\n%d kernels, %d bit-exactness failures\n", int(m_cases.size()), numFailures);
+
+  return numFailures;
+}
+
+//! \}
@@ -0,0 +1,178 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchApp.h
+    \brief    Kernel benchmark application class (header)
+*/
+
+#ifndef __KERNELBENCHAPP__
+#define __KERNELBENCHAPP__
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/AffineGradientSearch.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/QuantRDOQ.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/TrQuant.h"
+
+#include "KernelBenchAppCfg.h"
+
+class SPS;
+class Slice;
+class CodingStructure;
+
+//! \ingroup KernelBenchApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// transform kernel tables of TrQuant, which are not accessible from outside of the class
+class TransformKernels : public TrQuant
+{
+public:
+  void selectScalar() { init(nullptr, MAX_TB_SIZEY, false, false, false, false); }
+#ifdef TARGET_SIMD_X86
+  template<X86_VEXT vext> void selectX86() { _initX86<vext>(); }
+#endif
+
+  FwdTrans *fwdTx(TransType trType, int log2Size) const { return m_fwdTx[trType][log2Size - 1]; }
+  InvTrans *invTx(TransType trType, int log2Size) const { return m_invTx[trType][log2Size - 1]; }
+};
+
+/// kernel benchmark application class
+class KernelBenchApp : public KernelBenchAppCfg
+{
+  /// one benchmarked kernel invocation, run with the function tables of the selected SIMD extension
+  struct BenchCase
+  {
+    std::string                                  name;
+    std::string                                  size;
+    int                                          numSamples;   ///< samples processed per call, for the throughput
+    std::function<void()>                        init;         ///< fills the inputs and clears the outputs
+    std::function<void()>                        exec;         ///< runs the kernel once
+    std::function<void(std::vector<int64_t> &)>  output;       ///< collects the outputs for the bit-exactness check
+  };
+
+  struct BenchResult
+  {
+    double nsPerCall = 0.0;
+    bool   bitExact  = true;
+  };
+
+  static constexpr int MAX_BLK  = MAX_CU_SIZE;
+  static constexpr int MARGIN   = 16;
+  static constexpr int STRIDE   = MAX_BLK + 2 * MARGIN;
+  static constexpr int NUM_PELS = 4;
+
+  std::vector<BenchCase> m_cases;
+  std::vector<int>       m_levels;   ///< X86_VEXT values of the benchmarked extensions, SCALAR first
+
+  // kernel tables of the selected SIMD extension
+  PelBufferOps                          m_bufOps;
+  PelBufferOps                          m_scalarBufOps;   ///< C kernels, used to prepare the inputs
+  RdCost                                m_rdCost;
+  std::unique_ptr<InterpolationFilter>  m_if;
+  std::unique_ptr<TransformKernels>     m_trQuant;
+  std::unique_ptr<QuantRDOQ>            m_rdoq;
+  std::unique_ptr<AdaptiveLoopFilter>   m_alf;
+  std::unique_ptr<AffineGradientSearch> m_affine;
+
+  // minimal coding structure for the ALF kernels, which take the chroma format from the SPS
+  std::unique_ptr<SPS>                  m_sps;
+  std::unique_ptr<Slice>                m_slice;
+  std::unique_ptr<CodingStructure>      m_cs;
+
+  // test data, shared by all cases
+  std::vector<Pel>           m_pelBuf[NUM_PELS];
+  std::vector<Pel>           m_gradBuf[4];
+  std::vector<int>           m_intBuf[4];
+  std::vector<int64_t>       m_sums;
+  std::vector<TCoeff>        m_coeffBuf[3];
+  std::vector<int>           m_quantCoeff;
+  std::vector<double>        m_errScale;
+  std::unique_ptr<RdoqLevelCands> m_levelCands;
+  bool                       m_anyLevel = false;
+  std::vector<AlfClassifier> m_classifierBuf;
+  std::vector<AlfClassifier*> m_classifier;
+  std::vector<AlfCoeff>      m_alfCoeff;
+  std::vector<Pel>           m_alfClip;
+  int64_t                    m_equalCoeff[7][7];
+  int                        m_laplacianData[NUM_DIRECTIONS][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5]
+                                            [AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5];
+  int                       *m_laplacianPtr[NUM_DIRECTIONS][AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE + 5];
+  int                      **m_laplacian[NUM_DIRECTIONS];
+
+  Pel     *xPel(int idx) { return m_pelBuf[idx].data() + MARGIN * STRIDE + MARGIN; }
+  ClpRng   xClpRng() const;
+  void     xFill(Pel *dst, ptrdiff_t stride, int width, int height, int minVal, int maxVal, std::mt19937 &rng) const;
+  void     xFillPred(Pel *dst, ptrdiff_t stride, int width, int height, std::mt19937 &rng) const;
+  void     xFillPlane(int idx, int minVal, int maxVal, std::mt19937 &rng);
+  void     xCollect(std::vector<int64_t> &out, const Pel *src, ptrdiff_t stride, int width, int height) const;
+
+  void     xSelectLevel(int level);
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+  template<X86_VEXT vext> void xSelectX86();
+#endif
+
+  void     xAddRdCostCases();
+  void     xAddInterpolationCases();
+  void     xAddBufferCases();
+  void     xAddTransformCases();
+  void     xAddQuantCases();
+  void     xAddAlfCases();
+  void     xAddAffineCases();
+
+  double   xTime(const BenchCase &bc) const;
+
+public:
+  KernelBenchApp();
+  virtual ~KernelBenchApp();
+
+  int run();   ///< runs all selected kernels, returns the number of bit-exactness failures
+};
+
+//! \}
+
+#endif   // __KERNELBENCHAPP__
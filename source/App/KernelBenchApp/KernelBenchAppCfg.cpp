@@ -0,0 +1,126 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchAppCfg.cpp
+    \brief    Kernel benchmark configuration class
+*/
+
+#include <cstdio>
+#include <string>
+#include "KernelBenchAppCfg.h"
+#include "Utilities/program_options_lite.h"
+
+namespace po = ProgramOptionsLite;
+
+//! \ingroup KernelBenchApp
+//! \{
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+bool KernelBenchAppCfg::parseCfg(int argc, char *argv[])
+{
+  bool do_help = false;
+  int  warnUnknowParameter = 0;
+  po::Options opts;
+
+  // clang-format off
+  opts.addOptions()
+  ("help",                      do_help,                               false,      "this help text")
+  ("Kernels,k",                 m_kernelFilter,                        std::string(""), "only run the kernels whose name contains this string (default: all)")
+  ("SIMD",                      m_simdLevel,                           std::string(""), "highest SIMD extension to benchmark (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension")
+  ("BitDepth,d",                m_bitDepth,                            10,         "sample bit depth of the test data")
+  ("MinTime,t",                 m_minTime,                             50,         "minimum measurement time per kernel and SIMD extension in ms")
+  ("Seed",                      m_seed,                                1u,         "seed of the test data generator")
+  ("VerifyOnly",                m_verifyOnly,                          false,      "only check bit-exactness of the SIMD kernels against the C code")
+  ("CsvFile,o",                 m_csvFileName,                         std::string(""), "write the results to this CSV file")
+
+  ("WarnUnknowParameter,w",     warnUnknowParameter,                   0,          "warn for unknown configuration parameters instead of failing")
+  ;
+  // clang-format on
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const std::list<const char *> &argv_unhandled = po::scanArgv(opts, argc, (const char **) argv, err);
+
+  for (std::list<const char *>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    std::cerr << "Unhandled argument ignored: "<< *it << std::endl;
+  }
+
+  if (do_help)
+  {
+    po::doHelp(std::cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    if (!warnUnknowParameter)
+    {
+      /* errors have already been reported to stderr */
+      return false;
+    }
+  }
+
+  if (m_bitDepth < 8 || m_bitDepth > 12)
+  {
+    std::cerr << "BitDepth must be in the range 8 to 12, aborting" << std::endl;
+    return false;
+  }
+  if (m_minTime < 1)
+  {
+    std::cerr << "MinTime must be at least 1 ms, aborting" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+KernelBenchAppCfg::KernelBenchAppCfg()
+  : m_bitDepth(10)
+  , m_minTime(50)
+  , m_seed(1)
+  , m_verifyOnly(false)
+{
+}
+
+KernelBenchAppCfg::~KernelBenchAppCfg()
+{
+}
+
+//! \}
@@ -0,0 +1,74 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchAppCfg.h
+    \brief    Kernel benchmark configuration class (header)
+*/
+
+#ifndef __KERNELBENCHAPPCFG__
+#define __KERNELBENCHAPPCFG__
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include <string>
+
+//! \ingroup KernelBenchApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Kernel benchmark configuration class
+class KernelBenchAppCfg
+{
+protected:
+  std::string m_kernelFilter;   ///< only kernels whose name contains this string are run
+  std::string m_simdLevel;      ///< highest SIMD extension to benchmark, empty for the highest one supported
+  int         m_bitDepth;       ///< sample bit depth of the test data
+  int         m_minTime;        ///< minimum measurement time per kernel and extension in milliseconds
+  uint32_t    m_seed;           ///< seed of the test data generator
+  bool        m_verifyOnly;     ///< only check bit-exactness against the C code, without timing
+  std::string m_csvFileName;    ///< optional CSV output file
+
+public:
+  KernelBenchAppCfg();
+  virtual ~KernelBenchAppCfg();
+
+  bool parseCfg(int argc, char *argv[]);   ///< initialize option class from configuration
+};
+
+//! \}
+
+#endif   // __KERNELBENCHAPPCFG__
@@ -285,6 +285,16 @@ PelBufferOps::PelBufferOps()
   profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+
+  rspSignal      = rspSignalCore;
+  fwdScaleSignal = fwdScaleSignalCore;
+  invScaleSignal = invScaleSignalCore;
+
+  sampleRateConvHor = sampleRateConvHorCore;
+  sampleRateConvVer = sampleRateConvVerCore;
+
+  calcSsd     = calcSsdCore;
+  ssimMoments = ssimMomentsCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -322,6 +332,148 @@ void paddingCore(Pel *ptr, ptrdiff_t stride, int width, int height, int padSize)
     memcpy(ptrTemp2 + i * stride, (ptrTemp2), numBytes);
   }
 }
+void rspSignalCore(Pel *ptr, ptrdiff_t stride, int width, int height, const Pel *lut)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      ptr[x] = lut[ptr[x]];
+    }
+    ptr += stride;
+  }
+}
+
+void fwdScaleSignalCore(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int sign   = sgn2(ptr[x]);
+      const int absval = sign * ptr[x];
+      ptr[x] = (Pel) Clip3(-maxAbsClip, maxAbsClip, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
+    }
+    ptr += stride;
+  }
+}
+
+void invScaleSignalCore(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Pel src    = Clip3((Pel) (-maxAbsClip - 1), (Pel) maxAbsClip, ptr[x]);
+      const int sign   = sgn2(src);
+      const int absval = sign * src;
+      int       val    = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
+      if (sizeof(Pel) == 2) // avoid overflow when storing data
+      {
+        val = Clip3<int>(-32768, 32767, val);
+      }
+      ptr[x] = (Pel) val;
+    }
+    ptr += stride;
+  }
+}
+
+// horizontal resampling pass, output column x filters numTaps samples starting at src[xStart[x]] with the
+// coefficients coeff[x * numTaps]; the filter gain is kept in the output
+void sampleRateConvHorCore(const Pel *src, ptrdiff_t srcStride, int *dst, ptrdiff_t dstStride, int width, int height,
+                           const int *xStart, const TFilterCoeff *coeff, int numTaps)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Pel          *s   = src + xStart[x];
+      const TFilterCoeff *f   = coeff + x * numTaps;
+      int                 sum = 0;
+
+      for (int k = 0; k < numTaps; k++)
+      {
+        sum += f[k] * s[k];
+      }
+      dst[x] = sum;
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+// vertical resampling pass for one output row, tap k reads row rowIdx[k] of the horizontally filtered samples
+void sampleRateConvVerCore(const int *src, ptrdiff_t srcStride, Pel *dst, int width, const int *rowIdx,
+                           const TFilterCoeff *coeff, int numTaps, int shift, int maxVal)
+{
+  for (int x = 0; x < width; x++)
+  {
+    int sum = 0;
+
+    for (int k = 0; k < numTaps; k++)
+    {
+      sum += coeff[k] * src[rowIdx[k] * srcStride + x];
+    }
+    dst[x] = std::min<int>(std::max(0, (sum + (1 << (shift - 1))) >> shift), maxVal);
+  }
+}
+
+uint64_t calcSsdCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                     int height)
+{
+  uint64_t sum = 0;
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Intermediate_Int diff = src0[x] - src1[x];
+      sum += uint64_t(diff * diff);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+  return sum;
+}
+
+// weighted first and second order moments of numWindows horizontally adjacent winSize x winSize windows,
+// stored as { mean org, mean rec, mean org^2, mean rec^2, mean org*rec } per window
+void ssimMomentsCore(const double *org, const double *rec, ptrdiff_t stride, const double *weights, int winSize,
+                     int numWindows, double *moments)
+{
+  for (int i = 0; i < numWindows; i++)
+  {
+    double muOrg        = 0.0;
+    double muRec        = 0.0;
+    double muOrgSqr     = 0.0;
+    double muRecSqr     = 0.0;
+    double muOrgMultRec = 0.0;
+
+    for (int y = 0; y < winSize; y++)
+    {
+      for (int x = 0; x < winSize; x++)
+      {
+        const double weight = weights[y * winSize + x];
+        const double orgPel = org[y * stride + i + x];
+        const double recPel = rec[y * stride + i + x];
+
+        muOrg += orgPel * weight;
+        muRec += recPel * weight;
+        muOrgSqr += orgPel * orgPel * weight;
+        muRecSqr += recPel * recPel * weight;
+        muOrgMultRec += orgPel * recPel * weight;
+      }
+    }
+
+    moments[5 * i + 0] = muOrg;
+    moments[5 * i + 1] = muRec;
+    moments[5 * i + 2] = muOrgSqr;
+    moments[5 * i + 3] = muRecSqr;
+    moments[5 * i + 4] = muOrgMultRec;
+  }
+}
+
 template<>
 void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBuf<const Pel> &other2, const ClpRng& clpRng, const int8_t bcwIdx)
 {
@@ -355,26 +507,13 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
 template<>
 void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  for (unsigned y = 0; y < height; y++)
-  {
-    for (unsigned x = 0; x < width; x++)
-    {
-      dst[x] = pLUT[src[x]];
-    }
-    dst += stride;
-    src += stride;
-  }
+  g_pelBufOP.rspSignal(buf, stride, width, height, pLUT.data());
 }
 
 template<>
 void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& clpRng)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  int  absval;
-  int maxAbsclipBD = (1<<clpRng.bd) - 1;
+  const int maxAbsclipBD = (1 << clpRng.bd) - 1;
 
   if (dir) // forward
   {
@@ -382,40 +521,11 @@ void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& cl
     {
       THROW("Blocks of width = 1 not supported");
     }
-    else
-    {
-      for (unsigned y = 0; y < height; y++)
-      {
-        for (unsigned x = 0; x < width; x++)
-        {
-          const int sign = sgn2(src[x]);
-          absval = sign * src[x];
-          dst[x] = (Pel)Clip3(-maxAbsclipBD, maxAbsclipBD, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
-        }
-        dst += stride;
-        src += stride;
-      }
-    }
+    g_pelBufOP.fwdScaleSignal(buf, stride, width, height, scale, maxAbsclipBD);
   }
   else // inverse
   {
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-        src[x] = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, src[x]);
-        const int sign = sgn2(src[x]);
-        absval = sign * src[x];
-        int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
-        if (sizeof(Pel) == 2) // avoid overflow when storing data
-        {
-           val = Clip3<int>(-32768, 32767, val);
-        }
-        dst[x] = (Pel)val;
-      }
-      dst += stride;
-      src += stride;
-    }
+    g_pelBufOP.invScaleSignal(buf, stride, width, height, scale, maxAbsclipBD);
   }
 }
 
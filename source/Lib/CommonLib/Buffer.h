@@ -107,12 +107,34 @@ struct PelBufferOps
                     const Pel *gradX, const Pel *gradY, ptrdiff_t gradStride, const int *dMvX, const int *dMvY,
                     ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset, const ClpRng &clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  void (*rspSignal)(Pel *ptr, ptrdiff_t stride, int width, int height, const Pel *lut);
+  void (*fwdScaleSignal)(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip);
+  void (*invScaleSignal)(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip);
+  void (*sampleRateConvHor)(const Pel *src, ptrdiff_t srcStride, int *dst, ptrdiff_t dstStride, int width, int height,
+                            const int *xStart, const TFilterCoeff *coeff, int numTaps);
+  void (*sampleRateConvVer)(const int *src, ptrdiff_t srcStride, Pel *dst, int width, const int *rowIdx,
+                            const TFilterCoeff *coeff, int numTaps, int shift, int maxVal);
+  uint64_t (*calcSsd)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                      int height);
+  void (*ssimMoments)(const double *org, const double *rec, ptrdiff_t stride, const double *weights, int winSize,
+                      int numWindows, double *moments);
 };
 
 extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, ptrdiff_t stride, int width, int height, int padSize);
 void copyBufferCore(const Pel *src, ptrdiff_t srcStride, Pel *Dst, ptrdiff_t dstStride, int width, int height);
+void rspSignalCore(Pel *ptr, ptrdiff_t stride, int width, int height, const Pel *lut);
+void fwdScaleSignalCore(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip);
+void invScaleSignalCore(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip);
+void sampleRateConvHorCore(const Pel *src, ptrdiff_t srcStride, int *dst, ptrdiff_t dstStride, int width, int height,
+                           const int *xStart, const TFilterCoeff *coeff, int numTaps);
+void sampleRateConvVerCore(const int *src, ptrdiff_t srcStride, Pel *dst, int width, const int *rowIdx,
+                           const TFilterCoeff *coeff, int numTaps, int shift, int maxVal);
+uint64_t calcSsdCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                     int height);
+void ssimMomentsCore(const double *org, const double *rec, ptrdiff_t stride, const double *weights, int winSize,
+                     int numWindows, double *moments);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -547,6 +547,7 @@ static constexpr int RPR_PPS_ID[NUM_RPR_PPS] = { 0, ENC_PPS_ID_RPR3, ENC_PPS_ID_
 
 static constexpr int MAX_SCALING_RATIO =                              2;  // max downsampling ratio for RPR
 static constexpr ScalingRatio SCALE_1X = { 1 << ScalingRatio::BITS, 1 << ScalingRatio::BITS };   // scale ratio 1x
+static constexpr int MIN_RESCALE_BAND_HEIGHT =                       16;  // min number of rows per thread in picture resampling
 
 static constexpr int DELTA_QP_ACT[4] =                  { -5, 1, 3, 1 };
 static constexpr int MAX_TSRC_RICE =                                  8;  ///<Maximum supported TSRC Rice parameter
@@ -871,6 +872,7 @@ typedef enum{
   AVX512
 } X86_VEXT;
 
+X86_VEXT _get_x86_extensions();   // extensions supported by the CPU, regardless of the selected one
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
 #endif //TARGET_SIMD_X86
@@ -150,6 +150,22 @@ public:
     return m_sigFlagCtxSet[std::max( 0, state-1 )]( ctxOfs );
   }
 
+  // same as sigCtxIdAbs(), but with the template sums supplied by the caller (used by the fast rate estimation)
+  unsigned sigCtxIdAbsApprox( int scanPos, TCoeff sumAbs, int numPos, const int state )
+  {
+    const int diag   = m_scan[scanPos].x + m_scan[scanPos].y;
+    int       ctxOfs = int(std::min<TCoeff>((sumAbs+1)>>1, 3)) + ( diag < 2 ? 4 : 0 );
+
+    if (isLuma(m_chType))
+    {
+      ctxOfs += diag < 5 ? 4 : 0;
+    }
+
+    m_tmplCpDiag = diag;
+    m_tmplCpSum1 = sumAbs - numPos;
+    return m_sigFlagCtxSet[std::max( 0, state-1 )]( ctxOfs );
+  }
+
   uint8_t ctxOffsetAbs()
   {
     int offset = 0;
@@ -43,6 +43,7 @@
 #include "UnitPartitioner.h"
 #include "dtrace_codingstruct.h"
 #include "dtrace_buffer.h"
+#include "StageProfiler.h"
 
 //! \ingroup CommonLib
 //! \{
@@ -138,6 +139,7 @@ void DeblockingFilter::destroy()
 
 void DeblockingFilter::deblockingFilterPic(CodingStructure &cs)
 {
+  PROFILE_STAGE(ProfStage::LOOP_FILTER_DBF);
   const PreCalcValues &pcv = *cs.pcv;
 
   DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "poc", cs.slice->getPOC() ) ) );
@@ -167,6 +169,11 @@ void DeblockingFilter::deblockingFilterPic(CodingStructure &cs)
 
       const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
       CodingUnit *firstCU = cs.getCU(ctuArea.lumaPos(), ChannelType::LUMA);
+      if (firstCU == nullptr)
+      {
+        // CTU of a subpicture that was not decoded
+        continue;
+      }
       cs.slice = firstCU->slice;
 
       // CU-based deblocking
@@ -212,6 +219,11 @@ void DeblockingFilter::deblockingFilterPic(CodingStructure &cs)
 
       const UnitArea ctuArea( pcv.chrFormat, Area( x << pcv.maxCUWidthLog2, y << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUWidth ) );
       CodingUnit *firstCU = cs.getCU(ctuArea.lumaPos(), ChannelType::LUMA);
+      if (firstCU == nullptr)
+      {
+        // CTU of a subpicture that was not decoded
+        continue;
+      }
       cs.slice = firstCU->slice;
 
       // CU-based deblocking
@@ -776,13 +788,13 @@ void DeblockingFilter::xSetDeblockingFilterParam( const CodingUnit& cu )
     {
       CodingUnit *neighbourCu = cu.cs->getCU(pos.offset(-1, 0), cu.chType);
 
-      m_filterCuEdge.left = isNeighbourAvailable(cu, *neighbourCu, pps);
+      m_filterCuEdge.left = neighbourCu != nullptr && isNeighbourAvailable(cu, *neighbourCu, pps);
     }
     if (pos.y > 0)
     {
       CodingUnit *neighbourCu = cu.cs->getCU(pos.offset(0, -1), cu.chType);
 
-      m_filterCuEdge.top = isNeighbourAvailable(cu, *neighbourCu, pps);
+      m_filterCuEdge.top = neighbourCu != nullptr && isNeighbourAvailable(cu, *neighbourCu, pps);
     }
   }
 }
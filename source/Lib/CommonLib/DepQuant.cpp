@@ -37,8 +37,10 @@
 #include "UnitTools.h"
 
 #include <bitset>
+#include <mutex>
 
 #include "ContextModelling.h"
+#include "StageProfiler.h"
 
 
 
@@ -128,9 +130,11 @@ namespace DQIntern
   class Rom
   {
   public:
-    Rom() : m_scansInitialized(false) {}
+    Rom() : m_scansInitialized(false), m_numUsers(0) {}
     ~Rom() { xUninitScanArrays(); }
-    void                init        ()                       { xInitScanArrays(); }
+    // the scan arrays point into the global ROM tables, which are rebuilt when a new encoder is created
+    void                init        ()                       { std::lock_guard<std::mutex> lock( m_mutex ); if( m_numUsers++ == 0 ) { xInitScanArrays(); } }
+    void                uninit      ()                       { std::lock_guard<std::mutex> lock( m_mutex ); if( --m_numUsers == 0 ) { xUninitScanArrays(); } }
     const NbInfoSbb*    getNbInfoSbb( int hd, int vd ) const { return m_scanId2NbInfoSbbArray[hd][vd]; }
     const NbInfoOut*    getNbInfoOut( int hd, int vd ) const { return m_scanId2NbInfoOutArray[hd][vd]; }
     const TUParameters* getTUPars   ( const CompArea& area, const ComponentID compID ) const
@@ -142,6 +146,8 @@ namespace DQIntern
     void  xUninitScanArrays ();
   private:
     bool          m_scansInitialized;
+    int           m_numUsers;
+    std::mutex    m_mutex;
     NbInfoSbb*    m_scanId2NbInfoSbbArray[ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ];
     NbInfoOut*    m_scanId2NbInfoOutArray[ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ];
     TUParameters* m_tuParameters         [ MAX_CU_DEPTH+1 ][ MAX_CU_DEPTH+1 ][ MAX_NUM_CHANNEL_TYPE ];
@@ -1692,7 +1698,7 @@ namespace DQIntern
 
 
 //===== interface class =====
-DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
+DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other ), m_enc( enc )
 {
   const DepQuant* dq = dynamic_cast<const DepQuant*>( other );
   CHECK( other && !dq, "The DepQuant cast must be successfull!" );
@@ -1706,11 +1712,16 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
 DepQuant::~DepQuant()
 {
   delete static_cast<DQIntern::DepQuant*>(p);
+  if( m_enc )
+  {
+    DQIntern::g_Rom.uninit();
+  }
 }
 
 void DepQuant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &absSum,
                      const QpParam &cQP, const Ctx &ctx)
 {
+  PROFILE_STAGE(ProfStage::ENC_DEP_QUANT);
   const bool useRegularResidualCoding =
     tu.cu->slice->getTSResidualCodingDisabledFlag() || tu.mtsIdx[compID] != MtsType::SKIP;
   if( tu.cs->slice->getDepQuantEnabledFlag() && useRegularResidualCoding )
@@ -59,6 +59,7 @@ public:
 
 private:
   void* p;
+  bool  m_enc;
 };
 
 
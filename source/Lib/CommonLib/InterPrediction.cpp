@@ -1647,13 +1647,20 @@ constexpr InterPrediction::DmvrDist InterPrediction::UNDEFINED_DMVR_DIST;
 void InterPrediction::xDmvrIntegerRefine(int bd, DmvrDist &minCost, Mv &deltaMv, DmvrDist *sadPtr, int width,
                                          int height)
 {
+  // costs of all integer offsets are computed in a single pass over the initial predictions
+  Distortion sads[DMVR_AREA];
+  m_pcRdCost->getDmvrSadGrid(m_dmvrInitialPred[REF_PIC_LIST_0].bufAt(DMVR_RANGE, DMVR_RANGE),
+                             m_dmvrInitialPred[REF_PIC_LIST_0].stride,
+                             m_dmvrInitialPred[REF_PIC_LIST_1].bufAt(DMVR_RANGE, DMVR_RANGE),
+                             m_dmvrInitialPred[REF_PIC_LIST_1].stride, width, height, bd, sads);
+
   for (const auto &mvd: m_dmvrSearchOffsets)
   {
     const int32_t sadOffset = mvd.ver * DMVR_SPAN + mvd.hor;
 
     if (sadPtr[sadOffset] == UNDEFINED_DMVR_DIST)
     {
-      sadPtr[sadOffset] = xDmvrCost(bd, mvd, width, height);
+      sadPtr[sadOffset] = DmvrDist(sads[sadOffset + DMVR_AREA / 2] >> 1);
     }
     if (sadPtr[sadOffset] < minCost)
     {
@@ -2321,6 +2328,13 @@ bool InterPrediction::xPredInterBlkRPR(const ScalingRatio scalingRatio, const SP
     int tmpStride = width;
     int xInt = 0, yInt = 0;
 
+    // gather the per column filter positions and phases, the horizontal pass then filters all columns at once
+    const int numTaps = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+    int          xOffset[MAX_CU_SIZE];
+    TFilterCoeff xCoeff[MAX_CU_SIZE * NTAPS_LUMA];
+
+    CHECK(width > MAX_CU_SIZE, "Block is too wide for RPR interpolation");
+
     for( col = 0; col < width; col++ )
     {
       int posX = (int32_t)x0Int + col * stepX;
@@ -2330,14 +2344,15 @@ bool InterPrediction::xPredInterBlkRPR(const ScalingRatio scalingRatio, const SP
 
       CHECK( xInt0 > xInt, "Wrong horizontal starting point" );
 
-      Position offset = Position( xInt, yInt0 );
-      refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, offset, Size( 1, refHeight ) ), wrapRef );
+      xOffset[col] = xInt - xInt0 - (numTaps / 2 - 1);
+      m_if.getFilterCoeff(compID, xFrac, xFilter, xCoeff + col * numTaps);
+    }
 
-      Pel *const tempBuf = m_filteredBlockTmpRPR + col;
+    refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, Position( xInt0, yInt0 ), Size( 1, refHeight ) ), wrapRef );
 
-      m_if.filterHor(compID, (Pel *) refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tempBuf,
-                     tmpStride, 1, refHeight + vFilterSize - 1 + extSize, xFrac, false, clpRng, xFilter);
-    }
+    m_if.filterHorRpr(compID, refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride,
+                      m_filteredBlockTmpRPR, tmpStride, width, refHeight + vFilterSize - 1 + extSize, xOffset, xCoeff,
+                      clpRng);
 
     for( row = 0; row < height; row++ )
     {
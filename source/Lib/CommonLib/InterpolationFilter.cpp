@@ -365,6 +365,9 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+  m_filterHorRpr[_8_TAPS] = filterHorRpr<NTAPS_LUMA>;
+  m_filterHorRpr[_4_TAPS] = filterHorRpr<NTAPS_CHROMA>;
+
   m_weightedGeoBlk = xWeightedGeoBlk;
 }
 
@@ -613,6 +616,52 @@ void InterpolationFilter::filter(const ClpRng &clpRng, Pel const *src, const ptr
   }
 }
 
+/**
+ * \brief Apply first stage horizontal filtering with a different filter phase per column
+ *
+ * Used by the reference picture resampling prediction, where the position in the reference picture advances by a
+ * non-integer step from one column to the next.
+ *
+ * \param  clpRng    clip range
+ * \param  src       pointer to the first row of the source block
+ * \param  srcStride stride of the source block
+ * \param  dst       pointer to destination buffer
+ * \param  dstStride stride of the destination buffer
+ * \param  width     width of the block
+ * \param  height    height of the block
+ * \param  xOffset   per column offset of the first filter tap relative to src
+ * \param  coeff     per column filter coefficients, N values per column
+ */
+template<int N>
+void InterpolationFilter::filterHorRpr(const ClpRng &clpRng, Pel const *src, const ptrdiff_t srcStride, Pel *dst,
+                                       const ptrdiff_t dstStride, int width, int height, const int *xOffset,
+                                       TFilterCoeff const *coeff)
+{
+  const int headRoom = IF_INTERNAL_FRAC_BITS(clpRng.bd);
+  const int shift    = IF_FILTER_PREC - headRoom;
+  const int offset   = -IF_INTERNAL_OFFS << shift;
+
+  for (int row = 0; row < height; row++)
+  {
+    for (int col = 0; col < width; col++)
+    {
+      const Pel          *s   = src + xOffset[col];
+      const TFilterCoeff *c   = coeff + col * N;
+      int                 sum = 0;
+
+      for (int k = 0; k < N; k++)
+      {
+        sum += s[k] * c[k];
+        JVET_J0090_CACHE_ACCESS( &s[k], __FILE__, __LINE__ );
+      }
+      dst[col] = (Pel) ((sum + offset) >> shift);
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
 template<int N, bool biMCForDMVR>
 void InterpolationFilter::filterHor(const ClpRng &clpRng, Pel const *src, const ptrdiff_t srcStride, Pel *dst,
                                     const ptrdiff_t dstStride, int width, int height, bool isLast,
@@ -708,6 +757,85 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, co
   }
 }
 
+/**
+ * \brief Get the coefficients that filterHor() / filterVer() apply for a given fractional position
+ *
+ * For luma the coefficients are returned as NTAPS_LUMA taps aligned to the 8-tap filter window, i.e. the 6-tap affine
+ * filters are padded with zeros, and sample copies are expressed as a unit filter. For chroma NTAPS_CHROMA taps are
+ * returned. The DMVR bilinear filter is not supported.
+ *
+ * \param  compID      colour component ID
+ * \param  frac        fractional sample offset
+ * \param  nFilterIdx  filter index
+ * \param  coeff       output filter coefficients
+ */
+void InterpolationFilter::getFilterCoeff(const ComponentID compID, int frac, Filter nFilterIdx,
+                                         TFilterCoeff *coeff) const
+{
+  CHECK(nFilterIdx == Filter::DMVR, "Bilinear DMVR filter not supported");
+
+  const int numTaps = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+  std::fill_n(coeff, numTaps, 0);
+
+  if (frac == 0 && nFilterIdx <= Filter::AFFINE)
+  {
+    // filterCopy() output equals the output of a unit filter
+    coeff[numTaps / 2 - 1] = 1 << IF_FILTER_PREC;
+  }
+  else if (isLuma(compID))
+  {
+    CHECK(frac < 0 || frac >= LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction");
+    const TFilterCoeff *filter =
+      nFilterIdx == Filter::AFFINE        ? m_affineLumaFilter[frac]
+      : nFilterIdx == Filter::RPR1        ? m_lumaFilterRPR1[frac]
+      : nFilterIdx == Filter::RPR2        ? m_lumaFilterRPR2[frac]
+      : nFilterIdx == Filter::AFFINE_RPR1 ? m_affineLumaFilterRPR1[frac]
+      : nFilterIdx == Filter::AFFINE_RPR2 ? m_affineLumaFilterRPR2[frac]
+      : frac == LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS / 2 && nFilterIdx == Filter::HALFPEL_ALT
+        ? m_lumaAltHpelIFilter
+        : m_lumaFilter[frac];
+
+    if (nFilterIdx == Filter::AFFINE || nFilterIdx == Filter::AFFINE_RPR1 || nFilterIdx == Filter::AFFINE_RPR2)
+    {
+      std::copy_n(filter, NTAPS_LUMA_AFFINE, coeff + (NTAPS_LUMA - NTAPS_LUMA_AFFINE) / 2);
+    }
+    else
+    {
+      std::copy_n(filter, NTAPS_LUMA, coeff);
+    }
+  }
+  else
+  {
+    CHECK(frac < 0 || frac >= CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction");
+    const TFilterCoeff *filter = nFilterIdx == Filter::RPR1   ? m_chromaFilterRPR1[frac]
+                                 : nFilterIdx == Filter::RPR2 ? m_chromaFilterRPR2[frac]
+                                                              : m_chromaFilter[frac];
+    std::copy_n(filter, NTAPS_CHROMA, coeff);
+  }
+}
+
+/**
+ * \brief Filter a block horizontally with per column filter phases, producing intermediate samples
+ *
+ * \param  compID      colour component ID
+ * \param  src         pointer to the first row of the source block
+ * \param  srcStride   stride of the source block
+ * \param  dst         pointer to destination buffer
+ * \param  dstStride   stride of the destination buffer
+ * \param  width       width of the block
+ * \param  height      height of the block
+ * \param  xOffset     per column offset of the first filter tap relative to src
+ * \param  coeff       per column coefficients as returned by getFilterCoeff()
+ * \param  clpRng      clip range
+ */
+void InterpolationFilter::filterHorRpr(const ComponentID compID, Pel const *src, const ptrdiff_t srcStride, Pel *dst,
+                                       const ptrdiff_t dstStride, int width, int height, const int *xOffset,
+                                       TFilterCoeff const *coeff, const ClpRng &clpRng)
+{
+  m_filterHorRpr[isLuma(compID) ? _8_TAPS : _4_TAPS](clpRng, src, srcStride, dst, dstStride, width, height, xOffset,
+                                                     coeff);
+}
+
 void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, const ptrdiff_t srcStride, Pel *dst,
                                     const ptrdiff_t dstStride, int width, int height, int frac, bool isFirst,
                                     bool isLast, const ClpRng &clpRng, Filter nFilterIdx)
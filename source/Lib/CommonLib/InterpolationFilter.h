@@ -78,6 +78,10 @@ public:
   template<int N, bool isVertical, bool isFirst, bool isLast, bool biMCForDMVR>
   static void filter(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
                      int width, int height, TFilterCoeff const *coeff);
+  template<int N>
+  static void filterHorRpr(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
+                           int width, int height, const int *xOffset, TFilterCoeff const *coeff);
+
   template<int N, bool biMCForDMVR>
   void filterHor(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width,
                  int height, bool isLast, TFilterCoeff const *coeff);
@@ -128,6 +132,9 @@ public:
                                            ptrdiff_t dstStride, int width, int height, TFilterCoeff const *coeff);
   void (*m_filterCopy[2][2])(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
                              int width, int height, bool biMCForDMVR);
+  // per column phase horizontal filters for reference picture resampling, indexed by _8_TAPS (luma) and _4_TAPS
+  void (*m_filterHorRpr[2])(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
+                            int width, int height, const int *xOffset, TFilterCoeff const *coeff);
   void( *m_weightedGeoBlk )(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1);
 
   void initInterpolationFilter( bool enable );
@@ -140,6 +147,9 @@ public:
                  int width, int height, int frac, bool isLast, const ClpRng &clpRng, Filter nFilterIdx);
   void filterVer(const ComponentID compID, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
                  int width, int height, int frac, bool isFirst, bool isLast, const ClpRng &clpRng, Filter nFilterIdx);
+  void getFilterCoeff(const ComponentID compID, int frac, Filter nFilterIdx, TFilterCoeff *coeff) const;
+  void filterHorRpr(const ComponentID compID, Pel const *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride,
+                    int width, int height, const int *xOffset, TFilterCoeff const *coeff, const ClpRng &clpRng);
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   void cacheAssign( CacheModel *cache ) { m_cacheModel = cache; }
 #endif
@@ -35,28 +35,50 @@
 #include "SEI.h"
 #include "libmd5/MD5.h"
 
+#include <array>
+#include <thread>
+
 //! \ingroup CommonLib
 //! \{
 
+// pictures with fewer luma samples than this are hashed on the calling thread only
+static constexpr int MIN_PARALLEL_HASH_AREA = 256 * 256;
+
 /**
- * Update md5 using n samples from plane, each sample is adjusted to
- * OUTBIT_BITDEPTH_DIV8.
+ * Run planeHash for every component of pic and concatenate the per-plane
+ * digests in component order. For large pictures the chroma planes are
+ * hashed on worker threads while the luma plane is hashed on the calling one.
  */
-template<uint32_t OUTPUT_BITDEPTH_DIV8>
-static void md5_block(MD5& md5, const Pel* plane, uint32_t n)
+template<typename PlaneHashFunc>
+static void hashPlanes(const CPelUnitBuf &pic, PictureHash &digest, PlaneHashFunc planeHash)
 {
-  /* create a 64 byte buffer for packing Pel's into */
-  uint8_t buf[64/OUTPUT_BITDEPTH_DIV8][OUTPUT_BITDEPTH_DIV8];
-  for (uint32_t i = 0; i < n; i++)
+  const uint32_t numComp = (uint32_t) pic.bufs.size();
+  PictureHash    planeDigest[MAX_NUM_COMPONENT];
+
+  std::vector<std::thread> threads;
+  if (numComp > 1 && pic.bufs[0].area() >= MIN_PARALLEL_HASH_AREA)
   {
-    Pel pel = plane[i];
-    /* perform bitdepth and endian conversion */
-    for (uint32_t d = 0; d < OUTPUT_BITDEPTH_DIV8; d++)
+    for (uint32_t chan = 1; chan < numComp; chan++)
     {
-      buf[i][d] = pel >> (d*8);
+      threads.emplace_back([&planeHash, &planeDigest, chan]() { planeHash(ComponentID(chan), planeDigest[chan]); });
     }
   }
-  md5.update((uint8_t*)buf, n * OUTPUT_BITDEPTH_DIV8);
+
+  for (uint32_t chan = 0; chan < (threads.empty() ? numComp : 1); chan++)
+  {
+    planeHash(ComponentID(chan), planeDigest[chan]);
+  }
+
+  for (auto &thread: threads)
+  {
+    thread.join();
+  }
+
+  digest.hash.clear();
+  for (uint32_t chan = 0; chan < numComp; chan++)
+  {
+    digest.hash.insert(digest.hash.end(), planeDigest[chan].hash.begin(), planeDigest[chan].hash.end());
+  }
 }
 
 /**
@@ -66,59 +88,93 @@ static void md5_block(MD5& md5, const Pel* plane, uint32_t n)
 template<uint32_t OUTPUT_BITDEPTH_DIV8>
 static void md5_plane(MD5& md5, const Pel* plane, uint32_t width, uint32_t height, ptrdiff_t stride)
 {
-  /* N is the number of samples to process per md5 update.
-   * All N samples must fit in buf */
-  uint32_t N = 32;
-  uint32_t width_modN = width % N;
-  uint32_t width_less_modN = width - width_modN;
+  /* one line of samples, packed into unsigned chars in little endian byte order */
+  std::vector<uint8_t> buf(width * OUTPUT_BITDEPTH_DIV8);
 
   for (uint32_t y = 0; y < height; y++)
   {
-    /* convert pels into unsigned chars in little endian byte order.
-     * NB, for 8bit data, data is truncated to 8bits. */
-    for (uint32_t x = 0; x < width_less_modN; x += N)
+    /* NB, for 8bit data, data is truncated to 8bits. */
+    const Pel *line = plane + y * stride;
+    for (uint32_t x = 0; x < width; x++)
     {
-      md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + x], N);
+      for (uint32_t d = 0; d < OUTPUT_BITDEPTH_DIV8; d++)
+      {
+        buf[x * OUTPUT_BITDEPTH_DIV8 + d] = line[x] >> (d * 8);
+      }
     }
-
-    /* mop up any of the remaining line */
-    md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + width_less_modN], width_modN);
+    md5.update(buf.data(), width * OUTPUT_BITDEPTH_DIV8);
   }
 }
 
-uint32_t compCRC(int bitdepth, const Pel *plane, uint32_t width, uint32_t height, ptrdiff_t stride, PictureHash &digest)
+/**
+ * Lookup tables of the CRC-16 with generator polynomial 0x1021, processing eight
+ * message bytes per step: crcTables[k][b] is the remainder of byte b followed by
+ * k zero bytes.
+ */
+static const std::array<std::array<uint16_t, 256>, 8> &getCrcTables()
 {
-  uint32_t crcMsb;
-  uint32_t bitVal;
-  uint32_t crcVal = 0xffff;
-  uint32_t bitIdx;
-  for (uint32_t y = 0; y < height; y++)
+  static const std::array<std::array<uint16_t, 256>, 8> crcTables = []()
   {
-    for (uint32_t x = 0; x < width; x++)
+    std::array<std::array<uint16_t, 256>, 8> tables;
+    for (uint32_t b = 0; b < 256; b++)
     {
-      // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
+      uint32_t crcVal = b << 8;
+      for (int bitIdx = 0; bitIdx < 8; bitIdx++)
       {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+        crcVal = ((crcVal << 1) & 0xffff) ^ (((crcVal >> 15) & 1) * 0x1021);
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
+      tables[0][b] = crcVal;
+    }
+    for (int k = 1; k < 8; k++)
+    {
+      for (uint32_t b = 0; b < 256; b++)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        tables[k][b] = ((tables[k - 1][b] << 8) & 0xffff) ^ tables[0][tables[k - 1][b] >> 8];
       }
     }
+    return tables;
+  }();
+  return crcTables;
+}
+
+static uint32_t crcUpdate(uint32_t crcVal, const uint8_t *data, size_t len)
+{
+  const std::array<std::array<uint16_t, 256>, 8> &t = getCrcTables();
+
+  for (; len >= 8; len -= 8, data += 8)
+  {
+    crcVal = t[7][(crcVal >> 8) ^ data[0]] ^ t[6][(crcVal & 0xff) ^ data[1]] ^ t[5][data[2]] ^ t[4][data[3]]
+             ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+  }
+  for (; len > 0; len--, data++)
+  {
+    crcVal = ((crcVal << 8) & 0xffff) ^ t[0][(crcVal >> 8) ^ *data];
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
+  return crcVal;
+}
+
+uint32_t compCRC(int bitdepth, const Pel *plane, uint32_t width, uint32_t height, ptrdiff_t stride, PictureHash &digest)
+{
+  // the hash is specified as a bitwise CRC with initial value 0xffff that is flushed with
+  // 16 zero bits at the end; the equivalent byte-wise table-driven CRC starts from 0x1d0f
+  uint32_t crcVal = 0x1d0f;
+
+  const uint32_t       bytesPerSample = bitdepth > 8 ? 2 : 1;
+  std::vector<uint8_t> buf(width * bytesPerSample);
+
+  for (uint32_t y = 0; y < height; y++)
   {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
+    // first pictureData byte, followed by the second one if bit depth is greater than 8-bits
+    const Pel *line = plane + y * stride;
+    for (uint32_t x = 0; x < width; x++)
+    {
+      buf[x * bytesPerSample] = line[x] & 0xff;
+      if (bytesPerSample > 1)
+      {
+        buf[x * bytesPerSample + 1] = (line[x] >> 8) & 0xff;
+      }
+    }
+    crcVal = crcUpdate(crcVal, buf.data(), buf.size());
   }
 
   digest.hash.push_back((crcVal>>8)  & 0xff);
@@ -128,36 +184,42 @@ uint32_t compCRC(int bitdepth, const Pel *plane, uint32_t width, uint32_t height
 
 uint32_t calcCRC(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
-  uint32_t digestLen=0;
-  digest.hash.clear();
-  for (uint32_t chan = 0; chan< (uint32_t)pic.bufs.size(); chan++)
-  {
-    const ComponentID compID = ComponentID(chan);
+  hashPlanes(pic, digest, [&](const ComponentID compID, PictureHash &planeDigest) {
     const CPelBuf area = pic.get(compID);
-    digestLen =
-      compCRC(bitDepths[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, digest);
-  }
-  return digestLen;
+    compCRC(bitDepths[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride, planeDigest);
+  });
+  return 2;
 }
 
 uint32_t compChecksum(int bitdepth, const Pel *plane, uint32_t width, uint32_t height, ptrdiff_t stride,
                       PictureHash &digest, const BitDepths & /*bitDepths*/)
 {
   uint32_t checksum = 0;
-  uint8_t xor_mask;
 
   for (uint32_t y = 0; y < height; y++)
   {
-    for (uint32_t x = 0; x < width; x++)
-    {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
+    // xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8), truncated to 8 bits
+    const Pel     *line  = plane + y * stride;
+    const uint32_t yMask = y ^ (y >> 8);
+    uint32_t       lineSum = 0;
 
-      if(bitdepth > 8)
+    if (bitdepth > 8)
+    {
+      for (uint32_t x = 0; x < width; x++)
+      {
+        const uint32_t xor_mask = (x ^ (x >> 8) ^ yMask) & 0xff;
+        lineSum += ((line[x] & 0xff) ^ xor_mask) + ((line[x] >> 8) ^ xor_mask);
+      }
+    }
+    else
+    {
+      for (uint32_t x = 0; x < width; x++)
       {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
+        const uint32_t xor_mask = (x ^ (x >> 8) ^ yMask) & 0xff;
+        lineSum += (line[x] & 0xff) ^ xor_mask;
       }
     }
+    checksum += lineSum;
   }
 
   digest.hash.push_back((checksum>>24) & 0xff);
@@ -169,16 +231,12 @@ uint32_t compChecksum(int bitdepth, const Pel *plane, uint32_t width, uint32_t h
 
 uint32_t calcChecksum(const CPelUnitBuf& pic, PictureHash &digest, const BitDepths &bitDepths)
 {
-  uint32_t digestLen=0;
-  digest.hash.clear();
-  for(uint32_t chan=0; chan< (uint32_t)pic.bufs.size(); chan++)
-  {
-    const ComponentID compID=ComponentID(chan);
+  hashPlanes(pic, digest, [&](const ComponentID compID, PictureHash &planeDigest) {
     const CPelBuf area = pic.get(compID);
-    digestLen = compChecksum(bitDepths[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride,
-                             digest, bitDepths);
-  }
-  return digestLen;
+    compChecksum(bitDepths[toChannelType(compID)], area.bufAt(0, 0), area.width, area.height, area.stride,
+                 planeDigest, bitDepths);
+  });
+  return 4;
 }
 /**
  * Calculate the MD5sum of pic, storing the result in digest.
@@ -197,33 +255,24 @@ uint32_t calcMD5WithCropping(const CPelUnitBuf &pic, PictureHash &digest, const
 {
   /* choose an md5_plane packing function based on the system bitdepth */
   typedef void (*MD5PlaneFunc)(MD5 &, const Pel *, uint32_t, uint32_t, ptrdiff_t);
-  MD5PlaneFunc md5_plane_func;
-
-  MD5 md5[MAX_NUM_COMPONENT];
-
-  digest.hash.clear();
 
-  for (uint32_t chan = 0; chan< (uint32_t)pic.bufs.size(); chan++)
-  {
-    const ComponentID compID           = ComponentID(chan);
-    const CPelBuf     area             = pic.get(compID);
-    const int         chromaScaleX     = getComponentScaleX(compID, pic.chromaFormat);
-    const int         chromaScaleY     = getComponentScaleY(compID, pic.chromaFormat);
-    const int         compLeftOffset   = leftOffset >> chromaScaleX;
-    const int         compRightOffset  = rightOffset >> chromaScaleX;
-    const int         compTopOffset    = topOffset >> chromaScaleY;
-    const int         compBottomOffset = bottomOffset >> chromaScaleY;
-    md5_plane_func = bitDepths[toChannelType(compID)] <= 8 ? (MD5PlaneFunc) md5_plane<1> : (MD5PlaneFunc) md5_plane<2>;
+  hashPlanes(pic, digest, [&](const ComponentID compID, PictureHash &planeDigest) {
+    const CPelBuf area             = pic.get(compID);
+    const int     chromaScaleX     = getComponentScaleX(compID, pic.chromaFormat);
+    const int     chromaScaleY     = getComponentScaleY(compID, pic.chromaFormat);
+    const int     compLeftOffset   = leftOffset >> chromaScaleX;
+    const int     compRightOffset  = rightOffset >> chromaScaleX;
+    const int     compTopOffset    = topOffset >> chromaScaleY;
+    const int     compBottomOffset = bottomOffset >> chromaScaleY;
+    MD5PlaneFunc  md5_plane_func =
+      bitDepths[toChannelType(compID)] <= 8 ? (MD5PlaneFunc) md5_plane<1> : (MD5PlaneFunc) md5_plane<2>;
+    MD5     md5;
     uint8_t tmp_digest[MD5_DIGEST_STRING_LENGTH];
-    md5_plane_func(md5[compID], area.bufAt(compLeftOffset, compTopOffset),
-                   area.width - compRightOffset - compLeftOffset, area.height - compTopOffset - compBottomOffset,
-                   area.stride);
-    md5[compID].finalize(tmp_digest);
-    for (uint32_t i = 0; i < MD5_DIGEST_STRING_LENGTH; i++)
-    {
-      digest.hash.push_back(tmp_digest[i]);
-    }
-  }
+    md5_plane_func(md5, area.bufAt(compLeftOffset, compTopOffset), area.width - compRightOffset - compLeftOffset,
+                   area.height - compTopOffset - compBottomOffset, area.stride);
+    md5.finalize(tmp_digest);
+    planeDigest.hash.assign(tmp_digest, tmp_digest + MD5_DIGEST_STRING_LENGTH);
+  });
 
   return 16;
 }
@@ -40,10 +40,15 @@
 #include "ChromaFormat.h"
 #include "CommonLib/InterpolationFilter.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 // ---------------------------------------------------------------------------
 // picture methods
 // ---------------------------------------------------------------------------
 
+int Picture::m_rescaleThreads = 1;
 
 
 Picture::Picture()
@@ -57,6 +62,7 @@ Picture::Picture()
   longTerm             = false;
   reconstructed        = false;
   neededForOutput      = false;
+  viewCount            = 0;
   referenced           = false;
   temporalId           = std::numeric_limits<uint32_t>::max();
   fieldPic             = false;
@@ -747,39 +753,36 @@ void Picture::sampleRateConv(const ScalingRatio scalingRatio, const int scaleX,
   int log2NormList[3] = { 12, 16, 16 };
   const int filterLength = downsampling ? 12 : (rescaleForDisplay ? (useLumaFilter ? filterLengthsLuma[upscaleFilterForDisplay] : filterLengthsChroma[upscaleFilterForDisplay]) : useLumaFilter ? NTAPS_LUMA : NTAPS_CHROMA);
   const int log2Norm = downsampling ? 14 : (rescaleForDisplay ? log2NormList[upscaleFilterForDisplay] : 12);
-  int *buf = new int[orgHeight * scaledWidth];
   int maxVal = ( 1 << bitDepth ) - 1;
 
   CHECK( bitDepth > 17, "Overflow may happen!" );
 
+  // the horizontal filter windows are padded to the SIMD kernel width, taps that fall outside the picture are folded
+  // onto the border samples such that every window lies inside the source rows
+  const int numTapsHor = std::min(filterLength <= 8 ? 8 : 16, orgWidth);
+
+  std::vector<int>          xStart(scaledWidth);
+  std::vector<TFilterCoeff> coeffHor(scaledWidth * numTapsHor, 0);
+
   for( int i = 0; i < scaledWidth; i++ )
   {
-    const Pel* org = orgSrc;
-
-    int  refPos  = (((i << scaleX) - afterScaleLeftOffset) * scalingRatio.x + addX) >> posShiftX;
+    int refPos  = (((i << scaleX) - afterScaleLeftOffset) * scalingRatio.x + addX) >> posShiftX;
     int integer = refPos >> numFracShift;
     int frac = refPos & numFracPositions;
-    int* tmp = buf + i;
+    int start   = integer - filterLength / 2 + 1;
+    const TFilterCoeff* f = filterHor + frac * filterLength;
 
-    for( int j = 0; j < orgHeight; j++ )
-    {
-      int sum = 0;
-      const TFilterCoeff* f = filterHor + frac * filterLength;
+    xStart[i] = std::min(std::max(0, start), orgWidth - numTapsHor);
 
-      for( int k = 0; k < filterLength; k++ )
-      {
-        int xInt = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgWidth - 1 );
-        sum += f[k] * org[xInt]; // postpone horizontal filtering gain removal after vertical filtering
-      }
-
-      *tmp = sum;
-
-      tmp += scaledWidth;
-      org += orgStride;
+    for( int k = 0; k < filterLength; k++ )
+    {
+      int xInt = std::min<int>( std::max( 0, start + k ), orgWidth - 1 );
+      coeffHor[i * numTapsHor + xInt - xStart[i]] += f[k];
     }
   }
 
-  Pel* dst = scaledSrc;
+  std::vector<int>                 rowIdx(scaledHeight * filterLength);
+  std::vector<const TFilterCoeff*> coeffVer(scaledHeight);
 
   for( int j = 0; j < scaledHeight; j++ )
   {
@@ -787,25 +790,133 @@ void Picture::sampleRateConv(const ScalingRatio scalingRatio, const int scaleX,
     int integer = refPos >> numFracShift;
     int frac = refPos & numFracPositions;
 
-    for( int i = 0; i < scaledWidth; i++ )
+    coeffVer[j] = filterVer + frac * filterLength;
+
+    for( int k = 0; k < filterLength; k++ )
+    {
+      rowIdx[j * filterLength + k] = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgHeight - 1 );
+    }
+  }
+
+  // postpone horizontal filtering gain removal after vertical filtering
+  std::vector<int> buf(orgHeight * scaledWidth);
+
+  runInRowBands(orgHeight, [&](const int rowStart, const int rowEnd) {
+    g_pelBufOP.sampleRateConvHor(orgSrc + rowStart * orgStride, orgStride, buf.data() + rowStart * scaledWidth,
+                                 scaledWidth, scaledWidth, rowEnd - rowStart, xStart.data(), coeffHor.data(),
+                                 numTapsHor);
+  });
+
+  runInRowBands(scaledHeight, [&](const int rowStart, const int rowEnd) {
+    for( int j = rowStart; j < rowEnd; j++ )
+    {
+      g_pelBufOP.sampleRateConvVer(buf.data(), scaledWidth, scaledSrc + j * scaledStride, scaledWidth,
+                                   &rowIdx[j * filterLength], coeffVer[j], filterLength, log2Norm, maxVal);
+    }
+  });
+}
+
+// Worker threads of runInRowBands. They are started on first use and kept until the end of the process, so that
+// the resampling of every reference picture does not pay for creating threads.
+class RowBandWorkers
+{
+public:
+  ~RowBandWorkers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_exit = true;
+    }
+    m_jobCond.notify_all();
+    for (auto &thread: m_threads)
     {
-      int sum = 0;
-      int* tmp = buf + i;
-      const TFilterCoeff* f = filterVer + frac * filterLength;
+      thread.join();
+    }
+  }
 
-      for( int k = 0; k < filterLength; k++ )
+  // runs func on numBands row bands, the first one in the calling thread; returns false if the workers are busy
+  bool run(const int numRows, const int numBands, const std::function<void(int, int)> &func)
+  {
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock())
+    {
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      while ((int) m_threads.size() < numBands - 1)
       {
-        int yInt = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgHeight - 1 );
-        sum += f[k] * tmp[yInt*scaledWidth];
+        m_threads.emplace_back(&RowBandWorkers::xWorkerLoop, this, (int) m_threads.size() + 1);
       }
-
-      dst[i] = std::min<int>( std::max( 0, ( sum + ( 1 << ( log2Norm - 1 ) ) ) >> log2Norm ), maxVal );
+      m_func       = &func;
+      m_numRows    = numRows;
+      m_numBands   = numBands;
+      m_numPending = numBands - 1;
+      m_jobId++;
     }
+    m_jobCond.notify_all();
 
-    dst += scaledStride;
+    func(0, numRows / numBands);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCond.wait(lock, [&]() { return m_numPending == 0; });
+    m_func = nullptr;
+    return true;
+  }
+
+private:
+  void xWorkerLoop(const int band)
+  {
+    uint64_t                     lastJobId = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      m_jobCond.wait(lock, [&]() { return m_exit || m_jobId != lastJobId; });
+      if (m_exit)
+      {
+        return;
+      }
+      lastJobId = m_jobId;
+      if (band < m_numBands)
+      {
+        const std::function<void(int, int)> &func = *m_func;
+        const int rowStart = band * m_numRows / m_numBands;
+        const int rowEnd   = (band + 1) * m_numRows / m_numBands;
+        lock.unlock();
+        func(rowStart, rowEnd);
+        lock.lock();
+        if (--m_numPending == 0)
+        {
+          m_doneCond.notify_one();
+        }
+      }
+    }
   }
 
-  delete[] buf;
+  std::mutex                            m_runMutex;   ///< one job at a time
+  std::mutex                            m_mutex;
+  std::condition_variable               m_jobCond;
+  std::condition_variable               m_doneCond;
+  std::vector<std::thread>              m_threads;
+  const std::function<void(int, int)>  *m_func       = nullptr;
+  int                                   m_numRows    = 0;
+  int                                   m_numBands   = 0;
+  int                                   m_numPending = 0;
+  uint64_t                              m_jobId      = 0;
+  bool                                  m_exit       = false;
+};
+
+void Picture::runInRowBands(const int numRows, const std::function<void(int, int)> &func)
+{
+  const int numThreads = m_rescaleThreads > 0 ? m_rescaleThreads : std::max<int>(1, std::thread::hardware_concurrency());
+  const int numBands   = std::max(1, std::min(numThreads, numRows / MIN_RESCALE_BAND_HEIGHT));
+
+  static RowBandWorkers workers;
+  if (numBands == 1 || !workers.run(numRows, numBands, func))
+  {
+    // single band, or the workers are used by another thread
+    func(0, numRows);
+  }
 }
 
 void Picture::rescalePicture(const ScalingRatio scalingRatio, const CPelUnitBuf& beforeScaling,
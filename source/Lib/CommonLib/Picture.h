@@ -50,6 +50,7 @@
 #include "MCTS.h"
 #include "SEIColourTransform.h"
 #include <deque>
+#include <functional>
 #include "SEIFilmGrainSynthesizer.h"
 
 class SEI;
@@ -187,8 +188,12 @@ struct Picture : public UnitArea
                              const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling,
                              const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag,
                              bool rescaleForDisplay = false, int upscaleFilterForDisplay = 0);
+  static void   setRescaleThreads(int numThreads) { m_rescaleThreads = numThreads; }
 
 private:
+  static void   runInRowBands(const int numRows, const std::function<void(int, int)> &func);
+
+  static int    m_rescaleThreads;   ///< number of threads used by sampleRateConv (0: number of cores)
   Window        m_conformanceWindow;
   Window        m_scalingWindow;
   int           m_decodingOrderNumber;
@@ -223,6 +228,7 @@ public:
   bool referenced;
   bool reconstructed;
   bool neededForOutput;
+  int  viewCount;   // output views held by an application, the buffer is not reused while non-zero
   bool usedByCurr;
   bool longTerm;
   bool topField;
@@ -83,6 +83,14 @@ QuantRDOQ::QuantRDOQ( const Quant* other ) : Quant( other )
   const QuantRDOQ *rdoq = dynamic_cast<const QuantRDOQ*>( other );
   CHECK( other && !rdoq, "The RDOQ cast must be successfull!" );
   xInitScalingList( rdoq );
+
+  m_quantLevelCands = xQuantLevelCands;
+
+#if ENABLE_SIMD_OPT_RDOQ
+#ifdef TARGET_SIMD_X86
+  initQuantRDOQX86();
+#endif
+#endif
 }
 
 QuantRDOQ::~QuantRDOQ()
@@ -90,6 +98,41 @@ QuantRDOQ::~QuantRDOQ()
   xDestroyScalingList();
 }
 
+bool QuantRDOQ::xQuantLevelCands( const TCoeff* src, const ptrdiff_t stride, const int width, const int height,
+                                  const int* quantCoeff, const int defaultQuantCoeff, const double* errScale,
+                                  const double defaultErrScale, const int qBits, const TCoeff maxLevel, RdoqLevelCands& cands )
+{
+  const Intermediate_Int maxLevelDouble = std::numeric_limits<Intermediate_Int>::max() - ( Intermediate_Int( 1 ) << ( qBits - 1 ) );
+  bool anyNonZero = false;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int    blkPos                  = y * stride + x;
+      const int    quantisationCoefficient = quantCoeff ? quantCoeff[blkPos] : defaultQuantCoeff;
+      const double errorScale              = errScale   ? errScale  [blkPos] : defaultErrScale;
+      const int64_t  tmpLevel              = int64_t( abs( src[blkPos] ) ) * quantisationCoefficient;
+
+      const Intermediate_Int levelDouble   = (Intermediate_Int)std::min<int64_t>( tmpLevel, maxLevelDouble );
+      const uint32_t         maxAbsLevel   = std::min<uint32_t>( uint32_t( maxLevel ), uint32_t( ( levelDouble + ( Intermediate_Int( 1 ) << ( qBits - 1 ) ) ) >> qBits ) );
+
+      const double errZero  = double( levelDouble );
+      const double errMax   = double( levelDouble - ( Intermediate_Int( maxAbsLevel ) << qBits ) );
+      const double errMaxM1 = errMax + double( Intermediate_Int( 1 ) << qBits );
+
+      cands.levelDouble[blkPos] = levelDouble;
+      cands.maxAbsLevel[blkPos] = maxAbsLevel;
+      cands.costZero   [blkPos] = errZero  * errZero  * errorScale;
+      cands.costMax    [blkPos] = errMax   * errMax   * errorScale;
+      cands.costMaxM1  [blkPos] = errMaxM1 * errMaxM1 * errorScale;
+      anyNonZero               |= maxAbsLevel > 0;
+    }
+  }
+
+  return anyNonZero;
+}
+
 
 /** Get the best level in RD sense
  *
@@ -100,7 +143,8 @@ QuantRDOQ::~QuantRDOQ()
 inline uint32_t QuantRDOQ::xGetCodedLevel( double&            rd64CodedCost,
                                        double&            rd64CodedCost0,
                                        double&            rd64CodedCostSig,
-                                       Intermediate_Int   lLevelDouble,
+                                       double             costMaxLevel,
+                                       double             costMaxLevelM1,
                                        uint32_t               uiMaxAbsLevel,
                                        const BinFracBits* fracBitsSig,
                                        const BinFracBits& fracBitsPar,
@@ -109,8 +153,6 @@ inline uint32_t QuantRDOQ::xGetCodedLevel( double&            rd64CodedCost,
                                        const int          remRegBins,
                                        unsigned           goRiceZero,
                                        uint16_t             ui16AbsGoRice,
-                                       int                iQBits,
-                                       double             errorScale,
                                        bool               bLast,
                                        bool               useLimitedPrefixLength,
                                        const int          maxLog2TrDynamicRange
@@ -141,9 +183,7 @@ inline uint32_t QuantRDOQ::xGetCodedLevel( double&            rd64CodedCost,
   uint32_t uiMinAbsLevel    = ( uiMaxAbsLevel > 1 ? uiMaxAbsLevel - 1 : 1 );
   for( int uiAbsLevel  = uiMaxAbsLevel; uiAbsLevel >= uiMinAbsLevel ; uiAbsLevel-- )
   {
-    double dErr         = double( lLevelDouble  - ( Intermediate_Int(uiAbsLevel) << iQBits ) );
-
-    double dCurrCost    = dErr * dErr * errorScale + xGetICost( xGetICRate( uiAbsLevel, fracBitsPar, fracBitsGt1, fracBitsGt2, remRegBins, goRiceZero, ui16AbsGoRice, true, maxLog2TrDynamicRange ) );
+    double dCurrCost    = ( uiAbsLevel == uiMaxAbsLevel ? costMaxLevel : costMaxLevelM1 ) + xGetICost( xGetICRate( uiAbsLevel, fracBitsPar, fracBitsGt1, fracBitsGt2, remRegBins, goRiceZero, ui16AbsGoRice, true, maxLog2TrDynamicRange ) );
     dCurrCost          += dCurrCostSig;
 
     if( dCurrCost < rd64CodedCost )
@@ -676,6 +716,15 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   DTRACE( g_trace_ctx, D_RDOQ, "%d: %3d, %3d, %dx%d, comp=%d\n", DTRACE_GET_COUNTER( g_trace_ctx, D_RDOQ ), rect.x, rect.y, rect.width, rect.height, compID );
 #endif
 
+  // all levels are computed up front, a block without any non-zero level is not coded
+  if( !m_quantLevelCands( plSrcCoeff, uiWidth, getNonzeroTuSize( uiWidth ), getNonzeroTuSize( uiHeight ),
+                          enableScalingLists ? piQCoef : nullptr, defaultQuantisationCoefficient,
+                          enableScalingLists ? pdErrScale : nullptr, defaultErrorScale, iQBits, entropyCodingMaximum,
+                          m_levelCands ) )
+  {
+    return;
+  }
+
   const uint32_t lfnstIdx = tu.cu->lfnstIdx;
 
   const int iCGNum = lfnstIdx > 0 ? 1 : getNonzeroTuSize(uiWidth) * getNonzeroTuSize(uiHeight) >> cctx.log2CGSize();
@@ -705,16 +754,10 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
       uint32_t    uiBlkPos          = cctx.blockPos(iScanPos);
 
       // set coeff
-      const int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [uiBlkPos]               : defaultQuantisationCoefficient;
-      const double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos]               : defaultErrorScale;
-      const int64_t  tmpLevel                = int64_t(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient;
-
-      const Intermediate_Int lLevelDouble  = (Intermediate_Int)std::min<int64_t>(tmpLevel, std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1)));
-
-      uint32_t uiMaxAbsLevel        = std::min<uint32_t>(uint32_t(entropyCodingMaximum), uint32_t((lLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits));
+      const Intermediate_Int lLevelDouble  = m_levelCands.levelDouble[uiBlkPos];
+      uint32_t uiMaxAbsLevel               = m_levelCands.maxAbsLevel[uiBlkPos];
 
-      const double dErr         = double( lLevelDouble );
-      pdCostCoeff0[ iScanPos ]  = dErr * dErr * errorScale;
+      pdCostCoeff0[ iScanPos ]  = m_levelCands.costZero[uiBlkPos];
       d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
       piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
 
@@ -759,7 +802,7 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
         if( iScanPos == iLastScanPos )
         {
           uiLevel = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
-                                    lLevelDouble, uiMaxAbsLevel, nullptr, fracBitsPar, fracBitsGt1, fracBitsGt2, remRegBins, goRiceZero, goRiceParam, iQBits, errorScale, 1, extendedPrecision, maxLog2TrDynamicRange );
+                                    m_levelCands.costMax[uiBlkPos], m_levelCands.costMaxM1[uiBlkPos], uiMaxAbsLevel, nullptr, fracBitsPar, fracBitsGt1, fracBitsGt2, remRegBins, goRiceZero, goRiceParam, 1, extendedPrecision, maxLog2TrDynamicRange );
         }
         else
         {
@@ -767,7 +810,7 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
           const BinFracBits fracBitsSig = fracBits.getFracBitsArray( ctxIdSig );
           uiLevel = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
-                                    lLevelDouble, uiMaxAbsLevel, &fracBitsSig, fracBitsPar, fracBitsGt1, fracBitsGt2, remRegBins, goRiceZero, goRiceParam, iQBits, errorScale, 0, extendedPrecision, maxLog2TrDynamicRange );
+                                    m_levelCands.costMax[uiBlkPos], m_levelCands.costMaxM1[uiBlkPos], uiMaxAbsLevel, &fracBitsSig, fracBitsPar, fracBitsGt1, fracBitsGt2, remRegBins, goRiceZero, goRiceParam, 0, extendedPrecision, maxLog2TrDynamicRange );
           sigRateDelta[ uiBlkPos ] = ( remRegBins < 4 ? 0 : fracBitsSig.intBits[1] - fracBitsSig.intBits[0] );
         }
 
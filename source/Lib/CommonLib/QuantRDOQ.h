@@ -53,6 +53,16 @@
 // Class definition
 // ====================================================================================================================
 
+/// level candidates of the RD-optimised quantisation, per coefficient in raster order
+struct RdoqLevelCands
+{
+  Intermediate_Int levelDouble [MAX_TB_SIZEY * MAX_TB_SIZEY];   ///< scaled absolute level before the rounding
+  TCoeff           maxAbsLevel [MAX_TB_SIZEY * MAX_TB_SIZEY];   ///< rounded level, the highest level candidate
+  double           costZero    [MAX_TB_SIZEY * MAX_TB_SIZEY];   ///< distortion of a zero level
+  double           costMax     [MAX_TB_SIZEY * MAX_TB_SIZEY];   ///< distortion of level maxAbsLevel
+  double           costMaxM1   [MAX_TB_SIZEY * MAX_TB_SIZEY];   ///< distortion of level maxAbsLevel - 1
+};
+
 /// transform and quantization class
 class QuantRDOQ : public Quant
 {
@@ -60,6 +70,22 @@ public:
   QuantRDOQ( const Quant* other );
   ~QuantRDOQ();
 
+  /// computes the level candidates of the width x height coefficients at the top left of the block and returns
+  /// whether any of them is non-zero; quantCoeff and errScale are nullptr if no scaling list is used
+  bool (*m_quantLevelCands)( const TCoeff* src, const ptrdiff_t stride, const int width, const int height,
+                             const int* quantCoeff, const int defaultQuantCoeff, const double* errScale,
+                             const double defaultErrScale, const int qBits, const TCoeff maxLevel, RdoqLevelCands& cands );
+
+  static bool xQuantLevelCands( const TCoeff* src, const ptrdiff_t stride, const int width, const int height,
+                                const int* quantCoeff, const int defaultQuantCoeff, const double* errScale,
+                                const double defaultErrScale, const int qBits, const TCoeff maxLevel, RdoqLevelCands& cands );
+
+#ifdef TARGET_SIMD_X86
+  void initQuantRDOQX86();
+  template <X86_VEXT vext>
+  void _initQuantRDOQX86();
+#endif
+
 public:
   void setFlatScalingList   ( const int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths );
   void setScalingList       ( ScalingList *scalingList, const int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE], const BitDepths &bitDepths);
@@ -84,7 +110,8 @@ private:
   inline uint32_t xGetCodedLevel( double&            rd64CodedCost,
                               double&            rd64CodedCost0,
                               double&            rd64CodedCostSig,
-                              Intermediate_Int   lLevelDouble,
+                              double             costMaxLevel,
+                              double             costMaxLevelM1,
                               uint32_t               uiMaxAbsLevel,
                               const BinFracBits* fracBitsSig,
                               const BinFracBits& fracBitsPar,
@@ -93,8 +120,6 @@ private:
                               const int          remRegBins,
                               unsigned           goRiceZero,
                               uint16_t             ui16AbsGoRice,
-                              int                iQBits,
-                              double             errorScale,
                               bool               bLast,
                               bool               useLimitedPrefixLength,
                               const int          maxLog2TrDynamicRange ) const;
@@ -169,6 +194,7 @@ private:
   int    m_sigRateDelta       [MAX_TB_SIZEY * MAX_TB_SIZEY];
   TCoeff m_deltaU             [MAX_TB_SIZEY * MAX_TB_SIZEY];
   TCoeff m_fullCoeff          [MAX_TB_SIZEY * MAX_TB_SIZEY];
+  RdoqLevelCands m_levelCands;
   BdpcmMode m_bdpcm;
   int   m_testedLevels;
 };// END CLASS DEFINITION QuantRDOQ
@@ -48,6 +48,10 @@
 //! \{
 
 EnumArray<DistFunc, DFunc> RdCost::m_distortionFunc;
+void (*RdCost::m_dmvrSadGrid)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                              int height, int bitDepth, Distortion *sads);
+void (*RdCost::m_sadX4)(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads);
+void (*RdCost::m_sadX8)(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads);
 
 RdCost::RdCost()
 {
@@ -208,6 +212,10 @@ void RdCost::init()
 
   m_distortionFunc[DFunc::SAD_WITH_MASK] = RdCost::xGetSADwMask;
 
+  m_dmvrSadGrid = RdCost::xGetDmvrSadGrid;
+  m_sadX4       = RdCost::xGetSADxN<4>;
+  m_sadX8       = RdCost::xGetSADxN<8>;
+
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
   initRdCostX86();
@@ -483,6 +491,66 @@ Distortion RdCost::xGetSAD( const DistParam& rcDtParam )
   return (sum >> distortionShift);
 }
 
+template<int N> void RdCost::xGetSADxN(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads)
+{
+  const int       cols            = rcDtParam.org.width;
+  const int       rows            = rcDtParam.org.height;
+  const int       subShift        = rcDtParam.subShift;
+  const int       subStep         = (1 << subShift);
+  const ptrdiff_t strideCur       = rcDtParam.cur.stride;
+  const ptrdiff_t strideOrg       = rcDtParam.org.stride;
+  const uint32_t  distortionShift = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+
+  for (int i = 0; i < N; i++)
+  {
+    Distortion sum = 0;
+
+    for (int y = 0; y < rows; y += subStep)
+    {
+      const Pel *piOrg = rcDtParam.org.buf + y * strideOrg;
+      const Pel *piCur = cur[i] + y * strideCur;
+      for (int n = 0; n < cols; n++)
+      {
+        sum += abs(piOrg[n] - piCur[n]);
+      }
+    }
+
+    sads[i] = (sum << subShift) >> distortionShift;
+  }
+}
+
+template void RdCost::xGetSADxN<4>(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads);
+template void RdCost::xGetSADxN<8>(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads);
+
+void RdCost::xGetDmvrSadGrid(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                             int height, int bitDepth, Distortion *sads)
+{
+  const uint32_t distortionShift = DISTORTION_PRECISION_ADJUSTMENT(bitDepth);
+
+  for (int dy = -DMVR_RANGE; dy <= DMVR_RANGE; dy++)
+  {
+    for (int dx = -DMVR_RANGE; dx <= DMVR_RANGE; dx++)
+    {
+      const Pel *p0 = src0 + dy * src0Stride + dx;
+      const Pel *p1 = src1 - dy * src1Stride - dx;
+
+      Distortion sum = 0;
+
+      for (int y = 0; y < height; y += 2)
+      {
+        for (int x = 0; x < width; x++)
+        {
+          sum += abs(p0[x] - p1[x]);
+        }
+        p0 += 2 * src0Stride;
+        p1 += 2 * src1Stride;
+      }
+
+      sads[(dy + DMVR_RANGE) * DMVR_SPAN + dx + DMVR_RANGE] = (sum << 1) >> distortionShift;
+    }
+  }
+}
+
 Distortion RdCost::xGetSAD4( const DistParam& rcDtParam )
 {
   if ( rcDtParam.applyWeight )
@@ -116,6 +116,10 @@ private:
   // for distortion
 
   static EnumArray<DistFunc, DFunc> m_distortionFunc;
+  static void (*m_dmvrSadGrid)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride,
+                               int width, int height, int bitDepth, Distortion *sads);
+  static void (*m_sadX4)(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads);
+  static void (*m_sadX8)(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads);
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMPONENT]; // only chroma values are used.
   double                  m_dLambda;
@@ -223,6 +227,30 @@ public:
   void setDistParam(DistParam &rcDP, const CPelBuf &org, const Pel *piRefY, ptrdiff_t iRefStride, const Pel *mask,
                     ptrdiff_t iMaskStride, int stepX, ptrdiff_t iMaskStride2, int bitDepth, ComponentID compID);
 
+  // SAD (even rows only) between src0 displaced by (dx,dy) and src1 displaced by (-dx,-dy) for all DMVR integer
+  // offsets, stored in raster order in sads[(dy + DMVR_RANGE) * DMVR_SPAN + dx + DMVR_RANGE]
+  void getDmvrSadGrid(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                      int height, int bitDepth, Distortion *sads) const
+  {
+    m_dmvrSadGrid(src0, src0Stride, src1, src1Stride, width, height, bitDepth, sads);
+  }
+
+  // unweighted SADs of rcDtParam.org against num (at most 8) candidate blocks sharing the stride rcDtParam.cur.stride,
+  // computed in one pass over the original block without early termination
+  void getSADs(const DistParam &rcDtParam, const Pel *const *cur, int num, Distortion *sads) const
+  {
+    CHECK(num < 1 || num > 8, "Unsupported number of SAD candidates");
+    const Pel *curPad[8];
+    Distortion sadPad[8];
+    const int  numPad = num > 4 ? 8 : 4;
+    for (int i = 0; i < numPad; i++)
+    {
+      curPad[i] = cur[std::min(i, num - 1)];
+    }
+    (numPad == 4 ? m_sadX4 : m_sadX8)(rcDtParam, curPad, sadPad);
+    std::copy(sadPad, sadPad + num, sads);
+  }
+
   double         getMotionLambda          ( )  { return m_dLambdaMotionSAD; }
   void           selectMotionLambda       ( )  { m_motionLambda = getMotionLambda( ); }
   void           setPredictor             ( const Mv& rcMv )
@@ -412,6 +440,10 @@ private:
   static Distortion xGetSAD48         ( const DistParam& pcDtParam );
 
   static Distortion xGetSAD_full      ( const DistParam& pcDtParam );
+  static void       xGetDmvrSadGrid(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride,
+                                    int width, int height, int bitDepth, Distortion *sads);
+  template<int N>
+  static void       xGetSADxN(const DistParam &pcDtParam, const Pel *const *cur, Distortion *sads);
   static Distortion xGetSADwMask      ( const DistParam& pcDtParam );
 
   static Distortion xGetMRSAD         ( const DistParam& pcDtParam );
@@ -453,6 +485,13 @@ private:
   template<int width, X86_VEXT vext> static Distortion xGetSAD_NxN_SIMD(const DistParam &pcDtParam);
   template<X86_VEXT vext>
   static Distortion xGetSAD_IBD_SIMD( const DistParam& pcDtParam );
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  template<int N, X86_VEXT vext>
+  static void xGetSADxN_SIMD(const DistParam &pcDtParam, const Pel *const *cur, Distortion *sads);
+  template<X86_VEXT vext>
+  static void xGetDmvrSadGrid_SIMD(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride,
+                                   int width, int height, int bitDepth, Distortion *sads);
+#endif
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
   template<X86_VEXT vext>
   static Distortion xGetHADs_HBD_SIMD(const DistParam& pcDtParam);
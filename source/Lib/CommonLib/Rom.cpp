@@ -43,6 +43,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <iomanip>
+#include <mutex>
 
 constexpr int MmvdIdx::ADD_NUM;
 constexpr int MmvdIdx::BASE_MV_NUM;
@@ -275,9 +276,19 @@ Size g_log2TxSubblockSize[MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1] = {
   { { 4, 0 }, { 3, 1 }, { 2, 2 }, { 2, 2 }, { 2, 2 }, { 2, 2 }, { 2, 2 }, { 2, 2 } }
 };
 
+// the tables are shared by all encoder and decoder instances of a process
+static std::mutex g_romMutex;
+static int        g_romUsers = 0;
+
 // initialize ROM variables
 void initROM()
 {
+  std::lock_guard<std::mutex> lock(g_romMutex);
+  if (g_romUsers++ > 0)
+  {
+    return;
+  }
+
   gp_sizeIdxInfo = new SizeIndexInfoLog2();
   gp_sizeIdxInfo->init(MAX_CU_SIZE);
 
@@ -431,6 +442,12 @@ void initROM()
 
 void destroyROM()
 {
+  std::lock_guard<std::mutex> lock(g_romMutex);
+  if (--g_romUsers > 0)
+  {
+    return;
+  }
+
   unsigned numWidths = gp_sizeIdxInfo->numAllWidths();
   unsigned numHeights = gp_sizeIdxInfo->numAllHeights();
 
@@ -39,6 +39,7 @@
 
 #include <stdio.h>
 #include <cmath>
+#include <thread>
 
 
 /* static look up table definitions */
@@ -220,11 +221,20 @@ SEIFilmGrainSynthesizer::SEIFilmGrainSynthesizer()
   , m_idrPicId(0)
   , m_grainSynt(nullptr)
   , m_fgsBlkSize(8)
+  , m_numThreads(1)
   , m_poc(0)
   , m_errorCode(0)
   , m_fgcParameters(nullptr)
 {
-
+  m_deblockGrainStripe = deblockGrainStripe;
+  m_blendStripe        = blendStripe;
+  m_blockSum           = blockSum;
+
+#if ENABLE_SIMD_OPT_FGS
+#ifdef TARGET_SIMD_X86
+  initFilmGrainSynthesizerX86();
+#endif
+#endif
 }
 
 void SEIFilmGrainSynthesizer::create(uint32_t width, uint32_t height, ChromaFormat fmt, uint8_t bitDepth, uint32_t idrPicId)
@@ -391,6 +401,7 @@ void SEIFilmGrainSynthesizer::grainSynthesizeAndBlend(PelStorage* pGrainBuf, boo
   m_fgsArgs.blkSize = m_fgsBlkSize;
   m_fgsArgs.bitDepth = m_bitDepth;
   m_fgsArgs.pGrainSynt = m_grainSynt;
+  m_fgsArgs.numThreads = m_numThreads > 0 ? m_numThreads : std::max<int>(1, std::thread::hardware_concurrency());
 
   fgsProcess(m_fgsArgs);
 
@@ -705,19 +716,62 @@ uint32_t SEIFilmGrainSynthesizer::prng(uint32_t x_r)
 
 uint32_t SEIFilmGrainSynthesizer::fgsProcess(fgsProcessArgs &inArgs)
 {
-  uint32_t errorCode;
-  uint8_t  blkSize = inArgs.blkSize;
+  uint8_t  blkSize      = inArgs.blkSize;
+  uint32_t stripeHeight = (blkSize == 32) ? BLK_32 : BLK_16;
+
+  void (SEIFilmGrainSynthesizer::*simulationBlending)(const fgsProcessArgs *, uint8_t, uint32_t, Pel *) const;
 
   if (blkSize == 8)
-    errorCode = fgsSimulationBlending_8x8(&inArgs);
+    simulationBlending = &SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8;
   else if (blkSize == 16)
-    errorCode = fgsSimulationBlending_16x16(&inArgs);
+    simulationBlending = &SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16;
   else if (blkSize == 32)
-    errorCode = fgsSimulationBlending_32x32(&inArgs);
+    simulationBlending = &SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32;
   else
-    errorCode = FGS_FAIL;
+    return FGS_FAIL;
+
+  if (0 != inArgs.pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  {
+    return FGS_SUCCESS;
+  }
+
+  /* stripes only read and write their own lines of the picture, so they can be processed in any order */
+  std::vector<std::pair<uint8_t, uint32_t>> stripes;
+  for (uint8_t compCtr = 0; compCtr < inArgs.numComp; compCtr++)
+  {
+    if (1 == inArgs.pFgcParameters->m_compModel[compCtr].presentFlag)
+    {
+      for (uint32_t y = 0; y < inArgs.heightComp[compCtr]; y += stripeHeight)
+      {
+        stripes.push_back(std::make_pair(compCtr, y));
+      }
+    }
+  }
+
+  const uint32_t wdPadded   = ((inArgs.widthComp[0] - 1) | (stripeHeight - 1)) + 1;
+  const int      numThreads = std::max(1, std::min<int>(inArgs.numThreads, (int) stripes.size()));
+
+  auto processStripes = [&](int threadIdx)
+  {
+    std::vector<Pel> grainStripe(wdPadded * stripeHeight);
+    for (size_t i = threadIdx; i < stripes.size(); i += numThreads)
+    {
+      (this->*simulationBlending)(&inArgs, stripes[i].first, stripes[i].second, grainStripe.data());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int threadIdx = 1; threadIdx < numThreads; threadIdx++)
+  {
+    threads.emplace_back(processStripes, threadIdx);
+  }
+  processStripes(0);
+  for (auto &thread: threads)
+  {
+    thread.join();
+  }
 
-  return errorCode;
+  return FGS_SUCCESS;
 }
 
 void SEIFilmGrainSynthesizer::deblockGrainStripe(Pel *grainStripe, uint32_t widthComp, uint32_t heightComp,
@@ -777,98 +831,19 @@ void SEIFilmGrainSynthesizer::blendStripe(Pel *decSampleHbdOffsetY, Pel *grainSt
   return;
 }
 
-void SEIFilmGrainSynthesizer::blendStripe_32x32(Pel *decSampleHbdOffsetY, Pel *grainStripe, uint32_t widthComp,
-                                                ptrdiff_t strideSrc, ptrdiff_t strideGrain, uint32_t blockHeight,
-                                                uint8_t bitDepth)
-{
-  uint32_t k, l;
-  uint16_t maxRange;
-  maxRange = (1 << bitDepth) - 1;
-
-  int32_t  grainSample;
-  uint16_t decodeSampleHbd;
-  uint8_t bitDepthShift = (bitDepth - BIT_DEPTH_8);
-  ptrdiff_t bufInc        = (strideSrc - widthComp);
-  ptrdiff_t grainBufInc   = (strideGrain - widthComp);
-
-  for (l = 0; l < blockHeight; l++) /* y direction */
-  {
-    for (k = 0; k < widthComp; k++) /* x direction */
-    {
-      decodeSampleHbd = *decSampleHbdOffsetY;
-      grainSample = *grainStripe;
-      grainSample <<= bitDepthShift;
-      grainSample = CLIP3(0, maxRange, grainSample + decodeSampleHbd);
-      *decSampleHbdOffsetY = (Pel)grainSample;
-      decSampleHbdOffsetY++;
-      grainStripe++;
-    }
-    decSampleHbdOffsetY += bufInc;
-    grainStripe += grainBufInc;
-  }
-  return;
-}
-
-Pel SEIFilmGrainSynthesizer::blockAverage_8x8(Pel *decSampleBlk8, ptrdiff_t widthComp, uint16_t *pNumSamples,
-                                              uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
-{
-  uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  for (k = 0; k < ySize; k++)
-  {
-    for (l = 0; l < xSize; l++)
-    {
-      blockAvg += *decSampleBlk8;
-      decSampleBlk8++;
-    }
-    decSampleBlk8 += widthComp - xSize;
-  }
-
-  blockAvg = blockAvg >> (BLK_8_shift + (bitDepth - BIT_DEPTH_8));
-  *pNumSamples = BLK_AREA_8x8;
-
-  return blockAvg;
-}
-
-uint32_t SEIFilmGrainSynthesizer::blockAverage_16x16(Pel *decSampleBlk8, ptrdiff_t widthComp, uint16_t *pNumSamples,
-                                                     uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
+uint32_t SEIFilmGrainSynthesizer::blockSum(const Pel *decSampleBlk, ptrdiff_t strideComp, uint32_t blkSize)
 {
-  uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  for (k = 0; k < ySize; k++)
+  uint32_t blockSum = 0;
+  ptrdiff_t bufInc  = strideComp - blkSize;
+  for (uint32_t k = 0; k < blkSize; k++)
   {
-    for (l = 0; l < xSize; l++)
+    for (uint32_t l = 0; l < blkSize; l++)
     {
-      blockAvg += *decSampleBlk8;
-      decSampleBlk8++;
+      blockSum += *decSampleBlk++;
     }
-    decSampleBlk8 += widthComp - xSize;
+    decSampleBlk += bufInc;
   }
-
-  // blockAvg = blockAvg >> (BLK_16_shift + (bitDepth - BIT_DEPTH_8));
-  // If BLK_16 is not used or changed BLK_AREA_16x16 has to be changed
-  *pNumSamples = BLK_AREA_16x16;
-  return blockAvg;
-}
-
-uint32_t SEIFilmGrainSynthesizer::blockAverage_32x32(Pel *decSampleBlk32, ptrdiff_t strideComp, uint8_t bitDepth)
-{
-  uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  ptrdiff_t bufInc = strideComp - BLK_32;
-  for (k = 0; k < BLK_32; k++)
-  {
-    for (l = 0; l < BLK_32; l++)
-    {
-      blockAvg += *decSampleBlk32++;
-    }
-    decSampleBlk32 += bufInc;
-  }
-  blockAvg = blockAvg >> (BLK_32_shift + (bitDepth - BIT_DEPTH_8));
-  return blockAvg;
+  return blockSum;
 }
 
 void SEIFilmGrainSynthesizer::simulateGrainBlk8x8(Pel *grainStripe, uint32_t grainStripeOffsetBlk8,
@@ -943,321 +918,224 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk32x32(Pel *grainStripe, uint32_t g
   return;
 }
 
-uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(fgsProcessArgs *inArgs)
+void SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(const fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t y,
+                                                        Pel *grainStripe) const
 {
-  uint8_t  numComp, compCtr, blkId; /* number of color components */
-  uint8_t  log2ScaleFactor, h, v;
-  uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
-  uint32_t  widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT];
-  ptrdiff_t strideComp[MAX_NUM_COMPONENT];
-  Pel *    decSampleHbdBlk16, *decSampleHbdBlk8, *decSampleHbdOffsetY;
-  Pel *    decHbdComp[MAX_NUM_COMPONENT];
-  uint16_t numSamples;
-  int16_t  scaleFactor;
+  uint8_t   blkId;
+  uint8_t   log2ScaleFactor, h, v;
+  uint8_t   bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
+  uint32_t  widthComp;
+  ptrdiff_t strideComp;
+  Pel *     decSampleHbdBlk16, *decSampleHbdBlk8, *decSampleHbdOffsetY;
+  int16_t   scaleFactor;
   uint32_t  kOffset, lOffset, grainStripeOffset, grainStripeOffsetBlk8;
   ptrdiff_t offsetBlk8x8;
-  uint32_t kOffset_const, lOffset_const;
-  int16_t  scaleFactor_const;
-  Pel *    grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
-  int32_t  yOffset8x8, xOffset8x8;
-  uint32_t x, y;
-  uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
-  uint32_t grainStripeWidth;
-  uint32_t wdPadded;
+  uint32_t  kOffset_const, lOffset_const;
+  int16_t   scaleFactor_const;
+  int32_t   yOffset8x8, xOffset8x8;
+  uint32_t  x;
+  uint32_t  blockAvg, intensityInt;
+  uint32_t  grainStripeWidth;
 
   bitDepth        = inArgs->bitDepth;
-  numComp         = inArgs->numComp;
   log2ScaleFactor = inArgs->pFgcParameters->m_log2ScaleFactor;
+  strideComp      = inArgs->strideComp[compCtr];
+  widthComp       = inArgs->widthComp[compCtr];
 
-  for (compCtr = 0; compCtr < numComp; compCtr++)
-  {
-    decHbdComp[compCtr] = inArgs->decComp[compCtr];
-    strideComp[compCtr] = inArgs->strideComp[compCtr];
-    widthComp[compCtr]  = inArgs->widthComp[compCtr];
-    heightComp[compCtr] = inArgs->heightComp[compCtr];
-  }
+  grainStripeWidth = ((widthComp - 1) | 0xF) + 1;   // Make next muliptle of 16
 
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0xF) + 1;
-  grainStripe = new Pel[wdPadded * BLK_16];
+  decSampleHbdOffsetY  = inArgs->decComp[compCtr] + y * strideComp;
+  /* one PRNG value per 16x16 block of samples */
+  uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr] + (y / BLK_16) * (grainStripeWidth / BLK_16);
 
-  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  /* Initialization of grain stripe of 16xwidth size */
+  memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
+  for (x = 0; x < widthComp; x += BLK_16)
   {
-    for (compCtr = 0; compCtr < numComp; compCtr++)
-    {
-      if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
-      {
-        decSampleHbdOffsetY  = decHbdComp[compCtr];
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        grainStripeWidth = ((widthComp[compCtr] - 1) | 0xF) + 1;   // Make next muliptle of 16
-
-        /* Loop of 16x16 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += BLK_16)
-        {
-          /* Initialization of grain stripe of 16xwidth size */
-          memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += BLK_16)
-          {
-            /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-
-            decSampleHbdBlk16 = decSampleHbdOffsetY + x;
-
-            kOffset_const = (MSB16(*offset_tmp) % 52);
-            kOffset_const &= 0xFFFC;
+    /* start position offset of decoded sample in x direction */
+    grainStripeOffset = x;
 
-            lOffset_const = (LSB16(*offset_tmp) % 56);
-            lOffset_const &= 0xFFF8;
-            scaleFactor_const = 1 - 2 * BIT0(*offset_tmp);
-            for (blkId = 0; blkId < NUM_8x8_BLKS_16x16; blkId++)
-            {
-              yOffset8x8   = (blkId >> 1) * BLK_8;
-              xOffset8x8   = (blkId & 0x1) * BLK_8;
-              offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp[compCtr]);
+    decSampleHbdBlk16 = decSampleHbdOffsetY + x;
 
-              grainStripeOffsetBlk8 = grainStripeOffset + (xOffset8x8 + (yOffset8x8 * grainStripeWidth));
+    kOffset_const = (MSB16(*offset_tmp) % 52);
+    kOffset_const &= 0xFFFC;
 
-              decSampleHbdBlk8 = decSampleHbdBlk16 + offsetBlk8x8;
-              blockAvg = blockAverage_8x8(decSampleHbdBlk8, strideComp[compCtr], &numSamples, BLK_8, BLK_8, bitDepth);
+    lOffset_const = (LSB16(*offset_tmp) % 56);
+    lOffset_const &= 0xFFF8;
+    scaleFactor_const = 1 - 2 * BIT0(*offset_tmp);
+    for (blkId = 0; blkId < NUM_8x8_BLKS_16x16; blkId++)
+    {
+      yOffset8x8   = (blkId >> 1) * BLK_8;
+      xOffset8x8   = (blkId & 0x1) * BLK_8;
+      offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp);
 
-              /* Selection of the component model */
-              intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+      grainStripeOffsetBlk8 = grainStripeOffset + (xOffset8x8 + (yOffset8x8 * grainStripeWidth));
 
-              if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
-              {
-                /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
-                // kOffset = kOffset_const;
-                kOffset = kOffset_const + xOffset8x8;
+      decSampleHbdBlk8 = decSampleHbdBlk16 + offsetBlk8x8;
+      blockAvg = m_blockSum(decSampleHbdBlk8, strideComp, BLK_8) >> (BLK_8_shift + (bitDepth - BIT_DEPTH_8));
 
-                lOffset = lOffset_const + yOffset8x8;
+      /* Selection of the component model */
+      intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
-                scaleFactor =
-                  scaleFactor_const
-                  * inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-                h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-                v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+      if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
+      {
+        /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
+        kOffset = kOffset_const + xOffset8x8;
 
-                /* 8x8 block grain simulation */
-                simulateGrainBlk8x8(grainStripe, grainStripeOffsetBlk8, inArgs->pGrainSynt, grainStripeWidth,
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_8);
-              } /* only if average falls in any interval */
-              //  }/* includes corner case handling */
-            } /* 8x8 level block processing */
+        lOffset = lOffset_const + yOffset8x8;
 
-            /* uppdate the PRNG once per 16x16 block of samples */
-            offset_tmp++;
-          } /* End of 16xwidth grain simulation */
+        scaleFactor =
+          scaleFactor_const
+          * inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
+        h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+        v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
 
-          /* deblocking at the vertical edges of 8x8 at 16xwidth*/
-          deblockGrainStripe(grainStripe, widthComp[compCtr], BLK_16, grainStripeWidth, BLK_8);
+        /* 8x8 block grain simulation */
+        simulateGrainBlk8x8(grainStripe, grainStripeOffsetBlk8, inArgs->pGrainSynt, grainStripeWidth,
+                            log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_8);
+      } /* only if average falls in any interval */
+    } /* 8x8 level block processing */
 
-          /* Blending of size 16xwidth*/
+    /* uppdate the PRNG once per 16x16 block of samples */
+    offset_tmp++;
+  } /* End of 16xwidth grain simulation */
 
-          blendStripe(decSampleHbdOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth,
-                      BLK_16, bitDepth);
-          decSampleHbdOffsetY += BLK_16 * strideComp[compCtr];
+  /* deblocking at the vertical edges of 8x8 at 16xwidth*/
+  m_deblockGrainStripe(grainStripe, widthComp, BLK_16, grainStripeWidth, BLK_8);
 
-        } /* end of component loop */
-      }
-    }
-  }
-
-  delete [] grainStripe;
-  return FGS_SUCCESS;
+  /* Blending of size 16xwidth*/
+  m_blendStripe(decSampleHbdOffsetY, grainStripe, widthComp, strideComp, grainStripeWidth, BLK_16, bitDepth);
 }
 
-uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(fgsProcessArgs *inArgs)
+void SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(const fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t y,
+                                                          Pel *grainStripe) const
 {
-  uint8_t  numComp, compCtr; /* number of color components */
-  uint8_t  log2ScaleFactor, h, v;
-  uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
-  uint32_t  widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT];
-  ptrdiff_t strideComp[MAX_NUM_COMPONENT];
-  Pel *    decSampleHbdBlk16, *decSampleHbdOffsetY;
-  Pel *    decHbdComp[MAX_NUM_COMPONENT];
-  uint16_t numSamples;
-  int16_t  scaleFactor;
-  uint32_t kOffset, lOffset, grainStripeOffset;
-  Pel *    grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
-  uint32_t x, y;
-  uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
-  uint32_t grainStripeWidth;
-  uint32_t wdPadded;
+  uint8_t   log2ScaleFactor, h, v;
+  uint8_t   bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
+  uint32_t  widthComp;
+  ptrdiff_t strideComp;
+  Pel *     decSampleHbdBlk16, *decSampleHbdOffsetY;
+  int16_t   scaleFactor;
+  uint32_t  kOffset, lOffset, grainStripeOffset;
+  uint32_t  x;
+  uint32_t  blockAvg, intensityInt;
+  uint32_t  grainStripeWidth;
 
   bitDepth        = inArgs->bitDepth;
-  numComp         = inArgs->numComp;
   log2ScaleFactor = inArgs->pFgcParameters->m_log2ScaleFactor;
+  strideComp      = inArgs->strideComp[compCtr];
+  widthComp       = inArgs->widthComp[compCtr];
 
-  for (compCtr = 0; compCtr < numComp; compCtr++)
-  {
-    decHbdComp[compCtr] = inArgs->decComp[compCtr];
-    strideComp[compCtr] = inArgs->strideComp[compCtr];
-    widthComp[compCtr]  = inArgs->widthComp[compCtr];
-    heightComp[compCtr] = inArgs->heightComp[compCtr];
-  }
+  grainStripeWidth = ((widthComp - 1) | 0xF) + 1;   // Make next muliptle of 16
 
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0xF) + 1;
-  grainStripe = new Pel[wdPadded * BLK_16];
+  decSampleHbdOffsetY  = inArgs->decComp[compCtr] + y * strideComp;
+  /* one PRNG value per 16x16 block of samples */
+  uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr] + (y / BLK_16) * (grainStripeWidth / BLK_16);
 
-  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  /* Initialization of grain stripe of 16xwidth size */
+  memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
+  for (x = 0; x < widthComp; x += BLK_16)
   {
-    for (compCtr = 0; compCtr < numComp; compCtr++)
+    /* start position offset of decoded sample in x direction */
+    grainStripeOffset = x;
+
+    decSampleHbdBlk16 = decSampleHbdOffsetY + x;
+
+    blockAvg = m_blockSum(decSampleHbdBlk16, strideComp, BLK_16) >> (BLK_16_shift + (bitDepth - BIT_DEPTH_8));
+    /* Selection of the component model */
+    intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+
+    if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
     {
-      if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
-      {
-        decSampleHbdOffsetY  = decHbdComp[compCtr];
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        grainStripeWidth = ((widthComp[compCtr] - 1) | 0xF) + 1;   // Make next muliptle of 16
+      kOffset = (MSB16(*offset_tmp) % 52);
+      kOffset &= 0xFFFC;
 
-        /* Loop of 16x16 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += BLK_16)
-        {
-          /* Initialization of grain stripe of 16xwidth size */
-          memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += BLK_16)
-          {
-            /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-
-            decSampleHbdBlk16 = decSampleHbdOffsetY + x;
-
-            blockAvg =
-              blockAverage_16x16(decSampleHbdBlk16, strideComp[compCtr], &numSamples, BLK_16, BLK_16, bitDepth);
-            blockAvg = blockAvg >> (BLK_16_shift + (bitDepth - BIT_DEPTH_8));
-            /* Selection of the component model */
-            intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
-
-            if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
-            {
-              kOffset = (MSB16(*offset_tmp) % 52);
-              kOffset &= 0xFFFC;
-
-              lOffset = (LSB16(*offset_tmp) % 56);
-              lOffset &= 0xFFF8;
-              scaleFactor = 1 - 2 * BIT0(*offset_tmp);
-
-              scaleFactor *=
-                inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-              h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-              v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
-
-              /* 16x16 block grain simulation */
-              simulateGrainBlk16x16(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_16);
-
-            } /* only if average falls in any interval */
-            //  }/* includes corner case handling */
-            /* uppdate the PRNG once per 16x16 block of samples */
-            offset_tmp++;
-          } /* End of 16xwidth grain simulation */
-          /* deblocking at the vertical edges of 16x16 at 16xwidth*/
-          deblockGrainStripe(grainStripe, widthComp[compCtr], BLK_16, grainStripeWidth, BLK_16);
-
-          /* Blending of size 16xwidth*/
-          blendStripe(decSampleHbdOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth,
-                      BLK_16, bitDepth);
-          decSampleHbdOffsetY += BLK_16 * strideComp[compCtr];
-
-        } /* end of component loop */
-      }
-    }
-  }
+      lOffset = (LSB16(*offset_tmp) % 56);
+      lOffset &= 0xFFF8;
+      scaleFactor = 1 - 2 * BIT0(*offset_tmp);
 
-  delete [] grainStripe;
-  return FGS_SUCCESS;
+      scaleFactor *=
+        inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
+      h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+      v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+
+      /* 16x16 block grain simulation */
+      simulateGrainBlk16x16(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
+                            log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_16);
+    } /* only if average falls in any interval */
+
+    /* uppdate the PRNG once per 16x16 block of samples */
+    offset_tmp++;
+  } /* End of 16xwidth grain simulation */
+
+  /* deblocking at the vertical edges of 16x16 at 16xwidth*/
+  m_deblockGrainStripe(grainStripe, widthComp, BLK_16, grainStripeWidth, BLK_16);
+
+  /* Blending of size 16xwidth*/
+  m_blendStripe(decSampleHbdOffsetY, grainStripe, widthComp, strideComp, grainStripeWidth, BLK_16, bitDepth);
 }
 
-uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(fgsProcessArgs *inArgs)
+void SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(const fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t y,
+                                                          Pel *grainStripe) const
 {
-  uint8_t  numComp, compCtr; /* number of color components */
-  uint8_t  log2ScaleFactor, h, v;
-  uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
-  uint32_t  widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT];
-  ptrdiff_t strideComp[MAX_NUM_COMPONENT];
-  Pel *    decSampleBlk32, *decSampleOffsetY;
-  Pel *    decComp[MAX_NUM_COMPONENT];
-  int16_t  scaleFactor;
-  uint32_t kOffset, lOffset, grainStripeOffset;
-  Pel *    grainStripe;
-  uint32_t x, y;
-  uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
-  uint32_t grainStripeWidth;
-  uint32_t wdPadded;
-
-  bitDepth = inArgs->bitDepth;
-  numComp  = inArgs->numComp;
+  uint8_t   log2ScaleFactor, h, v;
+  uint8_t   bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
+  uint32_t  widthComp;
+  ptrdiff_t strideComp;
+  Pel *     decSampleBlk32, *decSampleOffsetY;
+  int16_t   scaleFactor;
+  uint32_t  kOffset, lOffset, grainStripeOffset;
+  uint32_t  x;
+  uint32_t  blockAvg, intensityInt;
+  uint32_t  grainStripeWidth;
 
+  bitDepth        = inArgs->bitDepth;
   log2ScaleFactor = inArgs->pFgcParameters->m_log2ScaleFactor;
+  strideComp      = inArgs->strideComp[compCtr];
+  widthComp       = inArgs->widthComp[compCtr];
 
-  for (compCtr = 0; compCtr < numComp; compCtr++)
-  {
-    decComp[compCtr]    = inArgs->decComp[compCtr];
-    strideComp[compCtr] = inArgs->strideComp[compCtr];
-    heightComp[compCtr] = inArgs->heightComp[compCtr];
-    widthComp[compCtr]  = inArgs->widthComp[compCtr];
-  }
+  grainStripeWidth = ((widthComp - 1) | 0x1F) + 1;   // Make next muliptle of 32
 
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0x1F) + 1;
-  grainStripe = new Pel[wdPadded * BLK_32];
+  decSampleOffsetY     = inArgs->decComp[compCtr] + y * strideComp;
+  /* one PRNG value per 32x32 block of samples */
+  uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr] + (y / BLK_32) * (grainStripeWidth / BLK_32);
 
-  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  /* Initialization of grain stripe of 32xwidth size */
+  memset(grainStripe, 0, (grainStripeWidth * BLK_32 * sizeof(Pel)));
+  for (x = 0; x < widthComp; x += BLK_32)
   {
-    for (compCtr = 0; compCtr < numComp; compCtr++)
-    {
-      if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
-      {
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        decSampleOffsetY     = decComp[compCtr];
-        grainStripeWidth = ((widthComp[compCtr] - 1) | 0x1F) + 1;   // Make next muliptle of 32
-
-        /* Loop of 32x32 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += BLK_32)
-        {
-          /* Initialization of grain stripe of 32xwidth size */
-          memset(grainStripe, 0, (grainStripeWidth * BLK_32 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += BLK_32)
-          {
-            /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-            decSampleBlk32    = decSampleOffsetY + x;
-            blockAvg = blockAverage_32x32(decSampleBlk32, strideComp[compCtr], bitDepth);
-
-            /* Selection of the component model */
-            intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+    /* start position offset of decoded sample in x direction */
+    grainStripeOffset = x;
+    decSampleBlk32    = decSampleOffsetY + x;
+    blockAvg = m_blockSum(decSampleBlk32, strideComp, BLK_32) >> (BLK_32_shift + (bitDepth - BIT_DEPTH_8));
 
-            if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
-            {
-              kOffset = (MSB16(*offset_tmp) % 36);
-              kOffset &= 0xFFFC;
+    /* Selection of the component model */
+    intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
-              lOffset = (LSB16(*offset_tmp) % 40);
-              lOffset &= 0xFFF8;
-              scaleFactor = 1 - 2 * BIT0(*offset_tmp);
+    if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
+    {
+      kOffset = (MSB16(*offset_tmp) % 36);
+      kOffset &= 0xFFFC;
 
-              scaleFactor *= inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-              h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-              v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+      lOffset = (LSB16(*offset_tmp) % 40);
+      lOffset &= 0xFFF8;
+      scaleFactor = 1 - 2 * BIT0(*offset_tmp);
 
-              /* 32x32 block grain simulation */
-              simulateGrainBlk32x32(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v);
+      scaleFactor *= inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
+      h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+      v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
 
-            } /* only if average falls in any interval */
+      /* 32x32 block grain simulation */
+      simulateGrainBlk32x32(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
+                            log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v);
+    } /* only if average falls in any interval */
 
-            /* uppdate the PRNG once per 16x16 block of samples */
-            offset_tmp++;
-          } /* End of 32xwidth grain simulation */
+    /* uppdate the PRNG once per 32x32 block of samples */
+    offset_tmp++;
+  } /* End of 32xwidth grain simulation */
 
-          /* deblocking at the vertical edges of 8x8 at 16xwidth*/
-          deblockGrainStripe(grainStripe, widthComp[compCtr], BLK_32, grainStripeWidth, BLK_32);
+  /* deblocking at the vertical edges of 32x32 at 32xwidth*/
+  m_deblockGrainStripe(grainStripe, widthComp, BLK_32, grainStripeWidth, BLK_32);
 
-          blendStripe_32x32(decSampleOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth, BLK_32, bitDepth);
-          decSampleOffsetY += BLK_32 * strideComp[compCtr];
-        } /* end of component loop */
-      }
-    }
-  }
-
-  delete [] grainStripe;
-  return FGS_SUCCESS;
+  m_blendStripe(decSampleOffsetY, grainStripe, widthComp, strideComp, grainStripeWidth, BLK_32, bitDepth);
 }
-
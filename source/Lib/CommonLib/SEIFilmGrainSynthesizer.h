@@ -158,6 +158,7 @@ typedef struct fgsProcessArgs
   GrainSynthesisStruct *       pGrainSynt;
   uint8_t                      bitDepth;
   uint8_t                      blkSize;
+  int                          numThreads;
 } fgsProcessArgs;
 
 class SEIFilmGrainSynthesizer
@@ -173,6 +174,7 @@ private:
   fgsProcessArgs               m_fgsArgs;
   GrainSynthesisStruct        *m_grainSynt;
   uint8_t                      m_fgsBlkSize;
+  int                          m_numThreads;
 
 public:
   uint32_t                     m_poc;
@@ -190,24 +192,32 @@ public:
   void      grainSynthesizeAndBlend (PelStorage* pGrainBuf, bool isIdrPic);
   uint8_t   grainValidateParams     ();
 
+  /* stripes of the picture are synthesized and blended by up to numThreads threads (0: number of cores) */
+  void      setNumThreads           (int numThreads) { m_numThreads = numThreads; }
+
+  void     (*m_deblockGrainStripe)(Pel *grainStripe, uint32_t widthComp, uint32_t heightComp, uint32_t strideComp,
+                                   uint32_t blkSize);
+  void     (*m_blendStripe)(Pel *decSampleOffsetY, Pel *grainStripe, uint32_t widthComp, ptrdiff_t strideSrc,
+                            ptrdiff_t strideGrain, uint32_t blockHeight, uint8_t bitDepth);
+  uint32_t (*m_blockSum)(const Pel *decSampleBlk, ptrdiff_t strideComp, uint32_t blkSize);
+
+#ifdef TARGET_SIMD_X86
+  void initFilmGrainSynthesizerX86();
+  template <X86_VEXT vext>
+  void _initFilmGrainSynthesizerX86();
+#endif
+
 private:
   void            deriveFGSBlkSize    ();
   void            dataBaseGen         ();
   static uint32_t prng                (uint32_t x_r);
-  static uint32_t fgsProcess          (fgsProcessArgs &inArgs);
+  uint32_t        fgsProcess          (fgsProcessArgs &inArgs);
 
   static void     deblockGrainStripe  (Pel *grainStripe, uint32_t widthComp, uint32_t heightComp, uint32_t strideComp,
                                       uint32_t blkSize);
   static void     blendStripe(Pel *decSampleOffsetY, Pel *grainStripe, uint32_t widthComp, ptrdiff_t strideSrc,
                               ptrdiff_t strideGrain, uint32_t blockHeight, uint8_t bitDepth);
-  static void     blendStripe_32x32(Pel *decSampleOffsetY, Pel *grainStripe, uint32_t widthComp, ptrdiff_t strideSrc,
-                                    ptrdiff_t strideGrain, uint32_t blockHeight, uint8_t bitDepth);
-
-  static Pel      blockAverage_8x8(Pel *decSampleBlk8, ptrdiff_t widthComp, uint16_t *pNumSamples, uint8_t ySize,
-                                   uint8_t xSize, uint8_t bitDepth);
-  static uint32_t blockAverage_16x16(Pel *decSampleBlk8, ptrdiff_t widthComp, uint16_t *pNumSamples, uint8_t ySize,
-                                     uint8_t xSize, uint8_t bitDepth);
-  static uint32_t blockAverage_32x32(Pel *decSampleBlk32, ptrdiff_t strideComp, uint8_t bitDepth);
+  static uint32_t blockSum(const Pel *decSampleBlk, ptrdiff_t strideComp, uint32_t blkSize);
 
   static void     simulateGrainBlk8x8 (Pel *grainStripe, uint32_t grainStripeOffsetBlk8, GrainSynthesisStruct *pGrainSynt,
                                       uint32_t width, uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
@@ -219,9 +229,13 @@ private:
                                         uint32_t width, uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
                                         uint32_t lOffset, uint8_t h, uint8_t v);
 
-  static uint32_t fgsSimulationBlending_8x8   (fgsProcessArgs *inArgs);
-  static uint32_t fgsSimulationBlending_16x16 (fgsProcessArgs *inArgs);
-  static uint32_t fgsSimulationBlending_32x32 (fgsProcessArgs *inArgs);
+  /* grain simulation and blending of the stripe of component compCtr starting at line y */
+  void            fgsSimulationBlending_8x8   (const fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t y,
+                                               Pel *grainStripe) const;
+  void            fgsSimulationBlending_16x16 (const fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t y,
+                                               Pel *grainStripe) const;
+  void            fgsSimulationBlending_32x32 (const fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t y,
+                                               Pel *grainStripe) const;
 
 };// END CLASS DEFINITION SEIFilmGrainSynthesizer
 
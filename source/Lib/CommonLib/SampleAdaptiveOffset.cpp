@@ -42,6 +42,7 @@
 #include "CodingStructure.h"
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -266,6 +267,15 @@ void SampleAdaptiveOffset::xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkP
 
   for(int ctuRsAddr=0; ctuRsAddr< cs.pcv->sizeInCtus; ctuRsAddr++)
   {
+    const Position ctuPos((ctuRsAddr % cs.pcv->widthInCtus) * cs.pcv->maxCUWidth,
+                          (ctuRsAddr / cs.pcv->widthInCtus) * cs.pcv->maxCUHeight);
+    if (cs.getCU(ctuPos, ChannelType::LUMA) == nullptr)
+    {
+      // CTU of a subpicture that was not decoded
+      saoBlkParams[ctuRsAddr].reset();
+      continue;
+    }
+
     MergeBlkParams mergeList;
     mergeList.fill(nullptr);
     getMergeList(cs, ctuRsAddr, saoBlkParams, mergeList);
@@ -638,6 +648,7 @@ void SampleAdaptiveOffset::offsetCTU(const UnitArea &area, const CPelUnitBuf &sr
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
 {
+  PROFILE_STAGE(ProfStage::LOOP_FILTER_SAO);
   CHECK(!saoBlkParams, "No parameters present");
 
   xReconstructBlkSAOParams(cs, saoBlkParams);
@@ -0,0 +1,263 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.cpp
+ *  \brief    Run time profiling of the main encoder and decoder stages
+ */
+
+#include "StageProfiler.h"
+
+#if ENABLE_STAGE_PROFILING
+#include <fstream>
+#include <ostream>
+
+StageProfiler g_stageProfiler;
+
+static const struct
+{
+  const char *name;
+  ProfStage   parent;
+} s_stageInfo[size_t(ProfStage::NUM)] = {
+  { "EncCu::compressCtu", ProfStage::NUM },
+  { "EncCu::xCompressCU", ProfStage::ENC_COMPRESS_CTU },
+  { "EncCu::xCheckRDCostInter", ProfStage::ENC_COMPRESS_CU },
+  { "InterSearch::predInterSearch", ProfStage::ENC_CHECK_INTER },
+  { "EncCu::xCheckRDCostUnifiedMerge", ProfStage::ENC_COMPRESS_CU },
+  { "EncCu::xCheckRDCostIntra", ProfStage::ENC_COMPRESS_CU },
+  { "IntraSearch::estIntraPredLumaQT", ProfStage::ENC_CHECK_INTRA },
+  { "EncCu::xCheckModeSplit", ProfStage::ENC_COMPRESS_CU },
+  { "DepQuant::quant", ProfStage::ENC_COMPRESS_CU },
+  { "CABACReader::coding_tree_unit", ProfStage::NUM },
+  { "DecCu::decompressCtu", ProfStage::NUM },
+  { "DeblockingFilter::deblockingFilterPic", ProfStage::NUM },
+  { "SAOProcess", ProfStage::NUM },
+  { "ALFProcess", ProfStage::NUM },
+};
+
+thread_local StageProfiler::ThreadState *StageProfiler::t_threadState = nullptr;
+
+static inline int64_t toNs(const StageProfiler::Clock::duration d)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+const char *StageProfiler::getName(const ProfStage stage)
+{
+  return s_stageInfo[size_t(stage)].name;
+}
+
+ProfStage StageProfiler::getParent(const ProfStage stage)
+{
+  return s_stageInfo[size_t(stage)].parent;
+}
+
+void StageProfiler::open(const std::string &fileName)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_fileName = fileName;
+}
+
+StageProfiler::ThreadState &StageProfiler::xGetThreadState()
+{
+  if (t_threadState == nullptr)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.push_back(std::make_unique<ThreadState>());
+    t_threadState = m_threads.back().get();
+  }
+  return *t_threadState;
+}
+
+void StageProfiler::enter(const ProfStage stage)
+{
+  ThreadState &ts  = xGetThreadState();
+  const auto   now = Clock::now();
+  const size_t idx = size_t(stage);
+
+  if (!ts.stack.empty())
+  {
+    ts.selfTime[size_t(ts.stack.back())].add(toNs(now - ts.lastEvent));
+  }
+  ts.stack.push_back(stage);
+  if (ts.depth[idx]++ == 0)
+  {
+    ts.start[idx] = now;
+  }
+  ts.calls[idx].add(1);
+  ts.lastEvent = now;
+}
+
+void StageProfiler::leave(const ProfStage stage)
+{
+  ThreadState &ts  = xGetThreadState();
+  const auto   now = Clock::now();
+  const size_t idx = size_t(stage);
+
+  CHECK(ts.stack.empty() || ts.stack.back() != stage, "Unbalanced profiling stages");
+  ts.selfTime[idx].add(toNs(now - ts.lastEvent));
+  ts.stack.pop_back();
+  if (--ts.depth[idx] == 0)
+  {
+    ts.totalTime[idx].add(toNs(now - ts.start[idx]));
+  }
+  ts.lastEvent = now;
+}
+
+StageProfiler::Stats StageProfiler::xSnapshot() const
+{
+  Stats stats{};
+  for (const auto &ts: m_threads)
+  {
+    for (size_t i = 0; i < stats.size(); i++)
+    {
+      stats[i].calls += ts->calls[i].get();
+      stats[i].selfTime += ts->selfTime[i].get();
+      stats[i].totalTime += ts->totalTime[i].get();
+    }
+  }
+  return stats;
+}
+
+void StageProfiler::finishPicture(const int poc)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const Stats  stats = xSnapshot();
+  PictureStats pic{ poc, stats };
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    pic.stats[i].calls -= m_lastSnapshot[i].calls;
+    pic.stats[i].selfTime -= m_lastSnapshot[i].selfTime;
+    pic.stats[i].totalTime -= m_lastSnapshot[i].totalTime;
+  }
+  m_lastSnapshot = stats;
+  m_pictures.push_back(pic);
+}
+
+static void writeCsvRows(std::ostream &os, const std::string &poc, const StageProfiler::Stats &stats)
+{
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    const ProfStage stage  = ProfStage(i);
+    const ProfStage parent = StageProfiler::getParent(stage);
+    os << poc << "," << StageProfiler::getName(stage) << ","
+       << (parent == ProfStage::NUM ? "" : StageProfiler::getName(parent)) << "," << stats[i].calls << ","
+       << stats[i].selfTime * 1e-6 << "," << stats[i].totalTime * 1e-6 << "\n";
+  }
+}
+
+void StageProfiler::xWriteCsv(std::ostream &os, const Stats &total) const
+{
+  os << "poc,stage,parent,calls,self_ms,total_ms\n";
+  for (const auto &pic: m_pictures)
+  {
+    writeCsvRows(os, std::to_string(pic.poc), pic.stats);
+  }
+  writeCsvRows(os, "all", total);
+}
+
+static void writeJsonStages(std::ostream &os, const StageProfiler::Stats &stats)
+{
+  os << "[";
+  for (size_t i = 0; i < stats.size(); i++)
+  {
+    const ProfStage stage  = ProfStage(i);
+    const ProfStage parent = StageProfiler::getParent(stage);
+    os << (i ? ",\n" : "\n") << "      { \"stage\": \"" << StageProfiler::getName(stage) << "\", \"parent\": \""
+       << (parent == ProfStage::NUM ? "" : StageProfiler::getName(parent)) << "\", \"calls\": " << stats[i].calls
+       << ", \"self_ms\": " << stats[i].selfTime * 1e-6 << ", \"total_ms\": " << stats[i].totalTime * 1e-6 << " }";
+  }
+  os << " ]";
+}
+
+void StageProfiler::xWriteJson(std::ostream &os, const Stats &total) const
+{
+  os << "{\n  \"pictures\": [";
+  for (size_t i = 0; i < m_pictures.size(); i++)
+  {
+    os << (i ? ",\n" : "\n") << "    { \"poc\": " << m_pictures[i].poc << ", \"stages\": ";
+    writeJsonStages(os, m_pictures[i].stats);
+    os << " }";
+  }
+  os << " ],\n  \"sequence\": { \"stages\": ";
+  writeJsonStages(os, total);
+  os << " }\n}\n";
+}
+
+void StageProfiler::close()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const Stats total    = xSnapshot();
+  int64_t     sumTime  = 0;
+  int64_t     sumCalls = 0;
+  for (const auto &s: total)
+  {
+    sumTime += s.selfTime;
+    sumCalls += s.calls;
+  }
+  if (sumCalls == 0 || m_closed)
+  {
+    return;
+  }
+  m_closed = true;
+
+  msg(INFO, "\nStage profile\n%-44s %10s %10s %10s %8s\n", "Stage", "Calls", "Self [s]", "Total [s]", "Self [%]");
+  for (size_t i = 0; i < total.size(); i++)
+  {
+    int depth = 0;
+    for (ProfStage p = getParent(ProfStage(i)); p != ProfStage::NUM; p = getParent(p))
+    {
+      depth++;
+    }
+    const std::string name = std::string(2 * depth, ' ') + getName(ProfStage(i));
+    msg(INFO, "%-44s %10lld %10.3f %10.3f %8.2f\n", name.c_str(), (long long) total[i].calls,
+        total[i].selfTime * 1e-9, total[i].totalTime * 1e-9, 100.0 * total[i].selfTime / std::max<int64_t>(sumTime, 1));
+  }
+
+  if (!m_fileName.empty())
+  {
+    std::ofstream file(m_fileName);
+    CHECK(!file.is_open(), "Cannot open profiling file " << m_fileName);
+    const bool json = m_fileName.size() >= 5 && m_fileName.compare(m_fileName.size() - 5, 5, ".json") == 0;
+    if (json)
+    {
+      xWriteJson(file, total);
+    }
+    else
+    {
+      xWriteCsv(file, total);
+    }
+  }
+}
+#endif
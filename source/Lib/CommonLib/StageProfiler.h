@@ -0,0 +1,164 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.h
+ *  \brief    Run time profiling of the main encoder and decoder stages
+ *
+ *  The profiler is compiled in with ENABLE_STAGE_PROFILING. Each stage is measured by a scoped timer
+ *  (PROFILE_STAGE), which counts the calls of the stage, its self time (while no nested stage is active) and its
+ *  total time (from the outermost activation, so recursive stages are not counted twice). The self times of all
+ *  stages add up to the profiled run time. The differences to the previous picture are recorded by
+ *  PROFILE_FINISH_PICTURE, and the per-picture and per-sequence breakdowns are written as CSV or JSON when the
+ *  profiler is closed.
+ */
+
+#ifndef __STAGEPROFILER__
+#define __STAGEPROFILER__
+
+#include "CommonDef.h"
+
+#if ENABLE_STAGE_PROFILING
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class ProfStage : uint8_t
+{
+  ENC_COMPRESS_CTU,
+  ENC_COMPRESS_CU,
+  ENC_CHECK_INTER,
+  ENC_INTER_SEARCH,
+  ENC_CHECK_MERGE,
+  ENC_CHECK_INTRA,
+  ENC_INTRA_SEARCH,
+  ENC_CHECK_SPLIT,
+  ENC_DEP_QUANT,
+  DEC_PARSE_CTU,
+  DEC_RECO_CTU,
+  LOOP_FILTER_DBF,
+  LOOP_FILTER_SAO,
+  LOOP_FILTER_ALF,
+  NUM
+};
+
+class StageProfiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct StageStats
+  {
+    int64_t calls     = 0;
+    int64_t selfTime  = 0;   ///< in ns
+    int64_t totalTime = 0;   ///< in ns
+  };
+  using Stats = std::array<StageStats, size_t(ProfStage::NUM)>;
+
+  void open(const std::string &fileName);
+  void close();   ///< prints the sequence totals and writes the profiling file
+  void finishPicture(int poc);
+
+  void enter(ProfStage stage);
+  void leave(ProfStage stage);
+
+  static const char *getName(ProfStage stage);
+  static ProfStage   getParent(ProfStage stage);   ///< ProfStage::NUM for top-level stages
+
+private:
+  struct Counter
+  {
+    std::atomic<int64_t> value{ 0 };
+
+    // only the owning thread writes the counter, other threads read it when taking a snapshot
+    void add(const int64_t v) { value.store(value.load(std::memory_order_relaxed) + v, std::memory_order_relaxed); }
+    int64_t get() const { return value.load(std::memory_order_relaxed); }
+  };
+
+  struct ThreadState
+  {
+    std::vector<ProfStage>                              stack;
+    Clock::time_point                                   lastEvent;
+    std::array<int, size_t(ProfStage::NUM)>               depth{};
+    std::array<Clock::time_point, size_t(ProfStage::NUM)> start;
+    std::array<Counter, size_t(ProfStage::NUM)>           calls;
+    std::array<Counter, size_t(ProfStage::NUM)>           selfTime;
+    std::array<Counter, size_t(ProfStage::NUM)>           totalTime;
+  };
+
+  struct PictureStats
+  {
+    int   poc;
+    Stats stats;
+  };
+
+  ThreadState &xGetThreadState();
+  Stats        xSnapshot() const;
+  void         xWriteCsv(std::ostream &os, const Stats &total) const;
+  void         xWriteJson(std::ostream &os, const Stats &total) const;
+
+  static thread_local ThreadState *t_threadState;
+
+  mutable std::mutex                        m_mutex;
+  std::vector<std::unique_ptr<ThreadState>> m_threads;   ///< kept after the threads end, to keep their times
+  Stats                                     m_lastSnapshot{};
+  std::vector<PictureStats>                 m_pictures;
+  std::string                               m_fileName;
+  bool                                      m_closed = false;   ///< the profile is reported once per process
+};
+
+extern StageProfiler g_stageProfiler;
+
+class StageTimer
+{
+public:
+  StageTimer(const ProfStage stage) : m_stage(stage) { g_stageProfiler.enter(stage); }
+  ~StageTimer() { g_stageProfiler.leave(m_stage); }
+
+private:
+  const ProfStage m_stage;
+};
+
+#define PROFILE_STAGE_CONCAT2(a, b)     a##b
+#define PROFILE_STAGE_CONCAT(a, b)      PROFILE_STAGE_CONCAT2(a, b)
+#define PROFILE_STAGE(stage)            StageTimer PROFILE_STAGE_CONCAT(stageTimer, __LINE__)(stage)
+#define PROFILE_FINISH_PICTURE(poc)     g_stageProfiler.finishPicture(poc)
+#else
+#define PROFILE_STAGE(stage)
+#define PROFILE_FINISH_PICTURE(poc)
+#endif
+
+#endif // __STAGEPROFILER__
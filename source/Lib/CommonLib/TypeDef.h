@@ -131,6 +131,10 @@
 #define ENABLE_TRACING                                    0 // DISABLE by default (enable only when debugging, requires 15% run-time in decoding) -- see documentation in 'doc/DTrace for NextSoftware.pdf'
 #endif
 
+#ifndef ENABLE_STAGE_PROFILING
+#define ENABLE_STAGE_PROFILING                            0 // DISABLE by default, collects the run time of the main encoder and decoder stages, see StageProfiler.h
+#endif
+
 #if ENABLE_TRACING
 #define K0149_BLOCK_STATISTICS                            1 // enables block statistics, which can be analysed with YUView (https://github.com/IENT/YUView)
 #if K0149_BLOCK_STATISTICS
@@ -206,6 +210,8 @@
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_FGS                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for film grain synthesis, no impact on output
+#define ENABLE_SIMD_OPT_RDOQ                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the level candidates of RDOQ, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
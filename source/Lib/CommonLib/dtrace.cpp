@@ -40,6 +40,7 @@
 #include <sstream>
 #include <vector>
 #include <cstdlib>
+#include <algorithm>
 
 #include "CommonDef.h"
 
@@ -47,7 +48,7 @@
 #include "dtrace_next.h"
 
 
-void Channel::update( std::map< CType, int > state )
+void Channel::update( const std::map< CType, int > &state )
 {
   for (std::list<Rule>::iterator rules_iter = rule_list.begin(); rules_iter != rule_list.end(); ++rules_iter)
   {
@@ -60,7 +61,8 @@ void Channel::update( std::map< CType, int > state )
 
     for (Rule::iterator cond_iter = rules_iter->begin(); cond_iter != rules_iter->end(); ++cond_iter)
     {
-      int sVal = state[cond_iter->type];
+      const auto stateIter = state.find( cond_iter->type );
+      int        sVal      = stateIter != state.end() ? stateIter->second : 0;
       if (!cond_iter->eval(cond_iter->rval, sVal))
       {
         probe = false;
@@ -102,12 +104,29 @@ std::vector<std::string> split( const std::string &s, char delim )
   return elems;
 }
 
-CDTrace::CDTrace(const char *filename, vstring channel_names) : copy(false), m_trace_file(nullptr), m_error_code(0)
+void CDTrace::xOpen( const char *filename )
 {
-  if (filename)
+  if( !filename )
+  {
+    return;
+  }
+  if( isBlockStatsBinaryFile( filename ) )
   {
-    m_trace_file = fopen(filename, "w");
+    m_binaryWriter = std::make_shared<BlockStatBinaryWriter>( filename );
+    if( !m_binaryWriter->isOpen() )
+    {
+      m_binaryWriter.reset();
+    }
   }
+  else
+  {
+    m_trace_file = fopen( filename, "w" );
+  }
+}
+
+CDTrace::CDTrace(const char *filename, vstring channel_names) : copy(false), m_trace_file(nullptr), m_error_code(0)
+{
+  xOpen( filename );
 
   int i = 0;
   for (vstring::iterator ci = channel_names.begin(); ci != channel_names.end(); ++ci)
@@ -120,10 +139,7 @@ CDTrace::CDTrace(const char *filename, vstring channel_names) : copy(false), m_t
 CDTrace::CDTrace(const char *filename, const dtrace_channels_t &channels)
   : copy(false), m_trace_file(nullptr), m_error_code(0)
 {
-  if( filename )
-  {
-    m_trace_file = fopen( filename, "w" );
-  }
+  xOpen( filename );
 
   //int i = 0;
   for (dtrace_channels_t::const_iterator ci = channels.begin(); ci != channels.end(); ++ci)
@@ -142,6 +158,7 @@ CDTrace::CDTrace( const CDTrace& other )
   state                = other.state;
   deserializationTable = other.deserializationTable;
   m_error_code         = other.m_error_code;
+  m_binaryWriter       = other.m_binaryWriter;
 }
 
 CDTrace::CDTrace( const std::string& sTracingFile, const std::string& sTracingRule, const dtrace_channels_t& channels )
@@ -165,6 +182,7 @@ void CDTrace::swap( CDTrace& other )
   swap(first.condition_types, second.condition_types);
   swap(first.state, second.state);
   swap(first.deserializationTable, second.deserializationTable);
+  swap(first.m_binaryWriter, second.m_binaryWriter);
 }
 
 CDTrace& CDTrace::operator=( const CDTrace& other )
@@ -329,10 +347,35 @@ std::string CDTrace::getErrMessage()
   return str;
 }
 
+static std::string formatTraceString( const char *format, va_list args )
+{
+  va_list argsCopy;
+  va_copy( argsCopy, args );
+  const int len = vsnprintf( nullptr, 0, format, argsCopy );
+  va_end( argsCopy );
+  std::string str( std::max( len, 0 ), '\0' );
+  if( len > 0 )
+  {
+    vsnprintf( &str[0], len + 1, format, args );
+  }
+  return str;
+}
+
 template< bool bCount>
 void CDTrace::dtrace( int k, const char *format, /*va_list args*/... )
 {
-  if( m_trace_file && chanRules[k].active() )
+  if( m_binaryWriter && chanRules[k].active() )
+  {
+    va_list args;
+    va_start( args, format );
+    m_binaryWriter->pushText( formatTraceString( format, args ) );
+    va_end( args );
+    if( bCount )
+    {
+      chanRules[k].incrementCounter();
+    }
+  }
+  else if( m_trace_file && chanRules[k].active() )
   {
     va_list args;
     va_start ( args, format );
@@ -352,7 +395,21 @@ template void CDTrace::dtrace<false>( int k, const char *format, /*va_list args*
 
 void CDTrace::dtrace_repeat( int k, int i_times, const char *format, /*va_list args*/... )
 {
-  if( m_trace_file && chanRules[k].active() )
+  if( m_binaryWriter && chanRules[k].active() )
+  {
+    va_list args;
+    va_start( args, format );
+    const std::string str = formatTraceString( format, args );
+    va_end( args );
+    std::string repeated;
+    while( i_times > 0 )
+    {
+      i_times--;
+      repeated += str;
+    }
+    m_binaryWriter->pushText( repeated );
+  }
+  else if( m_trace_file && chanRules[k].active() )
   {
     va_list args;
     va_start( args, format );
@@ -370,7 +427,14 @@ void CDTrace::dtrace_repeat( int k, int i_times, const char *format, /*va_list a
 #if K0149_BLOCK_STATISTICS
 void CDTrace::dtrace_header( const char *format, /*va_list args*/... )
 {
-  if( m_trace_file )
+  if( m_binaryWriter )
+  {
+    va_list args;
+    va_start( args, format );
+    m_binaryWriter->pushText( formatTraceString( format, args ) );
+    va_end( args );
+  }
+  else if( m_trace_file )
   {
     va_list args;
     va_start ( args, format );
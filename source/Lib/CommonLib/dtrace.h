@@ -47,10 +47,15 @@
 #include <vector>
 #include <cstdarg>
 #include <cstdint>
+#include <memory>
+#include <initializer_list>
+
+#include "dtrace_blockstatistics_binary.h"
 
 #if K0149_BLOCK_STATISTICS
 class CodingStructure;
 struct Position;
+struct Area;
 #endif
 
 class CDTrace;
@@ -82,7 +87,7 @@ class Channel
     typedef std::vector<Condition> Rule;
 public:
     Channel() : rule_list(), _active(false), _counter(0) {}
-    void update( std::map< CType, int > state );
+    void update( const std::map< CType, int > &state );
     bool active() { return _active; }
     void add( Rule rule );
     void incrementCounter() { _counter++; }
@@ -102,6 +107,7 @@ private:
     bool          copy;
     FILE         *m_trace_file;
     int           m_error_code;
+    std::shared_ptr<BlockStatBinaryWriter> m_binaryWriter;   // set instead of m_trace_file for binary trace files
 
     typedef std::string Key;
     typedef std::vector<std::string> vstring;
@@ -111,6 +117,12 @@ private:
     std::map< CType, int > state;
     std::map< Key, int > deserializationTable;
 
+    void xOpen( const char *filename );
+#if K0149_BLOCK_STATISTICS
+    void xPushBlockStat  ( int k, BlockStatRecordKind kind, int poc, const Area &blk, int scale, const std::string &stat_type, std::initializer_list<int> values );
+    void xPushPolygonStat( int k, BlockStatRecordKind kind, int poc, const std::vector<Position> &polygon, const std::string &stat_type, std::initializer_list<int> values );
+#endif
+
 public:
   CDTrace() : copy(false), m_trace_file(nullptr) {}
   CDTrace(const char *filename, vstring channel_names);
@@ -105,8 +105,63 @@ std::string GetBlockStatisticTypeSpecificInfo(BlockStatistic statistic)
   return std::get<2>(statisticIterator->second);
 }
 
+void CDTrace::xPushBlockStat( int k, BlockStatRecordKind kind, int poc, const Area &blk, int scale, const std::string &stat_type, std::initializer_list<int> values )
+{
+  if( !chanRules[k].active() )
+  {
+    return;
+  }
+  const int statId = m_binaryWriter->getStatId( stat_type );
+  CHECK( statId < 0, "Too many different block statistics for the binary trace format" );
+
+  BlockStatRecord rec;
+  rec.kind      = kind;
+  rec.statId    = uint8_t( statId );
+  rec.numValues = uint8_t( values.size() );
+  rec.numPoints = 0;
+  rec.poc       = poc;
+  rec.x         = blk.x * scale;
+  rec.y         = blk.y * scale;
+  rec.w         = uint16_t( blk.width * scale );
+  rec.h         = uint16_t( blk.height * scale );
+  std::copy( values.begin(), values.end(), rec.values );
+  m_binaryWriter->push( rec );
+}
+
+void CDTrace::xPushPolygonStat( int k, BlockStatRecordKind kind, int poc, const std::vector<Position> &polygon, const std::string &stat_type, std::initializer_list<int> values )
+{
+  if( !chanRules[k].active() )
+  {
+    return;
+  }
+  const int statId = m_binaryWriter->getStatId( stat_type );
+  CHECK( statId < 0, "Too many different block statistics for the binary trace format" );
+  CHECK( 2 * polygon.size() + values.size() > BLOCK_STATS_BINARY_MAX_VALUES, "Too many points. Unsupported polygon!" );
+
+  BlockStatRecord rec;
+  memset( &rec, 0, sizeof( rec ) );
+  rec.kind      = kind;
+  rec.statId    = uint8_t( statId );
+  rec.numValues = uint8_t( 2 * polygon.size() + values.size() );
+  rec.numPoints = uint8_t( polygon.size() );
+  rec.poc       = poc;
+  int *dst      = rec.values;
+  for( const auto &position : polygon )
+  {
+    *dst++ = position.x;
+    *dst++ = position.y;
+  }
+  std::copy( values.begin(), values.end(), dst );
+  m_binaryWriter->push( rec );
+}
+
 void CDTrace::dtrace_block_scalar( int k, const CodingStructure &cs, std::string stat_type, signed value )
 {
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Scalar, cs.picture->poc, cs.area.Y(), 1, stat_type, { value } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   dtrace<false>( k, "BlockStat;%d;%4d;%4d;%2d;%2d;%s;%d\n", cs.picture->poc, cs.area.lx(), cs.area.ly(), cs.area.lwidth(), cs.area.lheight(), stat_type.c_str(), value );
 #else
@@ -117,6 +172,11 @@ void CDTrace::dtrace_block_scalar( int k, const CodingStructure &cs, std::string
 void CDTrace::dtrace_block_scalar( int k, const CodingUnit &cu, std::string stat_type, signed value,  bool isChroma /*= false*/  )
 {
   const CodingStructure& cs = *cu.cs;
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Scalar, cs.picture->poc, isChroma ? cu.Cb() : cu.Y(), isChroma ? 2 : 1, stat_type, { value } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   if(isChroma)
   {
@@ -141,6 +201,11 @@ void CDTrace::dtrace_block_scalar( int k, const CodingUnit &cu, std::string stat
 void CDTrace::dtrace_block_vector( int k, const CodingUnit &cu, std::string stat_type, signed val_x, signed val_y )
 {
   const CodingStructure& cs = *cu.cs;
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Vector, cs.picture->poc, cu.Y(), 1, stat_type, { val_x, val_y } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   dtrace<false>( k, "BlockStat;%d;%4d;%4d;%2d;%2d;%s;%4d;%4d\n", cs.picture->poc, cu.lx(), cu.ly(), cu.lwidth(), cu.lheight(), stat_type.c_str(), val_x, val_y );
 #else
@@ -151,6 +216,11 @@ void CDTrace::dtrace_block_vector( int k, const CodingUnit &cu, std::string stat
 void CDTrace::dtrace_block_scalar( int k, const PredictionUnit &pu, std::string stat_type, signed value, bool isChroma /*= false*/  )
 {
   const CodingStructure& cs = *pu.cs;
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Scalar, cs.picture->poc, isChroma ? pu.Cb() : pu.Y(), isChroma ? 2 : 1, stat_type, { value } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   if(isChroma)
   {
@@ -175,6 +245,12 @@ void CDTrace::dtrace_block_scalar( int k, const PredictionUnit &pu, std::string
 void CDTrace::dtrace_block_vector( int k, const PredictionUnit &pu, std::string stat_type, signed val_x, signed val_y, bool isChroma /*= false*/  )
 {
   const CodingStructure& cs = *pu.cs;
+  if( m_binaryWriter )
+  {
+    const int scale = isChroma ? 2 : 1;
+    xPushBlockStat( k, BlockStatRecordKind::Vector, cs.picture->poc, isChroma ? pu.Cb() : pu.Y(), scale, stat_type, { val_x * scale, val_y * scale } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   if(isChroma)
   {
@@ -199,6 +275,11 @@ void CDTrace::dtrace_block_vector( int k, const PredictionUnit &pu, std::string
 void CDTrace::dtrace_block_scalar(int k, const TransformUnit &tu, std::string stat_type, signed value, bool isChroma /*= false*/  )
 {
   const CodingStructure& cs = *tu.cs;
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Scalar, cs.picture->poc, isChroma ? tu.Cb() : tu.Y(), isChroma ? 2 : 1, stat_type, { value } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   if(isChroma)
   {
@@ -223,6 +304,11 @@ void CDTrace::dtrace_block_scalar(int k, const TransformUnit &tu, std::string st
 void CDTrace::dtrace_block_vector(int k, const TransformUnit &tu, std::string stat_type, signed val_x, signed val_y)
 {
   const CodingStructure& cs = *tu.cs;
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Vector, cs.picture->poc, tu.Y(), 1, stat_type, { val_x, val_y } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   dtrace<false>(k, "BlockStat;%d;%4d;%4d;%2d;%2d;%s;%4d;%4d\n", cs.picture->poc, tu.lx(), tu.ly(), tu.lwidth(), tu.lheight(), stat_type.c_str(), val_x, val_y);
 #else
@@ -233,6 +319,11 @@ void CDTrace::dtrace_block_vector(int k, const TransformUnit &tu, std::string st
 void CDTrace::dtrace_block_affinetf( int k, const PredictionUnit &pu, std::string stat_type, signed val_x0, signed val_y0, signed val_x1, signed val_y1, signed val_x2, signed val_y2 )
 {
   const CodingStructure& cs = *pu.cs;
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::AffineTF, cs.picture->poc, pu.Y(), 1, stat_type, { val_x0, val_y0, val_x1, val_y1, val_x2, val_y2 } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   dtrace<false>( k, "BlockStat;%d;%4d;%4d;%2d;%2d;%s;%4d;%4d;%4d;%4d;%4d;%4d\n",
                  cs.picture->poc, pu.lx(), pu.ly(), pu.lwidth(), pu.lheight(), stat_type.c_str(),
@@ -246,6 +337,11 @@ void CDTrace::dtrace_block_affinetf( int k, const PredictionUnit &pu, std::strin
 
 void CDTrace::dtrace_block_line(int k, const CodingUnit &cu, std::string stat_type, int x0, int y0, int x1, int y1)
 {
+  if( m_binaryWriter )
+  {
+    xPushBlockStat( k, BlockStatRecordKind::Line, cu.slice->getPOC(), cu.Y(), 1, stat_type, { x0, y0, x1, y1 } );
+    return;
+  }
 #if BLOCK_STATS_AS_CSV
   dtrace<false>( k, "BlockStat;%d;%4d;%4d;%2d;%2d;%s;%4d;%4d;%4d;%4d;\n", cu.slice->getPOC(), cu.lx(), cu.ly(), cu.lwidth(), cu.lheight(), stat_type.c_str(), x0, y0, x1, y1);
 #else
@@ -257,6 +353,11 @@ void CDTrace::dtrace_polygon_scalar(int k, int poc, const std::vector<Position>
 {
   assert(polygon.size() >= BLOCK_STATS_POLYGON_MIN_POINTS && "Not enough points to from polygon!");
   assert(polygon.size() <= BLOCK_STATS_POLYGON_MAX_POINTS && "Too many points. Unsupported polygon!");
+  if( m_binaryWriter )
+  {
+    xPushPolygonStat( k, BlockStatRecordKind::PolygonScalar, poc, polygon, stat_type, { value } );
+    return;
+  }
   std::string polygonDescription;
 #if BLOCK_STATS_AS_CSV
   for (auto position : polygon)
@@ -279,6 +380,11 @@ void CDTrace::dtrace_polygon_vector(int k, int poc, const std::vector<Position>
 {
   assert(polygon.size() >= BLOCK_STATS_POLYGON_MIN_POINTS && "Not enough points to from polygon!");
   assert(polygon.size() <= BLOCK_STATS_POLYGON_MAX_POINTS && "Too many points. Unsupported polygon!");
+  if( m_binaryWriter )
+  {
+    xPushPolygonStat( k, BlockStatRecordKind::PolygonVector, poc, polygon, stat_type, { val_x, val_y } );
+    return;
+  }
   std::string polygonDescription;
 #if BLOCK_STATS_AS_CSV
   for (auto position : polygon)
@@ -0,0 +1,418 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     dtrace_blockstatistics_binary.cpp
+ *  \brief    Binary block statistics trace format, ring-buffered writer and reader
+ */
+
+#include "dtrace_blockstatistics_binary.h"
+
+#include <chrono>
+#include <cstring>
+
+static const size_t BLOCK_STATS_BINARY_HEADER_SIZE = 20;
+
+bool isBlockStatsBinaryFile( const std::string &fileName )
+{
+  const size_t extLen = strlen( BLOCK_STATS_BINARY_EXTENSION );
+  return fileName.size() >= extLen && fileName.compare( fileName.size() - extLen, extLen, BLOCK_STATS_BINARY_EXTENSION ) == 0;
+}
+
+static inline void writeLE( uint8_t *dst, uint32_t val, int numBytes )
+{
+  for( int i = 0; i < numBytes; i++ )
+  {
+    dst[i] = uint8_t( val >> ( 8 * i ) );
+  }
+}
+
+static inline uint32_t readLE( const uint8_t *src, int numBytes )
+{
+  uint32_t val = 0;
+  for( int i = 0; i < numBytes; i++ )
+  {
+    val |= uint32_t( src[i] ) << ( 8 * i );
+  }
+  return val;
+}
+
+bool isValidBlockStatRecord( const BlockStatRecord &rec )
+{
+  if( rec.numValues > BLOCK_STATS_BINARY_MAX_VALUES )
+  {
+    return false;
+  }
+  int numValuesUsed = 0;
+  switch( rec.kind )
+  {
+  case BlockStatRecordKind::Text:
+  case BlockStatRecordKind::StatName:
+    return true;
+  case BlockStatRecordKind::Scalar:
+    numValuesUsed = 1;
+    break;
+  case BlockStatRecordKind::Vector:
+    numValuesUsed = 2;
+    break;
+  case BlockStatRecordKind::AffineTF:
+    numValuesUsed = 6;
+    break;
+  case BlockStatRecordKind::Line:
+    numValuesUsed = 4;
+    break;
+  case BlockStatRecordKind::PolygonScalar:
+    numValuesUsed = 2 * rec.numPoints + 1;
+    break;
+  case BlockStatRecordKind::PolygonVector:
+    numValuesUsed = 2 * rec.numPoints + 2;
+    break;
+  default:
+    return false;
+  }
+  return numValuesUsed <= rec.numValues;
+}
+
+std::string formatBlockStatRecord( const BlockStatRecord &rec, const std::string &statName, bool asCsv )
+{
+  char        buf[256];
+  std::string line;
+
+  if( !isValidBlockStatRecord( rec ) || rec.kind == BlockStatRecordKind::Text || rec.kind == BlockStatRecordKind::StatName )
+  {
+    return line;
+  }
+
+  if( rec.kind == BlockStatRecordKind::PolygonScalar || rec.kind == BlockStatRecordKind::PolygonVector )
+  {
+    std::string polygonDescription;
+    for( int i = 0; i < rec.numPoints; i++ )
+    {
+      const int px = rec.values[2 * i];
+      const int py = rec.values[2 * i + 1];
+      polygonDescription += asCsv ? std::to_string( px ) + ";" + std::to_string( py ) + ";"
+                                  : "(" + std::to_string( px ) + ", " + std::to_string( py ) + ")--";
+    }
+    const int32_t *val = rec.values + 2 * rec.numPoints;
+    if( asCsv )
+    {
+      line = "BlockStat;" + std::to_string( rec.poc ) + ";" + polygonDescription + statName;
+      snprintf( buf, sizeof( buf ), rec.kind == BlockStatRecordKind::PolygonScalar ? ";%d\n" : ";%d;%d\n", val[0], val[1] );
+    }
+    else
+    {
+      line = "BlockStat: POC " + std::to_string( rec.poc ) + " @[" + polygonDescription + "] " + statName;
+      snprintf( buf, sizeof( buf ), rec.kind == BlockStatRecordKind::PolygonScalar ? "=%d\n" : "={%4d,%4d}\n", val[0], val[1] );
+    }
+    return line + buf;
+  }
+
+  if( asCsv )
+  {
+    snprintf( buf, sizeof( buf ), "BlockStat;%d;%4d;%4d;%2d;%2d;", rec.poc, rec.x, rec.y, rec.w, rec.h );
+  }
+  else
+  {
+    snprintf( buf, sizeof( buf ), "BlockStat: POC %d @(%4d,%4d) [%2dx%2d] ", rec.poc, rec.x, rec.y, rec.w, rec.h );
+  }
+  line = buf;
+  line += statName;
+
+  const int32_t *v = rec.values;
+  switch( rec.kind )
+  {
+  case BlockStatRecordKind::Scalar:
+    snprintf( buf, sizeof( buf ), asCsv ? ";%d\n" : "=%d\n", v[0] );
+    break;
+  case BlockStatRecordKind::Vector:
+    snprintf( buf, sizeof( buf ), asCsv ? ";%4d;%4d\n" : "={%4d,%4d}\n", v[0], v[1] );
+    break;
+  case BlockStatRecordKind::AffineTF:
+    snprintf( buf, sizeof( buf ), asCsv ? ";%4d;%4d;%4d;%4d;%4d;%4d\n" : "={%4d,%4d,%4d,%4d,%4d,%4d}\n", v[0], v[1], v[2], v[3], v[4], v[5] );
+    break;
+  case BlockStatRecordKind::Line:
+    snprintf( buf, sizeof( buf ), asCsv ? ";%4d;%4d;%4d;%4d;\n" : "={%4d,%4d,%4d,%4d}\n", v[0], v[1], v[2], v[3] );
+    break;
+  default:
+    buf[0] = '\0';
+    break;
+  }
+  return line + buf;
+}
+
+BlockStatBinaryWriter::BlockStatBinaryWriter( const std::string &fileName )
+  : m_file( nullptr )
+  , m_ring( RING_SIZE )
+  , m_head( 0 )
+  , m_tail( 0 )
+  , m_done( false )
+{
+  m_file = fopen( fileName.c_str(), "wb" );
+  if( m_file )
+  {
+    fwrite( BLOCK_STATS_BINARY_MAGIC, 1, strlen( BLOCK_STATS_BINARY_MAGIC ), m_file );
+    m_chunk.reserve( CHUNK_SIZE + BLOCK_STATS_BINARY_HEADER_SIZE + 4 * BLOCK_STATS_BINARY_MAX_VALUES );
+    m_thread = std::thread( &BlockStatBinaryWriter::xWriterLoop, this );
+  }
+}
+
+BlockStatBinaryWriter::~BlockStatBinaryWriter()
+{
+  if( m_file )
+  {
+    m_done.store( true, std::memory_order_release );
+    m_thread.join();
+    fclose( m_file );
+  }
+}
+
+int BlockStatBinaryWriter::getStatId( const std::string &statName )
+{
+  auto it = m_statIds.find( statName );
+  if( it != m_statIds.end() )
+  {
+    return it->second;
+  }
+  const int statId = int( m_statIds.size() );
+  if( statId > UINT8_MAX )
+  {
+    return -1;
+  }
+  m_statIds[statName] = statId;
+  xPushString( BlockStatRecordKind::StatName, statId, statName );
+  return statId;
+}
+
+void BlockStatBinaryWriter::push( const BlockStatRecord &rec )
+{
+  if( !m_file )
+  {
+    return;
+  }
+  const size_t head = m_head.load( std::memory_order_relaxed );
+  while( head - m_tail.load( std::memory_order_acquire ) >= RING_SIZE )
+  {
+    std::this_thread::yield();
+  }
+  m_ring[head & ( RING_SIZE - 1 )] = rec;
+  m_head.store( head + 1, std::memory_order_release );
+}
+
+void BlockStatBinaryWriter::xPushString( BlockStatRecordKind kind, int statId, const std::string &text )
+{
+  if( !m_file )
+  {
+    return;
+  }
+  if( kind == BlockStatRecordKind::Text && text.size() > BLOCK_STATS_BINARY_MAX_TEXT_SIZE )
+  {
+    // the reader rejects longer strings, long trace text is split into several records
+    for( size_t pos = 0; pos < text.size(); pos += BLOCK_STATS_BINARY_MAX_TEXT_SIZE )
+    {
+      xPushString( kind, statId, text.substr( pos, BLOCK_STATS_BINARY_MAX_TEXT_SIZE ) );
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock( m_stringMutex );
+    m_strings.push_back( text );
+  }
+  BlockStatRecord rec;
+  memset( &rec, 0, sizeof( rec ) );
+  rec.kind   = kind;
+  rec.statId = uint8_t( statId );
+  push( rec );
+}
+
+void BlockStatBinaryWriter::xSerialize( const BlockStatRecord &rec )
+{
+  const bool  isString = rec.kind == BlockStatRecordKind::Text || rec.kind == BlockStatRecordKind::StatName;
+  std::string text;
+  if( isString )
+  {
+    std::lock_guard<std::mutex> lock( m_stringMutex );
+    text.swap( m_strings.front() );
+    m_strings.pop_front();
+  }
+
+  uint8_t hdr[BLOCK_STATS_BINARY_HEADER_SIZE];
+  hdr[0] = uint8_t( rec.kind );
+  hdr[1] = rec.statId;
+  hdr[2] = isString ? 0 : rec.numValues;
+  hdr[3] = isString ? 0 : rec.numPoints;
+  writeLE( hdr + 4, isString ? uint32_t( text.size() ) : uint32_t( rec.poc ), 4 );
+  writeLE( hdr + 8, uint32_t( rec.x ), 4 );
+  writeLE( hdr + 12, uint32_t( rec.y ), 4 );
+  writeLE( hdr + 16, rec.w, 2 );
+  writeLE( hdr + 18, rec.h, 2 );
+  m_chunk.insert( m_chunk.end(), hdr, hdr + BLOCK_STATS_BINARY_HEADER_SIZE );
+
+  if( isString )
+  {
+    m_chunk.insert( m_chunk.end(), text.begin(), text.end() );
+    return;
+  }
+  for( int i = 0; i < rec.numValues; i++ )
+  {
+    uint8_t val[4];
+    writeLE( val, uint32_t( rec.values[i] ), 4 );
+    m_chunk.insert( m_chunk.end(), val, val + 4 );
+  }
+}
+
+void BlockStatBinaryWriter::xFlush()
+{
+  if( !m_chunk.empty() )
+  {
+    fwrite( m_chunk.data(), 1, m_chunk.size(), m_file );
+    m_chunk.clear();
+  }
+}
+
+void BlockStatBinaryWriter::xWriterLoop()
+{
+  while( true )
+  {
+    size_t       tail = m_tail.load( std::memory_order_relaxed );
+    const size_t head = m_head.load( std::memory_order_acquire );
+
+    if( tail == head )
+    {
+      // all records pushed before m_done was set are visible once m_done is observed
+      if( m_done.load( std::memory_order_acquire ) && m_head.load( std::memory_order_acquire ) == tail )
+      {
+        break;
+      }
+      xFlush();
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+      continue;
+    }
+
+    while( tail != head )
+    {
+      xSerialize( m_ring[tail & ( RING_SIZE - 1 )] );
+      tail++;
+      if( ( tail & 255 ) == 0 )
+      {
+        m_tail.store( tail, std::memory_order_release );
+      }
+      if( m_chunk.size() >= CHUNK_SIZE )
+      {
+        xFlush();
+      }
+    }
+    m_tail.store( tail, std::memory_order_release );
+  }
+  xFlush();
+}
+
+bool BlockStatBinaryReader::open( const std::string &fileName )
+{
+  close();
+  m_file    = fopen( fileName.c_str(), "rb" );
+  m_corrupt = false;
+  if( !m_file )
+  {
+    return false;
+  }
+  char         magic[8];
+  const size_t magicLen = strlen( BLOCK_STATS_BINARY_MAGIC );
+  if( fread( magic, 1, magicLen, m_file ) != magicLen || memcmp( magic, BLOCK_STATS_BINARY_MAGIC, magicLen ) != 0 )
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void BlockStatBinaryReader::close()
+{
+  if( m_file )
+  {
+    fclose( m_file );
+    m_file = nullptr;
+  }
+}
+
+bool BlockStatBinaryReader::read( BlockStatRecord &rec, std::string &text )
+{
+  uint8_t hdr[BLOCK_STATS_BINARY_HEADER_SIZE];
+  if( !m_file )
+  {
+    return false;
+  }
+  const size_t hdrSize = fread( hdr, 1, BLOCK_STATS_BINARY_HEADER_SIZE, m_file );
+  if( hdrSize != BLOCK_STATS_BINARY_HEADER_SIZE )
+  {
+    m_corrupt = hdrSize != 0;
+    return false;
+  }
+  rec.kind      = BlockStatRecordKind( hdr[0] );
+  rec.statId    = hdr[1];
+  rec.numValues = hdr[2];
+  rec.numPoints = hdr[3];
+  rec.poc       = int32_t( readLE( hdr + 4, 4 ) );
+  rec.x         = int32_t( readLE( hdr + 8, 4 ) );
+  rec.y         = int32_t( readLE( hdr + 12, 4 ) );
+  rec.w         = uint16_t( readLE( hdr + 16, 2 ) );
+  rec.h         = uint16_t( readLE( hdr + 18, 2 ) );
+  text.clear();
+
+  if( !isValidBlockStatRecord( rec ) )
+  {
+    m_corrupt = true;
+    return false;
+  }
+  if( rec.kind == BlockStatRecordKind::Text || rec.kind == BlockStatRecordKind::StatName )
+  {
+    const uint32_t textSize = uint32_t( rec.poc );
+    if( textSize > BLOCK_STATS_BINARY_MAX_TEXT_SIZE )
+    {
+      m_corrupt = true;
+      return false;
+    }
+    text.resize( textSize );
+    m_corrupt = !text.empty() && fread( &text[0], 1, text.size(), m_file ) != text.size();
+    return !m_corrupt;
+  }
+  for( int i = 0; i < rec.numValues; i++ )
+  {
+    uint8_t val[4];
+    if( fread( val, 1, 4, m_file ) != 4 )
+    {
+      m_corrupt = true;
+      return false;
+    }
+    rec.values[i] = int32_t( readLE( val, 4 ) );
+  }
+  return true;
+}
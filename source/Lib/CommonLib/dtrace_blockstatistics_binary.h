@@ -0,0 +1,153 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     dtrace_blockstatistics_binary.h
+ *  \brief    Binary block statistics trace format, ring-buffered writer and reader
+ */
+
+#ifndef _DTRACE_BLOCKSTATISTICS_BINARY_H_
+#define _DTRACE_BLOCKSTATISTICS_BINARY_H_
+
+#include <stdio.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// A trace file whose name ends with this extension receives the block statistics in the binary format
+// instead of text. Use the BlockStatsConvert tool to convert it back to the text format.
+#define BLOCK_STATS_BINARY_EXTENSION      ".vtmbmsbin"
+
+// File layout: the magic string, followed by records. Each record consists of a fixed 20 byte header
+// (kind, statId, numValues, numPoints as uint8, poc/x/y as int32, w/h as uint16) and numValues int32
+// values, all in little endian byte order. Text and StatName records carry their string length in the
+// poc field, followed by the characters. Polygon records store the point coordinates (x0,y0,x1,y1,...)
+// in front of the statistic values.
+#define BLOCK_STATS_BINARY_MAGIC          "VTMBMSB1"
+#define BLOCK_STATS_BINARY_MAX_VALUES     12
+#define BLOCK_STATS_BINARY_MAX_TEXT_SIZE  ( 1 << 20 )
+
+enum class BlockStatRecordKind : uint8_t
+{
+  Text,            // verbatim trace text (header lines, other channels)
+  StatName,        // assigns a name to statId
+  Scalar,
+  Vector,
+  AffineTF,
+  Line,
+  PolygonScalar,
+  PolygonVector,
+  NumKinds
+};
+
+struct BlockStatRecord
+{
+  BlockStatRecordKind kind;
+  uint8_t             statId;
+  uint8_t             numValues;
+  uint8_t             numPoints;
+  int32_t             poc;
+  int32_t             x;
+  int32_t             y;
+  uint16_t            w;
+  uint16_t            h;
+  int32_t             values[BLOCK_STATS_BINARY_MAX_VALUES];
+};
+
+bool isBlockStatsBinaryFile( const std::string &fileName );
+
+// checks that a statistic record carries all values its kind refers to
+bool isValidBlockStatRecord( const BlockStatRecord &rec );
+
+// formats a statistic record exactly like the text output of CDTrace, invalid records give an empty string
+std::string formatBlockStatRecord( const BlockStatRecord &rec, const std::string &statName, bool asCsv );
+
+// Single producer writer: records are stored into a lock-free ring buffer by the tracing thread and
+// serialised to the file in large chunks by a background thread. The producer waits for free space
+// instead of dropping records.
+class BlockStatBinaryWriter
+{
+public:
+  BlockStatBinaryWriter( const std::string &fileName );
+  ~BlockStatBinaryWriter();
+
+  bool isOpen() const { return m_file != nullptr; }
+  int  getStatId( const std::string &statName );
+  void push( const BlockStatRecord &rec );
+  void pushText( const std::string &text ) { xPushString( BlockStatRecordKind::Text, 0, text ); }
+
+private:
+  void xPushString( BlockStatRecordKind kind, int statId, const std::string &text );
+  void xWriterLoop();
+  void xSerialize( const BlockStatRecord &rec );
+  void xFlush();
+
+  static constexpr size_t RING_SIZE  = 1 << 14;
+  static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+  FILE                                    *m_file;
+  std::vector<BlockStatRecord>             m_ring;
+  std::atomic<size_t>                      m_head;   // next slot written by the producer
+  std::atomic<size_t>                      m_tail;   // next slot read by the writer thread
+  std::atomic<bool>                        m_done;
+  std::mutex                               m_stringMutex;
+  std::deque<std::string>                  m_strings;
+  std::unordered_map<std::string, int>     m_statIds;
+  std::vector<uint8_t>                     m_chunk;
+  std::thread                              m_thread;
+};
+
+class BlockStatBinaryReader
+{
+public:
+  BlockStatBinaryReader() : m_file( nullptr ), m_corrupt( false ) {}
+  ~BlockStatBinaryReader() { close(); }
+
+  bool open( const std::string &fileName );
+  void close();
+  // reads the next record, text and statistic name payloads are returned in text. Returns false at the end
+  // of the file and for truncated or invalid records, which also set isCorrupt().
+  bool read( BlockStatRecord &rec, std::string &text );
+  bool isCorrupt() const { return m_corrupt; }
+
+private:
+  FILE *m_file;
+  bool  m_corrupt;
+};
+
+#endif // _DTRACE_BLOCKSTATISTICS_BINARY_H_
@@ -1683,6 +1683,199 @@ template<X86_VEXT vext> static void simdFilter7x7Blk(AlfClassifier** classifier,
   }
 }
 #endif
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// CC-ALF: 8 (or 16 with AVX2) chroma samples per iteration, luma samples subsampled by 2 horizontally for 4:2:0/4:2:2
+template<X86_VEXT vext>
+static void simdFilterBlkCcAlf(const PelBuf& dstBuf, const CPelUnitBuf& recSrc, const Area& blkDst, const Area& blkSrc,
+                               const ComponentID compId, const AlfCoeff* filterCoeff, const ClpRngs& clpRngs,
+                               CodingStructure& cs, int vbCTUHeight, int vbPos)
+{
+  CHECK(1 << floorLog2(vbCTUHeight) != vbCTUHeight, "Not a power of 2");
+  CHECK(!isChroma(compId), "Must be chroma");
+
+  const ChromaFormat chromaFormat = cs.slice->getSPS()->getChromaFormatIdc();
+  const int          scaleX       = getComponentScaleX(compId, chromaFormat);
+  const int          scaleY       = getComponentScaleY(compId, chromaFormat);
+
+  const int width  = blkDst.width;
+  const int height = blkDst.height;
+
+  CHECK(blkDst.y % 4, "Wrong startHeight in filtering");
+  CHECK(blkDst.x % 4, "Wrong startWidth in filtering");
+  CHECK(height % 4, "Wrong endHeight in filtering");
+  CHECK(width % 4, "Wrong endWidth in filtering");
+
+  const CPelBuf   srcBuf       = recSrc.get(COMPONENT_Y);
+  const ptrdiff_t lumaStride   = srcBuf.stride;
+  const ptrdiff_t chromaStride = dstBuf.stride;
+
+  const Pel *lumaPtr   = srcBuf.buf + blkSrc.y * lumaStride + blkSrc.x;
+  Pel       *chromaPtr = dstBuf.buf + blkDst.y * chromaStride + blkDst.x;
+
+  constexpr int SHIFT  = AdaptiveLoopFilter::COEFF_SCALE_BITS;
+  const ClpRng &clpRng = clpRngs.comp[compId];
+  const int     offset = 1 << clpRng.bd >> 1;
+
+  // coefficient pairs for _mm_madd_epi16: (above, left), (right, below-left), (below, below-right), (below2, 0)
+  auto pair = [](const AlfCoeff c0, const AlfCoeff c1) { return int32_t(uint16_t(c0) | uint32_t(uint16_t(c1)) << 16); };
+
+  const int32_t coeff01 = pair(filterCoeff[0], filterCoeff[1]);
+  const int32_t coeff23 = pair(filterCoeff[2], filterCoeff[3]);
+  const int32_t coeff45 = pair(filterCoeff[4], filterCoeff[5]);
+  const int32_t coeff6  = pair(filterCoeff[6], 0);
+
+  for (int i = 0; i < height; i++)
+  {
+    ptrdiff_t offset1 = lumaStride;
+    ptrdiff_t offset2 = -lumaStride;
+    ptrdiff_t offset3 = 2 * lumaStride;
+
+    const int pos = ((blkDst.y + i) << scaleY) & (vbCTUHeight - 1);
+    if (!(scaleY == 0 && (pos == vbPos || pos == vbPos + 1)))
+    {
+      if (pos == (vbPos - 2) || pos == (vbPos + 1))
+      {
+        offset3 = offset1;
+      }
+      else if (pos == (vbPos - 1) || pos == vbPos)
+      {
+        offset1 = 0;
+        offset2 = 0;
+        offset3 = 0;
+      }
+
+      const Pel *srcCross = lumaPtr + ((ptrdiff_t) i << scaleY) * lumaStride;
+      Pel       *srcSelf  = chromaPtr + i * chromaStride;
+
+      int j = 0;
+#ifdef USE_AVX2
+      if (vext >= AVX2)
+      {
+        const __m256i mmCoeff01 = _mm256_set1_epi32(coeff01);
+        const __m256i mmCoeff23 = _mm256_set1_epi32(coeff23);
+        const __m256i mmCoeff45 = _mm256_set1_epi32(coeff45);
+        const __m256i mmCoeff6  = _mm256_set1_epi32(coeff6);
+        const __m256i mmRound   = _mm256_set1_epi32(1 << (SHIFT - 1));
+        const __m256i mmSumMin  = _mm256_set1_epi32(clpRng.min - offset);
+        const __m256i mmSumMax  = _mm256_set1_epi32(clpRng.max - offset);
+        const __m256i mmMin     = _mm256_set1_epi16(clpRng.min);
+        const __m256i mmMax     = _mm256_set1_epi16(clpRng.max);
+
+        // 16 luma samples at the chroma sample positions
+        auto load = [&](const Pel *p) {
+          if (scaleX == 0)
+          {
+            return _mm256_loadu_si256((const __m256i *) p);
+          }
+          const __m256i a = _mm256_loadu_si256((const __m256i *) p);
+          const __m256i b = _mm256_loadu_si256((const __m256i *) (p + 16));
+          const __m256i e = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16),
+                                               _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16));
+          return _mm256_permute4x64_epi64(e, 0xd8);
+        };
+
+        for (; j + 16 <= width; j += 16)
+        {
+          const Pel    *p    = srcCross + (j << scaleX);
+          const __m256i cur  = load(p);
+          const __m256i d0   = _mm256_sub_epi16(load(p + offset2), cur);
+          const __m256i d1   = _mm256_sub_epi16(load(p - 1), cur);
+          const __m256i d2   = _mm256_sub_epi16(load(p + 1), cur);
+          const __m256i d3   = _mm256_sub_epi16(load(p + offset1 - 1), cur);
+          const __m256i d4   = _mm256_sub_epi16(load(p + offset1), cur);
+          const __m256i d5   = _mm256_sub_epi16(load(p + offset1 + 1), cur);
+          const __m256i d6   = _mm256_sub_epi16(load(p + offset3), cur);
+          const __m256i zero = _mm256_setzero_si256();
+
+          __m256i sumLo = _mm256_madd_epi16(_mm256_unpacklo_epi16(d0, d1), mmCoeff01);
+          __m256i sumHi = _mm256_madd_epi16(_mm256_unpackhi_epi16(d0, d1), mmCoeff01);
+          sumLo = _mm256_add_epi32(sumLo, _mm256_madd_epi16(_mm256_unpacklo_epi16(d2, d3), mmCoeff23));
+          sumHi = _mm256_add_epi32(sumHi, _mm256_madd_epi16(_mm256_unpackhi_epi16(d2, d3), mmCoeff23));
+          sumLo = _mm256_add_epi32(sumLo, _mm256_madd_epi16(_mm256_unpacklo_epi16(d4, d5), mmCoeff45));
+          sumHi = _mm256_add_epi32(sumHi, _mm256_madd_epi16(_mm256_unpackhi_epi16(d4, d5), mmCoeff45));
+          sumLo = _mm256_add_epi32(sumLo, _mm256_madd_epi16(_mm256_unpacklo_epi16(d6, zero), mmCoeff6));
+          sumHi = _mm256_add_epi32(sumHi, _mm256_madd_epi16(_mm256_unpackhi_epi16(d6, zero), mmCoeff6));
+
+          sumLo = _mm256_srai_epi32(_mm256_add_epi32(sumLo, mmRound), SHIFT);
+          sumHi = _mm256_srai_epi32(_mm256_add_epi32(sumHi, mmRound), SHIFT);
+          sumLo = _mm256_min_epi32(_mm256_max_epi32(sumLo, mmSumMin), mmSumMax);
+          sumHi = _mm256_min_epi32(_mm256_max_epi32(sumHi, mmSumMin), mmSumMax);
+
+          // unpacklo/hi and packs operate within lanes, so the sample order is restored here
+          __m256i sum = _mm256_packs_epi32(sumLo, sumHi);
+          sum         = _mm256_add_epi16(sum, _mm256_loadu_si256((const __m256i *) (srcSelf + j)));
+          sum         = _mm256_min_epi16(_mm256_max_epi16(sum, mmMin), mmMax);
+          _mm256_storeu_si256((__m256i *) (srcSelf + j), sum);
+        }
+      }
+#endif
+      const __m128i mmCoeff01 = _mm_set1_epi32(coeff01);
+      const __m128i mmCoeff23 = _mm_set1_epi32(coeff23);
+      const __m128i mmCoeff45 = _mm_set1_epi32(coeff45);
+      const __m128i mmCoeff6  = _mm_set1_epi32(coeff6);
+      const __m128i mmRound   = _mm_set1_epi32(1 << (SHIFT - 1));
+      const __m128i mmSumMin  = _mm_set1_epi32(clpRng.min - offset);
+      const __m128i mmSumMax  = _mm_set1_epi32(clpRng.max - offset);
+      const __m128i mmMin     = _mm_set1_epi16(clpRng.min);
+      const __m128i mmMax     = _mm_set1_epi16(clpRng.max);
+
+      // 8 luma samples at the chroma sample positions
+      auto load = [&](const Pel *p) {
+        if (scaleX == 0)
+        {
+          return _mm_loadu_si128((const __m128i *) p);
+        }
+        const __m128i a = _mm_loadu_si128((const __m128i *) p);
+        const __m128i b = _mm_loadu_si128((const __m128i *) (p + 8));
+        return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+      };
+
+      for (; j < width; j += 8)
+      {
+        const Pel    *p    = srcCross + (j << scaleX);
+        const __m128i cur  = load(p);
+        const __m128i d0   = _mm_sub_epi16(load(p + offset2), cur);
+        const __m128i d1   = _mm_sub_epi16(load(p - 1), cur);
+        const __m128i d2   = _mm_sub_epi16(load(p + 1), cur);
+        const __m128i d3   = _mm_sub_epi16(load(p + offset1 - 1), cur);
+        const __m128i d4   = _mm_sub_epi16(load(p + offset1), cur);
+        const __m128i d5   = _mm_sub_epi16(load(p + offset1 + 1), cur);
+        const __m128i d6   = _mm_sub_epi16(load(p + offset3), cur);
+        const __m128i zero = _mm_setzero_si128();
+
+        __m128i sumLo = _mm_madd_epi16(_mm_unpacklo_epi16(d0, d1), mmCoeff01);
+        __m128i sumHi = _mm_madd_epi16(_mm_unpackhi_epi16(d0, d1), mmCoeff01);
+        sumLo = _mm_add_epi32(sumLo, _mm_madd_epi16(_mm_unpacklo_epi16(d2, d3), mmCoeff23));
+        sumHi = _mm_add_epi32(sumHi, _mm_madd_epi16(_mm_unpackhi_epi16(d2, d3), mmCoeff23));
+        sumLo = _mm_add_epi32(sumLo, _mm_madd_epi16(_mm_unpacklo_epi16(d4, d5), mmCoeff45));
+        sumHi = _mm_add_epi32(sumHi, _mm_madd_epi16(_mm_unpackhi_epi16(d4, d5), mmCoeff45));
+        sumLo = _mm_add_epi32(sumLo, _mm_madd_epi16(_mm_unpacklo_epi16(d6, zero), mmCoeff6));
+        sumHi = _mm_add_epi32(sumHi, _mm_madd_epi16(_mm_unpackhi_epi16(d6, zero), mmCoeff6));
+
+        sumLo = _mm_srai_epi32(_mm_add_epi32(sumLo, mmRound), SHIFT);
+        sumHi = _mm_srai_epi32(_mm_add_epi32(sumHi, mmRound), SHIFT);
+        sumLo = _mm_min_epi32(_mm_max_epi32(sumLo, mmSumMin), mmSumMax);
+        sumHi = _mm_min_epi32(_mm_max_epi32(sumHi, mmSumMin), mmSumMax);
+
+        __m128i sum = _mm_packs_epi32(sumLo, sumHi);
+        if (j + 8 <= width)
+        {
+          sum = _mm_add_epi16(sum, _mm_loadu_si128((const __m128i *) (srcSelf + j)));
+          sum = _mm_min_epi16(_mm_max_epi16(sum, mmMin), mmMax);
+          _mm_storeu_si128((__m128i *) (srcSelf + j), sum);
+        }
+        else
+        {
+          sum = _mm_add_epi16(sum, _mm_loadl_epi64((const __m128i *) (srcSelf + j)));
+          sum = _mm_min_epi16(_mm_max_epi16(sum, mmMin), mmMax);
+          _mm_storel_epi64((__m128i *) (srcSelf + j), sum);
+        }
+      }
+    }
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
 {
@@ -1707,6 +1900,7 @@ void AdaptiveLoopFilter::_initAdaptiveLoopFilterX86()
   m_deriveClassificationBlk = simdDeriveClassificationBlk<vext>;
   m_filter5x5Blk = simdFilter5x5Blk<vext>;
   m_filter7x7Blk = simdFilter7x7Blk<vext>;
+  m_filterCcAlf  = simdFilterBlkCcAlf<vext>;
 #endif
 }
 
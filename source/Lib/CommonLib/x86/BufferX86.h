@@ -172,7 +172,7 @@ template<X86_VEXT vext> void paddingSimd(Pel *dst, ptrdiff_t stride, int width,
 
     dst -= 1;
 
-    for (size_t i = 0; i < extWidth - 8; i++)
+    for (size_t i = 0; i < extWidth - 8; i += 8)
     {
       __m128i top = _mm_loadu_si128((const __m128i *) (dst + i));
       _mm_storeu_si128((__m128i *) (dst - stride + i), top);
@@ -182,7 +182,7 @@ template<X86_VEXT vext> void paddingSimd(Pel *dst, ptrdiff_t stride, int width,
 
     dst += height * stride;
 
-    for (size_t i = 0; i < extWidth - 8; i++)
+    for (size_t i = 0; i < extWidth - 8; i += 8)
     {
       __m128i bottom = _mm_loadu_si128((const __m128i *) (dst - stride + i));
       _mm_storeu_si128((__m128i *) (dst + i), bottom);
@@ -204,7 +204,7 @@ template<X86_VEXT vext> void paddingSimd(Pel *dst, ptrdiff_t stride, int width,
 
     dst -= 2;
 
-    for (size_t i = 0; i < extWidth - 8; i++)
+    for (size_t i = 0; i < extWidth - 8; i += 8)
     {
       __m128i top = _mm_loadu_si128((const __m128i *) (dst + i));
       _mm_storeu_si128((__m128i *) (dst - 2 * stride + i), top);
@@ -216,7 +216,7 @@ template<X86_VEXT vext> void paddingSimd(Pel *dst, ptrdiff_t stride, int width,
 
     dst += height * stride;
 
-    for (size_t i = 0; i < extWidth - 8; i++)
+    for (size_t i = 0; i < extWidth - 8; i += 8)
     {
       __m128i bottom = _mm_loadu_si128((const __m128i *) (dst - stride + i));
       _mm_storeu_si128((__m128i *) (dst + i), bottom);
@@ -968,6 +968,424 @@ void roundIntVector_SIMD(int* v, int size, unsigned int nShift, const int dmvLim
   }
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+#ifdef USE_AVX2
+// LUT entries are gathered as aligned pairs, so the LUT must hold an even number of entries (1 << bitDepth)
+template<X86_VEXT vext>
+void rspSignal_AVX2(Pel *ptr, ptrdiff_t stride, int width, int height, const Pel *lut)
+{
+  const __m256i mask = _mm256_set1_epi32(0xffff);
+  const __m256i one  = _mm256_set1_epi32(1);
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+      __m256i idx  = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) (ptr + x)));
+      __m256i pair = _mm256_i32gather_epi32((const int *) lut, _mm256_srli_epi32(idx, 1), 4);
+      __m256i val  = _mm256_srlv_epi32(pair, _mm256_slli_epi32(_mm256_and_si256(idx, one), 4));
+      val          = _mm256_and_si256(val, mask);
+      _mm_storeu_si128((__m128i *) (ptr + x),
+                       _mm_packus_epi32(_mm256_castsi256_si128(val), _mm256_extracti128_si256(val, 1)));
+    }
+    for (; x < width; x++)
+    {
+      ptr[x] = lut[ptr[x]];
+    }
+    ptr += stride;
+  }
+}
+#endif
+
+// the division by the chroma scale is carried out in double precision, which is exact for 16-bit residuals
+template<X86_VEXT vext>
+void fwdScaleSignal_SSE(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip)
+{
+  const __m128i vround = _mm_set1_epi32(scale >> 1);
+  const __m128i vmin   = _mm_set1_epi32(-maxAbsClip);
+  const __m128i vmax   = _mm_set1_epi32(maxAbsClip);
+  const __m128i vmask  = _mm_set1_epi32(0xffff);
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if (vext >= AVX2)
+    {
+      const __m256d vscale = _mm256_set1_pd(scale);
+
+      for (; x + 8 <= width; x += 8)
+      {
+        __m128i src = _mm_loadu_si128((const __m128i *) (ptr + x));
+        __m128i lo  = _mm_cvtepi16_epi32(src);
+        __m128i hi  = _mm_cvtepi16_epi32(_mm_srli_si128(src, 8));
+
+        __m128i numLo = _mm_add_epi32(_mm_slli_epi32(_mm_abs_epi32(lo), CSCALE_FP_PREC), vround);
+        __m128i numHi = _mm_add_epi32(_mm_slli_epi32(_mm_abs_epi32(hi), CSCALE_FP_PREC), vround);
+        __m128i quoLo = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(numLo), vscale));
+        __m128i quoHi = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(numHi), vscale));
+
+        quoLo = _mm_min_epi32(_mm_max_epi32(_mm_sign_epi32(quoLo, lo), vmin), vmax);
+        quoHi = _mm_min_epi32(_mm_max_epi32(_mm_sign_epi32(quoHi, hi), vmin), vmax);
+        _mm_storeu_si128((__m128i *) (ptr + x),
+                         _mm_packus_epi32(_mm_and_si128(quoLo, vmask), _mm_and_si128(quoHi, vmask)));
+      }
+    }
+#endif
+    const __m128d vscale = _mm_set1_pd(scale);
+
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i src = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) (ptr + x)));
+      __m128i num = _mm_add_epi32(_mm_slli_epi32(_mm_abs_epi32(src), CSCALE_FP_PREC), vround);
+
+      __m128i quoLo = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(num), vscale));
+      __m128i quoHi = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(num, 8)), vscale));
+      __m128i quo   = _mm_unpacklo_epi64(quoLo, quoHi);
+
+      quo = _mm_min_epi32(_mm_max_epi32(_mm_sign_epi32(quo, src), vmin), vmax);
+      _mm_storel_epi64((__m128i *) (ptr + x), _mm_packus_epi32(_mm_and_si128(quo, vmask), vmask));
+    }
+    for (; x < width; x++)
+    {
+      const int sign   = sgn2(ptr[x]);
+      const int absval = sign * ptr[x];
+      ptr[x] = (Pel) Clip3(-maxAbsClip, maxAbsClip, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
+    }
+    ptr += stride;
+  }
+}
+
+template<X86_VEXT vext>
+void invScaleSignal_SSE(Pel *ptr, ptrdiff_t stride, int width, int height, int scale, int maxAbsClip)
+{
+  const Pel minVal = (Pel) (-maxAbsClip - 1);
+  const Pel maxVal = (Pel) maxAbsClip;
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if (vext >= AVX2)
+    {
+      const __m256i vscale = _mm256_set1_epi32(scale);
+      const __m256i vround = _mm256_set1_epi32(1 << (CSCALE_FP_PREC - 1));
+      const __m128i vmin   = _mm_set1_epi16(minVal);
+      const __m128i vmax   = _mm_set1_epi16(maxVal);
+
+      for (; x + 8 <= width; x += 8)
+      {
+        __m128i src = _mm_loadu_si128((const __m128i *) (ptr + x));
+        src         = _mm_min_epi16(_mm_max_epi16(src, vmin), vmax);
+
+        __m256i val = _mm256_cvtepi16_epi32(src);
+        __m256i res = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_abs_epi32(val), vscale), vround);
+        res         = _mm256_sign_epi32(_mm256_srai_epi32(res, CSCALE_FP_PREC), val);
+        _mm_storeu_si128((__m128i *) (ptr + x),
+                         _mm_packs_epi32(_mm256_castsi256_si128(res), _mm256_extracti128_si256(res, 1)));
+      }
+    }
+#endif
+    const __m128i vscale = _mm_set1_epi32(scale);
+    const __m128i vround = _mm_set1_epi32(1 << (CSCALE_FP_PREC - 1));
+    const __m128i vmin   = _mm_set1_epi16(minVal);
+    const __m128i vmax   = _mm_set1_epi16(maxVal);
+
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i src = _mm_loadl_epi64((const __m128i *) (ptr + x));
+      src         = _mm_min_epi16(_mm_max_epi16(src, vmin), vmax);
+
+      __m128i val = _mm_cvtepi16_epi32(src);
+      __m128i res = _mm_add_epi32(_mm_mullo_epi32(_mm_abs_epi32(val), vscale), vround);
+      res         = _mm_sign_epi32(_mm_srai_epi32(res, CSCALE_FP_PREC), val);
+      _mm_storel_epi64((__m128i *) (ptr + x), _mm_packs_epi32(res, res));
+    }
+    for (; x < width; x++)
+    {
+      const Pel src    = Clip3(minVal, maxVal, ptr[x]);
+      const int sign   = sgn2(src);
+      const int absval = sign * src;
+      ptr[x]           = (Pel) Clip3<int>(-32768, 32767,
+                                          sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC));
+    }
+    ptr += stride;
+  }
+}
+
+// the per-column filter windows are padded to 8 or 16 taps, four output columns are reduced at a time
+template<X86_VEXT vext>
+void sampleRateConvHor_SSE(const Pel *src, ptrdiff_t srcStride, int *dst, ptrdiff_t dstStride, int width, int height,
+                           const int *xStart, const TFilterCoeff *coeff, int numTaps)
+{
+  if (numTaps != 8 && numTaps != 16)
+  {
+    sampleRateConvHorCore(src, srcStride, dst, dstStride, width, height, xStart, coeff, numTaps);
+    return;
+  }
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i sum[4];
+      for (int i = 0; i < 4; i++)
+      {
+        const Pel          *s = src + xStart[x + i];
+        const TFilterCoeff *f = coeff + (x + i) * numTaps;
+        if (numTaps == 8)
+        {
+          sum[i] = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) s), _mm_loadu_si128((const __m128i *) f));
+        }
+#ifdef USE_AVX2
+        else if (vext >= AVX2)
+        {
+          __m256i prod = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) s),
+                                           _mm256_loadu_si256((const __m256i *) f));
+          sum[i] = _mm_add_epi32(_mm256_castsi256_si128(prod), _mm256_extracti128_si256(prod, 1));
+        }
+#endif
+        else
+        {
+          sum[i] = _mm_add_epi32(
+            _mm_madd_epi16(_mm_loadu_si128((const __m128i *) s), _mm_loadu_si128((const __m128i *) f)),
+            _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s + 8)), _mm_loadu_si128((const __m128i *) (f + 8))));
+        }
+      }
+      _mm_storeu_si128((__m128i *) (dst + x),
+                       _mm_hadd_epi32(_mm_hadd_epi32(sum[0], sum[1]), _mm_hadd_epi32(sum[2], sum[3])));
+    }
+    for (; x < width; x++)
+    {
+      const Pel          *s   = src + xStart[x];
+      const TFilterCoeff *f   = coeff + x * numTaps;
+      int                 sum = 0;
+      for (int k = 0; k < numTaps; k++)
+      {
+        sum += f[k] * s[k];
+      }
+      dst[x] = sum;
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext>
+void sampleRateConvVer_SSE(const int *src, ptrdiff_t srcStride, Pel *dst, int width, const int *rowIdx,
+                           const TFilterCoeff *coeff, int numTaps, int shift, int maxVal)
+{
+  CHECK(numTaps > 12, "Unsupported number of filter taps");
+
+  const int *srcRow[12];
+  for (int k = 0; k < numTaps; k++)
+  {
+    srcRow[k] = src + rowIdx[k] * srcStride;
+  }
+  const __m128i vshift = _mm_cvtsi32_si128(shift);
+
+  int x = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    const __m256i vround = _mm256_set1_epi32(1 << (shift - 1));
+    const __m256i vmax   = _mm256_set1_epi32(maxVal);
+
+    for (; x + 8 <= width; x += 8)
+    {
+      __m256i sum = vround;
+      for (int k = 0; k < numTaps; k++)
+      {
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *) (srcRow[k] + x)),
+                                                       _mm256_set1_epi32(coeff[k])));
+      }
+      sum = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(sum, vshift), _mm256_setzero_si256()), vmax);
+      _mm_storeu_si128((__m128i *) (dst + x),
+                       _mm_packs_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+    }
+  }
+#endif
+  const __m128i vround = _mm_set1_epi32(1 << (shift - 1));
+  const __m128i vmax   = _mm_set1_epi32(maxVal);
+
+  for (; x + 4 <= width; x += 4)
+  {
+    __m128i sum = vround;
+    for (int k = 0; k < numTaps; k++)
+    {
+      sum = _mm_add_epi32(sum,
+                          _mm_mullo_epi32(_mm_loadu_si128((const __m128i *) (srcRow[k] + x)), _mm_set1_epi32(coeff[k])));
+    }
+    sum = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(sum, vshift), _mm_setzero_si128()), vmax);
+    _mm_storel_epi64((__m128i *) (dst + x), _mm_packs_epi32(sum, sum));
+  }
+  for (; x < width; x++)
+  {
+    int sum = 0;
+    for (int k = 0; k < numTaps; k++)
+    {
+      sum += coeff[k] * srcRow[k][x];
+    }
+    dst[x] = std::min<int>(std::max(0, (sum + (1 << (shift - 1))) >> shift), maxVal);
+  }
+}
+
+template<X86_VEXT vext>
+uint64_t calcSsd_SSE(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                     int height)
+{
+  if (width & 7)
+  {
+    return calcSsdCore(src0, src0Stride, src1, src1Stride, width, height);
+  }
+
+  // a pair of squared sample differences fits in 31 bits, the pair sums are widened to 64 bits before accumulation
+#ifdef USE_AVX2
+  if (vext >= AVX2 && (width & 15) == 0)
+  {
+    const __m256i vzero = _mm256_setzero_si256();
+    __m256i       vsum  = vzero;
+
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x += 16)
+      {
+        const __m256i vdiff = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *) (src0 + x)),
+                                               _mm256_loadu_si256((const __m256i *) (src1 + x)));
+        const __m256i vsq   = _mm256_madd_epi16(vdiff, vdiff);
+
+        vsum = _mm256_add_epi64(vsum, _mm256_unpacklo_epi32(vsq, vzero));
+        vsum = _mm256_add_epi64(vsum, _mm256_unpackhi_epi32(vsq, vzero));
+      }
+      src0 += src0Stride;
+      src1 += src1Stride;
+    }
+
+    const __m128i vtmp = _mm_add_epi64(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+    return uint64_t(_mm_cvtsi128_si64(vtmp)) + uint64_t(_mm_extract_epi64(vtmp, 1));
+  }
+#endif
+
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i       vsum  = vzero;
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      const __m128i vdiff =
+        _mm_sub_epi16(_mm_loadu_si128((const __m128i *) (src0 + x)), _mm_loadu_si128((const __m128i *) (src1 + x)));
+      const __m128i vsq = _mm_madd_epi16(vdiff, vdiff);
+
+      vsum = _mm_add_epi64(vsum, _mm_unpacklo_epi32(vsq, vzero));
+      vsum = _mm_add_epi64(vsum, _mm_unpackhi_epi32(vsq, vzero));
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+  return uint64_t(_mm_cvtsi128_si64(vsum)) + uint64_t(_mm_extract_epi64(vsum, 1));
+}
+#endif
+
+// each lane accumulates one window in the same order as ssimMomentsCore(), so the results are identical
+template<X86_VEXT vext>
+void ssimMoments_SSE(const double *org, const double *rec, ptrdiff_t stride, const double *weights, int winSize,
+                     int numWindows, double *moments)
+{
+  int i = 0;
+
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    for (; i + 4 <= numWindows; i += 4)
+    {
+      __m256d muOrg        = _mm256_setzero_pd();
+      __m256d muRec        = _mm256_setzero_pd();
+      __m256d muOrgSqr     = _mm256_setzero_pd();
+      __m256d muRecSqr     = _mm256_setzero_pd();
+      __m256d muOrgMultRec = _mm256_setzero_pd();
+
+      for (int y = 0; y < winSize; y++)
+      {
+        for (int x = 0; x < winSize; x++)
+        {
+          const __m256d weight = _mm256_set1_pd(weights[y * winSize + x]);
+          const __m256d orgPel = _mm256_loadu_pd(org + y * stride + i + x);
+          const __m256d recPel = _mm256_loadu_pd(rec + y * stride + i + x);
+
+          muOrg        = _mm256_add_pd(muOrg, _mm256_mul_pd(orgPel, weight));
+          muRec        = _mm256_add_pd(muRec, _mm256_mul_pd(recPel, weight));
+          muOrgSqr     = _mm256_add_pd(muOrgSqr, _mm256_mul_pd(_mm256_mul_pd(orgPel, orgPel), weight));
+          muRecSqr     = _mm256_add_pd(muRecSqr, _mm256_mul_pd(_mm256_mul_pd(recPel, recPel), weight));
+          muOrgMultRec = _mm256_add_pd(muOrgMultRec, _mm256_mul_pd(_mm256_mul_pd(orgPel, recPel), weight));
+        }
+      }
+
+      double tmp[5][4];
+      _mm256_storeu_pd(tmp[0], muOrg);
+      _mm256_storeu_pd(tmp[1], muRec);
+      _mm256_storeu_pd(tmp[2], muOrgSqr);
+      _mm256_storeu_pd(tmp[3], muRecSqr);
+      _mm256_storeu_pd(tmp[4], muOrgMultRec);
+      for (int k = 0; k < 4; k++)
+      {
+        for (int m = 0; m < 5; m++)
+        {
+          moments[5 * (i + k) + m] = tmp[m][k];
+        }
+      }
+    }
+  }
+#endif
+
+  for (; i + 2 <= numWindows; i += 2)
+  {
+    __m128d muOrg        = _mm_setzero_pd();
+    __m128d muRec        = _mm_setzero_pd();
+    __m128d muOrgSqr     = _mm_setzero_pd();
+    __m128d muRecSqr     = _mm_setzero_pd();
+    __m128d muOrgMultRec = _mm_setzero_pd();
+
+    for (int y = 0; y < winSize; y++)
+    {
+      for (int x = 0; x < winSize; x++)
+      {
+        const __m128d weight = _mm_set1_pd(weights[y * winSize + x]);
+        const __m128d orgPel = _mm_loadu_pd(org + y * stride + i + x);
+        const __m128d recPel = _mm_loadu_pd(rec + y * stride + i + x);
+
+        muOrg        = _mm_add_pd(muOrg, _mm_mul_pd(orgPel, weight));
+        muRec        = _mm_add_pd(muRec, _mm_mul_pd(recPel, weight));
+        muOrgSqr     = _mm_add_pd(muOrgSqr, _mm_mul_pd(_mm_mul_pd(orgPel, orgPel), weight));
+        muRecSqr     = _mm_add_pd(muRecSqr, _mm_mul_pd(_mm_mul_pd(recPel, recPel), weight));
+        muOrgMultRec = _mm_add_pd(muOrgMultRec, _mm_mul_pd(_mm_mul_pd(orgPel, recPel), weight));
+      }
+    }
+
+    double tmp[5][2];
+    _mm_storeu_pd(tmp[0], muOrg);
+    _mm_storeu_pd(tmp[1], muRec);
+    _mm_storeu_pd(tmp[2], muOrgSqr);
+    _mm_storeu_pd(tmp[3], muRecSqr);
+    _mm_storeu_pd(tmp[4], muOrgMultRec);
+    for (int k = 0; k < 2; k++)
+    {
+      for (int m = 0; m < 5; m++)
+      {
+        moments[5 * (i + k) + m] = tmp[m][k];
+      }
+    }
+  }
+
+  if (i < numWindows)
+  {
+    ssimMomentsCore(org + i, rec + i, stride, weights, winSize, numWindows - i, moments + 5 * i);
+  }
+}
+
 template<X86_VEXT vext, bool PAD = true>
 void gradFilter_SSE(Pel *src, ptrdiff_t srcStride, int width, int height, ptrdiff_t gradStride, Pel *gradX, Pel *gradY,
                     const int bitDepth)
@@ -1839,8 +2257,23 @@ void PelBufferOps::_initPelBufOpsX86()
 #endif
   profGradFilter = gradFilter_SSE<vext, false>;
   applyPROF      = applyPROF_SSE<vext>;
+
+#ifdef USE_AVX2
+  if (vext >= AVX2)
+  {
+    rspSignal = rspSignal_AVX2<vext>;
+  }
+#endif
+  fwdScaleSignal = fwdScaleSignal_SSE<vext>;
+  invScaleSignal = invScaleSignal_SSE<vext>;
+
+  sampleRateConvHor = sampleRateConvHor_SSE<vext>;
+  sampleRateConvVer = sampleRateConvVer_SSE<vext>;
+
+  calcSsd = calcSsd_SSE<vext>;
 #endif
   roundIntVector = roundIntVector_SIMD<vext>;
+  ssimMoments    = ssimMoments_SSE<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
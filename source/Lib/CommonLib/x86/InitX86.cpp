@@ -41,6 +41,7 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/InterpolationFilter.h"
 #include "CommonLib/TrQuant.h"
+#include "CommonLib/QuantRDOQ.h"
 #include "CommonLib/RdCost.h"
 #include "CommonLib/Buffer.h"
 
@@ -48,6 +49,8 @@
 
 #include "CommonLib/AdaptiveLoopFilter.h"
 
+#include "CommonLib/SEIFilmGrainSynthesizer.h"
+
 #include "CommonLib/IbcHashMap.h"
 
 #ifdef TARGET_SIMD_X86
@@ -167,6 +170,52 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_FGS
+void SEIFilmGrainSynthesizer::initFilmGrainSynthesizerX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initFilmGrainSynthesizerX86<AVX2>();
+    break;
+  case AVX:
+    _initFilmGrainSynthesizerX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initFilmGrainSynthesizerX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_RDOQ
+void QuantRDOQ::initQuantRDOQX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initQuantRDOQX86<AVX2>();
+    break;
+  case AVX:
+    _initQuantRDOQX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initQuantRDOQX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
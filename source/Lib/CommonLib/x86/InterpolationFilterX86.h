@@ -2453,6 +2453,123 @@ void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const u
   }
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// first stage horizontal filter with per column phases, four columns are reduced at a time with the coefficients
+// kept in registers while walking down the rows
+template<X86_VEXT vext, int N>
+static void simdFilterHorRpr(const ClpRng &clpRng, Pel const *src, ptrdiff_t srcStride, Pel *dst,
+                             ptrdiff_t dstStride, int width, int height, const int *xOffset, TFilterCoeff const *coeff)
+{
+  static_assert(N == 8 || N == 4, "Unsupported tap count");
+
+  const int     headRoom = IF_INTERNAL_FRAC_BITS(clpRng.bd);
+  const int     shift    = IF_FILTER_PREC - headRoom;
+  const int     offset   = -IF_INTERNAL_OFFS << shift;
+  const __m128i vshift   = _mm_cvtsi32_si128(shift);
+
+  int col = 0;
+#ifdef USE_AVX2
+  if (vext >= AVX2 && N == 8)
+  {
+    const __m256i voffset = _mm256_set1_epi32(offset);
+
+    for (; col + 8 <= width; col += 8)
+    {
+      __m256i c[4];
+      for (int i = 0; i < 4; i++)
+      {
+        c[i] = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (coeff + (col + i) * N))),
+          _mm_loadu_si128((const __m128i *) (coeff + (col + i + 4) * N)), 1);
+      }
+      const Pel *s = src;
+      Pel       *d = dst + col;
+      for (int row = 0; row < height; row++)
+      {
+        __m256i sum[4];
+        for (int i = 0; i < 4; i++)
+        {
+          __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (s + xOffset[col + i]))),
+            _mm_loadu_si128((const __m128i *) (s + xOffset[col + i + 4])), 1);
+          sum[i] = _mm256_madd_epi16(v, c[i]);
+        }
+        __m256i res = _mm256_hadd_epi32(_mm256_hadd_epi32(sum[0], sum[1]), _mm256_hadd_epi32(sum[2], sum[3]));
+        res         = _mm256_sra_epi32(_mm256_add_epi32(res, voffset), vshift);
+        res         = _mm256_permute4x64_epi64(_mm256_packs_epi32(res, res), 0x08);
+        _mm_storeu_si128((__m128i *) d, _mm256_castsi256_si128(res));
+        s += srcStride;
+        d += dstStride;
+      }
+    }
+  }
+#endif
+  const __m128i voffset = _mm_set1_epi32(offset);
+
+  for (; col + 4 <= width; col += 4)
+  {
+    __m128i c[4];
+    if (N == 8)
+    {
+      for (int i = 0; i < 4; i++)
+      {
+        c[i] = _mm_loadu_si128((const __m128i *) (coeff + (col + i) * N));
+      }
+    }
+    else
+    {
+      c[0] = _mm_loadu_si128((const __m128i *) (coeff + col * N));
+      c[1] = _mm_loadu_si128((const __m128i *) (coeff + (col + 2) * N));
+    }
+    const Pel *s = src;
+    Pel       *d = dst + col;
+    for (int row = 0; row < height; row++)
+    {
+      __m128i res;
+      if (N == 8)
+      {
+        __m128i sum[4];
+        for (int i = 0; i < 4; i++)
+        {
+          sum[i] = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s + xOffset[col + i])), c[i]);
+        }
+        res = _mm_hadd_epi32(_mm_hadd_epi32(sum[0], sum[1]), _mm_hadd_epi32(sum[2], sum[3]));
+      }
+      else
+      {
+        __m128i v0 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (s + xOffset[col + 0])),
+                                        _mm_loadl_epi64((const __m128i *) (s + xOffset[col + 1])));
+        __m128i v1 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (s + xOffset[col + 2])),
+                                        _mm_loadl_epi64((const __m128i *) (s + xOffset[col + 3])));
+        res        = _mm_hadd_epi32(_mm_madd_epi16(v0, c[0]), _mm_madd_epi16(v1, c[1]));
+      }
+      res = _mm_sra_epi32(_mm_add_epi32(res, voffset), vshift);
+      _mm_storel_epi64((__m128i *) d, _mm_packs_epi32(res, res));
+      s += srcStride;
+      d += dstStride;
+    }
+  }
+
+  for (; col < width; col++)
+  {
+    const Pel          *s = src + xOffset[col];
+    const TFilterCoeff *c = coeff + col * N;
+    Pel                *d = dst + col;
+    for (int row = 0; row < height; row++)
+    {
+      int sum = 0;
+      for (int k = 0; k < N; k++)
+      {
+        sum += s[k] * c[k];
+      }
+      *d = (Pel) ((sum + offset) >> shift);
+      s += srcStride;
+      d += dstStride;
+    }
+  }
+}
+#endif
+
 template <X86_VEXT vext>
 void InterpolationFilter::_initInterpolationFilterX86()
 {
@@ -2509,6 +2626,9 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
 
+  m_filterHorRpr[_8_TAPS] = simdFilterHorRpr<vext, NTAPS_LUMA>;
+  m_filterHorRpr[_4_TAPS] = simdFilterHorRpr<vext, NTAPS_CHROMA>;
+
   m_weightedGeoBlk = xWeightedGeoBlk_SSE<vext>;
 #endif
 }
@@ -0,0 +1,153 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     QuantRDOQX86.h
+    \brief    SIMD for the level candidates of QuantRDOQ
+*/
+
+// ====================================================================================================================
+// Includes
+// ====================================================================================================================
+
+#include "CommonDefX86.h"
+#include "../QuantRDOQ.h"
+
+#ifdef TARGET_SIMD_X86
+
+#include <immintrin.h>
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// The products of the absolute coefficients and the quantisation coefficients are formed in double precision. They
+// are exact up to 2^53, and any larger product is clipped to the maximum level anyway, so that the results are
+// identical to the 64 bit integer products of the C code.
+template<X86_VEXT vext>
+static bool simdQuantLevelCands(const TCoeff *src, const ptrdiff_t stride, const int width, const int height,
+                                const int *quantCoeff, const int defaultQuantCoeff, const double *errScale,
+                                const double defaultErrScale, const int qBits, const TCoeff maxLevel,
+                                RdoqLevelCands &cands)
+{
+  static_assert(sizeof(TCoeff) == 4 && sizeof(Intermediate_Int) == 4);
+
+  if (width & 3)
+  {
+    return QuantRDOQ::xQuantLevelCands(src, stride, width, height, quantCoeff, defaultQuantCoeff, errScale,
+                                       defaultErrScale, qBits, maxLevel, cands);
+  }
+
+  const int     add            = 1 << (qBits - 1);
+  const double  maxLevelDouble = double(std::numeric_limits<int>::max() - add);
+  const __m128i vAdd           = _mm_set1_epi32(add);
+  const __m128i vMaxLevel      = _mm_set1_epi32(maxLevel);
+  const __m128i vShift         = _mm_cvtsi32_si128(qBits);
+  const __m128i vQuantCoeff    = _mm_set1_epi32(defaultQuantCoeff);
+  __m128i       vAny           = _mm_setzero_si128();
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x += 4)
+    {
+      const ptrdiff_t blkPos = y * stride + x;
+
+      const __m128i absCoeff = _mm_abs_epi32(_mm_loadu_si128((const __m128i *) (src + blkPos)));
+      const __m128i q = quantCoeff ? _mm_loadu_si128((const __m128i *) (quantCoeff + blkPos)) : vQuantCoeff;
+
+#ifdef USE_AVX2
+      if constexpr (vext >= AVX2)
+      {
+        const __m256d scale = errScale ? _mm256_loadu_pd(errScale + blkPos) : _mm256_set1_pd(defaultErrScale);
+        const __m256d levelDouble =
+          _mm256_min_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(absCoeff), _mm256_cvtepi32_pd(q)),
+                        _mm256_set1_pd(maxLevelDouble));
+        const __m128i level  = _mm256_cvttpd_epi32(levelDouble);
+        const __m128i maxAbs = _mm_min_epi32(_mm_sra_epi32(_mm_add_epi32(level, vAdd), vShift), vMaxLevel);
+
+        const __m256d errMax   = _mm256_cvtepi32_pd(_mm_sub_epi32(level, _mm_sll_epi32(maxAbs, vShift)));
+        const __m256d errMaxM1 = _mm256_add_pd(errMax, _mm256_set1_pd(double(1 << qBits)));
+
+        _mm_storeu_si128((__m128i *) (cands.levelDouble + blkPos), level);
+        _mm_storeu_si128((__m128i *) (cands.maxAbsLevel + blkPos), maxAbs);
+        _mm256_storeu_pd(cands.costZero + blkPos, _mm256_mul_pd(_mm256_mul_pd(levelDouble, levelDouble), scale));
+        _mm256_storeu_pd(cands.costMax + blkPos, _mm256_mul_pd(_mm256_mul_pd(errMax, errMax), scale));
+        _mm256_storeu_pd(cands.costMaxM1 + blkPos, _mm256_mul_pd(_mm256_mul_pd(errMaxM1, errMaxM1), scale));
+
+        vAny = _mm_or_si128(vAny, maxAbs);
+      }
+      else
+#endif
+      {
+        const __m128d vMaxLevelDouble = _mm_set1_pd(maxLevelDouble);
+        const __m128d levelDouble[2]  = {
+          _mm_min_pd(_mm_mul_pd(_mm_cvtepi32_pd(absCoeff), _mm_cvtepi32_pd(q)), vMaxLevelDouble),
+          _mm_min_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(absCoeff, absCoeff)),
+                                _mm_cvtepi32_pd(_mm_unpackhi_epi64(q, q))),
+                     vMaxLevelDouble)
+        };
+        const __m128i level =
+          _mm_unpacklo_epi64(_mm_cvttpd_epi32(levelDouble[0]), _mm_cvttpd_epi32(levelDouble[1]));
+        const __m128i maxAbs = _mm_min_epi32(_mm_sra_epi32(_mm_add_epi32(level, vAdd), vShift), vMaxLevel);
+        const __m128i err    = _mm_sub_epi32(level, _mm_sll_epi32(maxAbs, vShift));
+
+        _mm_storeu_si128((__m128i *) (cands.levelDouble + blkPos), level);
+        _mm_storeu_si128((__m128i *) (cands.maxAbsLevel + blkPos), maxAbs);
+
+        for (int k = 0; k < 2; k++)
+        {
+          const __m128d scale    = errScale ? _mm_loadu_pd(errScale + blkPos + 2 * k) : _mm_set1_pd(defaultErrScale);
+          const __m128d errMax   = _mm_cvtepi32_pd(k ? _mm_unpackhi_epi64(err, err) : err);
+          const __m128d errMaxM1 = _mm_add_pd(errMax, _mm_set1_pd(double(1 << qBits)));
+
+          _mm_storeu_pd(cands.costZero + blkPos + 2 * k,
+                        _mm_mul_pd(_mm_mul_pd(levelDouble[k], levelDouble[k]), scale));
+          _mm_storeu_pd(cands.costMax + blkPos + 2 * k, _mm_mul_pd(_mm_mul_pd(errMax, errMax), scale));
+          _mm_storeu_pd(cands.costMaxM1 + blkPos + 2 * k, _mm_mul_pd(_mm_mul_pd(errMaxM1, errMaxM1), scale));
+        }
+
+        vAny = _mm_or_si128(vAny, maxAbs);
+      }
+    }
+  }
+
+  return !_mm_testz_si128(vAny, vAny);
+}
+#endif
+
+template<X86_VEXT vext> void QuantRDOQ::_initQuantRDOQX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_quantLevelCands = simdQuantLevelCands<vext>;
+#endif
+}
+
+template void QuantRDOQ::_initQuantRDOQX86<SIMDX86>();
+
+#endif   // TARGET_SIMD_X86
@@ -4603,6 +4603,224 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
 
   return sum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
+
+template<int N, X86_VEXT vext>
+void RdCost::xGetSADxN_SIMD(const DistParam &rcDtParam, const Pel *const *cur, Distortion *sads)
+{
+  const int width = rcDtParam.org.width;
+
+  if (rcDtParam.bitDepth > 10 || (width != 4 && (width & 7) != 0))
+  {
+    RdCost::xGetSADxN<N>(rcDtParam, cur, sads);
+    return;
+  }
+
+  const int       height          = rcDtParam.org.height;
+  const int       subShift        = rcDtParam.subShift;
+  const int       subStep         = (1 << subShift);
+  const ptrdiff_t strideOrg       = rcDtParam.org.stride * subStep;
+  const ptrdiff_t strideCur       = rcDtParam.cur.stride * subStep;
+  const uint32_t  distortionShift = DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+
+  const Pel *piOrg = rcDtParam.org.buf;
+  const Pel *piCur[N];
+  for (int i = 0; i < N; i++)
+  {
+    piCur[i] = cur[i];
+  }
+
+  uint32_t sum[N];
+
+  // the original samples are loaded once per position and compared against all candidates
+#ifdef USE_AVX2
+  if (vext >= AVX2 && (width & 15) == 0)
+  {
+    const __m256i vone = _mm256_set1_epi16(1);
+    __m256i       vsum[N];
+    for (int i = 0; i < N; i++)
+    {
+      vsum[i] = _mm256_setzero_si256();
+    }
+
+    for (int y = 0; y < height; y += subStep)
+    {
+      for (int x = 0; x < width; x += 16)
+      {
+        const __m256i vorg = _mm256_loadu_si256((const __m256i *) (piOrg + x));
+        for (int i = 0; i < N; i++)
+        {
+          const __m256i vcur  = _mm256_loadu_si256((const __m256i *) (piCur[i] + x));
+          const __m256i vdiff = _mm256_abs_epi16(_mm256_sub_epi16(vorg, vcur));
+          vsum[i]             = _mm256_add_epi32(vsum[i], _mm256_madd_epi16(vdiff, vone));
+        }
+      }
+      piOrg += strideOrg;
+      for (int i = 0; i < N; i++)
+      {
+        piCur[i] += strideCur;
+      }
+    }
+
+    for (int i = 0; i < N; i++)
+    {
+      __m128i vtmp = _mm_add_epi32(_mm256_castsi256_si128(vsum[i]), _mm256_extracti128_si256(vsum[i], 1));
+      vtmp         = _mm_add_epi32(vtmp, _mm_shuffle_epi32(vtmp, 0x4e));
+      vtmp         = _mm_add_epi32(vtmp, _mm_shuffle_epi32(vtmp, 0xb1));
+      sum[i]       = _mm_cvtsi128_si32(vtmp);
+    }
+  }
+  else
+#endif
+  {
+    const __m128i vone = _mm_set1_epi16(1);
+    __m128i       vsum[N];
+    for (int i = 0; i < N; i++)
+    {
+      vsum[i] = _mm_setzero_si128();
+    }
+
+    for (int y = 0; y < height; y += subStep)
+    {
+      if (width == 4)
+      {
+        const __m128i vorg = _mm_loadl_epi64((const __m128i *) piOrg);
+        for (int i = 0; i < N; i++)
+        {
+          const __m128i vcur  = _mm_loadl_epi64((const __m128i *) piCur[i]);
+          const __m128i vdiff = _mm_abs_epi16(_mm_sub_epi16(vorg, vcur));
+          vsum[i]             = _mm_add_epi32(vsum[i], _mm_madd_epi16(vdiff, vone));
+        }
+      }
+      else
+      {
+        for (int x = 0; x < width; x += 8)
+        {
+          const __m128i vorg = _mm_loadu_si128((const __m128i *) (piOrg + x));
+          for (int i = 0; i < N; i++)
+          {
+            const __m128i vcur  = _mm_loadu_si128((const __m128i *) (piCur[i] + x));
+            const __m128i vdiff = _mm_abs_epi16(_mm_sub_epi16(vorg, vcur));
+            vsum[i]             = _mm_add_epi32(vsum[i], _mm_madd_epi16(vdiff, vone));
+          }
+        }
+      }
+      piOrg += strideOrg;
+      for (int i = 0; i < N; i++)
+      {
+        piCur[i] += strideCur;
+      }
+    }
+
+    for (int i = 0; i < N; i++)
+    {
+      __m128i vtmp = _mm_add_epi32(vsum[i], _mm_shuffle_epi32(vsum[i], 0x4e));
+      vtmp         = _mm_add_epi32(vtmp, _mm_shuffle_epi32(vtmp, 0xb1));
+      sum[i]       = _mm_cvtsi128_si32(vtmp);
+    }
+  }
+
+  for (int i = 0; i < N; i++)
+  {
+    sads[i] = (Distortion(sum[i]) << subShift) >> distortionShift;
+  }
+}
+
+template<X86_VEXT vext>
+void RdCost::xGetDmvrSadGrid_SIMD(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride,
+                                  int width, int height, int bitDepth, Distortion *sads)
+{
+  if (bitDepth > 10 || (width & 7) != 0 || (height & 1) != 0)
+  {
+    RdCost::xGetDmvrSadGrid(src0, src0Stride, src1, src1Stride, width, height, bitDepth, sads);
+    return;
+  }
+
+  const uint32_t distortionShift = DISTORTION_PRECISION_ADJUSTMENT(bitDepth);
+
+  // all horizontal offsets of one vertical offset are accumulated in a single pass over the rows
+  for (int dy = -DMVR_RANGE; dy <= DMVR_RANGE; dy++)
+  {
+    const Pel *p0 = src0 + dy * src0Stride;
+    const Pel *p1 = src1 - dy * src1Stride;
+
+    uint32_t sum[DMVR_SPAN];
+
+#ifdef USE_AVX2
+    if (vext >= AVX2 && (width & 15) == 0)
+    {
+      const __m256i vone = _mm256_set1_epi16(1);
+      __m256i       vsum[DMVR_SPAN];
+      for (int dx = 0; dx < DMVR_SPAN; dx++)
+      {
+        vsum[dx] = _mm256_setzero_si256();
+      }
+
+      for (int y = 0; y < height; y += 2)
+      {
+        for (int x = 0; x < width; x += 16)
+        {
+          for (int dx = -DMVR_RANGE; dx <= DMVR_RANGE; dx++)
+          {
+            const __m256i vsrc0 = _mm256_loadu_si256((const __m256i *) (p0 + x + dx));
+            const __m256i vsrc1 = _mm256_loadu_si256((const __m256i *) (p1 + x - dx));
+            const __m256i vdiff = _mm256_abs_epi16(_mm256_sub_epi16(vsrc0, vsrc1));
+
+            vsum[dx + DMVR_RANGE] = _mm256_add_epi32(vsum[dx + DMVR_RANGE], _mm256_madd_epi16(vdiff, vone));
+          }
+        }
+        p0 += 2 * src0Stride;
+        p1 += 2 * src1Stride;
+      }
+
+      for (int dx = 0; dx < DMVR_SPAN; dx++)
+      {
+        __m128i vtmp = _mm_add_epi32(_mm256_castsi256_si128(vsum[dx]), _mm256_extracti128_si256(vsum[dx], 1));
+        vtmp         = _mm_add_epi32(vtmp, _mm_shuffle_epi32(vtmp, 0x4e));
+        vtmp         = _mm_add_epi32(vtmp, _mm_shuffle_epi32(vtmp, 0xb1));
+        sum[dx]      = _mm_cvtsi128_si32(vtmp);
+      }
+    }
+    else
+#endif
+    {
+      const __m128i vone = _mm_set1_epi16(1);
+      __m128i       vsum[DMVR_SPAN];
+      for (int dx = 0; dx < DMVR_SPAN; dx++)
+      {
+        vsum[dx] = _mm_setzero_si128();
+      }
+
+      for (int y = 0; y < height; y += 2)
+      {
+        for (int x = 0; x < width; x += 8)
+        {
+          for (int dx = -DMVR_RANGE; dx <= DMVR_RANGE; dx++)
+          {
+            const __m128i vsrc0 = _mm_loadu_si128((const __m128i *) (p0 + x + dx));
+            const __m128i vsrc1 = _mm_loadu_si128((const __m128i *) (p1 + x - dx));
+            const __m128i vdiff = _mm_abs_epi16(_mm_sub_epi16(vsrc0, vsrc1));
+
+            vsum[dx + DMVR_RANGE] = _mm_add_epi32(vsum[dx + DMVR_RANGE], _mm_madd_epi16(vdiff, vone));
+          }
+        }
+        p0 += 2 * src0Stride;
+        p1 += 2 * src1Stride;
+      }
+
+      for (int dx = 0; dx < DMVR_SPAN; dx++)
+      {
+        __m128i vtmp = _mm_add_epi32(vsum[dx], _mm_shuffle_epi32(vsum[dx], 0x4e));
+        vtmp         = _mm_add_epi32(vtmp, _mm_shuffle_epi32(vtmp, 0xb1));
+        sum[dx]      = _mm_cvtsi128_si32(vtmp);
+      }
+    }
+
+    for (int dx = 0; dx < DMVR_SPAN; dx++)
+    {
+      sads[(dy + DMVR_RANGE) * DMVR_SPAN + dx] = (Distortion(sum[dx]) << 1) >> distortionShift;
+    }
+  }
+}
 #endif
 template <X86_VEXT vext>
 void RdCost::_initRdCostX86()
@@ -4676,6 +4894,10 @@ void RdCost::_initRdCostX86()
   m_distortionFunc[DFunc::SAD_INTERMEDIATE_BITDEPTH] = RdCost::xGetSAD_IBD_SIMD<vext>;
 
   m_distortionFunc[DFunc::SAD_WITH_MASK] = xGetSADwMask_SIMD<vext>;
+
+  m_dmvrSadGrid = xGetDmvrSadGrid_SIMD<vext>;
+  m_sadX4       = xGetSADxN_SIMD<4, vext>;
+  m_sadX8       = xGetSADxN_SIMD<8, vext>;
 #endif
 }
 
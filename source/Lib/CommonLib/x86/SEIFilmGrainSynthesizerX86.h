@@ -0,0 +1,241 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SEIFilmGrainSynthesizerX86.h
+    \brief    SIMD kernels for the film grain synthesis
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+#include "CommonDefX86.h"
+#include "../SEIFilmGrainSynthesizer.h"
+
+#if ENABLE_SIMD_OPT_FGS
+#ifdef TARGET_SIMD_X86
+#if defined _MSC_VER
+#include <tmmintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+// filters the vertical block edges of eight lines at a time: the two samples on either side of an edge are
+// transposed into one vector per column, filtered and transposed back
+static void simdDeblockGrainStripe(Pel *grainStripe, uint32_t widthComp, uint32_t heightComp, uint32_t strideComp,
+                                   uint32_t blkSize)
+{
+  CHECK(heightComp & 7, "Grain stripe height must be a multiple of 8");
+
+  for (uint32_t y = 0; y < heightComp; y += 8)
+  {
+    Pel *src = grainStripe + y * strideComp;
+
+    for (uint32_t pos = blkSize; pos < widthComp; pos += blkSize)
+    {
+      Pel *edge = src + pos - 2;
+
+      // [ left1 left0 right0 right1 ] of each line
+      __m128i r0 = _mm_loadl_epi64((const __m128i *) (edge + 0 * strideComp));
+      __m128i r1 = _mm_loadl_epi64((const __m128i *) (edge + 1 * strideComp));
+      __m128i r2 = _mm_loadl_epi64((const __m128i *) (edge + 2 * strideComp));
+      __m128i r3 = _mm_loadl_epi64((const __m128i *) (edge + 3 * strideComp));
+      __m128i r4 = _mm_loadl_epi64((const __m128i *) (edge + 4 * strideComp));
+      __m128i r5 = _mm_loadl_epi64((const __m128i *) (edge + 5 * strideComp));
+      __m128i r6 = _mm_loadl_epi64((const __m128i *) (edge + 6 * strideComp));
+      __m128i r7 = _mm_loadl_epi64((const __m128i *) (edge + 7 * strideComp));
+
+      __m128i a01 = _mm_unpacklo_epi16(r0, r1);
+      __m128i a23 = _mm_unpacklo_epi16(r2, r3);
+      __m128i a45 = _mm_unpacklo_epi16(r4, r5);
+      __m128i a67 = _mm_unpacklo_epi16(r6, r7);
+
+      __m128i b0 = _mm_unpacklo_epi32(a01, a23);
+      __m128i b1 = _mm_unpackhi_epi32(a01, a23);
+      __m128i b2 = _mm_unpacklo_epi32(a45, a67);
+      __m128i b3 = _mm_unpackhi_epi32(a45, a67);
+
+      __m128i left1  = _mm_unpacklo_epi64(b0, b2);
+      __m128i left0  = _mm_unpackhi_epi64(b0, b2);
+      __m128i right0 = _mm_unpacklo_epi64(b1, b3);
+      __m128i right1 = _mm_unpackhi_epi64(b1, b3);
+
+      // grain samples are bounded by the 8-bit data base values, the filter sums fit into 16 bits
+      __m128i newRight0 = _mm_add_epi16(_mm_add_epi16(left0, _mm_slli_epi16(right0, 1)), right1);
+      __m128i newLeft0  = _mm_add_epi16(_mm_add_epi16(left1, _mm_slli_epi16(left0, 1)), right0);
+      newRight0         = _mm_srai_epi16(newRight0, 2);
+      newLeft0          = _mm_srai_epi16(newLeft0, 2);
+
+      // [ left0 right0 ] of each line
+      __m128i lo = _mm_unpacklo_epi16(newLeft0, newRight0);
+      __m128i hi = _mm_unpackhi_epi16(newLeft0, newRight0);
+
+      edge++;
+      *(int32_t *) (edge + 0 * strideComp) = _mm_cvtsi128_si32(lo);
+      *(int32_t *) (edge + 1 * strideComp) = _mm_cvtsi128_si32(_mm_srli_si128(lo, 4));
+      *(int32_t *) (edge + 2 * strideComp) = _mm_cvtsi128_si32(_mm_srli_si128(lo, 8));
+      *(int32_t *) (edge + 3 * strideComp) = _mm_cvtsi128_si32(_mm_srli_si128(lo, 12));
+      *(int32_t *) (edge + 4 * strideComp) = _mm_cvtsi128_si32(hi);
+      *(int32_t *) (edge + 5 * strideComp) = _mm_cvtsi128_si32(_mm_srli_si128(hi, 4));
+      *(int32_t *) (edge + 6 * strideComp) = _mm_cvtsi128_si32(_mm_srli_si128(hi, 8));
+      *(int32_t *) (edge + 7 * strideComp) = _mm_cvtsi128_si32(_mm_srli_si128(hi, 12));
+    }
+  }
+}
+
+// decoded samples are unsigned, the blending is done in 32 bits to cover bit depths up to 16
+template<X86_VEXT vext>
+static void simdBlendStripe(Pel *decSampleOffsetY, Pel *grainStripe, uint32_t widthComp, ptrdiff_t strideSrc,
+                            ptrdiff_t strideGrain, uint32_t blockHeight, uint8_t bitDepth)
+{
+  const int     bitDepthShift = bitDepth - BIT_DEPTH_8;
+  const int32_t maxRange      = (1 << bitDepth) - 1;
+  const __m128i vshift        = _mm_cvtsi32_si128(bitDepthShift);
+
+  for (uint32_t l = 0; l < blockHeight; l++)
+  {
+    uint32_t k = 0;
+#ifdef USE_AVX2
+    if (vext >= AVX2)
+    {
+      const __m256i vzero = _mm256_setzero_si256();
+      const __m256i vmax  = _mm256_set1_epi32(maxRange);
+
+      for (; k + 16 <= widthComp; k += 16)
+      {
+        __m256i dec   = _mm256_loadu_si256((const __m256i *) (decSampleOffsetY + k));
+        __m256i grain = _mm256_loadu_si256((const __m256i *) (grainStripe + k));
+
+        __m256i decLo   = _mm256_unpacklo_epi16(dec, vzero);
+        __m256i decHi   = _mm256_unpackhi_epi16(dec, vzero);
+        __m256i grainLo = _mm256_srai_epi32(_mm256_unpacklo_epi16(vzero, grain), 16);
+        __m256i grainHi = _mm256_srai_epi32(_mm256_unpackhi_epi16(vzero, grain), 16);
+
+        __m256i sumLo = _mm256_add_epi32(_mm256_sll_epi32(grainLo, vshift), decLo);
+        __m256i sumHi = _mm256_add_epi32(_mm256_sll_epi32(grainHi, vshift), decHi);
+        sumLo         = _mm256_min_epi32(_mm256_max_epi32(sumLo, vzero), vmax);
+        sumHi         = _mm256_min_epi32(_mm256_max_epi32(sumHi, vzero), vmax);
+
+        _mm256_storeu_si256((__m256i *) (decSampleOffsetY + k), _mm256_packus_epi32(sumLo, sumHi));
+      }
+    }
+#endif
+    const __m128i vzero = _mm_setzero_si128();
+    const __m128i vmax  = _mm_set1_epi32(maxRange);
+
+    for (; k + 8 <= widthComp; k += 8)
+    {
+      __m128i dec   = _mm_loadu_si128((const __m128i *) (decSampleOffsetY + k));
+      __m128i grain = _mm_loadu_si128((const __m128i *) (grainStripe + k));
+
+      __m128i decLo   = _mm_cvtepu16_epi32(dec);
+      __m128i decHi   = _mm_cvtepu16_epi32(_mm_srli_si128(dec, 8));
+      __m128i grainLo = _mm_cvtepi16_epi32(grain);
+      __m128i grainHi = _mm_cvtepi16_epi32(_mm_srli_si128(grain, 8));
+
+      __m128i sumLo = _mm_add_epi32(_mm_sll_epi32(grainLo, vshift), decLo);
+      __m128i sumHi = _mm_add_epi32(_mm_sll_epi32(grainHi, vshift), decHi);
+      sumLo         = _mm_min_epi32(_mm_max_epi32(sumLo, vzero), vmax);
+      sumHi         = _mm_min_epi32(_mm_max_epi32(sumHi, vzero), vmax);
+
+      _mm_storeu_si128((__m128i *) (decSampleOffsetY + k), _mm_packus_epi32(sumLo, sumHi));
+    }
+    for (; k < widthComp; k++)
+    {
+      int32_t grainSample = (int32_t) grainStripe[k] << bitDepthShift;
+      grainSample         = CLIP3(0, maxRange, grainSample + (uint16_t) decSampleOffsetY[k]);
+      decSampleOffsetY[k] = (Pel) grainSample;
+    }
+    decSampleOffsetY += strideSrc;
+    grainStripe += strideGrain;
+  }
+}
+
+template<X86_VEXT vext>
+static uint32_t simdBlockSum(const Pel *decSampleBlk, ptrdiff_t strideComp, uint32_t blkSize)
+{
+  CHECK(blkSize & 7, "Block size must be a multiple of 8");
+
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  if (vext >= AVX2 && blkSize >= 16)
+  {
+    const __m256i vone  = _mm256_set1_epi16(1);
+    __m256i       vsum2 = _mm256_setzero_si256();
+    for (uint32_t k = 0; k < blkSize; k++)
+    {
+      for (uint32_t l = 0; l < blkSize; l += 16)
+      {
+        __m256i src = _mm256_loadu_si256((const __m256i *) (decSampleBlk + l));
+        vsum2       = _mm256_add_epi32(vsum2, _mm256_madd_epi16(src, vone));
+      }
+      decSampleBlk += strideComp;
+    }
+    vsum = _mm_add_epi32(_mm256_castsi256_si128(vsum2), _mm256_extracti128_si256(vsum2, 1));
+  }
+  else
+#endif
+  {
+    const __m128i vone = _mm_set1_epi16(1);
+    for (uint32_t k = 0; k < blkSize; k++)
+    {
+      for (uint32_t l = 0; l < blkSize; l += 8)
+      {
+        __m128i src = _mm_loadu_si128((const __m128i *) (decSampleBlk + l));
+        vsum        = _mm_add_epi32(vsum, _mm_madd_epi16(src, vone));
+      }
+      decSampleBlk += strideComp;
+    }
+  }
+  vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0x4e));
+  vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0xb1));
+  return (uint32_t) _mm_cvtsi128_si32(vsum);
+}
+#endif
+
+template<X86_VEXT vext>
+void SEIFilmGrainSynthesizer::_initFilmGrainSynthesizerX86()
+{
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+  m_deblockGrainStripe = simdDeblockGrainStripe;
+  m_blendStripe        = simdBlendStripe<vext>;
+  m_blockSum           = simdBlockSum<vext>;
+#endif
+}
+
+template void SEIFilmGrainSynthesizer::_initFilmGrainSynthesizerX86<SIMDX86>();
+
+#endif   // TARGET_SIMD_X86
+#endif   // ENABLE_SIMD_OPT_FGS
+
+//! \}
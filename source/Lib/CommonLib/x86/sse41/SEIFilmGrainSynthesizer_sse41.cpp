@@ -0,0 +1 @@
+#include "../SEIFilmGrainSynthesizerX86.h"
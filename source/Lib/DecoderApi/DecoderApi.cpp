@@ -0,0 +1,381 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecoderApi.cpp
+    \brief    Embeddable decoder interface
+*/
+
+#include "DecoderApi.h"
+
+#include <algorithm>
+#include <deque>
+#include <sstream>
+
+#include "DecApp.h"
+#include "DecoderLib/AnnexBread.h"
+#include "DecoderLib/NALread.h"
+#include "Utilities/program_options_lite.h"
+
+//! \ingroup DecoderApi
+//! \{
+
+struct DecoderApi::Impl
+{
+  std::shared_ptr<DecApp>            decApp;            // shared with the picture views
+  std::string                        pending;           // byte stream data not yet read by the decoder
+  std::vector<size_t>                nalStarts;         // offsets of the start codes in pending
+  size_t                             scanPos      = 0;  // start code search position in pending
+  bool                               lastComplete = false;
+  int                                lastDecisive = -1; // last complete NAL unit that ends the look-ahead of the decoder
+  size_t                             numChecked   = 0;  // NAL units checked for lastDecisive
+  size_t                             numRead      = 0;  // NAL units read by the decoder
+  std::deque<DecoderApi::PicturePtr> output;
+  bool                               started = false;
+  bool                               flushed = false;
+  bool                               failed  = false;
+
+  void     scan();
+  bool     canStep() const;
+  bool     decode(bool endOfStream);
+  void     addOutput(::Picture *pcPic);
+};
+
+// NAL unit types that terminate both the picture and the access unit look-ahead of DecLib
+static bool isDecisiveNalUnitType(int nalUnitType)
+{
+  switch (nalUnitType)
+  {
+  case NAL_UNIT_ACCESS_UNIT_DELIMITER:
+  case NAL_UNIT_CODED_SLICE_TRAIL:
+  case NAL_UNIT_CODED_SLICE_STSA:
+  case NAL_UNIT_CODED_SLICE_RADL:
+  case NAL_UNIT_CODED_SLICE_RASL:
+  case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+  case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+  case NAL_UNIT_CODED_SLICE_CRA:
+  case NAL_UNIT_CODED_SLICE_GDR:
+  case NAL_UNIT_EOS:
+  case NAL_UNIT_EOB:
+  case NAL_UNIT_SUFFIX_APS:
+  case NAL_UNIT_SUFFIX_SEI:
+  case NAL_UNIT_FD:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void DecoderApi::Impl::scan()
+{
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(pending.data());
+  size_t         i    = scanPos;
+  for (; i + 2 < pending.size(); i++)
+  {
+    if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+    {
+      nalStarts.push_back(i);
+      i += 2;
+    }
+  }
+  scanPos = i;
+
+  // a NAL unit is complete when the next start code has been received
+  const size_t numComplete = lastComplete ? nalStarts.size() : std::max<size_t>(nalStarts.size(), 1) - 1;
+  for (; numChecked < numComplete; numChecked++)
+  {
+    const size_t header = nalStarts[numChecked] + 3;
+    if (header + 1 < pending.size() && isDecisiveNalUnitType(data[header + 1] >> 3))
+    {
+      lastDecisive = int(numChecked);
+    }
+  }
+}
+
+bool DecoderApi::Impl::canStep() const
+{
+  // the next NAL unit has to be followed by a start code, and the look-ahead has to end within the received data
+  return numRead + 1 < nalStarts.size() && lastDecisive >= int(numRead);
+}
+
+bool DecoderApi::Impl::decode(bool endOfStream)
+{
+  // nothing can be decoded before a NAL unit that ends the look-ahead has been received; checking this first
+  // avoids copying the pending data for every pushed chunk
+  if (nalStarts.empty() || (!endOfStream && !canStep()))
+  {
+    return true;
+  }
+
+  // a dummy NAL unit brings the byte stream reader into the state it has after reading a NAL unit
+  std::istringstream stream(std::string("\x00\x00\x01\xff", 4) + pending.substr(nalStarts[numRead]));
+  InputByteStream    bytestream(stream);
+  {
+    AnnexBStats  stats;
+    InputNALUnit nalu;
+    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+  }
+
+  try
+  {
+    if (endOfStream)
+    {
+      while (!!stream)
+      {
+        decApp->decodeStep(stream, bytestream);
+      }
+      numRead = nalStarts.size();
+    }
+    else
+    {
+      while (canStep())
+      {
+        if (decApp->decodeStep(stream, bytestream))
+        {
+          numRead++;
+        }
+      }
+    }
+  }
+  catch (Exception &e)
+  {
+    msg(ERROR, "%s\n", e.what());
+    failed = true;
+    return false;
+  }
+
+  // drop the data that has been read
+  const size_t offset = numRead < nalStarts.size() ? nalStarts[numRead] : pending.size();
+  pending.erase(0, offset);
+  nalStarts.erase(nalStarts.begin(), nalStarts.begin() + numRead);
+  for (auto &start: nalStarts)
+  {
+    start -= offset;
+  }
+  scanPos      = scanPos > offset ? scanPos - offset : 0;
+  numChecked   -= numRead;
+  lastDecisive -= int(numRead);
+  numRead      = 0;
+  return true;
+}
+
+void DecoderApi::Impl::addOutput(::Picture *pcPic)
+{
+  DecoderApi::Picture *view = new DecoderApi::Picture;
+
+  const ChromaFormat chromaFormat = pcPic->m_chromaFormatIdc;
+  const Window      &conf         = pcPic->getConformanceWindow();
+  const int          left         = conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormat);
+  const int          right        = conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormat);
+  const int          top          = conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormat);
+  const int          bottom       = conf.getWindowBottomOffset() * SPS::getWinUnitY(chromaFormat);
+
+  const PelUnitBuf reco = pcPic->getRecoBuf();
+  view->numComponents   = getNumberValidComponents(chromaFormat);
+  view->bytesPerSample  = sizeof(Pel);
+  view->bitDepths[0]    = pcPic->m_bitDepths[ChannelType::LUMA];
+  view->bitDepths[1]    = pcPic->m_bitDepths[ChannelType::CHROMA];
+  view->poc             = pcPic->getPOC();
+  view->layerId         = pcPic->layerId;
+  for (int comp = 0; comp < view->numComponents; comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const int         sx     = getComponentScaleX(compID, chromaFormat);
+    const int         sy     = getComponentScaleY(compID, chromaFormat);
+    const CPelBuf     buf    = reco.get(compID);
+    view->planes[comp]       = buf.bufAt(left >> sx, top >> sy);
+    view->strides[comp]      = buf.stride;
+    view->widths[comp]       = buf.width - ((left + right) >> sx);
+    view->heights[comp]      = buf.height - ((top + bottom) >> sy);
+  }
+
+  // the decoder application stays alive as long as a view refers to one of its pictures
+  std::shared_ptr<DecApp> app = decApp;
+  output.push_back(DecoderApi::PicturePtr(view, [app, pcPic](const DecoderApi::Picture *v) {
+    app->releaseOutputPicture(pcPic);
+    delete v;
+  }));
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+DecoderApi::DecoderApi()
+{
+}
+
+DecoderApi::~DecoderApi()
+{
+  close();
+}
+
+bool DecoderApi::init(const std::vector<std::string> &options)
+{
+  close();
+
+  m_impl.reset(new Impl);
+  m_impl->decApp = std::make_shared<DecApp>();
+  DecApp &decApp = *m_impl->decApp;
+
+  // the bitstream file name is mandatory for DecoderApp but not used here
+  std::vector<std::string> args = { "DecoderApi", "--BitstreamFile=-" };
+  args.insert(args.end(), options.begin(), options.end());
+  std::vector<char *> argv;
+  for (auto &arg: args)
+  {
+    argv.push_back(&arg[0]);
+  }
+
+  bool ok = false;
+  try
+  {
+    ok = decApp.parseCfg((int) argv.size(), argv.data());
+    if (ok)
+    {
+      Impl                 *impl = m_impl.get();
+      decApp.setOutputCallback([impl](::Picture *pcPic) { impl->addOutput(pcPic); });
+      decApp.startDecoding();
+      m_impl->started = true;
+    }
+  }
+  catch (ProgramOptionsLite::ParseFailure &e)
+  {
+    msg(ERROR, "Error parsing option \"%s\" with argument \"%s\".\n", e.arg.c_str(), e.val.c_str());
+    ok = false;
+  }
+  catch (Exception &e)
+  {
+    msg(ERROR, "%s\n", e.what());
+    ok = false;
+  }
+
+  if (!ok)
+  {
+    close();
+  }
+  return ok;
+}
+
+uint32_t DecoderApi::close()
+{
+  if (!m_impl)
+  {
+    return 0;
+  }
+
+  uint32_t numErrors = 0;
+  if (m_impl->started)
+  {
+    flush();
+    m_impl->decApp->setOutputCallback(nullptr);
+    numErrors = m_impl->decApp->finishDecoding();
+  }
+  m_impl.reset();
+  return numErrors;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+bool DecoderApi::pushBytes(const uint8_t *data, size_t size)
+{
+  if (!m_impl || !m_impl->started || m_impl->flushed || m_impl->failed)
+  {
+    return false;
+  }
+
+  m_impl->pending.append(reinterpret_cast<const char *>(data), size);
+  m_impl->lastComplete = false;
+  m_impl->scan();
+
+  return m_impl->decode(false);
+}
+
+bool DecoderApi::pushNalUnit(const uint8_t *data, size_t size)
+{
+  if (!m_impl || !m_impl->started || m_impl->flushed || m_impl->failed)
+  {
+    return false;
+  }
+
+  m_impl->pending.append("\x00\x00\x01", 3);
+  m_impl->pending.append(reinterpret_cast<const char *>(data), size);
+  m_impl->lastComplete = true;
+  m_impl->scan();
+
+  return m_impl->decode(false);
+}
+
+bool DecoderApi::flush()
+{
+  if (!m_impl || !m_impl->started || m_impl->failed)
+  {
+    return false;
+  }
+  if (m_impl->flushed)
+  {
+    return true;
+  }
+
+  m_impl->flushed = true;
+  if (!m_impl->decode(true))
+  {
+    return false;
+  }
+  try
+  {
+    m_impl->decApp->flushDecoding();
+  }
+  catch (Exception &e)
+  {
+    msg(ERROR, "%s\n", e.what());
+    m_impl->failed = true;
+    return false;
+  }
+  return true;
+}
+
+DecoderApi::PicturePtr DecoderApi::pullPicture()
+{
+  if (!m_impl || m_impl->output.empty())
+  {
+    return nullptr;
+  }
+
+  PicturePtr pic = m_impl->output.front();
+  m_impl->output.pop_front();
+  return pic;
+}
+
+//! \}
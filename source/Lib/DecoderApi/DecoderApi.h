@@ -0,0 +1,108 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecoderApi.h
+    \brief    Embeddable decoder interface (header)
+*/
+
+#ifndef __DECODERAPI__
+#define __DECODERAPI__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! \ingroup DecoderApi
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Push/pull decoder interface around DecLib.
+/// The decoder is configured with the same options as DecoderApp (given as "--Name=value" strings; no bitstream or
+/// reconstruction file is used). The caller pushes NAL units or arbitrary chunks of an Annex-B byte stream and pulls
+/// decoded pictures in output order. Pictures are views onto the decoder's picture buffers: a buffer is not reused
+/// by the decoder while a view of it is held. All calls, including the release of views, have to be made from the
+/// same thread.
+class DecoderApi
+{
+public:
+  /// view onto a decoded picture, cropped to the conformance window; samples are stored with bytesPerSample bytes each
+  struct Picture
+  {
+    int         numComponents  = 0;
+    const void *planes[3]      = { nullptr, nullptr, nullptr };
+    ptrdiff_t   strides[3]     = { 0, 0, 0 };   ///< in samples
+    int         widths[3]      = { 0, 0, 0 };
+    int         heights[3]     = { 0, 0, 0 };
+    int         bytesPerSample = 0;
+    int         bitDepths[2]   = { 0, 0 };      ///< luma, chroma
+    int         poc            = 0;
+    int         layerId        = 0;
+  };
+
+  /// the picture buffer is returned to the decoder when the last reference is dropped
+  typedef std::shared_ptr<const Picture> PicturePtr;
+
+  DecoderApi();
+  ~DecoderApi();
+
+  bool init(const std::vector<std::string> &options);
+
+  /// push one complete NAL unit without start code
+  bool pushNalUnit(const uint8_t *data, size_t size);
+
+  /// push a chunk of an Annex-B byte stream, NAL units may be split across chunks
+  bool pushBytes(const uint8_t *data, size_t size);
+
+  /// signal the end of the bitstream, all remaining pictures become available
+  bool flush();
+
+  /// next picture in output order, or nullptr if none is available yet
+  PicturePtr pullPicture();
+
+  /// flush if needed and release the decoder; pictures that are still held remain valid
+  /// returns the number of pictures with a mismatching decoded picture hash SEI
+  uint32_t close();
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+//! \}
+
+#endif // __DECODERAPI__
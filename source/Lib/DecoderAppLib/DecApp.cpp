@@ -58,6 +58,7 @@
 
 DecApp::DecApp()
 : m_iPOCLastDisplay(-MAX_INT)
+, m_pcListPic(nullptr)
 {
   for (int i = 0; i < MAX_NUM_LAYER_IDS; i++)
   {
@@ -79,12 +80,8 @@ DecApp::DecApp()
  */
 uint32_t DecApp::decode()
 {
-  int      poc;
-  PicList *pcListPic = nullptr;
-  
 #if GREEN_METADATA_SEI_ENABLED
   FeatureCounterStruct featureCounter;
-  FeatureCounterStruct featureCounterOld;
   std::ifstream        bitstreamSize(m_bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary);
   std::streampos fsize = 0;
   fsize = bitstreamSize.tellg();
@@ -101,6 +98,25 @@ uint32_t DecApp::decode()
 
   InputByteStream bytestream(bitstreamFile);
 
+  startDecoding();
+
+  // main decoder loop
+  while (!!bitstreamFile)
+  {
+    decodeStep(bitstreamFile, bytestream);
+  }
+
+  flushDecoding();
+
+  return finishDecoding();
+}
+
+/**
+ - create & initialize internal classes and open the output files
+ - reset the state of the decoding loop
+ */
+void DecApp::startDecoding()
+{
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
     m_seiMessageFileStream.open(m_outputDecodedSEIMessagesFilename.c_str(), std::ios::out);
@@ -155,697 +171,701 @@ uint32_t DecApp::decode()
     }
   }
 
-  // main decoder loop
-  bool loopFiltered[MAX_VPS_LAYERS] = { false };
-
-  bool bPicSkipped = false;
-
-  bool openedPostFile = false;
+  // main decoder loop state
+  m_pcListPic = nullptr;
+  for (int i = 0; i < MAX_VPS_LAYERS; i++)
+  {
+    m_loopFiltered[i] = false;
+  }
+  m_picSkipped = false;
+  m_openedPostFile = false;
   setShutterFilterFlag(!m_shutterIntervalPostFileName.empty());   // not apply shutter interval SEI processing if filename is not specified.
   m_cDecLib.setShutterFilterFlag(getShutterFilterFlag());
 
-  bool isEosPresentInPu = false;
-  bool isEosPresentInLastPu = false;
+  m_isEosPresentInPu = false;
+  m_isEosPresentInLastPu = false;
+  m_outputPicturePresentInBitstream = false;
 
-  bool outputPicturePresentInBitstream = false;
-  auto setOutputPicturePresentInStream = [&]()
-  {
-    if( !outputPicturePresentInBitstream )
-    {
-      PicList::iterator iterPic = pcListPic->begin();
-      while (!outputPicturePresentInBitstream && iterPic != pcListPic->end())
-      {
-        Picture *pcPic = *(iterPic++);
-        if (pcPic->neededForOutput)
-        {
-          outputPicturePresentInBitstream = true;
-        }
-      }
-    }
-  };
-
-    m_cDecLib.setHTidExternalSetFlag(m_mTidExternalSet);
-    m_cDecLib.setTOlsIdxExternalFlag(m_tOlsIdxTidExternalSet);
+  m_cDecLib.setHTidExternalSetFlag(m_mTidExternalSet);
+  m_cDecLib.setTOlsIdxExternalFlag(m_tOlsIdxTidExternalSet);
 
 #if GREEN_METADATA_SEI_ENABLED
-    m_cDecLib.setFeatureAnalysisFramewise( m_GMFAFramewise);
-    m_cDecLib.setGMFAFile(m_GMFAFile);
+  m_cDecLib.setFeatureAnalysisFramewise( m_GMFAFramewise);
+  m_cDecLib.setGMFAFile(m_GMFAFile);
 #endif
-  
-  bool gdrRecoveryPeriod[MAX_NUM_LAYER_IDS] = { false };
-  bool prevPicSkipped = true;
-  int lastNaluLayerId = -1;
-  bool decodedSliceInAU = false;
 
-  while (!!bitstreamFile)
+  for (int i = 0; i < MAX_NUM_LAYER_IDS; i++)
   {
-    InputNALUnit nalu;
-    nalu.m_nalUnitType = NAL_UNIT_INVALID;
+    m_gdrRecoveryPeriod[i] = false;
+  }
+  m_prevPicSkipped = true;
+  m_lastNaluLayerId = -1;
+  m_decodedSliceInAU = false;
+}
+
+/**
+ - decode the next NAL unit of the byte stream, or finish the current picture if the next NAL unit starts a new one
+ - returns true if a NAL unit was read from the stream
+ */
+bool DecApp::decodeStep(std::istream &bitstreamFile, InputByteStream &bytestream)
+{
+  int poc;
 
-    // determine if next NAL unit will be the first one from a new picture
-    bool bNewPicture = m_cDecLib.isNewPicture(&bitstreamFile, &bytestream);
-    bool bNewAccessUnit = bNewPicture && decodedSliceInAU && m_cDecLib.isNewAccessUnit( bNewPicture, &bitstreamFile, &bytestream );
-    if(!bNewPicture)
+  InputNALUnit nalu;
+  nalu.m_nalUnitType = NAL_UNIT_INVALID;
+
+  // determine if next NAL unit will be the first one from a new picture
+  bool bNewPicture = m_cDecLib.isNewPicture(&bitstreamFile, &bytestream);
+  bool bNewAccessUnit = bNewPicture && m_decodedSliceInAU && m_cDecLib.isNewAccessUnit( bNewPicture, &bitstreamFile, &bytestream );
+  if(!bNewPicture)
+  {
+    AnnexBStats stats = AnnexBStats();
+
+    // find next NAL unit in stream
+    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    if (nalu.getBitstream().getFifo().empty())
+    {
+      /* this can happen if the following occur:
+       *  - empty input file
+       *  - two back-to-back start_code_prefixes
+       *  - start_code_prefix immediately followed by EOF
+       */
+      msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
+    }
+    else
     {
-      AnnexBStats stats = AnnexBStats();
+      // read NAL unit header
+      read(nalu);
 
-      // find next NAL unit in stream
-      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
-      if (nalu.getBitstream().getFifo().empty())
+      // flush output for first slice of an IDR picture
+      if(m_cDecLib.getFirstSliceInPicture() &&
+          (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
+           nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP))
       {
-        /* this can happen if the following occur:
-         *  - empty input file
-         *  - two back-to-back start_code_prefixes
-         *  - start_code_prefix immediately followed by EOF
-         */
-        msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n");
-      }
-      else
-      {
-        // read NAL unit header
-        read(nalu);
-
-        // flush output for first slice of an IDR picture
-        if(m_cDecLib.getFirstSliceInPicture() &&
-            (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
-             nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP))
+        if (!m_cDecLib.getMixedNaluTypesInPicFlag())
         {
-          if (!m_cDecLib.getMixedNaluTypesInPicFlag())
-          {
-            m_newCLVS[nalu.m_nuhLayerId] = true;   // An IDR picture starts a new CLVS
-            xFlushOutput(pcListPic, nalu.m_nuhLayerId);
-          }
-          else
-          {
-            m_newCLVS[nalu.m_nuhLayerId] = false;
-          }
-        }
-        else if (m_cDecLib.getFirstSliceInPicture() && nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA && isEosPresentInLastPu)
-        {
-          // A CRA that is immediately preceded by an EOS is a CLVSS
-          m_newCLVS[nalu.m_nuhLayerId] = true;
-          xFlushOutput(pcListPic, nalu.m_nuhLayerId);
+          m_newCLVS[nalu.m_nuhLayerId] = true;   // An IDR picture starts a new CLVS
+          xFlushOutput(m_pcListPic, nalu.m_nuhLayerId);
         }
-        else if (m_cDecLib.getFirstSliceInPicture() && nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA && !isEosPresentInLastPu)
+        else
         {
-          // A CRA that is not immediately precede by an EOS is not a CLVSS
           m_newCLVS[nalu.m_nuhLayerId] = false;
         }
-        else if(m_cDecLib.getFirstSliceInPicture() && !isEosPresentInLastPu)
+      }
+      else if (m_cDecLib.getFirstSliceInPicture() && nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA && m_isEosPresentInLastPu)
+      {
+        // A CRA that is immediately preceded by an EOS is a CLVSS
+        m_newCLVS[nalu.m_nuhLayerId] = true;
+        xFlushOutput(m_pcListPic, nalu.m_nuhLayerId);
+      }
+      else if (m_cDecLib.getFirstSliceInPicture() && nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA && !m_isEosPresentInLastPu)
+      {
+        // A CRA that is not immediately precede by an EOS is not a CLVSS
+        m_newCLVS[nalu.m_nuhLayerId] = false;
+      }
+      else if(m_cDecLib.getFirstSliceInPicture() && !m_isEosPresentInLastPu)
+      {
+        m_newCLVS[nalu.m_nuhLayerId] = false;
+      }
+
+      // parse NAL unit syntax if within target decoding layer
+      if ((m_maxTemporalLayer == TL_INFINITY || nalu.m_temporalId <= m_maxTemporalLayer)
+          && xIsNaluWithinTargetDecLayerIdSet(&nalu))
+      {
+        if (m_targetDecLayerIdSet.size())
         {
-          m_newCLVS[nalu.m_nuhLayerId] = false;
+          CHECK(std::find(m_targetDecLayerIdSet.begin(), m_targetDecLayerIdSet.end(), nalu.m_nuhLayerId) == m_targetDecLayerIdSet.end(), "bitstream shall not contain any other layers than included in the OLS with OlsIdx");
         }
-
-        // parse NAL unit syntax if within target decoding layer
-        if ((m_maxTemporalLayer == TL_INFINITY || nalu.m_temporalId <= m_maxTemporalLayer)
-            && xIsNaluWithinTargetDecLayerIdSet(&nalu))
+        if (m_picSkipped)
         {
-          if (m_targetDecLayerIdSet.size())
+          if ((nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_TRAIL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_STSA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RASL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR))
           {
-            CHECK(std::find(m_targetDecLayerIdSet.begin(), m_targetDecLayerIdSet.end(), nalu.m_nuhLayerId) == m_targetDecLayerIdSet.end(), "bitstream shall not contain any other layers than included in the OLS with OlsIdx");
-          }
-          if (bPicSkipped)
-          {
-            if ((nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_TRAIL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_STSA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RASL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR))
+            if (m_decodedSliceInAU && m_cDecLib.isSliceNaluFirstInAU(true, nalu))
             {
-              if (decodedSliceInAU && m_cDecLib.isSliceNaluFirstInAU(true, nalu))
-              {
-                m_cDecLib.resetAccessUnitNals();
-                m_cDecLib.resetAccessUnitApsNals();
-                m_cDecLib.resetAccessUnitPicInfo();
-              }
-              bPicSkipped = false;
+              m_cDecLib.resetAccessUnitNals();
+              m_cDecLib.resetAccessUnitApsNals();
+              m_cDecLib.resetAccessUnitPicInfo();
             }
+            m_picSkipped = false;
           }
+        }
 
-          int skipFrameCounter = m_iSkipFrame;
-          m_cDecLib.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay, m_targetOlsIdx);
+        int skipFrameCounter = m_iSkipFrame;
+        m_cDecLib.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay, m_targetOlsIdx);
 
-          if ( prevPicSkipped && nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR )
-          {
-            gdrRecoveryPeriod[nalu.m_nuhLayerId] = true;
-          }
+        if ( m_prevPicSkipped && nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR )
+        {
+          m_gdrRecoveryPeriod[nalu.m_nuhLayerId] = true;
+        }
 
-          if ( skipFrameCounter == 1 && ( nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR  || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA ))
-          {
-            skipFrameCounter--;
-          }
+        if ( skipFrameCounter == 1 && ( nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR  || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA ))
+        {
+          skipFrameCounter--;
+        }
 
-          if ( m_iSkipFrame < skipFrameCounter  &&
-              ((nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_TRAIL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_STSA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RASL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR)))
+        if ( m_iSkipFrame < skipFrameCounter  &&
+            ((nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_TRAIL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_STSA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RASL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA) || (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_GDR)))
+        {
+          if (m_decodedSliceInAU && m_cDecLib.isSliceNaluFirstInAU(true, nalu))
           {
-            if (decodedSliceInAU && m_cDecLib.isSliceNaluFirstInAU(true, nalu))
-            {
-              m_cDecLib.checkSeiInPictureUnit();
-              m_cDecLib.resetPictureSeiNalus();
-              m_cDecLib.checkAPSInPictureUnit();
-              m_cDecLib.resetPictureUnitNals();
-              m_cDecLib.resetAccessUnitSeiTids();
-              m_cDecLib.checkSEIInAccessUnit();
-              m_cDecLib.resetAccessUnitSeiPayLoadTypes();
-              m_cDecLib.resetAccessUnitNals();
-              m_cDecLib.resetAccessUnitApsNals();
-              m_cDecLib.resetAccessUnitPicInfo();
-            }
-            bPicSkipped = true;
-            m_iSkipFrame++;   // skipFrame count restore, the real decrement occur at the begin of next frame
+            m_cDecLib.checkSeiInPictureUnit();
+            m_cDecLib.resetPictureSeiNalus();
+            m_cDecLib.checkAPSInPictureUnit();
+            m_cDecLib.resetPictureUnitNals();
+            m_cDecLib.resetAccessUnitSeiTids();
+            m_cDecLib.checkSEIInAccessUnit();
+            m_cDecLib.resetAccessUnitSeiPayLoadTypes();
+            m_cDecLib.resetAccessUnitNals();
+            m_cDecLib.resetAccessUnitApsNals();
+            m_cDecLib.resetAccessUnitPicInfo();
           }
+          m_picSkipped = true;
+          m_iSkipFrame++;   // skipFrame count restore, the real decrement occur at the begin of next frame
+        }
 
-          if (nalu.m_nalUnitType == NAL_UNIT_OPI)
-          {
-            if (!m_cDecLib.getHTidExternalSetFlag() && m_cDecLib.getOPI()->getHtidInfoPresentFlag())
-            {
-              m_maxTemporalLayer = m_cDecLib.getOPI()->getOpiHtidPlus1() - 1;
-            }
-            m_cDecLib.setHTidOpiSetFlag(m_cDecLib.getOPI()->getHtidInfoPresentFlag());
-          }
-          if (nalu.m_nalUnitType == NAL_UNIT_VPS)
-          {
-            m_cDecLib.deriveTargetOutputLayerSet( m_cDecLib.getVPS()->m_targetOlsIdx );
-            m_targetDecLayerIdSet = m_cDecLib.getVPS()->m_targetLayerIdSet;
-            m_targetOutputLayerIdSet = m_cDecLib.getVPS()->m_targetOutputLayerIdSet;
-          }
-          if (nalu.isSlice())
+        if (nalu.m_nalUnitType == NAL_UNIT_OPI)
+        {
+          if (!m_cDecLib.getHTidExternalSetFlag() && m_cDecLib.getOPI()->getHtidInfoPresentFlag())
           {
-            decodedSliceInAU = true;
+            m_maxTemporalLayer = m_cDecLib.getOPI()->getOpiHtidPlus1() - 1;
           }
+          m_cDecLib.setHTidOpiSetFlag(m_cDecLib.getOPI()->getHtidInfoPresentFlag());
         }
-        else
+        if (nalu.m_nalUnitType == NAL_UNIT_VPS)
         {
-          bPicSkipped = true;
-          if (nalu.isSlice())
-          {
-            m_cDecLib.setFirstSliceInPicture(false);
-          }
+          m_cDecLib.deriveTargetOutputLayerSet( m_cDecLib.getVPS()->m_targetOlsIdx );
+          m_targetDecLayerIdSet = m_cDecLib.getVPS()->m_targetLayerIdSet;
+          m_targetOutputLayerIdSet = m_cDecLib.getVPS()->m_targetOutputLayerIdSet;
+        }
+        if (nalu.isSlice())
+        {
+          m_decodedSliceInAU = true;
         }
       }
-
-      if( nalu.isSlice() && nalu.m_nalUnitType != NAL_UNIT_CODED_SLICE_RASL)
+      else
       {
-        prevPicSkipped = bPicSkipped;
+        m_picSkipped = true;
+        if (nalu.isSlice())
+        {
+          m_cDecLib.setFirstSliceInPicture(false);
+        }
       }
+    }
+
+    if( nalu.isSlice() && nalu.m_nalUnitType != NAL_UNIT_CODED_SLICE_RASL)
+    {
+      m_prevPicSkipped = m_picSkipped;
+    }
+
+    // once an EOS NAL unit appears in the current PU, mark the variable m_isEosPresentInPu as true
+    if (nalu.m_nalUnitType == NAL_UNIT_EOS)
+    {
+      m_isEosPresentInPu = true;
+      m_newCLVS[nalu.m_nuhLayerId] = true;  //The presence of EOS means that the next picture is the beginning of new CLVS
+      m_cDecLib.setEosPresentInPu(true);
+    }
+    // within the current PU, only EOS and EOB are allowed to be sent after an EOS nal unit
+    if(m_isEosPresentInPu)
+    {
+      CHECK(nalu.m_nalUnitType != NAL_UNIT_EOS && nalu.m_nalUnitType != NAL_UNIT_EOB, "When an EOS NAL unit is present in a PU, it shall be the last NAL unit among all NAL units within the PU other than other EOS NAL units or an EOB NAL unit");
+    }
+    m_lastNaluLayerId = nalu.m_nuhLayerId;
+  }
+  else
+  {
+    nalu.m_nuhLayerId = m_lastNaluLayerId;
+  }
 
-      // once an EOS NAL unit appears in the current PU, mark the variable isEosPresentInPu as true
+  if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
+  {
+    if (!m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId) && !m_picSkipped)
+    {
+      if (!m_loopFiltered[nalu.m_nuhLayerId] || bitstreamFile)
+      {
+        m_cDecLib.executeLoopFilters();
+        m_cDecLib.finishPicture(poc, m_pcListPic, INFO, m_newCLVS[nalu.m_nuhLayerId]);
+      }
+      m_loopFiltered[nalu.m_nuhLayerId] = (nalu.m_nalUnitType == NAL_UNIT_EOS);
       if (nalu.m_nalUnitType == NAL_UNIT_EOS)
       {
-        isEosPresentInPu = true;
-        m_newCLVS[nalu.m_nuhLayerId] = true;  //The presence of EOS means that the next picture is the beginning of new CLVS
-        m_cDecLib.setEosPresentInPu(true);
+        m_cDecLib.setFirstSliceInSequence(true, nalu.m_nuhLayerId);
       }
-      // within the current PU, only EOS and EOB are allowed to be sent after an EOS nal unit
-      if(isEosPresentInPu)
+
+      m_cDecLib.updateAssociatedIRAP();
+      m_cDecLib.updatePrevGDRInSameLayer();
+      m_cDecLib.updatePrevIRAPAndGDRSubpic();
+
+      if (m_gdrRecoveryPeriod[nalu.m_nuhLayerId])
       {
-        CHECK(nalu.m_nalUnitType != NAL_UNIT_EOS && nalu.m_nalUnitType != NAL_UNIT_EOB, "When an EOS NAL unit is present in a PU, it shall be the last NAL unit among all NAL units within the PU other than other EOS NAL units or an EOB NAL unit");
+        if (m_cDecLib.getGDRRecoveryPocReached())
+        {
+          m_gdrRecoveryPeriod[nalu.m_nuhLayerId] = false;
+        }
       }
-      lastNaluLayerId = nalu.m_nuhLayerId;
     }
     else
     {
-      nalu.m_nuhLayerId = lastNaluLayerId;
+      m_cDecLib.setFirstSliceInPicture(true);
     }
+  }
 
-    if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
+  if( m_pcListPic )
+  {
+    if ( m_gdrRecoveryPeriod[nalu.m_nuhLayerId] ) // Suppress YUV and OPL output during GDR recovery
     {
-      if (!m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId) && !bPicSkipped)
+      PicList::iterator iterPic = m_pcListPic->begin();
+      while (iterPic != m_pcListPic->end())
       {
-        if (!loopFiltered[nalu.m_nuhLayerId] || bitstreamFile)
-        {
-          m_cDecLib.executeLoopFilters();
-          m_cDecLib.finishPicture(poc, pcListPic, INFO, m_newCLVS[nalu.m_nuhLayerId]);
-        }
-        loopFiltered[nalu.m_nuhLayerId] = (nalu.m_nalUnitType == NAL_UNIT_EOS);
-        if (nalu.m_nalUnitType == NAL_UNIT_EOS)
+        Picture *pcPic = *(iterPic++);
+        if (pcPic->layerId == nalu.m_nuhLayerId)
         {
-          m_cDecLib.setFirstSliceInSequence(true, nalu.m_nuhLayerId);
+          pcPic->neededForOutput = false;
         }
+      }
+    }
 
-        m_cDecLib.updateAssociatedIRAP();
-        m_cDecLib.updatePrevGDRInSameLayer();
-        m_cDecLib.updatePrevIRAPAndGDRSubpic();
+    BitDepths layerOutputBitDepth;
 
-        if (gdrRecoveryPeriod[nalu.m_nuhLayerId])
-        {
-          if (m_cDecLib.getGDRRecoveryPocReached())
-          {
-            gdrRecoveryPeriod[nalu.m_nuhLayerId] = false;
-          }
-        }
-      }
-      else
+    PicList::iterator iterPicLayer = m_pcListPic->begin();
+    for (; iterPicLayer != m_pcListPic->end(); ++iterPicLayer)
+    {
+      if ((*iterPicLayer)->layerId == nalu.m_nuhLayerId)
       {
-        m_cDecLib.setFirstSliceInPicture(true);
+        break;
       }
     }
-
-    if( pcListPic )
+    if (iterPicLayer != m_pcListPic->end())
     {
-      if ( gdrRecoveryPeriod[nalu.m_nuhLayerId] ) // Suppress YUV and OPL output during GDR recovery
+      BitDepths &bitDepths = (*iterPicLayer)->m_bitDepths;
+
+      for (auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
       {
-        PicList::iterator iterPic = pcListPic->begin();
-        while (iterPic != pcListPic->end())
+        if (m_outputBitDepth[channelType] == 0)
         {
-          Picture *pcPic = *(iterPic++);
-          if (pcPic->layerId == nalu.m_nuhLayerId)
-          {
-            pcPic->neededForOutput = false;
-          }
+          layerOutputBitDepth[channelType] = bitDepths[channelType];
         }
-      }
-
-      BitDepths layerOutputBitDepth;
-
-      PicList::iterator iterPicLayer = pcListPic->begin();
-      for (; iterPicLayer != pcListPic->end(); ++iterPicLayer)
-      {
-        if ((*iterPicLayer)->layerId == nalu.m_nuhLayerId)
+        else
         {
-          break;
+          layerOutputBitDepth[channelType] = m_outputBitDepth[channelType];
         }
       }
-      if (iterPicLayer != pcListPic->end())
+      if (m_packedYUVMode
+          && (layerOutputBitDepth[ChannelType::LUMA] != 10 && layerOutputBitDepth[ChannelType::LUMA] != 12))
       {
-        BitDepths &bitDepths = (*iterPicLayer)->m_bitDepths;
+        EXIT("Invalid output bit-depth for packed YUV output, aborting\n");
+      }
 
-        for (auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
-        {
-          if (m_outputBitDepth[channelType] == 0)
-          {
-            layerOutputBitDepth[channelType] = bitDepths[channelType];
-          }
-          else
-          {
-            layerOutputBitDepth[channelType] = m_outputBitDepth[channelType];
-          }
-        }
-        if (m_packedYUVMode
-            && (layerOutputBitDepth[ChannelType::LUMA] != 10 && layerOutputBitDepth[ChannelType::LUMA] != 12))
+      if (!m_reconFileName.empty() && !m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].isOpen())
+      {
+        const auto  vps           = m_cDecLib.getVPS();
+        std::string reconFileName = m_reconFileName;
+
+        if (m_reconFileName.compare("/dev/null") && vps != nullptr && vps->getMaxLayers() > 1
+            && xIsNaluWithinTargetOutputLayerIdSet(&nalu))
         {
-          EXIT("Invalid output bit-depth for packed YUV output, aborting\n");
+          const size_t      pos         = reconFileName.find_last_of('.');
+          const std::string layerString = std::string(".layer") + std::to_string(nalu.m_nuhLayerId);
+
+          reconFileName.insert(pos, layerString);
         }
 
-        if (!m_reconFileName.empty() && !m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].isOpen())
+        if (vps == nullptr || vps->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))
         {
-          const auto  vps           = m_cDecLib.getVPS();
-          std::string reconFileName = m_reconFileName;
-
-          if (m_reconFileName.compare("/dev/null") && vps != nullptr && vps->getMaxLayers() > 1
-              && xIsNaluWithinTargetOutputLayerIdSet(&nalu))
+          if (isY4mFileExt(reconFileName))
           {
-            const size_t      pos         = reconFileName.find_last_of('.');
-            const std::string layerString = std::string(".layer") + std::to_string(nalu.m_nuhLayerId);
+            const auto sps        = m_pcListPic->front()->cs->sps;
+            Fraction   frameRate  = DEFAULT_FRAME_RATE;
 
-            reconFileName.insert(pos, layerString);
-          }
-
-          if (vps == nullptr || vps->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))
-          {
-            if (isY4mFileExt(reconFileName))
+            const bool useSpsData = sps->getGeneralHrdParametersPresentFlag();
+            if (useSpsData || (vps != nullptr && vps->getVPSGeneralHrdParamsPresentFlag()))
             {
-              const auto sps        = pcListPic->front()->cs->sps;
-              Fraction   frameRate  = DEFAULT_FRAME_RATE;
+              const GeneralHrdParams* hrd =
+                useSpsData ? sps->getGeneralHrdParameters() : vps->getGeneralHrdParameters();
 
-              const bool useSpsData = sps->getGeneralHrdParametersPresentFlag();
-              if (useSpsData || (vps != nullptr && vps->getVPSGeneralHrdParamsPresentFlag()))
-              {
-                const GeneralHrdParams* hrd =
-                  useSpsData ? sps->getGeneralHrdParameters() : vps->getGeneralHrdParameters();
-
-                const int tLayer = m_maxTemporalLayer == TL_INFINITY
-                                     ? (useSpsData ? sps->getMaxTLayers() - 1 : vps->getMaxSubLayers() - 1)
-                                     : m_maxTemporalLayer;
+              const int tLayer = m_maxTemporalLayer == TL_INFINITY
+                                   ? (useSpsData ? sps->getMaxTLayers() - 1 : vps->getMaxSubLayers() - 1)
+                                   : m_maxTemporalLayer;
 
-                const OlsHrdParams& olsHrdParam =
-                  (useSpsData ? sps->getOlsHrdParameters() : vps->getOlsHrdParameters(vps->m_targetOlsIdx))[tLayer];
+              const OlsHrdParams& olsHrdParam =
+                (useSpsData ? sps->getOlsHrdParameters() : vps->getOlsHrdParameters(vps->m_targetOlsIdx))[tLayer];
 
-                int elementDurationInTc = 1;
-                if (olsHrdParam.getFixedPicRateWithinCvsFlag())
-                {
-                  elementDurationInTc = olsHrdParam.getElementDurationInTc();
-                }
-                else
-                {
-                  msg(WARNING,
-                      "\nWarning: No fixed picture rate info is found in the bitstream, best guess is used.\n");
-                }
-                frameRate.num = hrd->getTimeScale();
-                frameRate.den = hrd->getNumUnitsInTick() * elementDurationInTc;
-                const int gcd = std::gcd(frameRate.num, frameRate.den);
-                frameRate.num /= gcd;
-                frameRate.den /= gcd;
-              }
-              else
+              int elementDurationInTc = 1;
+              if (olsHrdParam.getFixedPicRateWithinCvsFlag())
               {
-                msg(WARNING, "\nWarning: No frame rate info found in the bitstream, default 50 fps is used.\n");
-              }
-              const auto pps = pcListPic->front()->cs->pps;
-              const auto sx = SPS::getWinUnitX(sps->getChromaFormatIdc());
-              const auto sy = SPS::getWinUnitY(sps->getChromaFormatIdc());
-              int picWidth = 0, picHeight = 0;
-              if (m_upscaledOutput == 2)
-              {
-                auto confWindow = sps->getConformanceWindow();
-                picWidth = sps->getMaxPicWidthInLumaSamples() -(confWindow.getWindowLeftOffset() + confWindow.getWindowRightOffset()) * sx;
-                picHeight = sps->getMaxPicHeightInLumaSamples() - (confWindow.getWindowTopOffset() + confWindow.getWindowBottomOffset()) * sy;
+                elementDurationInTc = olsHrdParam.getElementDurationInTc();
               }
               else
               {
-                auto confWindow = pps->getConformanceWindow();
-                picWidth = pps->getPicWidthInLumaSamples() - (confWindow.getWindowLeftOffset() + confWindow.getWindowRightOffset()) * sx;
-                picHeight = pps->getPicHeightInLumaSamples() - (confWindow.getWindowTopOffset() + confWindow.getWindowBottomOffset()) * sy;
-              }              
-              m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setOutputY4mInfo(
-                picWidth, picHeight, frameRate, layerOutputBitDepth[ChannelType::LUMA], sps->getChromaFormatIdc(),
-                sps->getVuiParameters()->getChromaSampleLocType());
+                msg(WARNING,
+                    "\nWarning: No fixed picture rate info is found in the bitstream, best guess is used.\n");
+              }
+              frameRate.num = hrd->getTimeScale();
+              frameRate.den = hrd->getNumUnitsInTick() * elementDurationInTc;
+              const int gcd = std::gcd(frameRate.num, frameRate.den);
+              frameRate.num /= gcd;
+              frameRate.den /= gcd;
+            }
+            else
+            {
+              msg(WARNING, "\nWarning: No frame rate info found in the bitstream, default 50 fps is used.\n");
             }
-            m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].open(reconFileName, true, layerOutputBitDepth,
-                                                           layerOutputBitDepth, bitDepths);   // write mode
+            const auto pps = m_pcListPic->front()->cs->pps;
+            const auto sx = SPS::getWinUnitX(sps->getChromaFormatIdc());
+            const auto sy = SPS::getWinUnitY(sps->getChromaFormatIdc());
+            int picWidth = 0, picHeight = 0;
+            if (m_upscaledOutput == 2)
+            {
+              auto confWindow = sps->getConformanceWindow();
+              picWidth = sps->getMaxPicWidthInLumaSamples() -(confWindow.getWindowLeftOffset() + confWindow.getWindowRightOffset()) * sx;
+              picHeight = sps->getMaxPicHeightInLumaSamples() - (confWindow.getWindowTopOffset() + confWindow.getWindowBottomOffset()) * sy;
+            }
+            else
+            {
+              auto confWindow = m_pcListPic->front()->getConformanceWindow();
+              picWidth = pps->getPicWidthInLumaSamples() - (confWindow.getWindowLeftOffset() + confWindow.getWindowRightOffset()) * sx;
+              picHeight = pps->getPicHeightInLumaSamples() - (confWindow.getWindowTopOffset() + confWindow.getWindowBottomOffset()) * sy;
+            }              
+            m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setOutputY4mInfo(
+              picWidth, picHeight, frameRate, layerOutputBitDepth[ChannelType::LUMA], sps->getChromaFormatIdc(),
+              sps->getVuiParameters()->getChromaSampleLocType());
           }
+          m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].open(reconFileName, true, layerOutputBitDepth,
+                                                         layerOutputBitDepth, bitDepths);   // write mode
         }
-        // update file bitdepth shift if recon bitdepth changed between sequences
-        for (auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
+      }
+      // update file bitdepth shift if recon bitdepth changed between sequences
+      for (auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
+      {
+        int reconBitdepth = (*iterPicLayer)->m_bitDepths[( ChannelType) channelType];
+        int fileBitdepth  = m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].getFileBitdepth(channelType);
+        int bitdepthShift = m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].getBitdepthShift(channelType);
+        if (fileBitdepth + bitdepthShift != reconBitdepth)
         {
-          int reconBitdepth = (*iterPicLayer)->m_bitDepths[( ChannelType) channelType];
-          int fileBitdepth  = m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].getFileBitdepth(channelType);
-          int bitdepthShift = m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].getBitdepthShift(channelType);
-          if (fileBitdepth + bitdepthShift != reconBitdepth)
-          {
-            m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setBitdepthShift(channelType, reconBitdepth - fileBitdepth);
-          }
+          m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setBitdepthShift(channelType, reconBitdepth - fileBitdepth);
         }
+      }
 
-        if (!m_SEIFGSFileName.empty() && !m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].isOpen())
+      if (!m_SEIFGSFileName.empty() && !m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].isOpen())
+      {
+        std::string SEIFGSFileName = m_SEIFGSFileName;
+        if (m_SEIFGSFileName.compare("/dev/null") && m_cDecLib.getVPS() != nullptr && m_cDecLib.getVPS()->getMaxLayers() > 1 && xIsNaluWithinTargetOutputLayerIdSet(&nalu))
         {
-          std::string SEIFGSFileName = m_SEIFGSFileName;
-          if (m_SEIFGSFileName.compare("/dev/null") && m_cDecLib.getVPS() != nullptr && m_cDecLib.getVPS()->getMaxLayers() > 1 && xIsNaluWithinTargetOutputLayerIdSet(&nalu))
+          size_t      pos         = SEIFGSFileName.find_last_of('.');
+          std::string layerString = std::string(".layer") + std::to_string(nalu.m_nuhLayerId);
+          if (pos != std::string::npos)
           {
-            size_t      pos         = SEIFGSFileName.find_last_of('.');
-            std::string layerString = std::string(".layer") + std::to_string(nalu.m_nuhLayerId);
-            if (pos != std::string::npos)
-            {
-              SEIFGSFileName.insert(pos, layerString);
-            }
-            else
-            {
-              SEIFGSFileName.append(layerString);
-            }
+            SEIFGSFileName.insert(pos, layerString);
           }
-          if ((m_cDecLib.getVPS() != nullptr && (m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))) || m_cDecLib.getVPS() == nullptr)
+          else
           {
-            m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].open(SEIFGSFileName, true, layerOutputBitDepth,
-                                                           layerOutputBitDepth, bitDepths);   // write mode
+            SEIFGSFileName.append(layerString);
           }
         }
-        // update file bitdepth shift if recon bitdepth changed between sequences
-        if (!m_SEIFGSFileName.empty())
+        if ((m_cDecLib.getVPS() != nullptr && (m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))) || m_cDecLib.getVPS() == nullptr)
+        {
+          m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].open(SEIFGSFileName, true, layerOutputBitDepth,
+                                                         layerOutputBitDepth, bitDepths);   // write mode
+        }
+      }
+      // update file bitdepth shift if recon bitdepth changed between sequences
+      if (!m_SEIFGSFileName.empty())
+      {
+        for (const auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
         {
-          for (const auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
+          int reconBitdepth = (*iterPicLayer)->m_bitDepths[( ChannelType) channelType];
+          int fileBitdepth  = m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].getFileBitdepth(channelType);
+          int bitdepthShift = m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].getBitdepthShift(channelType);
+          if (fileBitdepth + bitdepthShift != reconBitdepth)
           {
-            int reconBitdepth = (*iterPicLayer)->m_bitDepths[( ChannelType) channelType];
-            int fileBitdepth  = m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].getFileBitdepth(channelType);
-            int bitdepthShift = m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].getBitdepthShift(channelType);
-            if (fileBitdepth + bitdepthShift != reconBitdepth)
-            {
-              m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].setBitdepthShift(channelType, reconBitdepth - fileBitdepth);
-            }
+            m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].setBitdepthShift(channelType, reconBitdepth - fileBitdepth);
           }
         }
+      }
 
-        if (!m_SEICTIFileName.empty() && !m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].isOpen())
+      if (!m_SEICTIFileName.empty() && !m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].isOpen())
+      {
+        std::string SEICTIFileName = m_SEICTIFileName;
+        if (m_SEICTIFileName.compare("/dev/null") && m_cDecLib.getVPS() != nullptr && m_cDecLib.getVPS()->getMaxLayers() > 1 && xIsNaluWithinTargetOutputLayerIdSet(&nalu))
         {
-          std::string SEICTIFileName = m_SEICTIFileName;
-          if (m_SEICTIFileName.compare("/dev/null") && m_cDecLib.getVPS() != nullptr && m_cDecLib.getVPS()->getMaxLayers() > 1 && xIsNaluWithinTargetOutputLayerIdSet(&nalu))
+          size_t pos = SEICTIFileName.find_last_of('.');
+          if (pos != std::string::npos)
           {
-            size_t pos = SEICTIFileName.find_last_of('.');
-            if (pos != std::string::npos)
-            {
-              SEICTIFileName.insert(pos, std::to_string(nalu.m_nuhLayerId));
-            }
-            else
-            {
-              SEICTIFileName.append(std::to_string(nalu.m_nuhLayerId));
-            }
+            SEICTIFileName.insert(pos, std::to_string(nalu.m_nuhLayerId));
           }
-          if ((m_cDecLib.getVPS() != nullptr && (m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))) || m_cDecLib.getVPS() == nullptr)
+          else
           {
-            m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].open(SEICTIFileName, true, layerOutputBitDepth,
-                                                            layerOutputBitDepth, bitDepths);   // write mode
+            SEICTIFileName.append(std::to_string(nalu.m_nuhLayerId));
           }
         }
+        if ((m_cDecLib.getVPS() != nullptr && (m_cDecLib.getVPS()->getMaxLayers() == 1 || xIsNaluWithinTargetOutputLayerIdSet(&nalu))) || m_cDecLib.getVPS() == nullptr)
+        {
+          m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].open(SEICTIFileName, true, layerOutputBitDepth,
+                                                          layerOutputBitDepth, bitDepths);   // write mode
+        }
       }
-      if (!m_annotatedRegionsSEIFileName.empty())
-      {
-        xOutputAnnotatedRegions(pcListPic);
-      }
+    }
+    if (!m_annotatedRegionsSEIFileName.empty())
+    {
+      xOutputAnnotatedRegions(m_pcListPic);
+    }
 
-      PicList::iterator iterPic = pcListPic->begin();
-      Picture* pcPic = *(iterPic);
-      SEIMessages       shutterIntervalInfo = getSeisByType(pcPic->SEIs, SEI::PayloadType::SHUTTER_INTERVAL_INFO);
+    PicList::iterator iterPic = m_pcListPic->begin();
+    Picture* pcPic = *(iterPic);
+    SEIMessages       shutterIntervalInfo = getSeisByType(pcPic->SEIs, SEI::PayloadType::SHUTTER_INTERVAL_INFO);
 
-      if (!m_shutterIntervalPostFileName.empty())
+    if (!m_shutterIntervalPostFileName.empty())
+    {
+      bool                    hasValidSII = true;
+      SEIShutterIntervalInfo *curSIIInfo  = nullptr;
+      if ((pcPic->getPictureType() == NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
+        pcPic->getPictureType() == NAL_UNIT_CODED_SLICE_IDR_N_LP) && m_newCLVS[nalu.m_nuhLayerId])
       {
-        bool                    hasValidSII = true;
-        SEIShutterIntervalInfo *curSIIInfo  = nullptr;
-        if ((pcPic->getPictureType() == NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
-          pcPic->getPictureType() == NAL_UNIT_CODED_SLICE_IDR_N_LP) && m_newCLVS[nalu.m_nuhLayerId])
-        {
-          IdrSiiInfo curSII;
-          curSII.m_picPoc = pcPic->getPOC();
+        IdrSiiInfo curSII;
+        curSII.m_picPoc = pcPic->getPOC();
 
-          curSII.m_isValidSii                             = false;
-          curSII.m_siiInfo.m_siiEnabled                   = false;
-          curSII.m_siiInfo.m_siiNumUnitsInShutterInterval = 0;
-          curSII.m_siiInfo.m_siiTimeScale = 0;
-          curSII.m_siiInfo.m_siiMaxSubLayersMinus1 = 0;
-          curSII.m_siiInfo.m_siiFixedSIwithinCLVS = 0;
+        curSII.m_isValidSii                             = false;
+        curSII.m_siiInfo.m_siiEnabled                   = false;
+        curSII.m_siiInfo.m_siiNumUnitsInShutterInterval = 0;
+        curSII.m_siiInfo.m_siiTimeScale = 0;
+        curSII.m_siiInfo.m_siiMaxSubLayersMinus1 = 0;
+        curSII.m_siiInfo.m_siiFixedSIwithinCLVS = 0;
 
-          if (shutterIntervalInfo.size() > 0)
-          {
-            SEIShutterIntervalInfo *seiShutterIntervalInfo = (SEIShutterIntervalInfo*) *(shutterIntervalInfo.begin());
-            curSII.m_isValidSii                            = true;
-
-            curSII.m_siiInfo.m_siiEnabled = seiShutterIntervalInfo->m_siiEnabled;
-            curSII.m_siiInfo.m_siiNumUnitsInShutterInterval = seiShutterIntervalInfo->m_siiNumUnitsInShutterInterval;
-            curSII.m_siiInfo.m_siiTimeScale = seiShutterIntervalInfo->m_siiTimeScale;
-            curSII.m_siiInfo.m_siiMaxSubLayersMinus1 = seiShutterIntervalInfo->m_siiMaxSubLayersMinus1;
-            curSII.m_siiInfo.m_siiFixedSIwithinCLVS = seiShutterIntervalInfo->m_siiFixedSIwithinCLVS;
-            curSII.m_siiInfo.m_siiSubLayerNumUnitsInSI.clear();
-            for (int i = 0; i < seiShutterIntervalInfo->m_siiSubLayerNumUnitsInSI.size(); i++)
-            {
-              curSII.m_siiInfo.m_siiSubLayerNumUnitsInSI.push_back(seiShutterIntervalInfo->m_siiSubLayerNumUnitsInSI[i]);
-            }
-
-            uint32_t tmpInfo = (uint32_t)(m_activeSiiInfo.size() + 1);
-            m_activeSiiInfo.insert(std::pair<uint32_t, IdrSiiInfo>(tmpInfo, curSII));
-            curSIIInfo = seiShutterIntervalInfo;
-          }
-          else
+        if (shutterIntervalInfo.size() > 0)
+        {
+          SEIShutterIntervalInfo *seiShutterIntervalInfo = (SEIShutterIntervalInfo*) *(shutterIntervalInfo.begin());
+          curSII.m_isValidSii                            = true;
+
+          curSII.m_siiInfo.m_siiEnabled = seiShutterIntervalInfo->m_siiEnabled;
+          curSII.m_siiInfo.m_siiNumUnitsInShutterInterval = seiShutterIntervalInfo->m_siiNumUnitsInShutterInterval;
+          curSII.m_siiInfo.m_siiTimeScale = seiShutterIntervalInfo->m_siiTimeScale;
+          curSII.m_siiInfo.m_siiMaxSubLayersMinus1 = seiShutterIntervalInfo->m_siiMaxSubLayersMinus1;
+          curSII.m_siiInfo.m_siiFixedSIwithinCLVS = seiShutterIntervalInfo->m_siiFixedSIwithinCLVS;
+          curSII.m_siiInfo.m_siiSubLayerNumUnitsInSI.clear();
+          for (int i = 0; i < seiShutterIntervalInfo->m_siiSubLayerNumUnitsInSI.size(); i++)
           {
-            curSII.m_isValidSii = false;
-            hasValidSII         = false;
-            uint32_t tmpInfo = (uint32_t)(m_activeSiiInfo.size() + 1);
-            m_activeSiiInfo.insert(std::pair<uint32_t, IdrSiiInfo>(tmpInfo, curSII));
+            curSII.m_siiInfo.m_siiSubLayerNumUnitsInSI.push_back(seiShutterIntervalInfo->m_siiSubLayerNumUnitsInSI[i]);
           }
+
+          uint32_t tmpInfo = (uint32_t)(m_activeSiiInfo.size() + 1);
+          m_activeSiiInfo.insert(std::pair<uint32_t, IdrSiiInfo>(tmpInfo, curSII));
+          curSIIInfo = seiShutterIntervalInfo;
         }
         else
         {
-          if (m_activeSiiInfo.size() == 1)
-          {
-            curSIIInfo = &(m_activeSiiInfo.begin()->second.m_siiInfo);
-          }
-          else
+          curSII.m_isValidSii = false;
+          hasValidSII         = false;
+          uint32_t tmpInfo = (uint32_t)(m_activeSiiInfo.size() + 1);
+          m_activeSiiInfo.insert(std::pair<uint32_t, IdrSiiInfo>(tmpInfo, curSII));
+        }
+      }
+      else
+      {
+        if (m_activeSiiInfo.size() == 1)
+        {
+          curSIIInfo = &(m_activeSiiInfo.begin()->second.m_siiInfo);
+        }
+        else
+        {
+          bool isLast = true;
+          for (int i = 1; i < m_activeSiiInfo.size() + 1; i++)
           {
-            bool isLast = true;
-            for (int i = 1; i < m_activeSiiInfo.size() + 1; i++)
+            if (pcPic->getPOC() <= m_activeSiiInfo.at(i).m_picPoc)
             {
-              if (pcPic->getPOC() <= m_activeSiiInfo.at(i).m_picPoc)
+              if (m_activeSiiInfo[i - 1].m_isValidSii)
               {
-                if (m_activeSiiInfo[i - 1].m_isValidSii)
-                {
-                  curSIIInfo = &(m_activeSiiInfo.at(i - 1).m_siiInfo);
-                }
-                else
-                {
-                  hasValidSII = false;
-                }
-                isLast = false;
-                break;
+                curSIIInfo = &(m_activeSiiInfo.at(i - 1).m_siiInfo);
               }
+              else
+              {
+                hasValidSII = false;
+              }
+              isLast = false;
+              break;
             }
-            if (isLast)
-            {
-              uint32_t tmpInfo = (uint32_t)(m_activeSiiInfo.size());
-              curSIIInfo = &(m_activeSiiInfo.at(tmpInfo).m_siiInfo);
-            }
+          }
+          if (isLast)
+          {
+            uint32_t tmpInfo = (uint32_t)(m_activeSiiInfo.size());
+            curSIIInfo = &(m_activeSiiInfo.at(tmpInfo).m_siiInfo);
           }
         }
+      }
 
-        if (hasValidSII)
+      if (hasValidSII)
+      {
+        if (!curSIIInfo->m_siiFixedSIwithinCLVS)
         {
-          if (!curSIIInfo->m_siiFixedSIwithinCLVS)
+          uint32_t siiMaxSubLayersMinus1 = curSIIInfo->m_siiMaxSubLayersMinus1;
+          uint32_t numUnitsLFR = curSIIInfo->m_siiSubLayerNumUnitsInSI[0];
+          uint32_t numUnitsHFR = curSIIInfo->m_siiSubLayerNumUnitsInSI[siiMaxSubLayersMinus1];
+
+          int blending_ratio = (numUnitsLFR / numUnitsHFR);
+          bool checkEqualValuesOfSFR = true;
+          bool checkSubLayerSI       = false;
+          int i;
+
+          //supports only the case of SFR = HFR / 2
+          if (curSIIInfo->m_siiSubLayerNumUnitsInSI[siiMaxSubLayersMinus1] <
+                      curSIIInfo->m_siiSubLayerNumUnitsInSI[siiMaxSubLayersMinus1 - 1])
           {
-            uint32_t siiMaxSubLayersMinus1 = curSIIInfo->m_siiMaxSubLayersMinus1;
-            uint32_t numUnitsLFR = curSIIInfo->m_siiSubLayerNumUnitsInSI[0];
-            uint32_t numUnitsHFR = curSIIInfo->m_siiSubLayerNumUnitsInSI[siiMaxSubLayersMinus1];
-
-            int blending_ratio = (numUnitsLFR / numUnitsHFR);
-            bool checkEqualValuesOfSFR = true;
-            bool checkSubLayerSI       = false;
-            int i;
-
-            //supports only the case of SFR = HFR / 2
-            if (curSIIInfo->m_siiSubLayerNumUnitsInSI[siiMaxSubLayersMinus1] <
-                        curSIIInfo->m_siiSubLayerNumUnitsInSI[siiMaxSubLayersMinus1 - 1])
-            {
-              checkSubLayerSI = true;
-            }
-            else
-            {
-              fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled due to SFR != (HFR / 2) \n");
-            }
-            //check shutter interval for all sublayer remains same for SFR pictures
-            for (i = 1; i < siiMaxSubLayersMinus1; i++)
-            {
-              if (curSIIInfo->m_siiSubLayerNumUnitsInSI[0] != curSIIInfo->m_siiSubLayerNumUnitsInSI[i])
-              {
-                checkEqualValuesOfSFR = false;
-              }
-            }
-            if (!checkEqualValuesOfSFR)
-            {
-              fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled when shutter interval is not same for SFR sublayers \n");
-            }
-            if (checkSubLayerSI && checkEqualValuesOfSFR)
-            {
-              setShutterFilterFlag(numUnitsLFR == blending_ratio * numUnitsHFR);
-              setBlendingRatio(blending_ratio);
-            }
-            else
-            {
-              setShutterFilterFlag(false);
-            }
-
-            const SPS* activeSPS = pcListPic->front()->cs->sps;
-
-            if (numUnitsLFR == blending_ratio * numUnitsHFR && activeSPS->getMaxTLayers() == 1 && activeSPS->getMaxDecPicBuffering(0) == 1)
+            checkSubLayerSI = true;
+          }
+          else
+          {
+            fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled due to SFR != (HFR / 2) \n");
+          }
+          //check shutter interval for all sublayer remains same for SFR pictures
+          for (i = 1; i < siiMaxSubLayersMinus1; i++)
+          {
+            if (curSIIInfo->m_siiSubLayerNumUnitsInSI[0] != curSIIInfo->m_siiSubLayerNumUnitsInSI[i])
             {
-              fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled for single TempLayer and single frame in DPB\n");
-              setShutterFilterFlag(false);
+              checkEqualValuesOfSFR = false;
             }
           }
+          if (!checkEqualValuesOfSFR)
+          {
+            fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled when shutter interval is not same for SFR sublayers \n");
+          }
+          if (checkSubLayerSI && checkEqualValuesOfSFR)
+          {
+            setShutterFilterFlag(numUnitsLFR == blending_ratio * numUnitsHFR);
+            setBlendingRatio(blending_ratio);
+          }
           else
           {
-            fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled for fixed shutter interval case\n");
+            setShutterFilterFlag(false);
+          }
+
+          const SPS* activeSPS = m_pcListPic->front()->cs->sps;
+
+          if (numUnitsLFR == blending_ratio * numUnitsHFR && activeSPS->getMaxTLayers() == 1 && activeSPS->getMaxDecPicBuffering(0) == 1)
+          {
+            fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled for single TempLayer and single frame in DPB\n");
             setShutterFilterFlag(false);
           }
         }
         else
         {
-          fprintf(stderr, "Warning: Shutter Interval information should be specified in SII-SEI message\n");
+          fprintf(stderr, "Warning: Shutter Interval SEI message processing is disabled for fixed shutter interval case\n");
           setShutterFilterFlag(false);
         }
       }
-
-
-      if (iterPicLayer != pcListPic->end())
+      else
       {
-        if ((!m_shutterIntervalPostFileName.empty()) && (!openedPostFile) && getShutterFilterFlag())
-        {
-          BitDepths &bitDepths = (*iterPicLayer)->m_bitDepths;
-          std::ofstream ofile(m_shutterIntervalPostFileName.c_str());
-          if (!ofile.good() || !ofile.is_open())
-          {
-            fprintf(stderr, "\nUnable to open file '%s' for writing shutter-interval-SEI video\n", m_shutterIntervalPostFileName.c_str());
-            exit(EXIT_FAILURE);
-          }
-          m_cTVideoIOYuvSIIPostFile.open(m_shutterIntervalPostFileName, true, layerOutputBitDepth, layerOutputBitDepth,
-                                         bitDepths);   // write mode
-          openedPostFile = true;
-        }
+        fprintf(stderr, "Warning: Shutter Interval information should be specified in SII-SEI message\n");
+        setShutterFilterFlag(false);
       }
+    }
 
-      // write reconstruction to file
-      if( bNewPicture )
-      {
-        setOutputPicturePresentInStream();
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-      }
-      if (nalu.m_nalUnitType == NAL_UNIT_EOS)
+
+    if (iterPicLayer != m_pcListPic->end())
+    {
+      if ((!m_shutterIntervalPostFileName.empty()) && (!m_openedPostFile) && getShutterFilterFlag())
       {
-        if (!m_annotatedRegionsSEIFileName.empty() && bNewPicture)
+        BitDepths &bitDepths = (*iterPicLayer)->m_bitDepths;
+        std::ofstream ofile(m_shutterIntervalPostFileName.c_str());
+        if (!ofile.good() || !ofile.is_open())
         {
-          xOutputAnnotatedRegions(pcListPic);
+          fprintf(stderr, "\nUnable to open file '%s' for writing shutter-interval-SEI video\n", m_shutterIntervalPostFileName.c_str());
+          exit(EXIT_FAILURE);
         }
-        setOutputPicturePresentInStream();
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-        m_cDecLib.setFirstSliceInPicture (false);
-      }
-      // write reconstruction to file -- for additional bumping as defined in C.5.2.3
-      if (!bNewPicture && ((nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL_11)
-        || (nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GDR)))
-      {
-        setOutputPicturePresentInStream();
-        xWriteOutput( pcListPic, nalu.m_temporalId );
+        m_cTVideoIOYuvSIIPostFile.open(m_shutterIntervalPostFileName, true, layerOutputBitDepth, layerOutputBitDepth,
+                                       bitDepths);   // write mode
+        m_openedPostFile = true;
       }
     }
+
+    // write reconstruction to file
     if( bNewPicture )
     {
-      m_cDecLib.checkSeiInPictureUnit();
-      m_cDecLib.resetPictureSeiNalus();
-      // reset the EOS present status for the next PU check
-      isEosPresentInLastPu = isEosPresentInPu;
-      isEosPresentInPu = false;
-    }
-    if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
-    {
-      m_cDecLib.checkAPSInPictureUnit();
-      m_cDecLib.resetPictureUnitNals();
+      xSetOutputPicturePresentInStream();
+      xWriteOutput( m_pcListPic, nalu.m_temporalId );
     }
-    if (bNewAccessUnit || !bitstreamFile)
+    if (nalu.m_nalUnitType == NAL_UNIT_EOS)
     {
-      m_cDecLib.CheckNoOutputPriorPicFlagsInAccessUnit();
-      m_cDecLib.resetAccessUnitNoOutputPriorPicFlags();
-      m_cDecLib.checkLayerIdIncludedInCvss();
-      m_cDecLib.checkSEIInAccessUnit();
-      m_cDecLib.resetAccessUnitNestedSliSeiInfo();
-      m_cDecLib.resetIsFirstAuInCvs();
-      m_cDecLib.resetAccessUnitEos();
-      m_cDecLib.resetAudIrapOrGdrAuFlag();
+      if (!m_annotatedRegionsSEIFileName.empty() && bNewPicture)
+      {
+        xOutputAnnotatedRegions(m_pcListPic);
+      }
+      xSetOutputPicturePresentInStream();
+      xWriteOutput( m_pcListPic, nalu.m_temporalId );
+      m_cDecLib.setFirstSliceInPicture (false);
     }
-    if(bNewAccessUnit)
+    // write reconstruction to file -- for additional bumping as defined in C.5.2.3
+    if (!bNewPicture && ((nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL_11)
+      || (nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GDR)))
     {
-      decodedSliceInAU = false;
-      m_cDecLib.checkTidLayerIdInAccessUnit();
-      m_cDecLib.resetAccessUnitSeiTids();
-      m_cDecLib.resetAccessUnitSeiPayLoadTypes();
-      m_cDecLib.checkSeiContentInAccessUnit();
-      m_cDecLib.resetAccessUnitSeiNalus();
-      m_cDecLib.resetAccessUnitNals();
-      m_cDecLib.resetAccessUnitApsNals();
-      m_cDecLib.resetAccessUnitPicInfo();
+      xSetOutputPicturePresentInStream();
+      xWriteOutput( m_pcListPic, nalu.m_temporalId );
     }
+  }
+  if( bNewPicture )
+  {
+    m_cDecLib.checkSeiInPictureUnit();
+    m_cDecLib.resetPictureSeiNalus();
+    // reset the EOS present status for the next PU check
+    m_isEosPresentInLastPu = m_isEosPresentInPu;
+    m_isEosPresentInPu = false;
+  }
+  if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
+  {
+    m_cDecLib.checkAPSInPictureUnit();
+    m_cDecLib.resetPictureUnitNals();
+  }
+  if (bNewAccessUnit || !bitstreamFile)
+  {
+    m_cDecLib.CheckNoOutputPriorPicFlagsInAccessUnit();
+    m_cDecLib.resetAccessUnitNoOutputPriorPicFlags();
+    m_cDecLib.checkLayerIdIncludedInCvss();
+    m_cDecLib.checkSEIInAccessUnit();
+    m_cDecLib.resetAccessUnitNestedSliSeiInfo();
+    m_cDecLib.resetIsFirstAuInCvs();
+    m_cDecLib.resetAccessUnitEos();
+    m_cDecLib.resetAudIrapOrGdrAuFlag();
+  }
+  if(bNewAccessUnit)
+  {
+    m_decodedSliceInAU = false;
+    m_cDecLib.checkTidLayerIdInAccessUnit();
+    m_cDecLib.resetAccessUnitSeiTids();
+    m_cDecLib.resetAccessUnitSeiPayLoadTypes();
+    m_cDecLib.checkSeiContentInAccessUnit();
+    m_cDecLib.resetAccessUnitSeiNalus();
+    m_cDecLib.resetAccessUnitNals();
+    m_cDecLib.resetAccessUnitApsNals();
+    m_cDecLib.resetAccessUnitPicInfo();
+  }
 #if GREEN_METADATA_SEI_ENABLED
-    if (m_GMFA && m_GMFAFramewise && bNewPicture)
-    {
-      FeatureCounterStruct featureCounterUpdated = m_cDecLib.getFeatureCounter();
-      writeGMFAOutput(featureCounterUpdated, featureCounterOld, m_GMFAFile,false);
-      featureCounterOld = m_cDecLib.getFeatureCounter();
-    }
-#endif
+  if (m_GMFA && m_GMFAFramewise && bNewPicture)
+  {
+    FeatureCounterStruct featureCounterUpdated = m_cDecLib.getFeatureCounter();
+    writeGMFAOutput(featureCounterUpdated, m_featureCounterOld, m_GMFAFile,false);
+    m_featureCounterOld = m_cDecLib.getFeatureCounter();
   }
+#endif
+
+  return !bNewPicture;
+}
+
+/**
+ - output all remaining pictures at the end of the bitstream
+ */
+void DecApp::flushDecoding()
+{
   if (!m_annotatedRegionsSEIFileName.empty())
   {
-    xOutputAnnotatedRegions(pcListPic);
+    xOutputAnnotatedRegions(m_pcListPic);
   }
   // May need to check again one more time as in case one the bitstream has only one picture, the first check may miss it
-  setOutputPicturePresentInStream();
-  CHECK(!outputPicturePresentInBitstream, "It is required that there shall be at least one picture with PictureOutputFlag equal to 1 in the bitstream")
+  xSetOutputPicturePresentInStream();
+  CHECK(!m_outputPicturePresentInBitstream, "It is required that there shall be at least one picture with PictureOutputFlag equal to 1 in the bitstream")
   
 #if GREEN_METADATA_SEI_ENABLED
   if (m_GMFA && m_GMFAFramewise) //Last frame
   {
     FeatureCounterStruct featureCounterUpdated = m_cDecLib.getFeatureCounter();
-    writeGMFAOutput(featureCounterUpdated, featureCounterOld, m_GMFAFile, false);
-    featureCounterOld = m_cDecLib.getFeatureCounter();
+    writeGMFAOutput(featureCounterUpdated, m_featureCounterOld, m_GMFAFile, false);
+    m_featureCounterOld = m_cDecLib.getFeatureCounter();
   }
   
   if (m_GMFA)
@@ -859,16 +879,36 @@ uint32_t DecApp::decode()
 
   m_cDecLib.applyNnPostFilter();
   
-  xFlushOutput( pcListPic );
+  xFlushOutput( m_pcListPic );
 
   if (!m_shutterIntervalPostFileName.empty() && getShutterFilterFlag())
   {
     m_cTVideoIOYuvSIIPostFile.close();
   }
+}
 
+/**
+ - delete allocated buffers and destroy internal classes
+ - returns the number of mismatching pictures
+ */
+uint32_t DecApp::finishDecoding()
+{
   // get the number of checksum errors
   uint32_t nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
 
+  // pictures still viewed by the caller are deleted by releaseOutputPicture()
+  if (m_pcListPic != nullptr)
+  {
+    for (Picture* pcPic: *m_pcListPic)
+    {
+      if (pcPic != nullptr && pcPic->viewCount > 0)
+      {
+        m_detachedPics.push_back(pcPic);
+      }
+    }
+    m_pcListPic->remove_if([](Picture* p) { return p == nullptr || p->viewCount > 0; });
+  }
+
   // delete buffers
   m_cDecLib.deletePicBuffer();
   // destroy internal classes
@@ -909,6 +949,20 @@ void DecApp::writeLineToOutputLog(Picture * pcPic)
   }
 }
 
+void DecApp::releaseOutputPicture(Picture* pcPic)
+{
+  CHECK(pcPic->viewCount <= 0, "Output picture released more often than it was passed to the output callback");
+  pcPic->viewCount--;
+
+  auto it = std::find(m_detachedPics.begin(), m_detachedPics.end(), pcPic);
+  if (pcPic->viewCount == 0 && it != m_detachedPics.end())
+  {
+    m_detachedPics.erase(it);
+    pcPic->destroy();
+    delete pcPic;
+  }
+}
+
 // ====================================================================================================================
 // Protected member functions
 // ====================================================================================================================
@@ -927,6 +981,9 @@ void DecApp::xCreateDecLib()
 #endif
   );
   m_cDecLib.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
+  m_cDecLib.setFilmGrainThreads(m_SEIFGSThreads);
+  Picture::setRescaleThreads(m_rescaleThreads);
+  m_cDecLib.setParseThread(m_parseThread);
 
 #if JVET_AJ0151_DSC_SEI
   m_cDecLib.setKeyStoreParameters(m_keyStoreDir, m_trustStoreDir);
@@ -979,6 +1036,42 @@ void DecApp::xDestroyDecLib()
 }
 
 
+void DecApp::xSetOutputPicturePresentInStream()
+{
+  if (!m_outputPicturePresentInBitstream && m_pcListPic != nullptr)
+  {
+    for (const Picture* pcPic: *m_pcListPic)
+    {
+      if (pcPic->neededForOutput)
+      {
+        m_outputPicturePresentInBitstream = true;
+        break;
+      }
+    }
+  }
+}
+
+void DecApp::xOutputPicture(Picture* pcPic)
+{
+  if (m_outputCallback)
+  {
+    pcPic->viewCount++;
+    m_outputCallback(pcPic);
+  }
+}
+
+void DecApp::xDeletePicture(Picture* pcPic)
+{
+  if (pcPic->viewCount > 0)
+  {
+    // still viewed by the caller, deleted by releaseOutputPicture()
+    m_detachedPics.push_back(pcPic);
+    return;
+  }
+  pcPic->destroy();
+  delete pcPic;
+}
+
 /** \param pcListPic list of pictures to be written to file
     \param tId       temporal sub-layer ID
  */
@@ -1089,6 +1182,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
         }
         writeLineToOutputLog(pcPicTop);
         writeLineToOutputLog(pcPicBottom);
+        xOutputPicture(pcPicTop);
+        xOutputPicture(pcPicBottom);
 
         // update POC of display order
         m_iPOCLastDisplay = pcPicBottom->getPOC();
@@ -1219,6 +1314,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           }
         }
         writeLineToOutputLog(pcPic);
+        xOutputPicture(pcPic);
 
         if (!m_objectMaskInfoSEIFileName.empty())
         {
@@ -1296,6 +1392,8 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
           }
           writeLineToOutputLog(pcPicTop);
           writeLineToOutputLog(pcPicBottom);
+          xOutputPicture(pcPicTop);
+          xOutputPicture(pcPicBottom);
         // update POC of display order
         m_iPOCLastDisplay = pcPicBottom->getPOC();
 
@@ -1311,10 +1409,8 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
         pcPicTop->neededForOutput = false;
         pcPicBottom->neededForOutput = false;
 
-        pcPicTop->destroy();
-        delete pcPicTop;
-        pcPicBottom->destroy();
-        delete pcPicBottom;
+        xDeletePicture(pcPicTop);
+        xDeletePicture(pcPicBottom);
         iterPic--;
         *iterPic = nullptr;
         iterPic++;
@@ -1322,8 +1418,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
       }
       else
       {
-        pcPicTop->destroy();
-        delete pcPicTop;
+        xDeletePicture(pcPicTop);
         iterPic--;
         *iterPic = nullptr;
         iterPic++;
@@ -1437,6 +1532,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
             }
           }
           writeLineToOutputLog(pcPic);
+          xOutputPicture(pcPic);
           if (!m_objectMaskInfoSEIFileName.empty())
           {
             xOutputObjectMaskInfos(pcPic);
@@ -1453,8 +1549,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
       }
       if (pcPic != nullptr && (m_shutterIntervalPostFileName.empty() || !getShutterFilterFlag()))
       {
-        pcPic->destroy();
-        delete pcPic;
+        xDeletePicture(pcPic);
         pcPic    = nullptr;
         *iterPic = nullptr;
       }
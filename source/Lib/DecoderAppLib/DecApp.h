@@ -40,6 +40,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "Utilities/VideoIOYuv.h"
 #include "CommonLib/Picture.h"
 #include "DecoderLib/DecLib.h"
@@ -92,6 +94,25 @@ private:
 
   SEIObjectMaskInfos::ObjectMaskInfoHeader m_omiHeader;   ///< OMI header
 
+  // decoding loop state, kept between calls of decodeStep()
+  PicList*        m_pcListPic;
+  bool            m_loopFiltered[MAX_VPS_LAYERS];
+  bool            m_gdrRecoveryPeriod[MAX_NUM_LAYER_IDS];
+  bool            m_picSkipped;
+  bool            m_prevPicSkipped;
+  bool            m_openedPostFile;
+  bool            m_isEosPresentInPu;
+  bool            m_isEosPresentInLastPu;
+  bool            m_outputPicturePresentInBitstream;
+  int             m_lastNaluLayerId;
+  bool            m_decodedSliceInAU;
+#if GREEN_METADATA_SEI_ENABLED
+  FeatureCounterStruct m_featureCounterOld;
+#endif
+
+  std::function<void(Picture*)> m_outputCallback;      ///< receives output pictures instead of the YUV files
+  std::vector<Picture*>         m_detachedPics;        ///< pictures removed from the DPB while still held by the caller
+
 private:
   bool  xIsNaluWithinTargetDecLayerIdSet( const InputNALUnit* nalu ) const; ///< check whether given Nalu is within targetDecLayerIdSet
   bool  xIsNaluWithinTargetOutputLayerIdSet( const InputNALUnit* nalu ) const; ///< check whether given Nalu is within targetOutputLayerIdSet
@@ -101,6 +122,18 @@ public:
   virtual ~DecApp         ()  {}
 
   uint32_t  decode            (); ///< main decoding function
+
+  // decoding loop driven by the caller: decode() is startDecoding(), decodeStep() until the end of the stream,
+  // flushDecoding() and finishDecoding()
+  void      startDecoding     ();
+  bool      decodeStep        ( std::istream &bitstreamFile, class InputByteStream &bytestream );
+  void      flushDecoding     ();
+  uint32_t  finishDecoding    ();
+
+  /// pictures are passed to the callback in output order; a picture is not reused by the decoder while its view
+  /// count is non-zero, releaseOutputPicture() decrements it
+  void  setOutputCallback     ( std::function<void(Picture*)> callback ) { m_outputCallback = callback; }
+  void  releaseOutputPicture  ( Picture* pcPic );
   bool  getShutterFilterFlag()        const { return m_ShutterFilterEnable; }
   void  setShutterFilterFlag(bool value) { m_ShutterFilterEnable = value; }
   int   getBlendingRatio()             const { return m_SII_BlendingRatio; }
@@ -111,6 +144,9 @@ private:
   void  xDestroyDecLib    (); ///< destroy internal classes
   void  xWriteOutput      ( PicList* pcListPic , uint32_t tId); ///< write YUV to file
   void  xFlushOutput( PicList* pcListPic, const int layerId = NOT_VALID ); ///< flush all remaining decoded pictures to file
+  void  xOutputPicture( Picture* pcPic );                                  ///< pass a picture to the output callback
+  void  xDeletePicture( Picture* pcPic );                                  ///< delete a picture removed from the DPB
+  void  xSetOutputPicturePresentInStream();
 
   // check if next NAL unit will be the first NAL unit from a new picture
   bool isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *bytestream);
@@ -43,6 +43,7 @@
 #include "Utilities/VideoIOYuv.h"
 #include "CommonLib/ChromaFormat.h"
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/StageProfiler.h"
 
 namespace po = ProgramOptionsLite;
 
@@ -67,6 +68,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   std::string sTracingFile;
   bool   bTracingChannelsList = false;
 #endif
+#if ENABLE_STAGE_PROFILING
+  std::string sProfileFile;
+#endif
 #if ENABLE_SIMD_OPT
   std::string ignore;
 #endif
@@ -98,6 +102,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("SEIColourRemappingInfoFilename", m_colourRemapSEIFileName,         std::string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
   ("SEICTIFilename",            m_SEICTIFileName,                      std::string(""), "CTI YUV output file name. If empty, no Colour Transform is applied (ignore SEI message)\n")
   ("SEIFGSFilename",            m_SEIFGSFileName,                      std::string(""), "FGS YUV output file name. If empty, no film grain is applied (ignore SEI message)\n")
+  ("SEIFGSThreads",             m_SEIFGSThreads,                       1,          "Number of threads used for film grain synthesis (0: number of cores)")
   ("SEIAnnotatedRegionsInfoFilename", m_annotatedRegionsSEIFileName,   std::string(""), "Annotated regions output file name. If empty, no object information will be saved (ignore SEI message)\n")
   ("SEIObjectMaskInfosFilename", m_objectMaskInfoSEIFileName,          std::string(""), "Object mask information output file name. If empty, no object mask information will be saved (ignore SEI message)\n")
   ("OutputDecodedSEIMessagesFilename", m_outputDecodedSEIMessagesFilename, std::string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
@@ -111,6 +116,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("TraceRule",                 sTracingRule,                          std::string(""), "Tracing rule (ex: \"D_CABAC:poc==8\" or \"D_REC_CB_LUMA:poc==8\")")
   ("TraceFile",                 sTracingFile,                          std::string(""), "Tracing file")
 #endif
+#if ENABLE_STAGE_PROFILING
+  ("ProfileFile",               sProfileFile,                          std::string(""), "Stage profiling output file, written as JSON for a .json extension and as CSV otherwise")
+#endif
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   ("CacheCfg",                  m_cacheCfgFile,                        std::string(""), "CacheCfg File")
 #endif
@@ -132,6 +140,8 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("UpscaledOutputWidth",      m_upscaledOutputWidth,                  0,          "Forced upscaled output width (override SPS)" )
   ("UpscaledOutputHeight",     m_upscaledOutputHeight,                 0,          "Forced upscaled output height (override SPS)" )
   ("UpscaleFilterForDisplay",  m_upscaleFilterForDisplay,              1,          "Filters used for upscaling reconstruction to full resolution (2: ECM 12 - tap luma and 6 - tap chroma MC filters, 1 : Alternative 12 - tap luma and 6 - tap chroma filters, 0 : VVC 8 - tap luma and 4 - tap chroma MC filters)")
+  ("RescaleThreads",           m_rescaleThreads,                       1,          "Number of threads used for reference picture resampling and upscaled output (0: number of cores)")
+  ("ParseThread",              m_parseThread,                          false,      "Parse the CTUs of a slice in a separate thread, pipelined with their reconstruction")
 #if JVET_AJ0151_DSC_SEI
   ("KeyStoreDir",              m_keyStoreDir,            std::string("keystore/pub"),    "Directory for locally stored public keys for verifying digitally signed content")
   ("TrustStoreDir",            m_trustStoreDir,          std::string("keystore/ca"),     "Directory for locally stored trusted CA certificates")
@@ -175,6 +185,9 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     msg( INFO, "\nAvailable tracing channels:\n\n%s\n", sChannelsList.c_str() );
   }
 #endif
+#if ENABLE_STAGE_PROFILING
+  g_stageProfiler.open( sProfileFile );
+#endif
 
   g_mctsDecCheckEnabled = m_mctsCheck;
   // Chroma output bit-depth
@@ -196,6 +209,18 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
     return false;
   }
 
+  if (m_SEIFGSThreads < 0)
+  {
+    msg( ERROR, "SEIFGSThreads must not be negative\n");
+    return false;
+  }
+
+  if (m_rescaleThreads < 0)
+  {
+    msg( ERROR, "RescaleThreads must not be negative\n");
+    return false;
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
@@ -274,6 +299,7 @@ DecAppCfg::DecAppCfg()
   , m_colourRemapSEIFileName()
   , m_SEICTIFileName()
   , m_SEIFGSFileName()
+  , m_SEIFGSThreads(1)
   , m_annotatedRegionsSEIFileName()
   , m_objectMaskInfoSEIFileName()
   , m_targetDecLayerIdSet()
@@ -294,6 +320,9 @@ DecAppCfg::~DecAppCfg()
 #if ENABLE_TRACING
   tracing_uninit( g_trace_ctx );
 #endif
+#if ENABLE_STAGE_PROFILING
+  g_stageProfiler.close();
+#endif
 }
 
 //! \}
@@ -77,6 +77,7 @@ protected:
   std::string   m_colourRemapSEIFileName;             ///< output Colour Remapping file name
   std::string   m_SEICTIFileName;                     ///< output Recon with CTI file name
   std::string   m_SEIFGSFileName;                     ///< output file name for reconstructed sequence with film grain
+  int           m_SEIFGSThreads;                      ///< number of threads used for film grain synthesis (0: number of cores)
   std::string   m_annotatedRegionsSEIFileName;        ///< annotated regions file name
   std::string m_objectMaskInfoSEIFileName;            ///< object mask information file name
   std::vector<int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
@@ -101,6 +102,8 @@ protected:
   int           m_upscaledOutputWidth;
   int           m_upscaledOutputHeight;
   int           m_upscaleFilterForDisplay;
+  int           m_rescaleThreads;                     ///< number of threads used for picture resampling (0: number of cores)
+  bool          m_parseThread;                        ///< parse the CTUs of a slice in a separate thread, ahead of their reconstruction
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
 #if JVET_AJ0151_DSC_SEI
   std::string   m_keyStoreDir;
@@ -59,6 +59,7 @@
 #endif
 
 #include "SEIDigitallySignedContent.h"
+#include "CommonLib/StageProfiler.h"
 
 bool tryDecodePicture(Picture *pcEncPic, const int expectedPoc, const std::string &bitstreamFileName,
                       const int layerIdx, EnumArray<ParameterSetMap<APS>, ApsType> *apsMap, 
@@ -666,6 +667,10 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
   for(auto * p: m_cListPic)
   {
     pcPic = p;  // workaround because range-based for-loops don't work with existing variables
+    if (pcPic->viewCount > 0)
+    {
+      continue;
+    }
     if ( pcPic->reconstructed == false && ! pcPic->neededForOutput )
     {
       pcPic->neededForOutput = false;
@@ -759,7 +764,7 @@ void DecLib::executeLoopFilters()
       for (uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth)
       {
         const CodingUnit *cu = cs.getCU(Position(xPos, yPos), ChannelType::LUMA);
-        if (cu->slice->getLmcsEnabledFlag())
+        if (cu != nullptr && cu->slice->getLmcsEnabledFlag())
         {
           const uint32_t width  = (xPos + pcv.maxCUWidth > pcv.lumaWidth) ? (pcv.lumaWidth - xPos) : pcv.maxCUWidth;
           const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
@@ -797,30 +802,6 @@ void DecLib::executeLoopFilters()
   m_featureCounter.addALF(cs.m_featureCounter);
   m_featureCounter.addBoundaryStrengths(cs.m_featureCounter);
 #endif
-  for (int i = 0; i < cs.pps->getNumSubPics() && m_targetSubPicIdx; i++)
-  {
-    // keep target subpic samples untouched, for other subpics mask their output sample value to 0
-    int targetSubPicIdx = m_targetSubPicIdx - 1;
-    if (i != targetSubPicIdx)
-    {
-      SubPic SubPicNoUse = cs.pps->getSubPics()[i];
-      uint32_t left  = SubPicNoUse.getSubPicLeft();
-      uint32_t right = SubPicNoUse.getSubPicRight();
-      uint32_t top   = SubPicNoUse.getSubPicTop();
-      uint32_t bottom= SubPicNoUse.getSubPicBottom();
-      for (uint32_t row = top; row <= bottom; row++)
-      {
-        for (uint32_t col = left; col <= right; col++)
-        {
-          cs.getRecoBuf().Y().at(col, row) = 0;
-          // for test only, hard coding using 4:2:0 chroma format
-          cs.getRecoBuf().Cb().at(col>>1, row>>1) = 0;
-          cs.getRecoBuf().Cr().at(col>>1, row>>1) = 0;
-        }
-      }
-    }
-  }
-
   m_pcPic->cs->slice->stopProcessingTimer();
 }
 
@@ -884,6 +865,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
 
   Slice*  pcSlice = m_pcPic->cs->slice;
   m_prevPicPOC = pcSlice->getPOC();
+  PROFILE_FINISH_PICTURE(pcSlice->getPOC());
 #if GREEN_METADATA_SEI_ENABLED
   m_featureCounter.height = m_pcPic->Y().height;
   m_featureCounter.width = m_pcPic->Y().width;
@@ -961,13 +943,18 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    // only the hashes of decoded subpictures can be checked
+    const bool targetSubPicOnly = xDecodeTargetSubPicOnly(pcSlice->getPPS());
+    if (!targetSubPicOnly)
+    {
+      m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    }
 
     SEIMessages snList = getSeisByType(m_pcPic->SEIs, SEI::PayloadType::SCALABLE_NESTING);
     for (auto& sei: snList)
     {
       auto sn = reinterpret_cast<SEIScalableNesting*>(sei);
-      if (!sn->subpicId.empty())
+      if (!sn->subpicId.empty() && (!targetSubPicOnly || sn->subpicId.front() == m_targetSubPicIdx - 1))
       {
         const uint32_t subpicId = sn->subpicId.front();
 
@@ -1096,6 +1083,44 @@ void DecLib::xUpdateRasInit(Slice* slice)
   }
 }
 
+bool DecLib::xDecodeTargetSubPicOnly(const PPS* pps) const
+{
+  if (m_targetSubPicIdx == 0 || pps->getNumSubPics() < 2)
+  {
+    return false;
+  }
+
+  // the target subpicture can be decoded on its own, when it is treated as a picture and in-loop filtering
+  // does not cross its boundaries
+  const SubPic targetSubPic = pps->getSubPic(m_targetSubPicIdx - 1);
+  return targetSubPic.getTreatedAsPicFlag() && !targetSubPic.getloopFilterAcrossEnabledFlag();
+}
+
+bool DecLib::xIsNonTargetSubPicSlice(const Slice* slice) const
+{
+  const PPS *pps = slice->getPPS();
+  return xDecodeTargetSubPicOnly(pps) && pps->getSubPicIdxFromSubPicId(slice->getSliceSubPicId()) != m_targetSubPicIdx - 1;
+}
+
+void DecLib::xCropToTargetSubPic(Picture* pic) const
+{
+  const PPS *pps = pic->cs->pps;
+  CHECK(m_targetSubPicIdx > pps->getNumSubPics(), "Target subpicture index exceeds the number of subpictures");
+
+  // restrict the output to the target subpicture by shrinking the conformance window of the picture
+  const SubPic   targetSubPic = pps->getSubPic(m_targetSubPicIdx - 1);
+  const int      unitX        = SPS::getWinUnitX(pic->cs->sps->getChromaFormatIdc());
+  const int      unitY        = SPS::getWinUnitY(pic->cs->sps->getChromaFormatIdc());
+  const int      subPicRight  = pps->getPicWidthInLumaSamples() - 1 - targetSubPic.getSubPicRight();
+  const int      subPicBottom = pps->getPicHeightInLumaSamples() - 1 - targetSubPic.getSubPicBottom();
+  Window        &conf         = pic->getConformanceWindow();
+
+  conf.setWindowLeftOffset(std::max<int>(conf.getWindowLeftOffset(), targetSubPic.getSubPicLeft() / unitX));
+  conf.setWindowRightOffset(std::max<int>(conf.getWindowRightOffset(), subPicRight / unitX));
+  conf.setWindowTopOffset(std::max<int>(conf.getWindowTopOffset(), targetSubPic.getSubPicTop() / unitY));
+  conf.setWindowBottomOffset(std::max<int>(conf.getWindowBottomOffset(), subPicBottom / unitY));
+}
+
 void DecLib::xCreateLostPicture( int iLostPoc, const int layerId )
 {
   msg( INFO, "\ninserting lost poc : %d\n",iLostPoc);
@@ -2161,6 +2186,10 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     m_pcPic = xGetNewPicBuffer( *sps, *pps, m_apcSlicePilot->getTLayer(), layerId );
 
     m_pcPic->finalInit( vps, *sps, *pps, &m_picHeader, apss, lmcsAPS, scalinglistAPS );
+    if (m_targetSubPicIdx)
+    {
+      xCropToTargetSubPic(m_pcPic);
+    }
 #if GDR_ENABLED
     m_apcSlicePilot->setPicHeader(m_pcPic->cs->picHeader);
 #endif
@@ -3668,7 +3697,19 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
   pcSlice->setFeatureCounter(this->m_featureCounter);
 #endif
   //  Decode a picture
-  m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
+  if (xIsNonTargetSubPicSlice(pcSlice))
+  {
+    // the slice is neither output nor referenced by the target subpicture, only the picture level data is set up
+    m_pcPic->resizeSAO(pcSlice->getPPS()->pcv->sizeInCtus, 0);
+    if (pcSlice->getFirstCtuRsAddrInSlice() == 0)
+    {
+      m_pcPic->resizeAlfData(pcSlice->getPPS()->pcv->sizeInCtus);
+    }
+  }
+  else
+  {
+    m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
+  }
 #if GREEN_METADATA_SEI_ENABLED
   this->m_featureCounter = pcSlice->getFeatureCounter();
 #endif
@@ -4203,7 +4244,7 @@ uint32_t DecLib::xGetNnpfaTargetId(uint8_t* payload, uint32_t payloadSize)
 /**
 - lookahead through next NAL units to determine if current NAL unit is the first NAL unit in a new picture
 */
-bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *bytestream)
+bool DecLib::isNewPicture(std::istream *bitstreamFile, class InputByteStream *bytestream)
 {
   bool ret = false;
   bool finished = false;
@@ -4312,7 +4353,7 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
 /**
 - lookahead through next NAL units to determine if current NAL unit is the first NAL unit in a new access unit
 */
-bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, class InputByteStream *bytestream )
+bool DecLib::isNewAccessUnit( bool newPicture, std::istream *bitstreamFile, class InputByteStream *bytestream )
 {
   bool ret = false;
   bool finished = false;
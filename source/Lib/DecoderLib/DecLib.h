@@ -273,6 +273,8 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  void  setFilmGrainThreads(int numThreads) { m_grainCharacteristic.setNumThreads(numThreads); }
+  void  setParseThread(bool b) { m_cSliceDecoder.setParseThread(b); }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -358,8 +360,8 @@ public:
   }
 
   void  setAPSMapEnc(EnumArray<ParameterSetMap<APS>, ApsType> *apsMap) { m_apsMapEnc = apsMap; }
-  bool  isNewPicture( std::ifstream *bitstreamFile, class InputByteStream *bytestream );
-  bool  isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, class InputByteStream *bytestream );
+  bool  isNewPicture( std::istream *bitstreamFile, class InputByteStream *bytestream );
+  bool  isNewAccessUnit( bool newPicture, std::istream *bitstreamFile, class InputByteStream *bytestream );
 
   bool      getHTidExternalSetFlag()               const { return m_mTidExternalSet; }
   void      setHTidExternalSetFlag(bool mTidExternalSet)  { m_mTidExternalSet = mTidExternalSet; }
@@ -398,6 +400,9 @@ public:
 
 protected:
   void  xUpdateRasInit(Slice* slice);
+  bool  xDecodeTargetSubPicOnly(const PPS* pps) const;
+  bool  xIsNonTargetSubPicSlice(const Slice* slice) const;
+  void  xCropToTargetSubPic(Picture* pic) const;
 
   Picture * xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_t temporalLayer, const int layerId );
   void  xCreateLostPicture( int iLostPOC, const int layerId );
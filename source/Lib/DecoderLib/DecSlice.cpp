@@ -38,7 +38,12 @@
 #include "DecSlice.h"
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/StageProfiler.h"
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 //! \ingroup DecoderLib
@@ -49,6 +54,7 @@
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_parseThread( false )
 {
 }
 
@@ -133,9 +139,13 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   {
     clipMv = clipMvInPic;
   }
-  // for every CTU in the slice segment...
-  unsigned subStrmId = 0;
-  for( unsigned ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++ )
+  const unsigned  maxCUSize   = sps->getMaxCUWidth();
+  const unsigned  numCtus     = slice->getNumCtuInSlice();
+  unsigned        subStrmId   = 0;
+
+  // parsing of one CTU, including the entropy coder state handling at tile, slice and WPP row boundaries
+  // returns false if the CTU is the debug CTU, at which decoding stops
+  auto parseCtu = [&]( const unsigned ctuIdx )
   {
     const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
     const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
@@ -147,7 +157,6 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     const unsigned  tileColWidth    = slice->getPPS()->getTileColumnWidth( tileColIdx );
     const unsigned  tileRowHeight   = slice->getPPS()->getTileRowHeight( tileRowIdx );
     const TileIdx   tileIdx         = slice->getPPS()->getTileIdx( ctuXPosInCtus, ctuYPosInCtus);
-    const unsigned  maxCUSize             = sps->getMaxCUWidth();
     Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
     UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
     const SubPic &curSubPic = slice->getPPS()->getSubPicFromPos(pos);
@@ -215,31 +224,15 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
       resetBcwCodingOrder(true, cs);
     }
 
-    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == tileXPosInCtus)
-    {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
-      cs.resetIBCBuffer = true;
-    }
-
-    if( !cs.slice->isIntra() )
+    if( ctuRsAddr == debugCTU )
     {
-      pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+      return false;
     }
-
-    if( ctuRsAddr == debugCTU )
     {
-      break;
+      PROFILE_STAGE(ProfStage::DEC_PARSE_CTU);
+      cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
     }
-    cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
 
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
-#if GREEN_METADATA_SEI_ENABLED
-    FeatureCounterStruct featureCounter = slice->getFeatureCounter();
-    countFeatures( featureCounter, cs,ctuArea);
-    slice->setFeatureCounter(featureCounter);
-#endif
-    
     if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
     {
       m_entropyCodingSyncContextState = cabacReader.getCtx();
@@ -247,7 +240,7 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     }
 
 
-    if( ctuIdx == slice->getNumCtuInSlice()-1 )
+    if( ctuIdx == numCtus-1 )
     {
       unsigned binVal = cabacReader.terminating_bit();
       CHECK( !binVal, "Expecting a terminating bit" );
@@ -270,7 +263,43 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
         subStrmId++;
       }
     }
-    if (slice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (slice->getNumCtuInSlice() - 1))
+    return true;
+  };
+
+  // reconstruction of one parsed CTU, in decoding order
+  auto reconstructCtu = [&]( const unsigned ctuIdx )
+  {
+    const unsigned  ctuRsAddr       = slice->getCtuAddrInSlice(ctuIdx);
+    const unsigned  ctuXPosInCtus   = ctuRsAddr % widthInCtus;
+    const unsigned  ctuYPosInCtus   = ctuRsAddr / widthInCtus;
+    const unsigned  tileXPosInCtus  = slice->getPPS()->getTileColumnBd( slice->getPPS()->ctuToTileCol( ctuXPosInCtus ) );
+    Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize) ;
+    UnitArea ctuArea(cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+    const SubPic &curSubPic = slice->getPPS()->getSubPicFromPos(pos);
+
+    if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == tileXPosInCtus)
+    {
+      cs.motionLut.lut.resize(0);
+      cs.motionLut.lutIbc.resize(0);
+      cs.resetIBCBuffer = true;
+    }
+
+    if( !cs.slice->isIntra() )
+    {
+      pic->mctsInfo.init( &cs, getCtuAddr( ctuArea.lumaPos(), *( cs.pcv ) ) );
+    }
+
+    {
+      PROFILE_STAGE(ProfStage::DEC_RECO_CTU);
+      m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    }
+#if GREEN_METADATA_SEI_ENABLED
+    FeatureCounterStruct featureCounter = slice->getFeatureCounter();
+    countFeatures( featureCounter, cs,ctuArea);
+    slice->setFeatureCounter(featureCounter);
+#endif
+
+    if (slice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (numCtus - 1))
     // for last Ctu in the slice
     {
       int subPicX = (int)curSubPic.getSubPicLeft();
@@ -291,8 +320,147 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
         }
       }
     }
+  };
+
+  // The reconstruction of a CTU looks up the units below-left of it. Within a tile, these are in the CTU that follows
+  // it by the tile width less one CTU in decoding order, so the parser does not start a CTU that far ahead of the CTU
+  // being reconstructed. Tiles narrower than three CTUs leave no room for the look-ahead of one CTU that the handover
+  // needs.
+  unsigned minTileWidthInCtus = widthInCtus;
+  for( int col = 0; col < cs.pps->getNumTileColumns(); col++ )
+  {
+    minTileWidthInCtus = std::min( minTileWidthInCtus, cs.pps->getTileColumnWidth( col ) );
   }
-  
+  const unsigned maxParseAhead = minTileWidthInCtus - 1;
+
+#if ENABLE_TRACING || RExt__DECODER_DEBUG_BIT_STATISTICS || RExt__DECODER_DEBUG_TOOL_STATISTICS
+  // the trace context and the statistics are not thread safe
+  const bool parseAhead = false;
+#else
+  const bool parseAhead = m_parseThread && debugCTU < 0 && numCtus > 1 && maxParseAhead >= 2;
+#endif
+
+  if( !parseAhead )
+  {
+    // for every CTU in the slice segment...
+    for( unsigned ctuIdx = 0; ctuIdx < numCtus; ctuIdx++ )
+    {
+      if( !parseCtu( ctuIdx ) )
+      {
+        break;
+      }
+      reconstructCtu( ctuIdx );
+    }
+  }
+  else
+  {
+    // Two stage pipeline: the parser thread runs ahead and fills the CUs, PUs, TUs and coefficients of the picture's
+    // coding structure, and this thread reconstructs the parsed CTUs in decoding order. Parsing only depends on the
+    // syntax of the preceding CTUs, so the reconstruction of a CTU waits for its parsing only. The parser in turn
+    // waits before it would start a CTU maxParseAhead CTUs ahead of the reconstruction.
+    // A CTU is handed over once the following CTU is parsed, as adding the first unit of a CTU links it to the last
+    // unit of the previous one. The unit lists must not be reallocated while they are accessed by both threads.
+    // A CTU adds at most two units (luma and chroma tree) per minimum block of each kind, so the lists are reserved
+    // for the picture plus one CTU, and a CTU is only parsed if the space for its units is left.
+    const size_t maxNumUnitsPerCtu = 2 * ( size_t( maxCUSize ) * maxCUSize >> ( 2 * MIN_CU_LOG2 ) );
+    const size_t maxNumUnits       = 2 * ( cs.area.Y().area() >> ( 2 * MIN_CU_LOG2 ) ) + maxNumUnitsPerCtu;
+    cs.cus.reserve( maxNumUnits );
+    cs.pus.reserve( maxNumUnits );
+    cs.tus.reserve( maxNumUnits );
+    const size_t cuCapacity = cs.cus.capacity();
+    const size_t puCapacity = cs.pus.capacity();
+    const size_t tuCapacity = cs.tus.capacity();
+
+    std::mutex              parseMutex;
+    std::condition_variable parseCond;
+    std::condition_variable reconCond;
+    unsigned                numParsedCtus        = 0;
+    unsigned                numReconstructedCtus = 0;
+    bool                    parseFinished        = false;
+    bool                    parseAbort           = false;
+    std::exception_ptr      parseError;
+
+    std::thread parser( [&]()
+    {
+      try
+      {
+        for( unsigned ctuIdx = 0; ctuIdx < numCtus; ctuIdx++ )
+        {
+          {
+            std::unique_lock<std::mutex> lock( parseMutex );
+            reconCond.wait( lock, [&]() { return ctuIdx - numReconstructedCtus < maxParseAhead || parseAbort; } );
+            if( parseAbort )
+            {
+              break;
+            }
+          }
+          CHECK( cs.cus.size() + maxNumUnitsPerCtu > cuCapacity || cs.pus.size() + maxNumUnitsPerCtu > puCapacity
+                   || cs.tus.size() + maxNumUnitsPerCtu > tuCapacity,
+                 "Not enough units reserved for parsing ahead" );
+          parseCtu( ctuIdx );
+          CHECK( cs.cus.capacity() != cuCapacity || cs.pus.capacity() != puCapacity || cs.tus.capacity() != tuCapacity,
+                 "Unit lists were reallocated while parsing ahead" );
+          {
+            std::lock_guard<std::mutex> lock( parseMutex );
+            numParsedCtus = ctuIdx;
+          }
+          parseCond.notify_one();
+        }
+        // the last CTU has no successor
+        std::lock_guard<std::mutex> lock( parseMutex );
+        numParsedCtus = numCtus;
+      }
+      catch( ... )
+      {
+        std::lock_guard<std::mutex> lock( parseMutex );
+        parseError = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock( parseMutex );
+        parseFinished = true;
+      }
+      parseCond.notify_one();
+    } );
+
+    try
+    {
+      for( unsigned ctuIdx = 0; ctuIdx < numCtus; ctuIdx++ )
+      {
+        {
+          std::unique_lock<std::mutex> lock( parseMutex );
+          parseCond.wait( lock, [&]() { return numParsedCtus > ctuIdx || parseFinished; } );
+          if( numParsedCtus <= ctuIdx )
+          {
+            // parsing failed, the error is reported below
+            break;
+          }
+        }
+        reconstructCtu( ctuIdx );
+        {
+          std::lock_guard<std::mutex> lock( parseMutex );
+          numReconstructedCtus = ctuIdx + 1;
+        }
+        reconCond.notify_one();
+      }
+    }
+    catch( ... )
+    {
+      {
+        std::lock_guard<std::mutex> lock( parseMutex );
+        parseAbort = true;
+      }
+      reconCond.notify_one();
+      parser.join();
+      throw;
+    }
+    parser.join();
+
+    if( parseError )
+    {
+      std::rethrow_exception( parseError );
+    }
+  }
+
 #if GREEN_METADATA_SEI_ENABLED
   FeatureCounterStruct featureCounter = slice->getFeatureCounter();
   featureCounter.baseQP[slice->getSliceQpBase()] ++;
@@ -63,6 +63,8 @@ private:
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
   PLTBuf          m_palettePredictorSyncState;      /// palette predictor storage at wavefront/WPP
 
+  bool            m_parseThread;                    ///< parse the CTUs in a separate thread, ahead of their reconstruction
+
 public:
   DecSlice();
   virtual ~DecSlice();
@@ -71,6 +73,8 @@ public:
   void  create            ();
   void  destroy           ();
 
+  void  setParseThread    ( bool b ) { m_parseThread = b; }
+
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
 };
 
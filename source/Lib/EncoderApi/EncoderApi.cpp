@@ -0,0 +1,287 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncoderApi.cpp
+    \brief    Embeddable encoder interface
+*/
+
+#include "EncoderApi.h"
+
+#include <fstream>
+
+#include "EncApp.h"
+#include "EncoderLib/EncLibCommon.h"
+#include "Utilities/program_options_lite.h"
+
+//! \ingroup EncoderApi
+//! \{
+
+struct EncoderApi::Impl
+{
+  std::fstream            bitstream;   // never opened, access units go to the callback
+  EncLibCommon            encLibCommon;
+  std::unique_ptr<EncApp> encApp;
+  bool                    created = false;
+  bool                    eos     = false;
+  bool                    failed  = false;
+};
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+EncoderApi::EncoderApi()
+{
+}
+
+EncoderApi::~EncoderApi()
+{
+  close();
+}
+
+bool EncoderApi::init(const std::vector<std::string> &options, AccessUnitCallback callback)
+{
+  close();
+  if (!callback)
+  {
+    return false;
+  }
+
+  initROM();
+  m_impl.reset(new Impl);
+  m_impl->encApp.reset(new EncApp(m_impl->bitstream, &m_impl->encLibCommon));
+  EncApp &encApp = *m_impl->encApp;
+
+  // defaults first, so that they can be overridden by the given options
+  std::vector<std::string> args = { "EncoderApi", "--BitstreamFile=-", "--FramesToBeEncoded=1048576" };
+  args.insert(args.end(), options.begin(), options.end());
+  std::vector<char *> argv;
+  for (auto &arg: args)
+  {
+    argv.push_back(&arg[0]);
+  }
+
+  bool ok = false;
+  try
+  {
+    encApp.create();
+    ok = encApp.parseCfg((int) argv.size(), argv.data()) && encApp.getMaxLayers() == 1
+         && encApp.getMultiRateQPs().empty();
+    if (ok)
+    {
+      encApp.setExternalIO([callback](const char *data, size_t size)
+                           { callback(reinterpret_cast<const uint8_t *>(data), size); });
+      encApp.createLib(0);
+      m_impl->created = true;
+    }
+  }
+  catch (ProgramOptionsLite::ParseFailure &e)
+  {
+    msg(ERROR, "Error parsing option \"%s\" with argument \"%s\".\n", e.arg.c_str(), e.val.c_str());
+    ok = false;
+  }
+  catch (Exception &e)
+  {
+    msg(ERROR, "%s\n", e.what());
+    ok = false;
+  }
+
+  if (!ok)
+  {
+    close();
+  }
+  return ok;
+}
+
+void EncoderApi::close()
+{
+  if (!m_impl)
+  {
+    return;
+  }
+  if (m_impl->created)
+  {
+    flush();
+    m_impl->encApp->destroyLib();
+  }
+  m_impl->encApp->destroy();
+  m_impl.reset();
+  destroyROM();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+EncoderApi::Picture EncoderApi::getInputPicture()
+{
+  Picture pic;
+  if (!m_impl || !m_impl->created || m_impl->eos || m_impl->failed)
+  {
+    return pic;
+  }
+
+  // the buffer changes after every picture, since EncLib takes over the input buffer
+  PelStorage &input  = m_impl->encApp->getInputPic();
+  pic.numComponents  = (int) input.bufs.size();
+  pic.bytesPerSample = sizeof(Pel);
+  pic.bitDepth       = m_impl->encApp->getBitDepth(ChannelType::LUMA);
+  for (int comp = 0; comp < pic.numComponents; comp++)
+  {
+    PelBuf buf         = input.get(ComponentID(comp));
+    pic.planes[comp]   = buf.buf;
+    pic.strides[comp]  = buf.stride;
+    pic.widths[comp]   = buf.width;
+    pic.heights[comp]  = buf.height;
+  }
+  return pic;
+}
+
+bool EncoderApi::encodeInputPicture()
+{
+  if (!m_impl || !m_impl->created || m_impl->eos || m_impl->failed)
+  {
+    return false;
+  }
+
+  EncApp &encApp = *m_impl->encApp;
+  bool    eos    = false;
+  try
+  {
+    if (!encApp.encodePrep(eos))
+    {
+      // a complete GOP has been received
+      while (encApp.encode())
+      {
+      }
+    }
+  }
+  catch (Exception &e)
+  {
+    msg(ERROR, "%s\n", e.what());
+    m_impl->failed = true;
+    return false;
+  }
+  m_impl->eos = eos;
+  return true;
+}
+
+bool EncoderApi::pushPicture(const Picture &picture)
+{
+  if (!m_impl || !m_impl->created || m_impl->eos || m_impl->failed)
+  {
+    return false;
+  }
+
+  PelStorage &input = m_impl->encApp->getInputPic();
+  if (picture.numComponents != (int) input.bufs.size()
+      || (picture.bytesPerSample != 1 && picture.bytesPerSample != 2))
+  {
+    return false;
+  }
+
+  for (int comp = 0; comp < picture.numComponents; comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    PelBuf            dst    = input.get(compID);
+    const int         width  = picture.widths[comp];
+    const int         height = picture.heights[comp];
+    if (width <= 0 || height <= 0 || width > dst.width || height > dst.height)
+    {
+      return false;
+    }
+
+    const int internalBitDepth = m_impl->encApp->getBitDepth(toChannelType(compID));
+    const int shift            = internalBitDepth - picture.bitDepth;
+    const int round            = shift < 0 ? 1 << (-shift - 1) : 0;
+    const int maxValue         = (1 << internalBitDepth) - 1;
+    for (int y = 0; y < height; y++)
+    {
+      Pel *dstRow = dst.bufAt(0, y);
+      for (int x = 0; x < width; x++)
+      {
+        const int value = picture.bytesPerSample == 1
+                            ? static_cast<const uint8_t *>(picture.planes[comp])[y * picture.strides[comp] + x]
+                            : static_cast<const uint16_t *>(picture.planes[comp])[y * picture.strides[comp] + x];
+        // rounding up may exceed the internal range, as in VideoIOYuv::scalePlane
+        dstRow[x] = Pel(Clip3(0, maxValue, shift >= 0 ? value << shift : (value + round) >> -shift));
+      }
+      // conformance padding
+      for (int x = width; x < dst.width; x++)
+      {
+        dstRow[x] = dstRow[width - 1];
+      }
+    }
+    for (int y = height; y < dst.height; y++)
+    {
+      dst.subBuf(0, y, dst.width, 1).copyFrom(dst.subBuf(0, height - 1, dst.width, 1));
+    }
+  }
+
+  return encodeInputPicture();
+}
+
+bool EncoderApi::flush()
+{
+  if (!m_impl || !m_impl->created || m_impl->failed)
+  {
+    return false;
+  }
+  if (m_impl->eos)
+  {
+    return true;
+  }
+
+  EncApp &encApp = *m_impl->encApp;
+  bool    eos    = false;
+  m_impl->eos    = true;
+  try
+  {
+    encApp.setInputEof();
+    if (!encApp.encodePrep(eos))
+    {
+      while (encApp.encode())
+      {
+      }
+    }
+  }
+  catch (Exception &e)
+  {
+    msg(ERROR, "%s\n", e.what());
+    m_impl->failed = true;
+    return false;
+  }
+  return true;
+}
+
+//! \}
@@ -0,0 +1,107 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncoderApi.h
+    \brief    Embeddable encoder interface (header)
+*/
+
+#ifndef __ENCODERAPI__
+#define __ENCODERAPI__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! \ingroup EncoderApi
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Streaming encoder interface around EncLib.
+/// The encoder is configured with the same options as EncoderApp (given as "--Name=value" strings, config files
+/// via "-c" remain possible but are not required). Pictures are pushed one by one in display order and coded access
+/// units are passed to a callback in Annex-B byte stream format. No input or bitstream files are used, so tools that
+/// read ahead in the input file (TemporalFilter, BIM, film grain analysis) are disabled.
+/// Instances may be created one after the other in a process; concurrent use from several threads is not supported.
+/// After an encoding error has been reported, all further calls fail until the encoder is closed.
+class EncoderApi
+{
+public:
+  /// called for each coded access unit
+  typedef std::function<void(const uint8_t *data, size_t size)> AccessUnitCallback;
+
+  /// view onto a picture buffer, samples are stored with bytesPerSample bytes each
+  struct Picture
+  {
+    int       numComponents = 0;
+    void     *planes[3]     = { nullptr, nullptr, nullptr };
+    ptrdiff_t strides[3]    = { 0, 0, 0 };   ///< in samples
+    int       widths[3]     = { 0, 0, 0 };
+    int       heights[3]    = { 0, 0, 0 };
+    int       bytesPerSample = 0;
+    int       bitDepth       = 0;
+  };
+
+  EncoderApi();
+  ~EncoderApi();
+
+  /// configure and create the encoder; SourceWidth, SourceHeight and the frame rate must be given
+  bool init(const std::vector<std::string> &options, AccessUnitCallback callback);
+
+  /// zero-copy input: the returned buffer is the encoder's input picture at internal bit depth; write the next
+  /// picture (including any conformance padding area) into it and call encodeInputPicture()
+  Picture getInputPicture();
+  bool    encodeInputPicture();
+
+  /// copy input: planes with 1 or 2 bytes per sample at the given bit depth, converted to the internal bit depth
+  bool pushPicture(const Picture &picture);
+
+  /// encode all pending pictures; no pictures can be pushed afterwards
+  bool flush();
+
+  /// flush if needed and release the encoder
+  void close();
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+//! \}
+
+#endif // __ENCODERAPI__
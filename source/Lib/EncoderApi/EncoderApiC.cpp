@@ -0,0 +1,97 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncoderApiC.cpp
+    \brief    C interface of the embeddable encoder
+*/
+
+#include "EncoderApiC.h"
+#include "EncoderApi.h"
+
+struct VtmEncoder
+{
+  EncoderApi encoder;
+};
+
+VtmEncoder *vtm_encoder_create(int numOptions, const char *const *options, VtmAccessUnitCallback callback, void *user)
+{
+  if (callback == nullptr)
+  {
+    return nullptr;
+  }
+
+  std::vector<std::string> opts(options, options + numOptions);
+  VtmEncoder              *enc = new VtmEncoder;
+  if (!enc->encoder.init(opts, [callback, user](const uint8_t *data, size_t size) { callback(user, data, size); }))
+  {
+    delete enc;
+    return nullptr;
+  }
+  return enc;
+}
+
+int vtm_encoder_push(VtmEncoder *enc, int numComponents, const void *const *planes, const ptrdiff_t *strides,
+                     const int *widths, const int *heights, int bytesPerSample, int bitDepth)
+{
+  if (enc == nullptr || numComponents < 1 || numComponents > 3)
+  {
+    return -1;
+  }
+
+  EncoderApi::Picture pic;
+  pic.numComponents  = numComponents;
+  pic.bytesPerSample = bytesPerSample;
+  pic.bitDepth       = bitDepth;
+  for (int comp = 0; comp < numComponents; comp++)
+  {
+    pic.planes[comp]  = const_cast<void *>(planes[comp]);
+    pic.strides[comp] = strides[comp];
+    pic.widths[comp]  = widths[comp];
+    pic.heights[comp] = heights[comp];
+  }
+  return enc->encoder.pushPicture(pic) ? 0 : -1;
+}
+
+int vtm_encoder_flush(VtmEncoder *enc)
+{
+  if (enc == nullptr)
+  {
+    return -1;
+  }
+  return enc->encoder.flush() ? 0 : -1;
+}
+
+void vtm_encoder_destroy(VtmEncoder *enc)
+{
+  delete enc;
+}
@@ -0,0 +1,70 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncoderApiC.h
+    \brief    C interface of the embeddable encoder (header)
+*/
+
+#ifndef __ENCODERAPIC__
+#define __ENCODERAPIC__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct VtmEncoder VtmEncoder;
+
+/// called for each coded access unit (Annex-B byte stream)
+typedef void (*VtmAccessUnitCallback)(void *user, const uint8_t *data, size_t size);
+
+/// create an encoder from EncoderApp options ("--Name=value"); returns NULL on failure
+VtmEncoder *vtm_encoder_create(int numOptions, const char *const *options, VtmAccessUnitCallback callback, void *user);
+
+/// push one picture with 1 or 2 bytes per sample; strides are in samples; returns 0 on success
+int vtm_encoder_push(VtmEncoder *enc, int numComponents, const void *const *planes, const ptrdiff_t *strides,
+                     const int *widths, const int *heights, int bytesPerSample, int bitDepth);
+
+/// encode all pending pictures; returns 0 on success
+int vtm_encoder_flush(VtmEncoder *enc);
+
+/// flush and release the encoder
+void vtm_encoder_destroy(VtmEncoder *enc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ENCODERAPIC__
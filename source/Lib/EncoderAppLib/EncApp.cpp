@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <fcntl.h>
 #include <iomanip>
+#include <sstream>
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
@@ -63,6 +64,9 @@ EncApp::EncApp(std::fstream &bitStream, EncLibCommon *encLibCommon) : m_cEncLib(
 #endif
   m_numEncoded = 0;
   m_flush = false;
+  m_inputSource  = nullptr;
+  m_externalInput = false;
+  m_externalEof   = false;
 }
 
 EncApp::~EncApp()
@@ -269,6 +273,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setPrintMSSSIM                                       ( m_printMSSSIM );
   m_cEncLib.setPrintWPSNR                                        ( m_printWPSNR );
   m_cEncLib.setPrintHightPrecEncTime(m_printHighPrecEncTime);
+  m_cEncLib.setAsyncMetrics(m_asyncMetrics);
   m_cEncLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
 
   m_cEncLib.setFrameRate(m_frameRate);
@@ -298,6 +303,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setSwitchPocPeriod                                   ( m_switchPocPeriod );
   m_cEncLib.setUpscaledOutput                                    ( m_upscaledOutput );
   m_cEncLib.setUpscaleFilerForDisplay                            (m_upscaleFilterForDisplay);
+  Picture::setRescaleThreads(m_rescaleThreads);
   m_cEncLib.setFramesToBeEncoded                                 ( m_framesToBeEncoded );
   m_cEncLib.setValidFrames(m_firstValidFrame, m_lastValidFrame);
   m_cEncLib.setAvoidIntraInDepLayer                              ( m_avoidIntraInDepLayer );
@@ -648,6 +654,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setBipredSearchRange                                 ( m_bipredSearchRange );
   m_cEncLib.setClipForBiPredMeEnabled                            ( m_bClipForBiPredMeEnabled );
   m_cEncLib.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
+  m_cEncLib.setPyramidME                                         ( m_pyramidME );
   m_cEncLib.setMinSearchWindow                                   ( m_minSearchWindow );
   m_cEncLib.setRestrictMESampling                                ( m_bRestrictMESampling );
 
@@ -741,6 +748,9 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setMaxTTSizes(m_maxTt);
   m_cEncLib.setFastTTskip                                        ( m_ttFastSkip );
   m_cEncLib.setFastTTskipThr                                     ( m_ttFastSkipThr );
+  m_cEncLib.setSplitPredictorModel                               ( m_splitPredictorModel );
+  m_cEncLib.setSplitPredictorThr                                 ( m_splitPredictorThr );
+  m_cEncLib.setSplitPredictorDumpFile                            ( m_splitPredictorDumpFile );
   m_cEncLib.setDualITree                                         ( m_dualTree );
   m_cEncLib.setLFNST                                             ( m_LFNST );
   m_cEncLib.setUseFastLFNST                                      ( m_useFastLFNST );
@@ -852,6 +862,9 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setMergeRdCandQuotaSubBlk                            ( m_mergeRdCandQuotaSubBlk);
   m_cEncLib.setMergeRdCandQuotaCiip                              ( m_mergeRdCandQuotaCiip );
   m_cEncLib.setMergeRdCandQuotaGpm                               ( m_mergeRdCandQuotaGpm );
+  m_cEncLib.setMergePredCacheSize                                ( m_mergePredCacheSize );
+  m_cEncLib.setIntraModeCacheSize                                ( m_intraModeCacheSize );
+  m_cEncLib.setFastResidualRate                                  ( m_fastResidualRate );
   m_cEncLib.setUsePbIntraFast                                    ( m_usePbIntraFast );
   m_cEncLib.setUseAMaxBT                                         ( m_useAMaxBT );
   m_cEncLib.setUseE0023FastEnc                                   ( m_e0023FastEnc );
@@ -1633,23 +1646,26 @@ void EncApp::xInitLibCfg( int layerIdx )
 void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
 {
   // Video I/O
-  m_cVideoIOYuvInputFile.open(m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth,
-                              m_internalBitDepth);   // read  mode
+  if (m_inputSource == nullptr && !m_externalInput)
+  {
+    m_cVideoIOYuvInputFile.open(m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth,
+                                m_internalBitDepth);   // read  mode
 #if EXTENSION_360_VIDEO
-  m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_inputFileWidth, m_inputFileHeight, m_inputChromaFormatIDC);
+    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_inputFileWidth, m_inputFileHeight, m_inputChromaFormatIDC);
 #else
-  const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
-  if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
-  {
-    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidthBeforeScale, m_sourceHeightBeforeScale,
-                                      m_inputChromaFormatIDC);
-  }
-  else
-  {
-    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidth - m_sourcePadding[0],
-                                      sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
-  }
+    const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
+    if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidthBeforeScale, m_sourceHeightBeforeScale,
+                                        m_inputChromaFormatIDC);
+    }
+    else
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidth - m_sourcePadding[0],
+                                        sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
+    }
 #endif
+  }
   if (!m_reconFileName.empty())
   {
     if (m_packedYUVMode
@@ -1728,6 +1744,49 @@ void EncApp::xInitLib()
 // Public member functions
 // ====================================================================================================================
 
+void EncApp::setMultiRate( EncApp *inputSource )
+{
+  m_inputSource = inputSource;
+
+  // each rate writes its own bitstream and reconstruction
+  const std::string suffix = "_QP" + std::to_string(m_iQP);
+  for (std::string *fileName: { &m_bitstreamFileName, &m_reconFileName })
+  {
+    if (fileName->empty() || !fileName->compare("/dev/null"))
+    {
+      continue;
+    }
+    const size_t pos = fileName->find_last_of('.');
+    if (pos != std::string::npos && fileName->find_first_of("/\\", pos) == std::string::npos)
+    {
+      fileName->insert(pos, suffix);
+    }
+    else
+    {
+      fileName->append(suffix);
+    }
+  }
+}
+
+void EncApp::setExternalIO( std::function<void(const char *, size_t)> auCallback )
+{
+  m_auCallback    = auCallback;
+  m_externalInput = true;
+
+  // these tools read future pictures from the input file, which does not exist here
+  if (m_gopBasedTemporalFilterEnabled || m_bimEnabled || (m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty()))
+  {
+    msg(WARNING, "Warning: TemporalFilter, BIM and film grain analysis are not supported without input file and are disabled\n");
+    m_gopBasedTemporalFilterEnabled = false;
+    m_bimEnabled                    = false;
+    m_temporalFilterPrefilterOnly   = false;
+    if (m_fgcSEIExternalDenoised.empty())
+    {
+      m_fgcSEIAnalysisEnabled = false;
+    }
+  }
+}
+
 void EncApp::createLib( const int layerIdx )
 {
   const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
@@ -1760,7 +1819,7 @@ void EncApp::createLib( const int layerIdx )
     m_cEncLib.setAdaptQPmap(adaptQPmap);
   }
 
-  if( !m_bitstream.is_open() )
+  if( !m_bitstream.is_open() && !m_auCallback )
   {
     m_bitstream.open(m_bitstreamFileName.c_str(), std::fstream::binary | std::fstream::out);
     if( !m_bitstream )
@@ -1797,6 +1856,10 @@ void EncApp::createLib( const int layerIdx )
                           m_gopBasedTemporalFilterPastRefs, m_gopBasedTemporalFilterFutureRefs, m_firstValidFrame,
                           m_lastValidFrame, m_gopBasedTemporalFilterEnabled, m_cEncLib.getAdaptQPmap(),
                           m_cEncLib.getBIM(), m_ctuSize);
+    if (!m_temporalFilterCacheDir.empty())
+    {
+      m_cEncLib.getTemporalFilter().initCache(m_temporalFilterCacheDir);
+    }
   }
   if ( m_fgcSEIAnalysisEnabled && m_fgcSEIExternalDenoised.empty() )
   {
@@ -1812,6 +1875,10 @@ void EncApp::createLib( const int layerIdx )
 
 void EncApp::destroyLib()
 {
+  if( !m_multiRateQPs.empty() )
+  {
+    printf( "\nRate %2d (QP %d)", m_multiRateIdx, m_iQP );
+  }
   printf( "\nLayerId %2d", m_cEncLib.getLayerId() );
 
   m_cEncLib.printSummary( m_isField );
@@ -1869,13 +1936,34 @@ void EncApp::destroyLib()
   printRateSummary();
 }
 
-bool EncApp::encodePrep( bool& eos )
+bool EncApp::xIsInputEof()
 {
-  // main encoder loop
+  if (m_externalInput)
+  {
+    return m_externalEof;
+  }
+  return m_inputSource != nullptr ? m_inputSource->xIsInputEof() : m_cVideoIOYuvInputFile.isEof();
+}
+
+void EncApp::xReadInputPicture()
+{
+  if (m_inputSource != nullptr)
+  {
+    // multi-rate encoding: the picture has just been read by the encoder of the first rate. Its m_orgPic buffer has
+    // already been handed over to its EncLib, but m_trueOrgPic still holds a copy of the input picture.
+    m_orgPic->copyFrom(*m_inputSource->m_trueOrgPic);
+    m_trueOrgPic->copyFrom(*m_inputSource->m_trueOrgPic);
+    return;
+  }
+  if (m_externalInput)
+  {
+    // the picture has been written into m_orgPic by the caller
+    m_trueOrgPic->copyFrom(*m_orgPic);
+    return;
+  }
+
   const InputColourSpaceConversion ipCSC = m_inputColourSpaceConvert;
-  const InputColourSpaceConversion snrCSC = ( !m_snrInternalColourSpace ) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
 
-  // read input YUV file
 #if EXTENSION_360_VIDEO
   if( m_ext360->isEnabled() )
   {
@@ -1914,6 +2002,14 @@ bool EncApp::encodePrep( bool& eos )
                                 m_clipInputVideoToRec709Range);
   }
 #endif
+}
+
+bool EncApp::encodePrep( bool& eos )
+{
+  // main encoder loop
+  const InputColourSpaceConversion snrCSC = ( !m_snrInternalColourSpace ) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+
+  xReadInputPicture();
 
   // increase number of received frames
   m_frameRcvd++;
@@ -1922,7 +2018,7 @@ bool EncApp::encodePrep( bool& eos )
     (m_isField && (m_frameRcvd == (m_framesToBeEncoded >> 1))) || (!m_isField && (m_frameRcvd == m_framesToBeEncoded));
 
   // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-  if( m_cVideoIOYuvInputFile.isEof() )
+  if( xIsInputEof() )
   {
     m_flush = true;
     eos = true;
@@ -1983,7 +2079,7 @@ bool EncApp::encode()
       xWriteOutput( m_numEncoded, m_recBufList );
     }
     // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    if( m_temporalSubsampleRatio > 1 && m_inputSource == nullptr && !m_externalInput )
     {
 #if EXTENSION_360_VIDEO
       m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight,
@@ -1999,6 +2095,22 @@ bool EncApp::encode()
   return keepDoing;
 }
 
+void EncApp::prefilterTemporal()
+{
+  // read the input and run the temporal filter on each picture, which stores its results in the cache
+  for (int poc = 0; poc < m_framesToBeEncoded; poc++)
+  {
+    xReadInputPicture();
+    if (xIsInputEof())
+    {
+      break;
+    }
+    m_frameRcvd++;
+    m_cEncLib.getTemporalFilter().filter(m_orgPic, poc);
+  }
+  msg(NOTICE, "\nTemporal filter cache filled for %d pictures\n", m_frameRcvd);
+}
+
 void EncApp::applyNnPostFilter()
 {
   m_cEncLib.applyNnPostFilter();
@@ -2106,6 +2218,15 @@ void EncApp::xWriteOutput(int numEncoded, std::list<PelUnitBuf *> &recBufList)
 
 void EncApp::outputAU( const AccessUnit& au )
 {
+  if (m_auCallback)
+  {
+    std::ostringstream auStream;
+    const std::vector<uint32_t> &stats = writeAnnexBAccessUnit(auStream, au);
+    rateStatsAccum(au, stats);
+    const std::string data = auStream.str();
+    m_auCallback(data.data(), data.size());
+    return;
+  }
   const std::vector<uint32_t> &stats = writeAnnexBAccessUnit(m_bitstream, au);
   rateStatsAccum(au, stats);
   m_bitstream.flush();
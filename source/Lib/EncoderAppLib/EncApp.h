@@ -38,6 +38,7 @@
 #ifndef __ENCAPP__
 #define __ENCAPP__
 
+#include <functional>
 #include <list>
 #include <ostream>
 
@@ -88,6 +89,8 @@ private:
   void xDestroyLib ();                           ///< destroy encoder class
 
   // file I/O
+  void xReadInputPicture();                      ///< read next picture into m_orgPic / m_trueOrgPic
+  bool xIsInputEof();                      ///< end of input reached
   void xWriteOutput(int numEncoded, std::list<PelUnitBuf *> &recBufList);   ///< write bitstream to file
   void rateStatsAccum   ( const AccessUnit& au, const std::vector<uint32_t>& stats);
   void printRateSummary ();
@@ -104,6 +107,10 @@ private:
   TExt360AppEncTop*      m_ext360;
 #endif
   bool m_flush;
+  EncApp*                m_inputSource;           ///< encoder of the first rate, which reads the shared input
+  std::function<void(const char *, size_t)> m_auCallback;   ///< receives the access units instead of the bitstream file
+  bool                   m_externalInput;         ///< pictures are written into m_orgPic by the caller
+  bool                   m_externalEof;           ///< caller signalled the end of the input
 #if GREEN_METADATA_SEI_ENABLED
   FeatureCounterStruct      m_featureCounter;
 #endif
@@ -113,10 +120,15 @@ public:
   virtual ~EncApp();
 
   int   getMaxLayers() const { return m_maxLayers; }
+  void  setMultiRate( EncApp *inputSource );
+  void  setExternalIO( std::function<void(const char *, size_t)> auCallback );   ///< no input/bitstream files, see EncoderApi
+  PelStorage& getInputPic()         { return *m_orgPic; }
+  void  setInputEof()               { m_externalEof = true; }
   void  createLib( const int layerIdx );
   void  destroyLib();
   bool  encodePrep( bool& eos );
   bool  encode();                               ///< main encoding function
+  void  prefilterTemporal();                    ///< only run the temporal filter to fill its cache
   void applyNnPostFilter();
 
   void  outputAU( const AccessUnit& au );
@@ -127,6 +139,7 @@ public:
   VPS * getVPS() { return m_cEncLib.getVPS(); }
   ChromaFormat getChromaFormatIDC() const { return m_cEncLib.getChromaFormatIdc(); }
   int   getBitDepth() const { return m_cEncLib.getBitDepth(ChannelType::LUMA); }
+  int   getBitDepth( const ChannelType chType ) const { return m_internalBitDepth[chType]; }
   bool  getALFEnabled() { return m_cEncLib.getUseALF(); }
   int   getMaxNumALFAPS() { return m_cEncLib.getMaxNumALFAPS(); }
   int   getALFAPSIDShift() { return m_cEncLib.getALFAPSIDShift(); }
@@ -137,6 +150,7 @@ public:
   FeatureCounterStruct getFeatureCounter(){return m_cEncLib.getFeatureCounter();}
   void      featureToFile(std::ofstream& featureFile,int feature[MAX_CU_DEPTH+1][MAX_CU_DEPTH+1], std::string featureName);
 #endif
+  bool  getTemporalFilterPrefilterOnly() const { return m_temporalFilterPrefilterOnly; }
   bool getNNPostFilterEnabled() { return m_cEncLib.getNNPostFilterSEICharacteristicsEnabled() || m_cEncLib.getNnPostFilterSEIActivationEnabled(); }
 };// END CLASS DEFINITION EncApp
 
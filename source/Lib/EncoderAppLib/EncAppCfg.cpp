@@ -50,6 +50,7 @@
 #include "EncoderLib/RateCtrl.h"
 
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/StageProfiler.h"
 #include "CommonLib/ProfileTierLevel.h"
 
 #define MACRO_TO_STRING_HELPER(val) #val
@@ -91,7 +92,8 @@ constexpr int TF_DEFAULT_REFS = 4;
 // ====================================================================================================================
 
 EncAppCfg::EncAppCfg()
-: m_inputColourSpaceConvert(IPCOLOURSPACE_UNCHANGED)
+: m_multiRateIdx(0)
+, m_inputColourSpaceConvert(IPCOLOURSPACE_UNCHANGED)
 , m_snrInternalColourSpace(false)
 , m_outputInternalColourSpace(false)
 , m_packedYUVMode(false)
@@ -107,6 +109,9 @@ EncAppCfg::~EncAppCfg()
   tracing_uninit(g_trace_ctx);
   g_trace_ctx = nullptr;
 #endif
+#if ENABLE_STAGE_PROFILING
+  g_stageProfiler.close();
+#endif
 }
 
 void EncAppCfg::create()
@@ -326,6 +331,63 @@ strToScalingListMode[] =
   {"file",    SCALING_LIST_FILE_READ}
 };
 
+// Encoder speed presets, ordered from the slowest to the fastest. "slow" matches the settings of
+// encoder_randomaccess_vtm.cfg; the low delay and all intra files differ in a few options (e.g. all intra enables
+// ISPFast, FastMIP and FastLFNST). Only encoder decisions are set, no values that are signalled in the bitstream.
+// Every preset sets all options of the table, so that the result does not depend on which presets or
+// configuration files were given before.
+static const char *const presetNames[] = { "slow", "medium", "fast", "faster", "veryfast" };
+static constexpr int     NUM_PRESETS   = sizeof(presetNames) / sizeof(presetNames[0]);
+
+static const struct PresetOption
+{
+  const char *name;
+  const char *values[NUM_PRESETS];
+}
+presetOptions[] =
+{
+  //                                 slow    medium  fast    faster  veryfast
+  { "FastSearch",                  { "1",    "1",    "1",    "1",    "1" } },
+  { "FEN",                         { "1",    "1",    "1",    "3",    "3" } },
+  { "FDM",                         { "1",    "1",    "1",    "1",    "1" } },
+  { "FastMrg",                     { "1",    "1",    "1",    "1",    "1" } },
+  { "LCTUFast",                    { "1",    "1",    "1",    "1",    "1" } },
+  { "PBIntraFast",                 { "1",    "1",    "1",    "1",    "1" } },
+  { "AMaxBT",                      { "1",    "1",    "1",    "1",    "1" } },
+  { "TransformSkipFast",           { "1",    "1",    "1",    "1",    "1" } },
+  { "BcwFast",                     { "1",    "1",    "1",    "1",    "1" } },
+  { "MTTSkipping",                 { "1",    "1",    "1",    "1",    "1" } },
+  { "ContentBasedFastQtbt",        { "0",    "1",    "1",    "1",    "1" } },
+  { "FastMIP",                     { "0",    "1",    "1",    "1",    "1" } },
+  { "FastLFNST",                   { "0",    "1",    "1",    "1",    "1" } },
+  { "ISPFast",                     { "0",    "1",    "1",    "1",    "1" } },
+  { "FastLocalDualTreeMode",       { "1",    "1",    "1",    "2",    "2" } },
+  { "ESD",                         { "0",    "0",    "1",    "1",    "1" } },
+  { "ECU",                         { "0",    "0",    "0",    "1",    "1" } },
+  { "MTSIntraMaxCand",             { "4",    "3",    "2",    "1",    "1" } },
+  { "MTSInterMaxCand",             { "4",    "4",    "3",    "2",    "1" } },
+  { "MaxMergeRdCandNumTotal",      { "7",    "6",    "5",    "4",    "3" } },
+};
+
+// applies the options of a speed preset as if they were read from a configuration file at this position
+static void parsePreset(po::Options &opts, const std::string &name, po::ErrorReporter &err)
+{
+  for (int preset = 0; preset < NUM_PRESETS; preset++)
+  {
+    if (name == presetNames[preset])
+    {
+      std::stringstream cfg;
+      for (const auto &option: presetOptions)
+      {
+        cfg << option.name << ": " << option.values[preset] << "\n";
+      }
+      po::parseConfigStream(opts, cfg, "Preset " + name, err);
+      return;
+    }
+  }
+  err.error("Preset") << "unknown preset '" << name << "'\n";
+}
+
 template<typename T, typename P>
 static std::string enumToString(P map[], uint32_t mapLen, const T val)
 {
@@ -608,6 +670,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   SMultiValueInput<int>  cfg_targetPivotValue                (std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), 0, 1<<16);
 
 
+  SMultiValueInput<int>  cfg_multiRateQPs                    (MIN_QP_VALUE_FOR_16_BIT, MAX_QP, 0, MAX_NUM_QP_VALUES);
   SMultiValueInput<double> cfg_adIntraLambdaModifier         (0, std::numeric_limits<double>::max(), 0, MAX_TLAYER); ///< Lambda modifier for Intra pictures, one for each temporal layer. If size>temporalLayer, then use [temporalLayer], else if size>0, use [size()-1], else use m_adLambdaModifier.
   SMultiValueInput<uint16_t>  cfgSliceLosslessArray          (0, std::numeric_limits<uint16_t>::max(), 0, MAX_SLICES);
 #if SHARP_LUMA_DELTA_QP
@@ -811,6 +874,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   std::string sTracingFile;
   bool   bTracingChannelsList = false;
 #endif
+#if ENABLE_STAGE_PROFILING
+  std::string sProfileFile;
+#endif
 #if ENABLE_SIMD_OPT
   std::string ignore;
 #endif
@@ -825,6 +891,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   opts.addOptions()
   ("help",                                            do_help,                                          false, "this help text")
   ("c",    po::parseConfigFile, "configuration file name")
+  ("Preset",                                          parsePreset,                                             "encoder speed preset (slow, medium, fast, faster, veryfast), options given after it take precedence")
   ("WarnUnknowParameter,w",                           warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
 #if ENABLE_SIMD_OPT
   ("SIMD",                                            ignore,                                      std::string(""), "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: the highest supported extension\n")
@@ -861,6 +928,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("PrintMSSSIM",                                     m_printMSSSIM,                                    false, "0 (default) do not print MS-SSIM scores, 1 = print MS-SSIM scores for each frame and for the whole sequence")
   ("PrintWPSNR",                                      m_printWPSNR,                                     false, "0 (default) do not print HDR-PQ based wPSNR, 1 = print HDR-PQ based wPSNR")
   ("PrintHighPrecEncTime",                            m_printHighPrecEncTime,                           false, "0 (default): print integer value of encoding time in seconds, 1: print floating-point value of encoding time")
+  ("AsyncMetrics",                                    m_asyncMetrics,                                   false, "0 (default): measure PSNR/MS-SSIM/WPSNR after each picture, 1: measure them on a background thread (per-picture output keeps its order)")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceWindowMode",                           m_conformanceWindowMode,                              1, "Window conformance mode (0: no window, 1:automatic padding (default), 2:padding parameters specified, 3:conformance window parameters specified")
@@ -1043,6 +1111,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MaxTTNonISlice",                                  m_maxTt[1],                                       64u, "MaxTTNonISlice")
   ("TTFastSkip",                                      m_ttFastSkip,                                        31, "fast skip method for TT split partition")
   ("TTFastSkipThr",                                   m_ttFastSkipThr,                                  1.075, "Threshold value of fast skip method for TT split partition")
+  ("SplitPredictorModel",                             m_splitPredictorModel,                  std::string(""), "Model file of the learned early termination of BT and TT splits (empty: disabled)")
+  ("SplitPredictorThr",                               m_splitPredictorThr,                                0.1, "BT/TT splits are skipped if the predicted probability of being chosen is below this threshold")
+  ("SplitPredictorDumpFile",                          m_splitPredictorDumpFile,               std::string(""), "CSV file receiving the features and outcomes of tested BT/TT splits for model training")
   ("DualITree",                                       m_dualTree,                                       false, "Use separate QTBT trees for intra slice luma and chroma channel types")
   ( "LFNST",                                          m_LFNST,                                          false, "Enable LFNST (0:off, 1:on)  [default: off]" )
   ( "FastLFNST",                                      m_useFastLFNST,                                   false, "Fast methods for LFNST" )
@@ -1140,6 +1211,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MergeRdCandQuotaSubBlk",                          m_mergeRdCandQuotaSubBlk,         NUM_AFF_MRG_SATD_CAND, "Quota of sub-block merge candidates in full RD checking")
   ("MergeRdCandQuotaCiip",                            m_mergeRdCandQuotaCiip,                               1, "Quota of CIIP merge candidates in full RD checking")
   ("MergeRdCandQuotaGpm",                             m_mergeRdCandQuotaGpm,        GEO_MAX_TRY_WEIGHTED_SATD, "Quota of GPM merge candidates in full RD checking")
+  ("MergePredCacheSize",                              m_mergePredCacheSize,                                64, "Number of merge predictions cached per CTU for reuse by other partitionings (0: off)")
+  ("IntraModeCacheSize",                              m_intraModeCacheSize,                               256, "Number of blocks whose intra mode candidates are cached per CTU for reuse by other partitionings (0: off)")
+  ("FastResidualRate",                                m_fastResidualRate,                               false, "Approximate the rate of the coefficient levels in the intra mode and inter transform decisions")
   ("PBIntraFast",                                     m_usePbIntraFast,                                 false, "Fast assertion if the intra mode is probable")
   ("AMaxBT",                                          m_useAMaxBT,                                      false, "Adaptive maximal BT-size")
   ("E0023FastEnc",                                    m_e0023FastEnc,                                    true, "Fast encoding setting for QTBT (proposal E0023)")
@@ -1188,6 +1262,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("RestrictMESampling",                              m_bRestrictMESampling,                            false, "Restrict ME Sampling for selective inter motion search")
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                        false, "Enables clipping in the Bi-Pred ME. It is disabled to reduce encoder run-time")
   ("FastMEAssumingSmootherMVEnabled",                 m_bFastMEAssumingSmootherMVEnabled,                true, "Enables fast ME assuming a smoother MV.")
+  ("PyramidME",                                       m_pyramidME,                                      false, "Enables a hierarchical motion estimation pre-pass on 1/4 and 1/16 resolution pictures providing per-64x64 start candidates for the integer motion search")
 
   ("HadamardME",                                      m_bUseHADME,                                       true, "Hadamard ME for fractional-pel")
   ("ASR",                                             m_bUseASR,                                        false, "Adaptive motion search range");
@@ -1206,6 +1281,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 
   /* Quantization parameters */
   ("QP,q",                                            m_iQP,                                               30, "Qp value")
+  ("MultiRateQPs",                                    cfg_multiRateQPs,                          cfg_multiRateQPs, "List of QPs encoded in one process from a single input reader, one bitstream and reconstruction per QP (file names get a _QP<n> suffix)")
   ("QPIncrementFrame,-qpif",                          m_qpIncrementAtSourceFrame,   std::optional<uint32_t>(), "If a source file frame number is specified, the internal QP will be incremented for all POCs associated with source frames >= frame number. If empty, do not increment.")
   ("IntraQPOffset",                                   m_intraQPOffset,                                      0, "Qp offset value for intra slice, typically determined based on GOP size")
   ("LambdaFromQpEnable",                              m_lambdaFromQPEnable,                             false, "Enable flag for derivation of lambda from QP")
@@ -1550,6 +1626,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 ("TraceRule", sTracingRule, std::string(""), "Tracing rule (ex: \"D_CABAC:poc==8\" or \"D_REC_CB_LUMA:poc==8\")")
 ("TraceFile", sTracingFile, std::string(""), "Tracing file")
 #endif
+#if ENABLE_STAGE_PROFILING
+("ProfileFile", sProfileFile, std::string(""), "Stage profiling output file, written as JSON for a .json extension and as CSV otherwise")
+#endif
 
 ("SEIEOIEnabled", m_eoiSEIEnabled, false, "Control use of the Encoder Optimization Information SEI")
 ("SEIEOICancelFlag", m_eoiSEICancelFlag, false, "Specifies that the persistence of the previous applied optimization")
@@ -1812,6 +1891,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("UpscaledOutputWidth",                             m_upscaledOutputWidth,                        0, "Forced upscaled output width (override SPS)" )
   ("UpscaledOutputHeight",                            m_upscaledOutputHeight,                       0, "Forced upscaled output height (override SPS)" )
   ("UpscaleFilterForDisplay",                         m_upscaleFilterForDisplay,                    1, "Filters used for upscaling reconstruction to full resolution (2: ECM 12-tap luma and 6-tap chroma MC filters, 1: Alternative 12-tap luma and 6-tap chroma filters, 0: VVC 8-tap luma and 4-tap chroma MC filters)")
+  ("RescaleThreads",                                  m_rescaleThreads,                             1, "Number of threads used for reference picture resampling (0: number of cores)")
   ( "MaxLayers",                                      m_maxLayers,                                  1, "Max number of layers" )
   ( "EnableOperatingPointInformation",                m_OPIEnabled,                             false, "Enables writing of Operating Point Information (OPI)" )
   ( "MaxTemporalLayer",                               m_maxTemporalLayer,                         500, "Maximum temporal layer to be signalled in OPI" )
@@ -1847,7 +1927,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
     ("FirstValidFrame",              m_firstValidFrame,                                       0, "First valid frame")
     ("LastValidFrame",               m_lastValidFrame,                                  MAX_INT, "Last valid frame")
     ("TemporalFilterStrengthFrame*", m_gopBasedTemporalFilterStrengths, std::map<int, double>(), "Strength for every * frame in GOP based temporal filter, where * is an integer."
-                                                                                                                  " E.g. --TemporalFilterStrengthFrame8 0.95 will enable GOP based temporal filter at every 8th frame with strength 0.95");
+                                                                                                                  " E.g. --TemporalFilterStrengthFrame8 0.95 will enable GOP based temporal filter at every 8th frame with strength 0.95")
+    ("TemporalFilterCacheDir",       m_temporalFilterCacheDir,                    std::string(""), "Directory of the cache of temporally filtered pictures, reused by encodings with identical filter settings (empty: no cache)")
+    ("TemporalFilterPrefilterOnly",  m_temporalFilterPrefilterOnly,                         false, "Only run the temporal filter to fill the cache given by TemporalFilterCacheDir, do not encode");
   
   opts.addOptions()
     ("SEIGenerativeFaceVideoEnabled",                         m_generativeFaceVideoEnabled,                             false,                                                         "Control use of the Generative Face Video SEI on current picture")
@@ -2490,6 +2572,13 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 
   m_framesToBeEncoded = ( m_framesToBeEncoded + m_temporalSubsampleRatio - 1 ) / m_temporalSubsampleRatio;
   m_adIntraLambdaModifier = cfg_adIntraLambdaModifier.values;
+  m_multiRateQPs          = cfg_multiRateQPs.values;
+  if (!m_multiRateQPs.empty())
+  {
+    // the QP of this rate overrides any QP given in the configuration
+    CHECK(m_multiRateIdx >= (int) m_multiRateQPs.size(), "Invalid multi-rate index");
+    m_iQP = m_multiRateQPs[m_multiRateIdx];
+  }
   if(m_isField)
   {
     //Frame height
@@ -3723,6 +3812,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
     msg( INFO, "\n Using tracing channels:\n\n%s\n", sChannelsList.c_str() );
   }
 #endif
+#if ENABLE_STAGE_PROFILING
+  g_stageProfiler.open(sProfileFile);
+#endif
 
 #if ENABLE_QPA
   if (m_bUsePerceptQPA && !m_bUseAdaptiveQP && m_dualTree && (m_cbQpOffsetDualTree != 0 || m_crQpOffsetDualTree != 0 || m_cbCrQpOffsetDualTree != 0))
@@ -4696,6 +4788,8 @@ bool EncAppCfg::xCheckParameter()
     || m_mergeRdCandQuotaCiip < 0 || m_mergeRdCandQuotaCiip > maxCandNum
     || m_mergeRdCandQuotaGpm < 0 || m_mergeRdCandQuotaGpm > maxCandNum,
     "MaxMergeRdCandNumReguar, MaxMergeRdCandNumReguarSmallBlk, MaxMergeRdCandNumSubBlk, MaxMergeRdCandNumCiip, and MaxMergeRdCandNumGpm must be between 0 and 15, inclusive");
+  xConfirmPara(m_mergePredCacheSize < 0 || m_mergePredCacheSize > 1024, "MergePredCacheSize must be between 0 and 1024, inclusive");
+  xConfirmPara(m_intraModeCacheSize < 0 || m_intraModeCacheSize > 4096, "IntraModeCacheSize must be between 0 and 4096, inclusive");
   if ( m_Affine == 0 )
   {
     m_maxNumAffineMergeCand = m_sbTmvpEnableFlag ? 1 : 0;
@@ -4751,6 +4845,7 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara(m_scalWinRight   % SPS::getWinUnitX(m_chromaFormatIdc) != 0, "Right scaling window offset must be an integer multiple of the specified chroma subsampling");
   xConfirmPara(m_scalWinTop     % SPS::getWinUnitY(m_chromaFormatIdc) != 0, "Top scaling window offset must be an integer multiple of the specified chroma subsampling");
   xConfirmPara(m_scalWinBottom  % SPS::getWinUnitY(m_chromaFormatIdc) != 0, "Bottom scaling window offset must be an integer multiple of the specified chroma subsampling");
+  xConfirmPara(m_rescaleThreads < 0, "RescaleThreads must not be negative");
   xConfirmPara((m_scalWinLeft < -m_sourceWidth * 15) || (m_scalWinLeft >= m_sourceWidth),
                "The values of SubWidthC * pps_scaling_win_left_offset shall be greater than or equal to -pps_pic_width_in_luma_samples * 15 and less than pps_pic_width_in_luma_samples");
   xConfirmPara((m_scalWinRight < -m_sourceWidth * 15) || (m_scalWinRight >= m_sourceWidth),
@@ -4897,6 +4992,7 @@ bool EncAppCfg::xCheckParameter()
   xConfirmPara( m_fastLocalDualTreeMode < 0 || m_fastLocalDualTreeMode > 2, "FastLocalDualTreeMode must be in range [0..2]" );
 
   xConfirmPara( m_fastAdaptCostPredMode < 0 || m_fastAdaptCostPredMode > 2, "FastAdaptCostPredMode must be in range [0..2]" );
+  xConfirmPara( m_splitPredictorThr < 0.0 || m_splitPredictorThr >= 1.0, "SplitPredictorThr must be in range [0..1)" );
 
   int extraRPLs = 0;
   bool hasFutureRef = false;
@@ -5786,6 +5882,20 @@ bool EncAppCfg::xCheckParameter()
       msg(WARNING, "Number of frames used for temporal prefilter is different from default.\n");
     }
   }
+  if (!m_multiRateQPs.empty())
+  {
+    xConfirmPara(m_maxLayers > 1, "MultiRateQPs is not supported with multiple layers");
+    xConfirmPara(m_rcEnableRateControl, "MultiRateQPs is not supported with rate control");
+    xConfirmPara(m_temporalFilterPrefilterOnly, "MultiRateQPs is not supported with TemporalFilterPrefilterOnly");
+  }
+  if (m_temporalFilterPrefilterOnly)
+  {
+    xConfirmPara(!m_gopBasedTemporalFilterEnabled && !m_bimEnabled,
+                 "TemporalFilterPrefilterOnly requires TemporalFilter or BIM to be enabled");
+    xConfirmPara(m_temporalFilterCacheDir.empty(), "TemporalFilterPrefilterOnly requires TemporalFilterCacheDir");
+    xConfirmPara(m_isField || m_compositeRefEnabled || m_resChangeInClvsEnabled,
+                 "TemporalFilterPrefilterOnly does not support field coding, composite reference or RPR");
+  }
   if (m_bimEnabled)
   {
     xConfirmPara(m_temporalSubsampleRatio != 1, "Block Importance Mapping only support Temporal sub-sample ratio 1");
@@ -5843,6 +5953,7 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Sequence MSE output                    : %s\n", ( m_printSequenceMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Frame MSE output                       : %s\n", ( m_printFrameMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "MS-SSIM output                         : %s\n", ( m_printMSSSIM ? "Enabled" : "Disabled") );
+  msg( DETAILS, "Asynchronous metrics                   : %s\n", ( m_asyncMetrics ? "Enabled" : "Disabled") );
   msg( DETAILS, "Cabac-zero-word-padding                : %s\n", ( m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled" ) );
   if (m_isField)
   {
@@ -6008,6 +6119,7 @@ void EncAppCfg::xPrintParameter()
 #endif
   msg( VERBOSE, "SQP:%d ", m_uiDeltaQpRD                        );
   msg( VERBOSE, "ASR:%d ", m_bUseASR                            );
+  msg( VERBOSE, "PyramidME:%d ", m_pyramidME                    );
   msg( VERBOSE, "MinSearchWindow:%d ", m_minSearchWindow        );
   msg( VERBOSE, "RestrictMESampling:%d ", m_bRestrictMESampling );
   msg( VERBOSE, "FEN:%d ", int(m_fastInterSearchMode)           );
@@ -6142,6 +6254,9 @@ void EncAppCfg::xPrintParameter()
     m_maxMergeRdCandNumTotal, m_mergeRdCandQuotaRegular, m_mergeRdCandQuotaRegularSmallBlk);
   msg( VERBOSE, "MergeRdCandQuotaSubBlk:%d MergeRdCandQuotaCiip:%d MergeRdCandQuotaGpm:%d ",
     m_mergeRdCandQuotaSubBlk, m_mergeRdCandQuotaCiip, m_mergeRdCandQuotaGpm);
+  msg( VERBOSE, "MergePredCacheSize:%d ", m_mergePredCacheSize );
+  msg( VERBOSE, "IntraModeCacheSize:%d ", m_intraModeCacheSize );
+  msg( VERBOSE, "FastResidualRate:%d ", m_fastResidualRate );
   msg( VERBOSE, "PBIntraFast:%d ", m_usePbIntraFast );
   if( m_ImvMode ) msg( VERBOSE, "IMV4PelFast:%d ", m_Imv4PelFast );
   if (m_mtsMode)
@@ -6159,6 +6274,7 @@ void EncAppCfg::xPrintParameter()
   if( m_MIP ) msg(VERBOSE, "FastMIP:%d ", m_useFastMIP);
   msg( VERBOSE, "TTFastSkip:%d ", m_ttFastSkip);
   msg( VERBOSE, "TTFastSkipThr:%.3f ", m_ttFastSkipThr);
+  if( !m_splitPredictorModel.empty() ) msg( VERBOSE, "SplitPredictorThr:%.3f ", m_splitPredictorThr );
   msg( VERBOSE, "FastLocalDualTree:%d ", m_fastLocalDualTreeMode );
 
   if (m_resChangeInClvsEnabled)
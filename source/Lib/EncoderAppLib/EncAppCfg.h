@@ -79,6 +79,8 @@ protected:
   std::string m_inputFileName;                                ///< source file name
   std::string m_bitstreamFileName;                            ///< output bitstream file
   std::string m_reconFileName;                                ///< output reconstruction file
+  std::vector<int> m_multiRateQPs;                            ///< QPs of multi-rate encoding from a single input reader
+  int         m_multiRateIdx;                                 ///< index into m_multiRateQPs of this encoder instance
 
   // Lambda modifiers
   double    m_adLambdaModifier[ MAX_TLAYER ];                 ///< Lambda modifier array for each temporal layer
@@ -135,6 +137,7 @@ protected:
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
   bool      m_printHighPrecEncTime = false;
+  bool      m_asyncMetrics;
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_clipInputVideoToRec709Range;
   bool      m_clipOutputVideoToRec709Range;
@@ -343,6 +346,9 @@ protected:
   unsigned              m_maxTt[3];
   int       m_ttFastSkip;
   double    m_ttFastSkipThr;
+  std::string m_splitPredictorModel;                        ///< model file of the learned BT/TT split early termination
+  double    m_splitPredictorThr;                              ///< split probability below which BT/TT splits are skipped
+  std::string m_splitPredictorDumpFile;                     ///< CSV output of split features for offline training
   bool      m_dualTree;
   bool      m_LFNST;
   bool      m_useFastLFNST;
@@ -433,6 +439,9 @@ protected:
   int       m_mergeRdCandQuotaSubBlk;
   int       m_mergeRdCandQuotaCiip;
   int       m_mergeRdCandQuotaGpm;
+  int       m_mergePredCacheSize;
+  int       m_intraModeCacheSize;
+  bool      m_fastResidualRate;
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
   bool      m_useNonLinearAlfLuma;
@@ -491,6 +500,7 @@ protected:
   int       m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
   bool      m_bClipForBiPredMeEnabled;                        ///< Enables clipping for Bi-Pred ME.
   bool      m_bFastMEAssumingSmootherMVEnabled;               ///< Enables fast ME assuming a smoother MV.
+  bool      m_pyramidME;                                      ///< hierarchical motion estimation pre-pass
   FastInterSearchMode m_fastInterSearchMode;                  ///< Parameter that controls fast encoder settings
   bool      m_bUseEarlyCU;                                    ///< flag for using Early CU setting
   bool      m_useFastDecisionForMerge;                        ///< flag for using Fast Decision Merge RD-Cost
@@ -1076,6 +1086,7 @@ protected:
   int         m_upscaledOutputWidth;
   int         m_upscaledOutputHeight;
   int         m_upscaleFilterForDisplay;
+  int         m_rescaleThreads;                               ///< number of threads used for picture resampling (0: number of cores)
   bool        m_craAPSreset;
   bool        m_rprRASLtoolSwitch;
   bool        m_avoidIntraInDepLayer;
@@ -1084,6 +1095,8 @@ protected:
   int                   m_gopBasedTemporalFilterPastRefs;
   int                   m_gopBasedTemporalFilterFutureRefs;
   std::map<int, double> m_gopBasedTemporalFilterStrengths;             ///< Filter strength per frame for the GOP-based Temporal Filter
+  std::string           m_temporalFilterCacheDir;                      ///< directory of the on-disk cache of filtered pictures
+  bool                  m_temporalFilterPrefilterOnly;                 ///< only fill the temporal filter cache, do not encode
   bool                  m_bimEnabled;
   bool                  m_dpfEnabled;
   int                   m_dpfKeyLen;
@@ -1197,6 +1210,9 @@ public:
   void  create    ();                                         ///< create option handling class
   void  destroy   ();                                         ///< destroy option handling class
   bool  parseCfg  ( int argc, char* argv[] );                ///< parse configuration file to fill member variables
+
+  void  setMultiRateIdx( int rateIdx )                        { m_multiRateIdx = rateIdx; }   ///< to be set before parseCfg
+  const std::vector<int>& getMultiRateQPs() const             { return m_multiRateQPs; }
 };
 
 //! \}
@@ -111,6 +111,7 @@ public:
 public:
   virtual void      resetBits         ()                                    = 0;
   virtual uint64_t  getEstFracBits    ()                              const = 0;
+  virtual void      addEstFracBits    ( uint64_t    fracBits )              = 0;
   virtual unsigned  getNumBins        ( unsigned    ctxId )           const = 0;
 public:
   virtual void      encodeBin         ( unsigned bin,   unsigned ctxId    ) = 0;
@@ -177,6 +178,7 @@ public:
 public:
   void      resetBits           ();
   uint64_t  getEstFracBits      ()                    const { THROW( "not supported" ); return 0; }
+  void      addEstFracBits      ( uint64_t fracBits )       { THROW( "not supported" ); }
   unsigned  getNumBins          ( unsigned ctxId )    const { return BinCounter::getCtx(ctxId); }
 public:
   void      encodeBinEP         ( unsigned bin                      );
@@ -252,6 +254,7 @@ public:
   void resetBits() { m_estFracBits = 0; }
 
   uint64_t  getEstFracBits() const { return m_estFracBits; }
+  void      addEstFracBits(uint64_t fracBits) { m_estFracBits += fracBits; }
   unsigned  getNumBins          ( unsigned ctxId )              const { THROW( "not supported for BitEstimator" ); return 0; }
 public:
   void      encodeBinEP(unsigned bin) { m_estFracBits += BinProbModelBase::estFracBitsEP(); }
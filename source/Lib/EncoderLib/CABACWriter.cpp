@@ -2672,7 +2672,14 @@ void CABACWriter::residual_coding( const TransformUnit& tu, ComponentID compID,
         continue;
       }
     }
-    residual_coding_subblock( cctx, coeff, stateTab, state );
+    if( m_fastResidualRate )
+    {
+      residual_coding_subblock_fast( cctx, coeff, stateTab, state );
+    }
+    else
+    {
+      residual_coding_subblock( cctx, coeff, stateTab, state );
+    }
 
     if ( cuCtx && isLuma(compID) && cctx.isSigGroup() && ( cctx.cgPosY() > 3 || cctx.cgPosX() > 3 ) )
     {
@@ -3048,6 +3055,108 @@ void CABACWriter::residual_coding_subblock( CoeffCodingContext& cctx, const TCoe
   m_binEncoder.encodeBinsEP(signPattern, numSigns);
 }
 
+// Approximate rate of a subblock for the fast residual rate estimation. The bins are costed with the current context
+// states, but the states are not updated, and the template of the already coded neighbours, which selects the contexts
+// and Rice parameters, is approximated by the two coefficients preceding in coding order.
+void CABACWriter::residual_coding_subblock_fast( CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state )
+{
+  const FracBitsAccess& fracBits    = m_binEncoder.getCtx().getFracBitsAcess();
+  const int             minSubPos   = cctx.minSubPos();
+  const bool            isLast      = cctx.isLast();
+  int                   nextSigPos  = ( isLast ? cctx.scanPosLast() : cctx.maxSubPos() );
+  const int             baseLevel   = cctx.getBaseLevel();
+  uint64_t              ctxBits     = 0;
+
+  if( !isLast && cctx.isNotFirst() )
+  {
+    ctxBits += fracBits.getFracBitsArray( cctx.sigGroupCtxId() ).intBits[cctx.isSigGroup() ? 1 : 0];
+    if( !cctx.isSigGroup() )
+    {
+      m_binEncoder.addEstFracBits( ctxBits );
+      return;
+    }
+  }
+
+  const int inferSigPos = nextSigPos != cctx.scanPosLast() ? ( cctx.isNotFirst() ? minSubPos : -1 ) : nextSigPos;
+  int       firstNZPos  = nextSigPos;
+  int       lastNZPos   = -1;
+  int       numNonZero  = 0;
+  int       remRegBins  = cctx.regBinLimit;
+  TCoeff    prevAbs[2]  = { 0, 0 };
+
+  for( ; nextSigPos >= minSubPos && remRegBins >= 4; nextSigPos-- )
+  {
+    const TCoeff absLevel = abs( coeff[cctx.blockPos( nextSigPos )] );
+
+    if( nextSigPos != cctx.scanPosLast() )
+    {
+      // the template covers five neighbours, the approximation two
+      const TCoeff   sumAbs   = ( 5 * ( std::min<TCoeff>( 4 + ( prevAbs[0] & 1 ), prevAbs[0] ) + std::min<TCoeff>( 4 + ( prevAbs[1] & 1 ), prevAbs[1] ) ) ) >> 1;
+      const int      numPos   = ( 5 * ( int( prevAbs[0] != 0 ) + int( prevAbs[1] != 0 ) ) ) >> 1;
+      const unsigned sigCtxId = cctx.sigCtxIdAbsApprox( nextSigPos, sumAbs, numPos, state );
+      if( numNonZero || nextSigPos != inferSigPos )
+      {
+        ctxBits += fracBits.getFracBitsArray( sigCtxId ).intBits[absLevel ? 1 : 0];
+        remRegBins--;
+      }
+    }
+
+    if( absLevel )
+    {
+      const uint8_t ctxOff = cctx.ctxOffsetAbs();
+      numNonZero++;
+      firstNZPos = nextSigPos;
+      lastNZPos  = std::max<int>( lastNZPos, nextSigPos );
+
+      ctxBits += fracBits.getFracBitsArray( cctx.greater1CtxIdAbs( ctxOff ) ).intBits[absLevel > 1 ? 1 : 0];
+      remRegBins--;
+
+      if( absLevel > 1 )
+      {
+        ctxBits += fracBits.getFracBitsArray( cctx.parityCtxIdAbs( ctxOff ) ).intBits[absLevel & 1];
+        ctxBits += fracBits.getFracBitsArray( cctx.greater2CtxIdAbs( ctxOff ) ).intBits[absLevel > 3 ? 1 : 0];
+        remRegBins -= 2;
+
+        if( absLevel > 3 )
+        {
+          const TCoeff   sumRice = ( ( 5 * ( prevAbs[0] + prevAbs[1] ) ) >> 1 ) - 5 * baseLevel;
+          const unsigned ricePar = g_goRiceParsCoeff[std::max<TCoeff>( std::min<TCoeff>( sumRice, 31 ), 0 )];
+          m_binEncoder.encodeRemAbsEP( unsigned( absLevel - 4 ) >> 1, ricePar, COEF_REMAIN_BIN_REDUCTION, cctx.maxLog2TrDRange() );
+        }
+      }
+    }
+
+    state      = ( stateTransTable >> ( ( state << 2 ) + ( ( absLevel & 1 ) << 1 ) ) ) & 3;
+    prevAbs[1] = prevAbs[0];
+    prevAbs[0] = absLevel;
+  }
+  cctx.regBinLimit = remRegBins;
+
+  for( ; nextSigPos >= minSubPos; nextSigPos-- )
+  {
+    const TCoeff   absLevel = abs( coeff[cctx.blockPos( nextSigPos )] );
+    const unsigned rice     = g_goRiceParsCoeff[std::min<TCoeff>( ( 5 * ( prevAbs[0] + prevAbs[1] ) ) >> 1, 31 )];
+    const TCoeff   pos0     = g_goRicePosCoeff0( state, rice );
+    const TCoeff   rem      = ( absLevel == 0 ? pos0 : absLevel <= pos0 ? absLevel - 1 : absLevel );
+    m_binEncoder.encodeRemAbsEP( unsigned( rem ), rice, COEF_REMAIN_BIN_REDUCTION, cctx.maxLog2TrDRange() );
+
+    if( absLevel )
+    {
+      numNonZero++;
+      firstNZPos = nextSigPos;
+      lastNZPos  = std::max<int>( lastNZPos, nextSigPos );
+    }
+
+    state      = ( stateTransTable >> ( ( state << 2 ) + ( ( absLevel & 1 ) << 1 ) ) ) & 3;
+    prevAbs[1] = prevAbs[0];
+    prevAbs[0] = absLevel;
+  }
+
+  const unsigned numSigns = numNonZero - ( cctx.hideSign( firstNZPos, lastNZPos ) ? 1 : 0 );
+  m_binEncoder.encodeBinsEP( 0, numSigns );
+  m_binEncoder.addEstFracBits( ctxBits );
+}
+
 void CABACWriter::residual_codingTS( const TransformUnit& tu, ComponentID compID )
 {
   DTRACE( g_trace_ctx, D_SYNTAX, "residual_codingTS() etype=%d pos=(%d,%d) size=%dx%d\n", tu.blocks[compID].compID, tu.blocks[compID].x, tu.blocks[compID].y, tu.blocks[compID].width, tu.blocks[compID].height );
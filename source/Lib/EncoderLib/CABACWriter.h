@@ -51,7 +51,7 @@ class EncCu;
 class CABACWriter
 {
 public:
-  CABACWriter(BinEncIf &binEncoder) : m_binEncoder(binEncoder), m_bitstream(nullptr)
+  CABACWriter(BinEncIf &binEncoder) : m_binEncoder(binEncoder), m_bitstream(nullptr), m_fastResidualRate(false)
   {
     m_testCtx = m_binEncoder.getCtx();
     m_encCu   = nullptr;
@@ -77,6 +77,10 @@ public:
   uint32_t getNumBins() { return m_binEncoder.getNumBins(); }
   bool     isEncoding() { return m_binEncoder.isEncoding(); }
 
+  // approximate the rate of the coefficient levels instead of estimating all their bins (bit estimation only)
+  void     setFastResidualRate(bool b) { m_fastResidualRate = b; }
+  bool     getFastResidualRate() const { return m_fastResidualRate; }
+
 public:
   // slice segment data (clause 7.3.8.1)
   void        end_of_slice              ();
@@ -159,6 +163,7 @@ public:
   void        isp_mode                  ( const CodingUnit&             cu );
   void        last_sig_coeff            ( CoeffCodingContext&           cctx,     const TransformUnit& tu, ComponentID       compID );
   void        residual_coding_subblock  ( CoeffCodingContext&           cctx,     const TCoeff*     coeff, const int stateTransTable, int& state );
+  void        residual_coding_subblock_fast( CoeffCodingContext&        cctx,     const TCoeff*     coeff, const int stateTransTable, int& state );
   void        residual_codingTS         ( const TransformUnit&          tu,       ComponentID       compID );
   void        residual_coding_subblockTS( CoeffCodingContext&           cctx,     const TCoeff*     coeff, unsigned (&RiceBit)[8], int riceParam, bool ricePresentFlag);
   void        joint_cb_cr               ( const TransformUnit&          tu,       const int cbfMask );
@@ -190,6 +195,7 @@ private:
   Ctx               m_testCtx;
   EncCu            *m_encCu;
   ScanElement*      m_scanOrder;
+  bool              m_fastResidualRate;
 };
 
 
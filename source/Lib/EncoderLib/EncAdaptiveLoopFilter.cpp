@@ -38,6 +38,7 @@
 
 #include "CommonLib/Picture.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/StageProfiler.h"
 
 #define AlfCtx(c) SubCtx( Ctx::Alf, c)
 
@@ -877,6 +878,7 @@ void EncAdaptiveLoopFilter::ALFProcess(CodingStructure& cs, const double *lambda
                                        , Picture* pcPic, uint32_t numSliceSegments
                                       )
 {
+  PROFILE_STAGE(ProfStage::LOOP_FILTER_ALF);
   // IRAP AU is assumed
   if( ( cs.slice->getPendingRasInit() || cs.slice->isIDRorBLA() || ( cs.slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA && m_encCfg->getCraAPSreset() ) ) )
   {
@@ -185,6 +185,7 @@ protected:
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
   bool      m_printHighPrecEncTime = false;
+  bool      m_asyncMetrics = false;                         ///< measure per-picture quality metrics on a background thread
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_ShutterFilterEnable;                          ///< enable Pre-Filtering with Shutter Interval SEI
   int       m_SII_BlendingRatio;
@@ -333,6 +334,9 @@ protected:
   unsigned  m_uiMaxMTTHierarchyDepthIChroma;
   int       m_ttFastSkip;
   double    m_ttFastSkipThr;
+  std::string m_splitPredictorModel;
+  double    m_splitPredictorThr;
+  std::string m_splitPredictorDumpFile;
   bool      m_dualITree;
   unsigned  m_maxCUWidth;
   unsigned  m_maxCUHeight;
@@ -419,6 +423,9 @@ protected:
   int       m_mergeRdCandQuotaSubBlk;
   int       m_mergeRdCandQuotaCiip;
   int       m_mergeRdCandQuotaGpm;
+  int       m_mergePredCacheSize;
+  int       m_intraModeCacheSize;
+  bool      m_fastResidualRate;
   bool      m_usePbIntraFast;
   bool      m_useAMaxBT;
   bool      m_e0023FastEnc;
@@ -461,6 +468,7 @@ protected:
   int       m_bipredSearchRange;
   bool      m_bClipForBiPredMeEnabled;
   bool      m_bFastMEAssumingSmootherMVEnabled;
+  bool      m_pyramidME;
   int       m_minSearchWindow;
   bool      m_bRestrictMESampling;
 
@@ -1374,6 +1382,8 @@ public:
   void      setPrintWPSNR                   (bool value)     { m_printWPSNR = value;              }
 
   bool getPrintHighPrecEncTime() const { return m_printHighPrecEncTime; }
+  bool getAsyncMetrics() const { return m_asyncMetrics; }
+  void setAsyncMetrics(bool value) { m_asyncMetrics = value; }
   void setPrintHightPrecEncTime(bool val) { m_printHighPrecEncTime = val; }
 
   bool      getCabacZeroWordPaddingEnabled()           const { return m_cabacZeroWordPaddingEnabled;  }
@@ -1509,6 +1519,12 @@ public:
   int       getFastTTskip                   ()         const { return m_ttFastSkip; }
   void      setFastTTskipThr                (double val)     { m_ttFastSkipThr = val; }
   double    getFastTTskipThr                ()         const { return m_ttFastSkipThr; }
+  void      setSplitPredictorModel          (const std::string &s) { m_splitPredictorModel = s; }
+  const std::string& getSplitPredictorModel () const { return m_splitPredictorModel; }
+  void      setSplitPredictorThr            (double val)     { m_splitPredictorThr = val; }
+  double    getSplitPredictorThr            ()         const { return m_splitPredictorThr; }
+  void      setSplitPredictorDumpFile       (const std::string &s) { m_splitPredictorDumpFile = s; }
+  const std::string& getSplitPredictorDumpFile () const { return m_splitPredictorDumpFile; }
   void      setDualITree                    ( bool b )       { m_dualITree = b; }
   bool      getDualITree                    ()         const { return m_dualITree; }
   void      setSubPicInfoPresentFlag                        (bool b)                    { m_subPicInfoPresentFlag = b; }
@@ -1715,6 +1731,12 @@ public:
   int       getMergeRdCandQuotaCiip         () const         { return m_mergeRdCandQuotaCiip;}
   void      setMergeRdCandQuotaGpm          ( int n )        { m_mergeRdCandQuotaGpm = n;}
   int       getMergeRdCandQuotaGpm          () const         { return m_mergeRdCandQuotaGpm;}
+  void      setMergePredCacheSize           ( int n )        { m_mergePredCacheSize = n;}
+  int       getMergePredCacheSize           () const         { return m_mergePredCacheSize;}
+  void      setIntraModeCacheSize           ( int n )        { m_intraModeCacheSize = n;}
+  int       getIntraModeCacheSize           () const         { return m_intraModeCacheSize;}
+  void      setFastResidualRate             ( bool  b )      { m_fastResidualRate = b; }
+  bool      getFastResidualRate             () const         { return m_fastResidualRate; }
   void      setUsePbIntraFast               ( bool  n )      { m_usePbIntraFast = n; }
   bool      getUsePbIntraFast               () const         { return m_usePbIntraFast; }
   void      setUseAMaxBT                    ( bool  n )      { m_useAMaxBT = n; }
@@ -1768,6 +1790,7 @@ public:
   void      setBipredSearchRange            ( int   i )      { m_bipredSearchRange = i; }
   void      setClipForBiPredMeEnabled       ( bool  b )      { m_bClipForBiPredMeEnabled = b; }
   void      setFastMEAssumingSmootherMVEnabled ( bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
+  void      setPyramidME                    ( bool b )       { m_pyramidME = b; }
   void      setMinSearchWindow              ( int   i )      { m_minSearchWindow = i; }
   void      setRestrictMESampling           ( bool  b )      { m_bRestrictMESampling = b; }
 
@@ -1896,6 +1919,7 @@ public:
   int       getSearchRange                     () const { return m_searchRange; }
   bool      getClipForBiPredMeEnabled          () const { return m_bClipForBiPredMeEnabled; }
   bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
+  bool      getPyramidME                    () const { return m_pyramidME; }
   int       getMinSearchWindow                 () const { return m_minSearchWindow; }
   bool      getRestrictMESampling              () const { return m_bRestrictMESampling; }
 
@@ -48,6 +48,7 @@
 
 
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <stdio.h>
 #include <cmath>
@@ -84,6 +85,7 @@ void EncCu::create( EncCfg* encCfg )
 
   m_pelUnitBufPool.initPelUnitBufPool(chromaFormat, uiMaxWidth, uiMaxHeight);
   m_mergeItemList.init(encCfg->getMaxMergeRdCandNumTotal(), chromaFormat, uiMaxWidth, uiMaxHeight);
+  m_mergePredCache.init(encCfg->getMergePredCacheSize(), chromaFormat, uiMaxWidth, uiMaxHeight);
 
   for( unsigned w = 0; w < numWidths; w++ )
   {
@@ -180,6 +182,8 @@ void EncCu::destroy()
   delete[] m_pBestCS2; m_pBestCS2 = nullptr;
   delete[] m_pTempCS2; m_pTempCS2 = nullptr;
 
+  m_mergePredCache.destroy();
+
 #if REUSE_CU_RESULTS
   if (m_tmpStorageCtu)
   {
@@ -240,11 +244,14 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigned ctuRsAddr,
                         const EnumArray<int, ChannelType> &prevQP, const EnumArray<int, ChannelType> &currQP)
 {
+  PROFILE_STAGE(ProfStage::ENC_COMPRESS_CTU);
   m_modeCtrl->initCTUEncoding( *cs.slice );
   cs.treeType = TREE_D;
 
   cs.slice->m_mapPltCost[0].clear();
   cs.slice->m_mapPltCost[1].clear();
+  m_mergePredCache.reset();
+  m_pcIntraSearch->resetModeCache();
   // init the partitioning manager
   QTBTPartitioner partitioner;
   partitioner.initCtu(area, ChannelType::LUMA, *cs.slice);
@@ -479,6 +486,7 @@ bool EncCu::xCheckBestMode( CodingStructure *&tempCS, CodingStructure *&bestCS,
 
 void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& partitioner, double maxCostAllowed )
 {
+  PROFILE_STAGE(ProfStage::ENC_COMPRESS_CU);
   CHECK(maxCostAllowed < 0, "Wrong value of maxCostAllowed!");
 
   uint32_t compBegin;
@@ -1088,6 +1096,7 @@ void EncCu::updateLambda(Slice *slice, const int dQP,
 
 void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode, const ModeType modeTypeParent, bool &skipInterPass, double *splitRdCostBest )
 {
+  PROFILE_STAGE(ProfStage::ENC_CHECK_SPLIT);
   const int qp                = encTestMode.qp;
   const Slice &slice          = *tempCS->slice;
   const int oldPrevQp         = tempCS->prevQP[partitioner.chType];
@@ -1526,6 +1535,7 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
 
 bool EncCu::xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode, bool adaptiveColorTrans)
 {
+  PROFILE_STAGE(ProfStage::ENC_CHECK_INTRA);
   double          bestInterCost             = m_modeCtrl->getBestInterCost();
   double          costSize2Nx2NmtsFirstPass = m_modeCtrl->getMtsSize2Nx2NFirstPassCost();
   bool            skipSecondMtsPass         = m_modeCtrl->getSkipSecondMTSPass();
@@ -1644,7 +1654,10 @@ bool EncCu::xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS
             {
               bestCostSoFar = encTestMode.maxCostAllowed;
             }
+            // the luma mode decision may use the approximate residual rate, the CU rate below is estimated exactly
+            m_CABACEstimator->setFastResidualRate(m_pcEncCfg->getFastResidualRate());
             validCandRet = m_pcIntraSearch->estIntraPredLumaQT(cu, partitioner, bestCostSoFar, mtsFlag, startMTSIdx[trGrpIdx], endMTSIdx[trGrpIdx], (trGrpIdx > 0), !cu.colorTransform ? bestCS : nullptr);
+            m_CABACEstimator->setFastResidualRate(false);
             if ((!validCandRet || (cu.ispMode != ISPType::NONE && cu.firstTU->cbf[COMPONENT_Y] == 0)))
             {
               continue;
@@ -2188,6 +2201,7 @@ int getDmvrMvdNum(const PredictionUnit& pu)
 
 void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  PROFILE_STAGE(ProfStage::ENC_CHECK_MERGE);
   const Slice &slice = *tempCS->slice;
 
   CHECK(slice.getSliceType() == I_SLICE, "Merge modes not available for I-slices");
@@ -2781,10 +2795,11 @@ PredictionUnit* EncCu::getPuForInterPrediction(CodingStructure* cs)
   return pu;
 }
 
-void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma, 
+MergePredCache::Entry* EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma, 
   PelUnitBuf& dstBuf, bool finalRd, bool forceNoResidual, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2)
 {
   CHECK((luma && mergeItem->lumaPredReady) || (chroma && mergeItem->chromaPredReady), "Prediction has been avaiable");
+  MergePredCache::Entry* cacheEntry = nullptr;
   // update Pu info
   mergeItem->exportMergeInfo(pu, forceNoResidual);
   if (!finalRd)
@@ -2796,7 +2811,7 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
   {
   case MergeItem::MergeItemType::REGULAR:
     // here predBuf1 is predBufNoMvRefine, predBuf2 is predBufNoCiip
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, predBuf1, false);
+    cacheEntry = motionCompensation4Merge(unitArea, mergeItem, pu, luma, chroma, dstBuf, finalRd, predBuf1);
     if (predBuf2 != nullptr)
     {
       if (luma && chroma)
@@ -2841,7 +2856,7 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
   case MergeItem::MergeItemType::MMVD:
     pu.mmvdEncOptMode = finalRd ? 0 : (pu.mmvdMergeIdx.pos.step > 2 ? 2 : 1);
     mergeItem->noBdofRefine = pu.mmvdEncOptMode == 2 && pu.cs->sps->getBDOFEnabledFlag();
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
+    cacheEntry = motionCompensation4Merge(unitArea, mergeItem, pu, luma, chroma, dstBuf, finalRd, nullptr);
     break;
 
   case MergeItem::MergeItemType::SBTMVP:
@@ -2849,7 +2864,7 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
     break;
 
   case MergeItem::MergeItemType::AFFINE:
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
+    cacheEntry = motionCompensation4Merge(unitArea, mergeItem, pu, luma, chroma, dstBuf, finalRd, nullptr);
     break;
 
   case MergeItem::MergeItemType::GPM:
@@ -2885,12 +2900,72 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
     mergeItem->lumaPredReady |= luma;
     mergeItem->chromaPredReady |= chroma;
   }
+
+  return cacheEntry;
 }
 
-double EncCu::calcLumaCost4MergePrediction(const TempCtx& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam)
+MergePredCache::Entry* EncCu::motionCompensation4Merge(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
+  PelUnitBuf& dstBuf, bool finalRd, PelUnitBuf* predBufNoMvRefine)
 {
-  distParam.cur = predBuf.Y();
-  auto dist = distParam.distFunc(distParam);
+  // only the pruning stage is cached, where the predictions of all candidates are generated
+  if (finalRd || !luma || !m_mergePredCache.isEnabled())
+  {
+    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, predBufNoMvRefine, false);
+    return nullptr;
+  }
+
+  const MergePredKey key(pu, mergeItem->mergeItemType, chroma, predBufNoMvRefine != nullptr);
+  MergePredCache::Entry* entry = m_mergePredCache.find(key);
+  if (entry != nullptr)
+  {
+    dstBuf.copyFrom(entry->pred.getBuf(unitArea), !chroma);
+    if (predBufNoMvRefine != nullptr)
+    {
+      predBufNoMvRefine->copyFrom(entry->predNoMvRefine.getBuf(unitArea), !chroma);
+    }
+    if (PU::checkDMVRCondition(pu))
+    {
+      std::copy_n(entry->mvdL0SubPu, MAX_NUM_SUBCU_DMVR, pu.mvdL0SubPu);
+      pu.dmvrImpreciseMv = entry->dmvrImpreciseMv;
+    }
+    return entry;
+  }
+
+  m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, predBufNoMvRefine, false);
+
+  entry = m_mergePredCache.insert(key);
+  entry->pred.getBuf(unitArea).copyFrom(dstBuf, !chroma);
+  if (predBufNoMvRefine != nullptr)
+  {
+    entry->predNoMvRefine.getBuf(unitArea).copyFrom(*predBufNoMvRefine, !chroma);
+  }
+  if (PU::checkDMVRCondition(pu))
+  {
+    // the refined motion is needed for the final RD checking
+    std::copy_n(pu.mvdL0SubPu, MAX_NUM_SUBCU_DMVR, entry->mvdL0SubPu);
+    entry->dmvrImpreciseMv = pu.dmvrImpreciseMv;
+  }
+  return entry;
+}
+
+double EncCu::calcLumaCost4MergePrediction(const TempCtx& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam,
+  MergePredCache::Entry* cacheEntry)
+{
+  Distortion dist;
+  if (cacheEntry != nullptr && cacheEntry->distValid)
+  {
+    dist = cacheEntry->dist;
+  }
+  else
+  {
+    distParam.cur = predBuf.Y();
+    dist = distParam.distFunc(distParam);
+    if (cacheEntry != nullptr)
+    {
+      cacheEntry->dist = dist;
+      cacheEntry->distValid = true;
+    }
+  }
   m_CABACEstimator->getCtx() = ctxStart;
   auto fracBits = m_pcInterSearch->xCalcPuMeBits(pu);
   double cost = (double)dist + (double)fracBits * lambda;
@@ -2981,9 +3056,9 @@ void EncCu::addRegularCandsToPruningList(const MergeCtx& mergeCtx, const UnitAre
     // For regular merge cands, both luma and chroma are predicted at the pruning stage.
     // CIIP may be reset back to regular merge in the pass of no residuals. In this case,
     // mrgPredBufNoCiip will be used directly without performing prediction
-    generateMergePrediction(localUnitArea, regularMerge, *pu, true, true, dstBuf, false, false,
+    MergePredCache::Entry* cacheEntry = generateMergePrediction(localUnitArea, regularMerge, *pu, true, true, dstBuf, false, false,
       mrgPredBufNoMvRefine[uiMergeCand], mrgPredBufNoCiip[uiMergeCand]);
-    regularMerge->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPassIntra, *pu, distParam);
+    regularMerge->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPassIntra, *pu, distParam, cacheEntry);
     if (PU::checkDMVRCondition(*pu))
     {
       std::copy_n(pu->mvdL0SubPu, numDmvrMvd, dmvrL0Mvd[regularMerge->mergeIdx]);
@@ -3069,8 +3144,8 @@ void EncCu::addMmvdCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea&
     MergeItem* mmvdMerge = m_mergeItemList.allocateNewMergeItem();
     mmvdMerge->importMergeInfo(mergeCtx, mmvdIdx.val, MergeItem::MergeItemType::MMVD, *pu);
     auto dstBuf = mmvdMerge->getPredBuf(localUnitArea);
-    generateMergePrediction(localUnitArea, mmvdMerge, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
-    mmvdMerge->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPassIntra, *pu, distParam);
+    MergePredCache::Entry* cacheEntry = generateMergePrediction(localUnitArea, mmvdMerge, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
+    mmvdMerge->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPassIntra, *pu, distParam, cacheEntry);
     m_mergeItemList.insertMergeItemToList(mmvdMerge, m_pcEncCfg->getEncILOpt());
   }
 }
@@ -3090,8 +3165,8 @@ void EncCu::addAffineCandsToPruningList(AffineMergeCtx& affineMergeCtx, const Un
     mergeItem->importMergeInfo(affineMergeCtx, mergeIdx, affineMergeCtx.mergeType[mergeIdx] == MergeType::SUBPU_ATMVP
       ? MergeItem::MergeItemType::SBTMVP : MergeItem::MergeItemType::AFFINE, localUnitArea);
     auto dstBuf = mergeItem->getPredBuf(localUnitArea);
-    generateMergePrediction(localUnitArea, mergeItem, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
-    mergeItem->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPass, *pu, distParam);
+    MergePredCache::Entry* cacheEntry = generateMergePrediction(localUnitArea, mergeItem, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
+    mergeItem->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPass, *pu, distParam, cacheEntry);
 
 #if GDR_ENABLED
     if (isEncodeGdrClean)
@@ -3419,6 +3494,7 @@ void EncCu::xCheckRDCostIBCMode(CodingStructure *&tempCS, CodingStructure *&best
 
 void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  PROFILE_STAGE(ProfStage::ENC_CHECK_INTER);
   const EncType encType = dynamic_cast<EncLib*>(m_pcEncCfg)->getEncType();
   if (m_pcEncCfg->getDPF() && encType == ENC_PRE)
   {
@@ -4949,4 +5025,130 @@ void MergeItemList::insertBackupItemsToList()
   m_backupList.clear();
 }
 
+
+MergePredKey::MergePredKey(const PredictionUnit& pu, MergeItem::MergeItemType _mergeItemType, bool _chroma, bool _noMvRefine)
+  : area(pu.Y())
+  , mergeItemType(_mergeItemType)
+  , interDir(pu.interDir)
+  , bcwIdx(pu.cu->bcwIdx)
+  , imv(pu.cu->imv)
+  , mmvdEncOptMode(pu.mmvdEncOptMode)
+  , affineType(pu.cu->affine ? pu.cu->affineType : AffineModel::_4_PARAMS)
+  , chroma(_chroma)
+  , noMvRefine(_noMvRefine)
+{
+  // the motion after the bi-prediction restriction, unused lists and control points are left invalid
+  for (auto l : { REF_PIC_LIST_0, REF_PIC_LIST_1 })
+  {
+    if (pu.refIdx[l] < 0)
+    {
+      continue;
+    }
+    if (pu.cu->affine)
+    {
+      for (int cp = 0; cp < AFFINE_MAX_NUM_CP; cp++)
+      {
+        mvField[cp][l] = MvField(pu.mvAffi[l][cp], pu.refIdx[l]);
+      }
+    }
+    else
+    {
+      mvField[0][l] = MvField(pu.mv[l], pu.refIdx[l]);
+    }
+  }
+}
+
+bool MergePredKey::operator==(const MergePredKey& other) const
+{
+  if (area != other.area || mergeItemType != other.mergeItemType || interDir != other.interDir || bcwIdx != other.bcwIdx
+    || imv != other.imv || mmvdEncOptMode != other.mmvdEncOptMode || affineType != other.affineType
+    || chroma != other.chroma || noMvRefine != other.noMvRefine)
+  {
+    return false;
+  }
+  for (int cp = 0; cp < AFFINE_MAX_NUM_CP; cp++)
+  {
+    if (mvField[cp][REF_PIC_LIST_0] != other.mvField[cp][REF_PIC_LIST_0] || mvField[cp][REF_PIC_LIST_1] != other.mvField[cp][REF_PIC_LIST_1])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MergePredCache::init(size_t maxSize, ChromaFormat chromaFormat, int ctuWidth, int ctuHeight)
+{
+  destroy();
+  m_maxSize = maxSize;
+  m_entries.reserve(maxSize);
+  m_chromaFormat = chromaFormat;
+  m_ctuArea = Area(0, 0, ctuWidth, ctuHeight);
+}
+
+void MergePredCache::destroy()
+{
+  for (auto p : m_entries)
+  {
+    p->pred.destroy();
+    p->predNoMvRefine.destroy();
+    delete p;
+  }
+  m_entries.clear();
+  m_maxSize = 0;
+  m_useCounter = 0;
+}
+
+void MergePredCache::reset()
+{
+  // the entries keep their buffers, only the keys are invalidated
+  for (auto p : m_entries)
+  {
+    p->lastUse = 0;
+  }
+  m_useCounter = 0;
+}
+
+MergePredCache::Entry* MergePredCache::find(const MergePredKey& key)
+{
+  for (auto p : m_entries)
+  {
+    if (p->lastUse != 0 && p->key == key)
+    {
+      p->lastUse = ++m_useCounter;
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+MergePredCache::Entry* MergePredCache::insert(const MergePredKey& key)
+{
+  Entry* entry = nullptr;
+  if (m_entries.size() < m_maxSize)
+  {
+    entry = new Entry(key);
+    m_entries.push_back(entry);
+  }
+  else
+  {
+    // replace the least recently used entry, unused entries have lastUse 0
+    entry = *std::min_element(m_entries.begin(), m_entries.end(),
+                              [](const Entry* a, const Entry* b) { return a->lastUse < b->lastUse; });
+    entry->key = key;
+  }
+
+  if (entry->pred.bufs.empty())
+  {
+    entry->pred.create(m_chromaFormat, m_ctuArea);
+  }
+  if (key.noMvRefine && entry->predNoMvRefine.bufs.empty())
+  {
+    entry->predNoMvRefine.create(m_chromaFormat, m_ctuArea);
+  }
+  entry->distValid = false;
+  entry->dmvrImpreciseMv = false;
+  entry->lastUse = ++m_useCounter;
+  return entry;
+}
+
 //! \}
@@ -231,6 +231,63 @@ public:
 
 };
 
+// Identifies a merge prediction generated at the pruning stage: a block with the same position, size and motion
+// has the same prediction, regardless of the partitioning path it has been reached by
+struct MergePredKey
+{
+  Area                                      area;
+  MergeItem::MergeItemType                  mergeItemType;
+  std::array<MvField[2], AFFINE_MAX_NUM_CP> mvField;
+  uint8_t                                   interDir;
+  uint8_t                                   bcwIdx;
+  uint8_t                                   imv;
+  uint8_t                                   mmvdEncOptMode;
+  AffineModel                               affineType;
+  bool                                      chroma;
+  bool                                      noMvRefine;
+
+  MergePredKey(const PredictionUnit& pu, MergeItem::MergeItemType _mergeItemType, bool _chroma, bool _noMvRefine);
+  bool operator==(const MergePredKey& other) const;
+};
+
+// Bounded cache of the merge predictions and their luma SATDs of the current CTU, entries are replaced in
+// least recently used order
+class MergePredCache
+{
+public:
+  struct Entry
+  {
+    MergePredKey key;
+    PelStorage   pred;
+    PelStorage   predNoMvRefine;
+    Distortion   dist;
+    bool         distValid;
+    Mv           mvdL0SubPu[MAX_NUM_SUBCU_DMVR];
+    bool         dmvrImpreciseMv;
+    uint64_t     lastUse;
+
+    Entry(const MergePredKey& _key) : key(_key), dist(0), distValid(false), dmvrImpreciseMv(false), lastUse(0) {}
+  };
+
+private:
+  std::vector<Entry*> m_entries;
+  size_t              m_maxSize = 0;
+  uint64_t            m_useCounter = 0;
+  ChromaFormat        m_chromaFormat;
+  Area                m_ctuArea;
+
+public:
+  MergePredCache() {}
+  ~MergePredCache() { destroy(); }
+
+  void          init(size_t maxSize, ChromaFormat chromaFormat, int ctuWidth, int ctuHeight);
+  void          destroy();
+  void          reset();
+  bool          isEnabled() const { return m_maxSize > 0; }
+  Entry*        find(const MergePredKey& key);
+  Entry*        insert(const MergePredKey& key);
+};
+
 class EncCu
   : DecCu
 {
@@ -295,6 +352,7 @@ private:
 
   GeoComboCostList m_comboList;
   MergeItemList         m_mergeItemList;
+  MergePredCache        m_mergePredCache;
 
 public:
   /// copy parameters from encoder class
@@ -380,9 +438,13 @@ protected:
   PredictionUnit* getPuForInterPrediction(CodingStructure* cs);
   unsigned int updateRdCheckingNum(double threshold, unsigned int numMergeSatdCand);
 
-  void generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
+  // returns the merge prediction cache entry holding the prediction if it has been looked up or stored there
+  MergePredCache::Entry* generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
     PelUnitBuf& dstBuf, bool finalRd, bool forceNoResidual, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2);
-  double calcLumaCost4MergePrediction(const TempCtx& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam);
+  MergePredCache::Entry* motionCompensation4Merge(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
+    PelUnitBuf& dstBuf, bool finalRd, PelUnitBuf* predBufNoMvRefine);
+  double calcLumaCost4MergePrediction(const TempCtx& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam,
+    MergePredCache::Entry* cacheEntry = nullptr);
 
   template <size_t N>
   void addRegularCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
@@ -58,6 +58,7 @@
 #include "CommonLib/ProfileTierLevel.h"
 
 #include "DecoderLib/DecLib.h"
+#include "CommonLib/StageProfiler.h"
 
 //! \ingroup EncoderLib
 //! \{
@@ -193,6 +194,7 @@ void  EncGOP::destroy()
   {
     m_fgAnalyzer.destroy();
   }
+  xReportPendingPictures(true);
   if (m_pcRefLayerRescaledPicYuv)
   {
     m_pcRefLayerRescaledPicYuv->destroy();
@@ -4505,6 +4507,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
       //-- For time output for each slice
       auto elapsed = std::chrono::steady_clock::now() - beforeTime;
       auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( elapsed ).count()/1000.0;
+      PROFILE_FINISH_PICTURE(pcSlice->getPOC());
 
       std::string digestStr;
 #if GDR_ENABLED
@@ -4547,7 +4550,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
 
       m_pcCfg->setEncodedFlag(gopId, true);
 
-      double PSNR_Y;
+      double PSNR_Y = 0.0;
       xCalculateAddPSNRs(isField, isTff, gopId, pcPic, accessUnit, rcListPic, encTime, snr_conversion, printFrameMSE,
                          printMSSSIM, &PSNR_Y, isEncodeLtRef);
 #if GREEN_METADATA_SEI_ENABLED
@@ -4778,6 +4781,8 @@ void EncGOP::printOutSummary(uint32_t numAllPicCoded, bool isField, const bool p
                              const bool printSequenceMSE, const bool printMSSSIM, const bool printHexPsnr,
                              const bool printRprPsnr, const BitDepths &bitDepths, int layerId)
 {
+  xReportPendingPictures(true);
+
 #if ENABLE_QPA
   const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
 #endif
@@ -5043,14 +5048,7 @@ static inline double calcWeightedSquaredError(const CPelBuf& org,        const C
   int x, y;
 
   // calculate image differences and activity
-  for (y = 0; y < blockHeight; y++)  // error
-  {
-    for (x = 0; x < blockWidth; x++)
-    {
-      const     int64_t iDiff = (int64_t)o[y*O + x] - (int64_t)r[y*R + x];
-      ssErr += uint64_t(iDiff * iDiff);
-    }
-  }
+  ssErr = g_pelBufOP.calcSsd(o, O, r, R, blockWidth, blockHeight); // error
   if (wAct <= xAct || hAct <= yAct)
   {
     return (double) ssErr;
@@ -5112,18 +5110,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        totalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            totalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return totalDiff;
+        return g_pelBufOP.calcSsd(pSrc0, pic0.stride, pSrc1, pic1.stride, W, H);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -5160,17 +5147,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    totalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int temp = pSrc0[x] - pSrc1[x];
-        totalDiff += uint64_t(temp * temp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    totalDiff = g_pelBufOP.calcSsd(pSrc0, pic0.stride, pSrc1, pic1.stride, pic0.width, pic0.height);
   }
 
   return totalDiff;
@@ -5312,36 +5289,8 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   CHECK(!(conversion == IPCOLOURSPACE_UNCHANGED), "Unspecified error");
 //  const CPelUnitBuf& org = (conversion != IPCOLOURSPACE_UNCHANGED) ? pcPic->getPicYuvTrueOrg()->getBuf() : pcPic->getPicYuvOrg()->getBuf();
   const CPelUnitBuf& org = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->getTrueOrigBuf() : pcPic->getOrigBuf();
-#if ENABLE_QPA
-  const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
-#endif
-  double  dPSNR[MAX_NUM_COMPONENT];
-  double msssim[MAX_NUM_COMPONENT] = {0.0};
-#if WCG_WPSNR
-  const bool    useLumaWPSNR = m_pcEncLib->getPrintWPSNR();
-  double  dPSNRWeighted[MAX_NUM_COMPONENT];
-  double  MSEyuvframeWeighted[MAX_NUM_COMPONENT];
-#endif
-  double  upscaledPSNR[MAX_NUM_COMPONENT];
-  double  upscaledMsssim[MAX_NUM_COMPONENT];
-  for(int i=0; i<MAX_NUM_COMPONENT; i++)
-  {
-    dPSNR[i]=0.0;
-#if WCG_WPSNR
-    dPSNRWeighted[i]=0.0;
-    MSEyuvframeWeighted[i] = 0.0;
-#endif
-    upscaledPSNR[i] = 0.0;
-  }
-#if JVET_O0756_CALCULATE_HDRMETRICS
-  double deltaE[hdrtoolslib::NB_REF_WHITE];
-  double psnrL[hdrtoolslib::NB_REF_WHITE];
-  for (int i=0; i<hdrtoolslib::NB_REF_WHITE; i++)
-  {
-    deltaE[i] = 0.0;
-    psnrL[i] = 0.0;
-  }
-#endif
+
+  std::unique_ptr<PicMetricsJob> job(new PicMetricsJob);
 
   PelStorage interm;
 
@@ -5353,20 +5302,36 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 
   const CPelUnitBuf& picC = (conversion == IPCOLOURSPACE_UNCHANGED) ? pic : interm;
 
-  //===== calculate PSNR =====
-  double             mseYuvFrame[MAX_NUM_COMPONENT] = { 0, 0, 0 };
-  const ChromaFormat formatD = pic.chromaFormat;
-  const ChromaFormat format  = sps.getChromaFormatIdc();
+  const ChromaFormat format = sps.getChromaFormatIdc();
 
   const bool bPicIsField     = pcPic->fieldPic;
   const Slice*  pcSlice      = pcPic->slices[0];
 
-  PelStorage upscaledRec;
+  job->rec         = picC;
+  job->org         = org;
+  job->format      = format;
+  job->bitDepths   = sps.getBitDepths();
+  job->isField     = bPicIsField;
+  job->useUpscaled = m_pcEncLib->isResChangeInClvsEnabled();
+  job->useRefLayer = false;
+  job->printMSSSIM = printMSSSIM;
+  job->padX        = m_pcEncLib->getSourcePadding(0);
+  job->padY        = m_pcEncLib->getSourcePadding(1);
+
+  // when RPR is enabled, picture padding is picture specific due to possible different picture resoluitons, however only full resolution padding is stored in EncLib
+  // get per picture padding from the conformance window, in this case if conformance window is set not equal to the padding then PSNR results may be inaccurate
+  if (job->useUpscaled)
+  {
+    const Window& conf = pcPic->getConformanceWindow();
+    job->padX = conf.getWindowRightOffset() * SPS::getWinUnitX(format);
+    job->padY = conf.getWindowBottomOffset() * SPS::getWinUnitY(format);
+  }
 
   if (m_pcEncLib->isResChangeInClvsEnabled())
   {
-    const CPelBuf& upscaledOrg = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->M_BUFS( 0, PIC_TRUE_ORIGINAL_INPUT).get( COMPONENT_Y ) : pcPic->M_BUFS( 0, PIC_ORIGINAL_INPUT).get( COMPONENT_Y );
-    upscaledRec.create( pic.chromaFormat, Area( Position(), upscaledOrg ) );
+    job->upscaledOrg = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->M_BUFS( 0, PIC_TRUE_ORIGINAL_INPUT) : pcPic->M_BUFS( 0, PIC_ORIGINAL_INPUT);
+    const CPelBuf& upscaledOrg = job->upscaledOrg.get(COMPONENT_Y);
+    job->upscaledRec.create( pic.chromaFormat, Area( Position(), upscaledOrg ) );
 
     ScalingRatio scalingRatio;
     // it is assumed that full resolution picture PPS has ppsId 0
@@ -5375,7 +5340,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     CU::getRprScaling(&sps, pps, pcPic, scalingRatio);
 
     bool rescaleForDisplay = true;
-    Picture::rescalePicture(scalingRatio, picC, pcPic->getScalingWindow(), upscaledRec, pps->getScalingWindow(), format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), rescaleForDisplay, m_pcCfg->getUpscaleFilerForDisplay());
+    Picture::rescalePicture(scalingRatio, picC, pcPic->getScalingWindow(), job->upscaledRec, pps->getScalingWindow(), format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), rescaleForDisplay, m_pcCfg->getUpscaleFilerForDisplay());
   }
 
   Picture* picRefLayer = nullptr;
@@ -5417,38 +5382,192 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 
         Picture::rescalePicture( scalingRatio, pub0, wScaling0, *m_pcRefLayerRescaledPicYuv, wScaling1, format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag() );
         m_pcEncLib->setRefLayerRescaledAvailable(true);
+
+        job->refLayerRec = *m_pcRefLayerRescaledPicYuv;
+        job->useRefLayer = !job->useUpscaled;
       }
     }
   }
 
-  for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+#if JVET_O0756_CALCULATE_HDRMETRICS
+  job->calculateHdrMetrics = m_pcEncLib->getCalculateHdrMetrics();
+  for (int i=0; i<hdrtoolslib::NB_REF_WHITE; i++)
   {
-    const ComponentID compID = ComponentID(comp);
-    const CPelBuf&    p = picC.get(compID);
-    const CPelBuf&    o = org.get(compID);
+    job->deltaE[i] = 0.0;
+    job->psnrL[i] = 0.0;
+  }
+  if (job->calculateHdrMetrics)
+  {
+    auto beforeTime = std::chrono::steady_clock::now();
+    xCalculateHDRMetrics(pcPic, job->deltaE, job->psnrL);
+    auto elapsed = std::chrono::steady_clock::now() - beforeTime;
+    m_metricTime += elapsed;
+  }
+#endif
 
-    CHECK(!( p.width  == o.width), "Unspecified error");
-    CHECK(!( p.height == o.height), "Unspecified error");
+  /* calculate the size of the access unit, excluding:
+   *  - any AnnexB contributions (start_code_prefix, zero_byte, etc.,)
+   *  - SEI NAL units
+   */
+  uint32_t numRBSPBytes = 0;
+  for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
+  {
+    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.str().size());
+    if (m_pcCfg->getSummaryVerboseness() > 0)
+    {
+      job->nalUnitSizes.push_back(std::make_pair((*it)->m_nalUnitType, numRBSPBytes_nal));
+    }
+    if( ( *it )->m_nalUnitType != NAL_UNIT_PREFIX_SEI && ( *it )->m_nalUnitType != NAL_UNIT_SUFFIX_SEI )
+    {
+      numRBSPBytes += numRBSPBytes_nal;
+      if (it == accessUnit.begin() || (*it)->m_nalUnitType == NAL_UNIT_OPI || (*it)->m_nalUnitType == NAL_UNIT_VPS || (*it)->m_nalUnitType == NAL_UNIT_DCI || (*it)->m_nalUnitType == NAL_UNIT_SPS || (*it)->m_nalUnitType == NAL_UNIT_PPS || (*it)->m_nalUnitType == NAL_UNIT_PREFIX_APS || (*it)->m_nalUnitType == NAL_UNIT_SUFFIX_APS)
+      {
+        numRBSPBytes += 4;
+      }
+      else
+      {
+        numRBSPBytes += 3;
+      }
+    }
+  }
 
-    int padX = m_pcEncLib->getSourcePadding( 0 );
-    int padY = m_pcEncLib->getSourcePadding( 1 );
+  uint32_t uibits = numRBSPBytes * 8;
+  m_rvm.push_back(uibits);
 
-    // when RPR is enabled, picture padding is picture specific due to possible different picture resoluitons, however only full resolution padding is stored in EncLib
-    // get per picture padding from the conformance window, in this case if conformance window is set not equal to the padding then PSNR results may be inaccurate
-    if (m_pcEncLib->isResChangeInClvsEnabled())
+  char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
+  if (! pcPic->referenced)
+  {
+    c += 32;
+  }
+  if (m_pcCfg->getDependentRAPIndicationSEIEnabled() && pcSlice->isDRAP())
+  {
+    c = 'D';
+  }
+  if (m_pcCfg->getEdrapIndicationSEIEnabled() && pcSlice->getEdrapRapId() > 0)
+  {
+    c = 'E';
+  }
+
+  job->poc           = pcSlice->getPOC();
+  job->layerId       = pcSlice->getPic()->layerId;
+  job->tLayer        = pcSlice->getTLayer();
+  job->nalUnitType   = pcSlice->getNalUnitType();
+  job->sliceType     = pcSlice->getSliceType();
+  job->sliceTypeChar = c;
+  job->sliceQp       = pcSlice->getSliceQp();
+  job->bits          = uibits;
+  job->encTime       = dEncTime;
+  job->printFrameMSE = printFrameMSE;
+  job->printUpscaled = m_pcEncLib->isResChangeInClvsEnabled() || m_pcEncLib->isRefLayerRescaledAvailable();
+  job->isEncodeLtRef = isEncodeLtRef;
+
+  std::ostringstream refLists;
+  for (int refList = 0; refList < 2; refList++)
+  {
+    refLists << " [L" << refList;
+    for (int refIndex = 0; refIndex < pcSlice->getNumRefIdx(RefPicList(refList)); refIndex++)
     {
-      const Window& conf = pcPic->getConformanceWindow();
-      padX = conf.getWindowRightOffset() * SPS::getWinUnitX( format );
-      padY = conf.getWindowBottomOffset() * SPS::getWinUnitY( format );
+      const ScalingRatio &scaleRatio = pcSlice->getScalingRatio(RefPicList(refList), refIndex);
+
+      refLists << ' ' << pcSlice->getRefPOC(RefPicList(refList), refIndex);
+      if (pcPic->cs->picHeader->getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - refList)
+          && pcSlice->getColRefIdx() == refIndex)
+      {
+        refLists << 'c';
+      }
+      if (scaleRatio != SCALE_1X)
+      {
+        refLists << '(' << std::fixed << std::setprecision(2) << double(scaleRatio.x) / (1 << ScalingRatio::BITS)
+                 << "x, " << double(scaleRatio.y) / (1 << ScalingRatio::BITS) << "x)";
+      }
+
+      if (pcSlice->getRefPOC(RefPicList(refList), refIndex) == pcSlice->getPOC())
+      {
+        refLists << '.' << pcSlice->getRefPic(RefPicList(refList), refIndex)->layerId;
+      }
     }
+    refLists << ']';
+  }
+  job->refLists = refLists.str();
 
-    const uint32_t width = p.width - ( padX >> ::getComponentScaleX( compID, format ) );
-    const uint32_t height = p.height - ( padY >> ( !!bPicIsField + ::getComponentScaleY( compID, format ) ) );
+  // the 360 video metrics, field coding, multiple layers and the green metadata SEI need the results right away
+  bool measureAsync = m_pcCfg->getAsyncMetrics() && !bPicIsField && conversion == IPCOLOURSPACE_UNCHANGED
+                      && (pcPic->cs->vps == nullptr || pcPic->cs->vps->getMaxLayers() == 1);
+#if EXTENSION_360_VIDEO
+  measureAsync = false;
+#endif
+#if GREEN_METADATA_SEI_ENABLED
+  measureAsync = measureAsync && !m_pcCfg->getSEIGreenMetadataInfoSEIEnable();
+#endif
+
+  if (measureAsync)
+  {
+    // the picture buffers are reused before a background measurement would finish
+    job->retainedRec.create(job->rec.chromaFormat, Area(Position(), job->rec.Y()));
+    job->retainedRec.copyFrom(job->rec);
+    job->rec = job->retainedRec;
+    job->retainedOrg.create(job->org.chromaFormat, Area(Position(), job->org.Y()));
+    job->retainedOrg.copyFrom(job->org);
+    job->org = job->retainedOrg;
+    if (job->useUpscaled)
+    {
+      job->retainedUpscaledOrg.create(job->upscaledOrg.chromaFormat, Area(Position(), job->upscaledOrg.Y()));
+      job->retainedUpscaledOrg.copyFrom(job->upscaledOrg);
+      job->upscaledOrg = job->retainedUpscaledOrg;
+    }
+    if (job->useRefLayer)
+    {
+      job->retainedRefLayerRec.create(job->refLayerRec.chromaFormat, Area(Position(), job->refLayerRec.Y()));
+      job->retainedRefLayerRec.copyFrom(job->refLayerRec);
+      job->refLayerRec = job->retainedRefLayerRec;
+    }
+
+    PicMetricsJob *pending = job.get();
+    job->measured = std::async(std::launch::async, [this, pending]() { xMeasurePicture(*pending); });
+    m_pendingMetrics.push_back(std::move(job));
+    xReportPendingPictures(false);
+    // not known yet; the green metadata SEI, which uses it, disables the asynchronous measurement
+    *PSNR_Y = 0.0;
+    return;
+  }
+
+  xReportPendingPictures(true);
+  xMeasurePicture(*job);
+#if EXTENSION_360_VIDEO
+  m_ext360.calculatePSNRs(pcPic);
+#endif
+  xReportPicture(*job);
+  *PSNR_Y = job->metrics.psnr[COMPONENT_Y];
+}
+
+void EncGOP::xMeasurePicture(PicMetricsJob &job)
+{
+#if ENABLE_QPA
+  const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
+#endif
+#if WCG_WPSNR
+  const bool    useLumaWPSNR = m_pcEncLib->getPrintWPSNR();
+#endif
+  const ChromaFormat formatD = job.rec.chromaFormat;
+  const ChromaFormat format  = job.format;
+  PicMetrics&        metrics = job.metrics;
+
+  for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf&    p = job.rec.get(compID);
+    const CPelBuf&    o = job.org.get(compID);
+
+    CHECK(!( p.width  == o.width), "Unspecified error");
+    CHECK(!( p.height == o.height), "Unspecified error");
+
+    const uint32_t width = p.width - ( job.padX >> ::getComponentScaleX( compID, format ) );
+    const uint32_t height = p.height - ( job.padY >> ( !!job.isField + ::getComponentScaleY( compID, format ) ) );
 
     // create new buffers with correct dimensions
     const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
     const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
-    const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    const uint32_t    bitDepth = job.bitDepths[toChannelType(compID)];
 #if ENABLE_QPA
     const uint64_t ssdTemp =
       xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format),
@@ -5459,189 +5578,163 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     const uint32_t maxval = 255 << (bitDepth - 8);
     const uint32_t size   = width * height;
     const double fRefValue = (double)maxval * maxval * size;
-    dPSNR[comp]              = ssdTemp ? 10.0 * log10(fRefValue / (double) ssdTemp) : 999.99;
-    mseYuvFrame[comp]        = (double) ssdTemp / size;
-    if(printMSSSIM)
+    metrics.psnr[comp]       = ssdTemp ? 10.0 * log10(fRefValue / (double) ssdTemp) : 999.99;
+    metrics.mse[comp]        = (double) ssdTemp / size;
+    if (job.printMSSSIM)
     {
-      msssim[comp] = xCalculateMSSSIM (o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, width, height, bitDepth);
+      metrics.msssim[comp] = xCalculateMSSSIM (o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, width, height, bitDepth);
     }
 #if WCG_WPSNR
-    const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
+    const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, job.org.get(COMPONENT_Y), compID, format);
     if (useLumaWPSNR)
     {
-      dPSNRWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
-      MSEyuvframeWeighted[comp] = (double)uiSSDtempWeighted / size;
+      metrics.psnrWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
+      metrics.mseWeighted[comp]  = (double)uiSSDtempWeighted / size;
     }
 #endif
 
-
-    if (m_pcEncLib->isResChangeInClvsEnabled())
+    if (job.useUpscaled)
     {
-      const CPelBuf& upscaledOrg = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->M_BUFS( 0, PIC_TRUE_ORIGINAL_INPUT).get( compID ) : pcPic->M_BUFS( 0, PIC_ORIGINAL_INPUT).get( compID );
+      const CPelBuf& upscaledOrg = job.upscaledOrg.get(compID);
 
       const uint32_t upscaledWidth = upscaledOrg.width - ( m_pcEncLib->getSourcePadding( 0 ) >> ::getComponentScaleX( compID, format ) );
-      const uint32_t upscaledHeight = upscaledOrg.height - ( m_pcEncLib->getSourcePadding( 1 ) >> ( !!bPicIsField + ::getComponentScaleY( compID, format ) ) );
+      const uint32_t upscaledHeight = upscaledOrg.height - ( m_pcEncLib->getSourcePadding( 1 ) >> ( !!job.isField + ::getComponentScaleY( compID, format ) ) );
 
       // create new buffers with correct dimensions
-      const CPelBuf upscaledRecPB( upscaledRec.get( compID ).bufAt( 0, 0 ), upscaledRec.get( compID ).stride, upscaledWidth, upscaledHeight );
+      const CPelBuf upscaledRecPB( job.upscaledRec.get( compID ).bufAt( 0, 0 ), job.upscaledRec.get( compID ).stride, upscaledWidth, upscaledHeight );
       const CPelBuf upscaledOrgPB( upscaledOrg.bufAt( 0, 0 ), upscaledOrg.stride, upscaledWidth, upscaledHeight );
 
 #if ENABLE_QPA
       const uint64_t upscaledSSD = xFindDistortionPlane( upscaledRecPB, upscaledOrgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX( compID, format ) );
 #else
-      const uint64_t scaledSSD = xFindDistortionPlane( upsacledRecPB, upsacledOrgPB, 0 );
+      const uint64_t upscaledSSD = xFindDistortionPlane( upscaledRecPB, upscaledOrgPB, 0 );
 #endif
 
-      upscaledPSNR[comp] = upscaledSSD ? 10.0 * log10( (double)maxval * maxval * upscaledWidth * upscaledHeight / (double)upscaledSSD ) : 999.99;
-      upscaledMsssim[comp] = xCalculateMSSSIM (upscaledOrgPB.bufAt(0, 0), upscaledOrgPB.stride, upscaledRecPB.bufAt(0, 0), upscaledRecPB.stride, upscaledWidth, upscaledHeight, bitDepth);
+      metrics.upscaledPsnr[comp] = upscaledSSD ? 10.0 * log10( (double)maxval * maxval * upscaledWidth * upscaledHeight / (double)upscaledSSD ) : 999.99;
+      metrics.upscaledMsssim[comp] = xCalculateMSSSIM (upscaledOrgPB.bufAt(0, 0), upscaledOrgPB.stride, upscaledRecPB.bufAt(0, 0), upscaledRecPB.stride, upscaledWidth, upscaledHeight, bitDepth);
     }
-    else if (picRefLayer)
+    else if (job.useRefLayer)
     {
-      const CPelBuf& p = m_pcRefLayerRescaledPicYuv->get(compID);
-      const CPelBuf& o = org.get(compID);
+      const CPelBuf& p = job.refLayerRec.get(compID);
+      const CPelBuf& o = job.org.get(compID);
 #if ENABLE_QPA
       const uint64_t upscaledSSD = xFindDistortionPlane(p, o, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format));
 #else
       const uint64_t upscaledSSD = xFindDistortionPlane(p, o, 0);
 #endif
-      upscaledPSNR[comp] = upscaledSSD ? 10.0 * log10((double) fRefValue / (double) upscaledSSD) : 999.99;
-      if (printMSSSIM)
+      metrics.upscaledPsnr[comp] = upscaledSSD ? 10.0 * log10((double) fRefValue / (double) upscaledSSD) : 999.99;
+      if (job.printMSSSIM)
       {
         const uint32_t upscaledWidth = o.width - ( m_pcEncLib->getSourcePadding( 0 ) >> ::getComponentScaleX( compID, format ) );
-        const uint32_t upscaledHeight = o.height - ( m_pcEncLib->getSourcePadding( 1 ) >> ( !!bPicIsField + ::getComponentScaleY( compID, format ) ) );
-        upscaledMsssim[comp] = xCalculateMSSSIM(o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, upscaledWidth, upscaledHeight, bitDepth);
+        const uint32_t upscaledHeight = o.height - ( m_pcEncLib->getSourcePadding( 1 ) >> ( !!job.isField + ::getComponentScaleY( compID, format ) ) );
+        metrics.upscaledMsssim[comp] = xCalculateMSSSIM(o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, upscaledWidth, upscaledHeight, bitDepth);
       }
     }
   }
+}
 
-#if EXTENSION_360_VIDEO
-  m_ext360.calculatePSNRs(pcPic);
-#endif
+void EncGOP::xReportPendingPictures(bool flush)
+{
+  // bounds the number of retained picture copies when the measurement falls behind
+  static constexpr size_t MAX_PENDING_METRICS = 4;
 
-#if JVET_O0756_CALCULATE_HDRMETRICS
-  const bool calculateHdrMetrics = m_pcEncLib->getCalculateHdrMetrics();
-  if (calculateHdrMetrics)
+  while (!m_pendingMetrics.empty())
   {
-    auto beforeTime = std::chrono::steady_clock::now();
-    xCalculateHDRMetrics(pcPic, deltaE, psnrL);
-    auto elapsed = std::chrono::steady_clock::now() - beforeTime;
-    m_metricTime += elapsed;
+    PicMetricsJob &job = *m_pendingMetrics.front();
+    if (!flush && m_pendingMetrics.size() <= MAX_PENDING_METRICS
+        && job.measured.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      break;
+    }
+    job.measured.get();
+    xReportPicture(job);
+    m_pendingMetrics.pop_front();
   }
+}
+
+void EncGOP::xReportPicture(const PicMetricsJob &job)
+{
+  const PicMetrics& metrics = job.metrics;
+#if WCG_WPSNR
+  const bool    useLumaWPSNR = m_pcEncLib->getPrintWPSNR();
 #endif
+  const double *dPSNR = metrics.psnr;
 
-  /* calculate the size of the access unit, excluding:
-   *  - any AnnexB contributions (start_code_prefix, zero_byte, etc.,)
-   *  - SEI NAL units
-   */
-  uint32_t numRBSPBytes = 0;
-  for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
+  if (m_pcCfg->getSummaryVerboseness() > 0)
   {
-    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.str().size());
-    if (m_pcCfg->getSummaryVerboseness() > 0)
+    for (const auto &nalUnitSize: job.nalUnitSizes)
     {
-      msg( NOTICE, "*** %6s numBytesInNALunit: %u\n", nalUnitTypeToString((*it)->m_nalUnitType), numRBSPBytes_nal);
-    }
-    if( ( *it )->m_nalUnitType != NAL_UNIT_PREFIX_SEI && ( *it )->m_nalUnitType != NAL_UNIT_SUFFIX_SEI )
-    {
-      numRBSPBytes += numRBSPBytes_nal;
-      if (it == accessUnit.begin() || (*it)->m_nalUnitType == NAL_UNIT_OPI || (*it)->m_nalUnitType == NAL_UNIT_VPS || (*it)->m_nalUnitType == NAL_UNIT_DCI || (*it)->m_nalUnitType == NAL_UNIT_SPS || (*it)->m_nalUnitType == NAL_UNIT_PPS || (*it)->m_nalUnitType == NAL_UNIT_PREFIX_APS || (*it)->m_nalUnitType == NAL_UNIT_SUFFIX_APS)
-      {
-        numRBSPBytes += 4;
-      }
-      else
-      {
-        numRBSPBytes += 3;
-      }
+      msg( NOTICE, "*** %6s numBytesInNALunit: %u\n", nalUnitTypeToString(nalUnitSize.first), nalUnitSize.second);
     }
   }
 
-  uint32_t uibits = numRBSPBytes * 8;
-  m_rvm.push_back(uibits);
-
   //===== add PSNR =====
-  m_gcAnalyzeAll.addResult(dPSNR, (double) uibits, mseYuvFrame, upscaledPSNR, msssim, upscaledMsssim, isEncodeLtRef);
+  m_gcAnalyzeAll.addResult(dPSNR, (double) job.bits, metrics.mse, metrics.upscaledPsnr, metrics.msssim, metrics.upscaledMsssim, job.isEncodeLtRef);
 #if EXTENSION_360_VIDEO
   m_ext360.addResult(m_gcAnalyzeAll);
 #endif
 #if JVET_O0756_CALCULATE_HDRMETRICS
-  if (calculateHdrMetrics)
+  if (job.calculateHdrMetrics)
   {
-    m_gcAnalyzeAll.addHDRMetricsResult(deltaE, psnrL);
+    m_gcAnalyzeAll.addHDRMetricsResult(job.deltaE, job.psnrL);
   }
 #endif
-  if (pcSlice->isIntra())
+  if (job.sliceType == I_SLICE)
   {
-    m_gcAnalyzeI.addResult(dPSNR, (double) uibits, mseYuvFrame, upscaledPSNR, msssim, upscaledMsssim, isEncodeLtRef);
-    *PSNR_Y = dPSNR[COMPONENT_Y];
+    m_gcAnalyzeI.addResult(dPSNR, (double) job.bits, metrics.mse, metrics.upscaledPsnr, metrics.msssim, metrics.upscaledMsssim, job.isEncodeLtRef);
 #if EXTENSION_360_VIDEO
     m_ext360.addResult(m_gcAnalyzeI);
 #endif
 #if JVET_O0756_CALCULATE_HDRMETRICS
-    if (calculateHdrMetrics)
+    if (job.calculateHdrMetrics)
     {
-      m_gcAnalyzeI.addHDRMetricsResult(deltaE, psnrL);
+      m_gcAnalyzeI.addHDRMetricsResult(job.deltaE, job.psnrL);
     }
 #endif
   }
-  if (pcSlice->isInterP())
+  if (job.sliceType == P_SLICE)
   {
-    m_gcAnalyzeP.addResult(dPSNR, (double) uibits, mseYuvFrame, upscaledPSNR, msssim, upscaledMsssim, isEncodeLtRef);
-    *PSNR_Y = dPSNR[COMPONENT_Y];
+    m_gcAnalyzeP.addResult(dPSNR, (double) job.bits, metrics.mse, metrics.upscaledPsnr, metrics.msssim, metrics.upscaledMsssim, job.isEncodeLtRef);
 #if EXTENSION_360_VIDEO
     m_ext360.addResult(m_gcAnalyzeP);
 #endif
 #if JVET_O0756_CALCULATE_HDRMETRICS
-    if (calculateHdrMetrics)
+    if (job.calculateHdrMetrics)
     {
-      m_gcAnalyzeP.addHDRMetricsResult(deltaE, psnrL);
+      m_gcAnalyzeP.addHDRMetricsResult(job.deltaE, job.psnrL);
     }
 #endif
   }
-  if (pcSlice->isInterB())
+  if (job.sliceType == B_SLICE)
   {
-    m_gcAnalyzeB.addResult(dPSNR, (double) uibits, mseYuvFrame, upscaledPSNR, msssim, upscaledMsssim, isEncodeLtRef);
-    *PSNR_Y = dPSNR[COMPONENT_Y];
+    m_gcAnalyzeB.addResult(dPSNR, (double) job.bits, metrics.mse, metrics.upscaledPsnr, metrics.msssim, metrics.upscaledMsssim, job.isEncodeLtRef);
 #if EXTENSION_360_VIDEO
     m_ext360.addResult(m_gcAnalyzeB);
 #endif
 #if JVET_O0756_CALCULATE_HDRMETRICS
-    if (calculateHdrMetrics)
+    if (job.calculateHdrMetrics)
     {
-      m_gcAnalyzeB.addHDRMetricsResult(deltaE, psnrL);
+      m_gcAnalyzeB.addHDRMetricsResult(job.deltaE, job.psnrL);
     }
 #endif
   }
 #if WCG_WPSNR
   if (useLumaWPSNR)
   {
-    m_gcAnalyzeWPSNR.addResult( dPSNRWeighted, (double)uibits, MSEyuvframeWeighted, upscaledPSNR, msssim, upscaledMsssim, isEncodeLtRef );
+    m_gcAnalyzeWPSNR.addResult( metrics.psnrWeighted, (double)job.bits, metrics.mseWeighted, metrics.upscaledPsnr, metrics.msssim, metrics.upscaledMsssim, job.isEncodeLtRef );
   }
 #endif
 
-  char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (! pcPic->referenced)
-  {
-    c += 32;
-  }
-  if (m_pcCfg->getDependentRAPIndicationSEIEnabled() && pcSlice->isDRAP())
-  {
-    c = 'D';
-  }
-  if (m_pcCfg->getEdrapIndicationSEIEnabled() && pcSlice->getEdrapRapId() > 0)
-  {
-    c = 'E';
-  }
-
   if( g_verbosity >= NOTICE )
   {
     msg( NOTICE, "POC %4d LId: %2d TId: %1d ( %s, %c-SLICE, QP %d ) %10d bits",
-         pcSlice->getPOC(),
-         pcSlice->getPic()->layerId,
-         pcSlice->getTLayer(),
-         nalUnitTypeToString(pcSlice->getNalUnitType()),
-         c,
-         pcSlice->getSliceQp(),
-         uibits );
+         job.poc,
+         job.layerId,
+         job.tLayer,
+         nalUnitTypeToString(job.nalUnitType),
+         job.sliceTypeChar,
+         job.sliceQp,
+         job.bits );
 
     msg( NOTICE, " [Y %6.4lf dB    U %6.4lf dB    V %6.4lf dB]", dPSNR[COMPONENT_Y], dPSNR[COMPONENT_Cb], dPSNR[COMPONENT_Cr] );
 
@@ -5654,7 +5747,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
       uint64_t xPsnr[MAX_NUM_COMPONENT];
       for (int i = 0; i < MAX_NUM_COMPONENT; i++)
       {
-        std::copy(reinterpret_cast<uint8_t *>(&dPSNR[i]), reinterpret_cast<uint8_t *>(&dPSNR[i]) + sizeof(dPSNR[i]),
+        std::copy(reinterpret_cast<const uint8_t *>(&dPSNR[i]), reinterpret_cast<const uint8_t *>(&dPSNR[i]) + sizeof(dPSNR[i]),
                   reinterpret_cast<uint8_t *>(&xPsnr[i]));
       }
       msg(NOTICE, " [xY %16" PRIx64 " xU %16" PRIx64 " xV %16" PRIx64 "]", xPsnr[COMPONENT_Y], xPsnr[COMPONENT_Cb], xPsnr[COMPONENT_Cr]);
@@ -5663,19 +5756,20 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
       m_ext360.printPerPOCInfo(NOTICE, true);
 #endif
     }
-    if (printMSSSIM)
+    if (job.printMSSSIM)
     {
-      msg( NOTICE, " [MS-SSIM Y %1.6lf    U %1.6lf    V %1.6lf]", msssim[COMPONENT_Y], msssim[COMPONENT_Cb], msssim[COMPONENT_Cr] );
+      msg( NOTICE, " [MS-SSIM Y %1.6lf    U %1.6lf    V %1.6lf]", metrics.msssim[COMPONENT_Y], metrics.msssim[COMPONENT_Cb], metrics.msssim[COMPONENT_Cr] );
     }
 
-    if( printFrameMSE )
+    if (job.printFrameMSE)
     {
-      msg(NOTICE, " [Y MSE %6.4lf  U MSE %6.4lf  V MSE %6.4lf]", mseYuvFrame[COMPONENT_Y], mseYuvFrame[COMPONENT_Cb],
-          mseYuvFrame[COMPONENT_Cr]);
+      msg(NOTICE, " [Y MSE %6.4lf  U MSE %6.4lf  V MSE %6.4lf]", metrics.mse[COMPONENT_Y], metrics.mse[COMPONENT_Cb],
+          metrics.mse[COMPONENT_Cr]);
     }
 #if WCG_WPSNR
     if (useLumaWPSNR)
     {
+      const double *dPSNRWeighted = metrics.psnrWeighted;
       msg(NOTICE, " [WY %6.4lf dB    WU %6.4lf dB    WV %6.4lf dB]", dPSNRWeighted[COMPONENT_Y], dPSNRWeighted[COMPONENT_Cb], dPSNRWeighted[COMPONENT_Cr]);
 
       if (m_pcEncLib->getPrintHexPsnr())
@@ -5683,8 +5777,8 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
         uint64_t xPsnrWeighted[MAX_NUM_COMPONENT];
         for (int i = 0; i < MAX_NUM_COMPONENT; i++)
         {
-          std::copy(reinterpret_cast<uint8_t *>(&dPSNRWeighted[i]),
-                    reinterpret_cast<uint8_t *>(&dPSNRWeighted[i]) + sizeof(dPSNRWeighted[i]),
+          std::copy(reinterpret_cast<const uint8_t *>(&dPSNRWeighted[i]),
+                    reinterpret_cast<const uint8_t *>(&dPSNRWeighted[i]) + sizeof(dPSNRWeighted[i]),
                     reinterpret_cast<uint8_t *>(&xPsnrWeighted[i]));
         }
         msg(NOTICE, " [xWY %16" PRIx64 " xWU %16" PRIx64 " xWV %16" PRIx64 "]", xPsnrWeighted[COMPONENT_Y], xPsnrWeighted[COMPONENT_Cb], xPsnrWeighted[COMPONENT_Cr]);
@@ -5692,8 +5786,10 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     }
 #endif
 #if JVET_O0756_CALCULATE_HDRMETRICS
-    if(calculateHdrMetrics)
+    if(job.calculateHdrMetrics)
     {
+      const double *deltaE = job.deltaE;
+      const double *psnrL  = job.psnrL;
       for (int i=0; i<1; i++)
       {
         msg(NOTICE, " [DeltaE%d %6.4lf dB]", (int)m_pcCfg->getWhitePointDeltaE(i), deltaE[i]);
@@ -5702,7 +5798,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
           int64_t xdeltaE[MAX_NUM_COMPONENT];
           for (int i = 0; i < 1; i++)
           {
-            std::copy_n(reinterpret_cast<uint8_t*>(&deltaE[i]), sizeof(deltaE[i]),
+            std::copy_n(reinterpret_cast<const uint8_t*>(&deltaE[i]), sizeof(deltaE[i]),
                         reinterpret_cast<uint8_t*>(&xdeltaE[i]));
           }
           msg(NOTICE, " [xDeltaE%d %16" PRIx64 "]", (int)m_pcCfg->getWhitePointDeltaE(i), xdeltaE[0]);
@@ -5717,7 +5813,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
           int64_t xpsnrL[MAX_NUM_COMPONENT];
           for (int i = 0; i < 1; i++)
           {
-            std::copy_n(reinterpret_cast<uint8_t*>(&psnrL[i]), sizeof(psnrL[i]),
+            std::copy_n(reinterpret_cast<const uint8_t*>(&psnrL[i]), sizeof(psnrL[i]),
                         reinterpret_cast<uint8_t*>(&xpsnrL[i]));
           }
 
@@ -5726,66 +5822,28 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
       }
     }
 #endif
-    msg(NOTICE, m_pcCfg->getPrintHighPrecEncTime() ? " [ET %6.3f ]" : " [ET %5.0f ]", dEncTime);
+    msg(NOTICE, m_pcCfg->getPrintHighPrecEncTime() ? " [ET %6.3f ]" : " [ET %5.0f ]", job.encTime);
 
     // msg( SOME, " [WP %d]", pcSlice->getUseWeightedPrediction());
 
-    for (int refList = 0; refList < 2; refList++)
-    {
-      msg(NOTICE, " [L%d", refList);
-      for (int refIndex = 0; refIndex < pcSlice->getNumRefIdx(RefPicList(refList)); refIndex++)
-      {
-        const ScalingRatio &scaleRatio = pcSlice->getScalingRatio(RefPicList(refList), refIndex);
-
-        if (pcPic->cs->picHeader->getEnableTMVPFlag() && pcSlice->getColFromL0Flag() == bool(1 - refList)
-            && pcSlice->getColRefIdx() == refIndex)
-        {
-          if (scaleRatio != SCALE_1X)
-          {
-            msg(NOTICE, " %dc(%1.2lfx, %1.2lfx)", pcSlice->getRefPOC(RefPicList(refList), refIndex),
-                double(scaleRatio.x) / (1 << ScalingRatio::BITS), double(scaleRatio.y) / (1 << ScalingRatio::BITS));
-          }
-          else
-          {
-            msg(NOTICE, " %dc", pcSlice->getRefPOC(RefPicList(refList), refIndex));
-          }
-        }
-        else
-        {
-          if (scaleRatio != SCALE_1X)
-          {
-            msg(NOTICE, " %d(%1.2lfx, %1.2lfx)", pcSlice->getRefPOC(RefPicList(refList), refIndex),
-                double(scaleRatio.x) / (1 << ScalingRatio::BITS), double(scaleRatio.y) / (1 << ScalingRatio::BITS));
-          }
-          else
-          {
-            msg(NOTICE, " %d", pcSlice->getRefPOC(RefPicList(refList), refIndex));
-          }
-        }
+    msg(NOTICE, "%s", job.refLists.c_str());
 
-        if (pcSlice->getRefPOC(RefPicList(refList), refIndex) == pcSlice->getPOC())
-        {
-          msg(NOTICE, ".%d", pcSlice->getRefPic(RefPicList(refList), refIndex)->layerId);
-        }
-      }
-      msg( NOTICE, "]" );
-    }
-    if (m_pcEncLib->isResChangeInClvsEnabled() || m_pcEncLib->isRefLayerRescaledAvailable())
+    if (job.printUpscaled)
     {
-      msg( NOTICE, " [Y2 %6.4lf dB  U2 %6.4lf dB  V2 %6.4lf dB]", upscaledPSNR[COMPONENT_Y], upscaledPSNR[COMPONENT_Cb], upscaledPSNR[COMPONENT_Cr] );
-      if (printMSSSIM)
+      msg( NOTICE, " [Y2 %6.4lf dB  U2 %6.4lf dB  V2 %6.4lf dB]", metrics.upscaledPsnr[COMPONENT_Y], metrics.upscaledPsnr[COMPONENT_Cb], metrics.upscaledPsnr[COMPONENT_Cr] );
+      if (job.printMSSSIM)
       {
-        msg( NOTICE, " MS-SSIM2: [Y %1.6lf  U %1.6lf  V %1.6lf ]", upscaledMsssim[COMPONENT_Y], upscaledMsssim[COMPONENT_Cb], upscaledMsssim[COMPONENT_Cr] );
+        msg( NOTICE, " MS-SSIM2: [Y %1.6lf  U %1.6lf  V %1.6lf ]", metrics.upscaledMsssim[COMPONENT_Y], metrics.upscaledMsssim[COMPONENT_Cb], metrics.upscaledMsssim[COMPONENT_Cr] );
       }
     }
   }
   else if( g_verbosity >= INFO )
   {
-    std::cout << "\r\t" << pcSlice->getPOC();
+    std::cout << "\r\t" << job.poc;
     std::cout.flush();
   }
 #if GREEN_METADATA_SEI_ENABLED
-  m_SEIGreenQualityMetrics.ssim = msssim[0];
+  m_SEIGreenQualityMetrics.ssim = metrics.msssim[0];
   m_SEIGreenQualityMetrics.wpsnr = dPSNR[0];
 #endif
 }
@@ -6050,32 +6108,21 @@ double EncGOP::xCalculateMSSSIM(const Pel *org, const ptrdiff_t orgStride, const
 
     double meanSSIM= 0.0;
 
+    // window moments of one row of blocks at a time
+    std::vector<double> moments(5 * std::max(blocksPerRow, 0));
+
     for(int blockIndexY=0; blockIndexY<blocksPerColumn; blockIndexY++)
     {
+      g_pelBufOP.ssimMoments(&original[scale][blockIndexY * scaledWidth], &recon[scale][blockIndexY * scaledWidth],
+                             scaledWidth, &weights[0][0], WEIGHTING_SIZE, blocksPerRow, moments.data());
+
       for(int blockIndexX=0; blockIndexX<blocksPerRow; blockIndexX++)
       {
-        double muOrg          =0.0;
-        double muRec          =0.0;
-        double muOrigSqr      =0.0;
-        double muRecSqr       =0.0;
-        double muOrigMultRec  =0.0;
-
-        for(int y=0; y<WEIGHTING_SIZE; y++)
-        {
-          for(int x=0;x<WEIGHTING_SIZE; x++)
-          {
-            const double gaussianWeight=weights[y][x];
-            const int    sampleOffset=(blockIndexY+y)*scaledWidth+(blockIndexX+x);
-            const double orgPel=original[scale][sampleOffset];
-            const double recPel=   recon[scale][sampleOffset];
-
-            muOrg        +=orgPel*       gaussianWeight;
-            muRec        +=recPel*       gaussianWeight;
-            muOrigSqr    +=orgPel*orgPel*gaussianWeight;
-            muRecSqr     +=recPel*recPel*gaussianWeight;
-            muOrigMultRec+=orgPel*recPel*gaussianWeight;
-          }
-        }
+        const double muOrg         = moments[5 * blockIndexX + 0];
+        const double muRec         = moments[5 * blockIndexX + 1];
+        const double muOrigSqr     = moments[5 * blockIndexX + 2];
+        const double muRecSqr      = moments[5 * blockIndexX + 3];
+        const double muOrigMultRec = moments[5 * blockIndexX + 4];
 
         const double sigmaSqrOrig = muOrigSqr    -(muOrg*muOrg);
         const double sigmaSqrRec  = muRecSqr     -(muRec*muRec);
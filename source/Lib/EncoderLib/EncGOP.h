@@ -61,6 +61,9 @@
 #include "Analyze.h"
 #include "RateCtrl.h"
 #include <vector>
+#include <deque>
+#include <future>
+#include <memory>
 #include "EncHRD.h"
 
 #if JVET_AJ0151_DSC_SEI
@@ -197,6 +200,68 @@ private:
   } m_deblockParam[MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS];
   PelStorage*             m_pcRefLayerRescaledPicYuv;
 
+  // per-picture quality metrics, see xCalculateAddPSNR()
+  struct PicMetrics
+  {
+    double psnr[MAX_NUM_COMPONENT]           = { 0.0 };
+    double mse[MAX_NUM_COMPONENT]            = { 0.0 };
+    double msssim[MAX_NUM_COMPONENT]         = { 0.0 };
+#if WCG_WPSNR
+    double psnrWeighted[MAX_NUM_COMPONENT]   = { 0.0 };
+    double mseWeighted[MAX_NUM_COMPONENT]    = { 0.0 };
+#endif
+    double upscaledPsnr[MAX_NUM_COMPONENT]   = { 0.0 };
+    double upscaledMsssim[MAX_NUM_COMPONENT] = { 0.0 };
+  };
+
+  // everything needed to measure and report one picture; with AsyncMetrics the measurement runs on a background
+  // thread from retained copies of the buffers and the report is emitted later, in coding order
+  struct PicMetricsJob
+  {
+    CPelUnitBuf  rec;           // reconstruction (after colour space conversion)
+    CPelUnitBuf  org;
+    CPelUnitBuf  upscaledOrg;   // RPR: original at full resolution
+    CPelUnitBuf  refLayerRec;   // reference layer reconstruction rescaled to the current layer
+    PelStorage   upscaledRec;   // RPR: reconstruction rescaled to full resolution
+    PelStorage   retainedRec;
+    PelStorage   retainedOrg;
+    PelStorage   retainedUpscaledOrg;
+    PelStorage   retainedRefLayerRec;
+    ChromaFormat format;
+    BitDepths    bitDepths;
+    bool         isField;
+    int          padX;
+    int          padY;
+    bool         useUpscaled;
+    bool         useRefLayer;
+    bool         printMSSSIM;
+
+    PicMetrics   metrics;
+
+    int          poc;
+    int          layerId;
+    int          tLayer;
+    NalUnitType  nalUnitType;
+    SliceType    sliceType;
+    char         sliceTypeChar;
+    int          sliceQp;
+    uint32_t     bits;
+    std::vector<std::pair<NalUnitType, uint32_t>> nalUnitSizes;
+    std::string  refLists;
+    double       encTime;
+    bool         printFrameMSE;
+    bool         printUpscaled;
+    bool         isEncodeLtRef;
+#if JVET_O0756_CALCULATE_HDRMETRICS
+    bool         calculateHdrMetrics;
+    double       deltaE[hdrtoolslib::NB_REF_WHITE];
+    double       psnrL[hdrtoolslib::NB_REF_WHITE];
+#endif
+
+    std::future<void> measured;
+  };
+  std::deque<std::unique_ptr<PicMetricsJob>> m_pendingMetrics;
+
   // members needed for adaptive max BT size
   struct BlkStat
   {
@@ -336,6 +401,9 @@ protected:
                                        PelUnitBuf cPicRecFirstField, PelUnitBuf cPicRecSecondField,
                                        const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
                                        const bool printMSSSIM, double *PSNR_Y, bool isEncodeLtRef);
+  void     xMeasurePicture(PicMetricsJob &job);
+  void     xReportPicture(const PicMetricsJob &job);
+  void     xReportPendingPictures(bool flush);
   double   xCalculateMSSSIM(const Pel *org, const ptrdiff_t orgStride, const Pel *rec, const ptrdiff_t recStride,
                             const int width, const int height, const uint32_t bitDepth);
   uint64_t xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift
@@ -1089,6 +1089,7 @@ void EncModeCtrlMTnoRQT::create( const EncCfg& cfg )
   BestEncInfoCache::create( cfg.getChromaFormatIdc(), cfg.getCTUSize());
 #endif
   SaveLoadEncInfoSbt::create(cfg.getCTUSize());
+  m_splitPredictor.create(cfg.getSplitPredictorModel(), cfg.getSplitPredictorThr(), cfg.getSplitPredictorDumpFile());
 }
 
 void EncModeCtrlMTnoRQT::destroy()
@@ -1098,6 +1099,7 @@ void EncModeCtrlMTnoRQT::destroy()
   BestEncInfoCache::destroy();
 #endif
   SaveLoadEncInfoSbt::destroy();
+  m_splitPredictor.destroy();
 }
 
 void EncModeCtrlMTnoRQT::initCTUEncoding( const Slice &slice )
@@ -1464,6 +1466,13 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
 
 void EncModeCtrlMTnoRQT::finishCULevel( Partitioner &partitioner )
 {
+  const ComprCUCtx &cuECtx = m_ComprCUCtxList.back();
+
+  if( !cuECtx.splitSamples.empty() && cuECtx.bestCS )
+  {
+    m_splitPredictor.dumpSamples( cuECtx.splitSamples, m_slice->getPOC(), partitioner.currArea().Y(),
+                                  getPartSplit( getCSEncMode( *cuECtx.bestCS ) ), cuECtx.bestCS->cost );
+  }
   m_ComprCUCtxList.pop_back();
 }
 
@@ -1953,6 +1962,25 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
         if (area.width <= 2 * size && split == CU_TRIV_SPLIT) return false;
       }
     }
+
+    if( ( m_splitPredictor.usePrediction() || m_splitPredictor.useDump() ) && split != CU_QUAD_SPLIT && isLuma( partitioner.chType ) )
+    {
+      SplitFeatures features;
+      xGetSplitFeatures( cs, partitioner, encTestmode.qp, cuECtx, features );
+
+      if( m_splitPredictor.skipSplit( split, features ) )
+      {
+        if( featureToSet >= 0 )
+        {
+          cuECtx.set( featureToSet, false );
+        }
+        return false;
+      }
+      if( m_splitPredictor.useDump() )
+      {
+        cuECtx.splitSamples.push_back( { split, features, MAX_DOUBLE } );
+      }
+    }
     return true;
   }
   else
@@ -2157,6 +2185,99 @@ bool EncModeCtrlMTnoRQT::xSkipTreeCandidate(const PartSplit split, const double*
   return res;
 }
 
+void EncModeCtrlMTnoRQT::xGetSplitFeatures( const CodingStructure &cs, const Partitioner &partitioner, const int qp, ComprCUCtx &cuECtx, SplitFeatures &features )
+{
+  const CompArea &area = partitioner.currArea().Y();
+
+  if( !cuECtx.splitBlkStatsValid )
+  {
+    // variance and mean absolute gradients of the original samples, scaled to 8 bit
+    const CPelBuf org     = cs.getOrgBuf( area );
+    int64_t       sum     = 0;
+    int64_t       sumSq   = 0;
+    int64_t       gradHor = 0;
+    int64_t       gradVer = 0;
+
+    for( int y = 0; y < area.height; y++ )
+    {
+      for( int x = 0; x < area.width; x++ )
+      {
+        const int val = org.at( x, y );
+        sum   += val;
+        sumSq += val * val;
+        if( x + 1 < area.width )
+        {
+          gradHor += abs( org.at( x + 1, y ) - val );
+        }
+        if( y + 1 < area.height )
+        {
+          gradVer += abs( org.at( x, y + 1 ) - val );
+        }
+      }
+    }
+
+    const double scale    = std::ldexp( 1.0, 8 - cs.sps->getBitDepth( ChannelType::LUMA ) );
+    const double numPels  = double( area.area() );
+    const double variance = ( sumSq - sum * double( sum ) / numPels ) / numPels * scale * scale;
+
+    cuECtx.splitBlkStats[0]   = float( std::log2( 1.0 + std::max( 0.0, variance ) ) );
+    cuECtx.splitBlkStats[1]   = float( std::log2( 1.0 + gradHor * scale / ( area.height * ( area.width - 1 ) ) ) );
+    cuECtx.splitBlkStats[2]   = float( std::log2( 1.0 + gradVer * scale / ( area.width * ( area.height - 1 ) ) ) );
+    cuECtx.splitBlkStatsValid = true;
+  }
+
+  const CodingUnit *cuLeft  = cs.getCU( area.pos().offset( -1, 0 ), partitioner.chType );
+  const CodingUnit *cuAbove = cs.getCU( area.pos().offset( 0, -1 ), partitioner.chType );
+
+  features[SPLIT_FT_LOG2_WIDTH]      = float( floorLog2( area.width ) );
+  features[SPLIT_FT_LOG2_HEIGHT]     = float( floorLog2( area.height ) );
+  features[SPLIT_FT_QT_DEPTH]        = float( partitioner.currQtDepth );
+  features[SPLIT_FT_MT_DEPTH]        = float( partitioner.currMtDepth );
+  features[SPLIT_FT_QP]              = float( qp );
+  features[SPLIT_FT_TEMPORAL_LAYER]  = float( m_slice->isIntra() ? 0 : m_slice->getHierPredLayerIdx() + 1 );
+  features[SPLIT_FT_LOG_VARIANCE]    = cuECtx.splitBlkStats[0];
+  features[SPLIT_FT_LOG_GRAD_HOR]    = cuECtx.splitBlkStats[1];
+  features[SPLIT_FT_LOG_GRAD_VER]    = cuECtx.splitBlkStats[2];
+  features[SPLIT_FT_LEFT_DEPTH]      = float( cuLeft  ? int( cuLeft->depth  ) - int( partitioner.currDepth ) : 0 );
+  features[SPLIT_FT_ABOVE_DEPTH]     = float( cuAbove ? int( cuAbove->depth ) - int( partitioner.currDepth ) : 0 );
+
+  const CodingStructure *bestCS = cuECtx.bestCS;
+  const CodingUnit      *bestCU = cuECtx.bestCU;
+
+  if( bestCS && bestCU && bestCS->cost != MAX_DOUBLE )
+  {
+    const double costPerPel = bestCS->cost / ( m_pcRdCost->getLambda() * area.area() );
+
+    features[SPLIT_FT_LOG_BEST_COST]     = float( std::log2( 1.0 + costPerPel ) );
+    features[SPLIT_FT_BEST_IS_SPLIT]     = float( isModeSplit( getCSEncMode( *bestCS ) ) );
+    features[SPLIT_FT_BEST_IS_SKIP]      = float( bestCU->skip );
+    features[SPLIT_FT_BEST_IS_INTRA]     = float( CU::isIntra( *bestCU ) );
+    features[SPLIT_FT_BEST_HAS_RESIDUAL] = float( bestCU->rootCbf );
+  }
+  else
+  {
+    features[SPLIT_FT_LOG_BEST_COST]     = -1.0f;
+    features[SPLIT_FT_BEST_IS_SPLIT]     = 0.0f;
+    features[SPLIT_FT_BEST_IS_SKIP]      = 0.0f;
+    features[SPLIT_FT_BEST_IS_INTRA]     = 0.0f;
+    features[SPLIT_FT_BEST_HAS_RESIDUAL] = 0.0f;
+  }
+
+  const double nonSplitCost = cuECtx.get<double>( BEST_NON_SPLIT_COST );
+  auto         splitGain    = [nonSplitCost]( const double splitCost )
+  {
+    if( splitCost == MAX_DOUBLE || nonSplitCost == MAX_DOUBLE || nonSplitCost <= 0.0 )
+    {
+      return 2.0f;
+    }
+    return float( Clip3( -1.0, 1.0, splitCost / nonSplitCost - 1.0 ) );
+  };
+
+  features[SPLIT_FT_HORZ_SPLIT_GAIN] = splitGain( cuECtx.get<double>( BEST_HORZ_SPLIT_COST ) );
+  features[SPLIT_FT_VERT_SPLIT_GAIN] = splitGain( cuECtx.get<double>( BEST_VERT_SPLIT_COST ) );
+  features[SPLIT_FT_DID_QUAD_SPLIT]  = float( cuECtx.get<bool>( DID_QUAD_SPLIT ) );
+}
+
 bool EncModeCtrlMTnoRQT::checkSkipOtherLfnst( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner )
 {
   xExtractFeatures( encTestmode, *tempCS );
@@ -2182,6 +2303,18 @@ bool EncModeCtrlMTnoRQT::useModeResult( const EncTestMode& encTestmode, CodingSt
 
   ComprCUCtx& cuECtx = m_ComprCUCtxList.back();
 
+  if( !cuECtx.splitSamples.empty() && isModeSplit( encTestmode ) )
+  {
+    for( auto sample = cuECtx.splitSamples.rbegin(); sample != cuECtx.splitSamples.rend(); sample++ )
+    {
+      if( sample->split == getPartSplit( encTestmode ) )
+      {
+        sample->cost = tempCS->cost;
+        break;
+      }
+    }
+  }
+
   if(      encTestmode.type == ETM_SPLIT_BT_H )
   {
     cuECtx.set( BEST_HORZ_SPLIT_COST, tempCS->cost );
@@ -44,6 +44,7 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/CodingStructure.h"
 #include "InterSearch.h"
+#include "EncSplitPredictor.h"
 
 #include <typeinfo>
 #include <vector>
@@ -263,6 +264,11 @@ struct ComprCUCtx
   ISPType ispMode{ ISPType::NONE };
   uint8_t ispLfnstIdx{ 0 };
 
+  // split predictor: original sample statistics (computed on first use) and candidates recorded for the dump file
+  bool                     splitBlkStatsValid{ false };
+  float                    splitBlkStats[3];
+  std::vector<SplitSample> splitSamples;
+
   template<typename T> T    get( int ft )       const { return typeid(T) == typeid(double) ? (T&)extraFeaturesd[ft] : T(extraFeatures[ft]); }
   template<typename T> void set( int ft, T val )      { extraFeatures [ft] = int64_t( val ); }
   void                      set( int ft, double val ) { extraFeaturesd[ft] = val; }
@@ -859,6 +865,7 @@ class EncModeCtrlMTnoRQT : public EncModeCtrl, public CacheBlkInfoCtrl
 #if GDR_ENABLED
   EncCfg m_encCfg;
 #endif
+  EncSplitPredictor m_splitPredictor;
 
 public:
 
@@ -874,6 +881,9 @@ public:
   virtual bool checkSkipOtherLfnst( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner );
 
   bool xSkipTreeCandidate(const PartSplit split, const double* splitRdCostBest, const SliceType& sliceType) const;
+
+protected:
+  void xGetSplitFeatures( const CodingStructure &cs, const Partitioner &partitioner, const int qp, ComprCUCtx &cuECtx, SplitFeatures &features );
 };
 
 //! \}
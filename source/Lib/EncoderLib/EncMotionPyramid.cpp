@@ -0,0 +1,261 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncMotionPyramid.cpp
+    \brief    hierarchical motion estimation pre-pass
+*/
+
+#include "EncMotionPyramid.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+EncMotionPyramid::EncMotionPyramid() : m_pcRdCost(nullptr)
+{
+}
+
+void EncMotionPyramid::init(RdCost *rdCost)
+{
+  m_pcRdCost = rdCost;
+  destroy();
+}
+
+void EncMotionPyramid::destroy()
+{
+  m_candidates.clear();
+  m_levels.clear();
+}
+
+Mv EncMotionPyramid::getCandidate(const Picture &curPic, const Picture &refPic, const Position &pos, int searchRange,
+                                  int bitDepth)
+{
+  const PictureLevels &cur = xGetLevels(curPic, true);
+  const PictureLevels &ref = xGetLevels(refPic, false);
+  CandidateSet        &set = xGetCandidateSet(cur, ref, searchRange);
+
+  const int blkX = std::min<int>(pos.x / BLOCK_SIZE, set.widthInBlocks - 1);
+  const int blkY = std::min<int>(pos.y / BLOCK_SIZE, int(set.mvs.size()) / set.widthInBlocks - 1);
+  const int idx  = blkY * set.widthInBlocks + blkX;
+
+  if (!set.valid[idx])
+  {
+    set.mvs[idx]   = xSearchBlock(cur, ref, blkX, blkY, searchRange, bitDepth);
+    set.valid[idx] = true;
+  }
+  return set.mvs[idx];
+}
+
+const EncMotionPyramid::PictureLevels &EncMotionPyramid::xGetLevels(const Picture &pic, bool useOrig)
+{
+  for (auto it = m_levels.begin(); it != m_levels.end(); ++it)
+  {
+    if (it->pic == &pic && it->poc == pic.getPOC() && it->layerId == pic.layerId && it->useOrig == useOrig)
+    {
+      m_levels.splice(m_levels.begin(), m_levels, it);
+      return m_levels.front();
+    }
+  }
+
+  if (m_levels.size() >= MAX_CACHED_LEVELS)
+  {
+    const PictureLevels *evicted = &m_levels.back();
+    m_candidates.remove_if([evicted](const CandidateSet &set) { return set.cur == evicted || set.ref == evicted; });
+    m_levels.pop_back();
+  }
+
+  m_levels.emplace_front();
+  PictureLevels &levels = m_levels.front();
+  levels.pic            = &pic;
+  levels.poc            = pic.getPOC();
+  levels.layerId        = pic.layerId;
+  levels.useOrig        = useOrig;
+
+  CPelBuf src = useOrig ? pic.getOrigBuf().Y() : pic.getRecoBuf(COMPONENT_Y);
+
+  for (int level = 0; level < NUM_LEVELS; level++)
+  {
+    const int width  = src.width >> 1;
+    const int height = src.height >> 1;
+
+    const int margin = PictureLevels::margin(level);
+
+    levels.width[level]  = width;
+    levels.height[level] = height;
+    levels.plane[level].resize((width + 2 * margin) * (height + 2 * margin));
+
+    PelBuf dst = levels.getBuf(level);
+    for (int y = 0; y < height; y++)
+    {
+      const Pel *src0 = src.bufAt(0, 2 * y);
+      const Pel *src1 = src0 + src.stride;
+      Pel       *dstY = dst.bufAt(0, y);
+      for (int x = 0; x < width; x++)
+      {
+        dstY[x] = (src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2) >> 2;
+      }
+    }
+    dst.extendBorderPel(margin);
+
+    src = dst;
+  }
+
+  return levels;
+}
+
+EncMotionPyramid::CandidateSet &EncMotionPyramid::xGetCandidateSet(const PictureLevels &cur, const PictureLevels &ref,
+                                                                    int searchRange)
+{
+  for (auto it = m_candidates.begin(); it != m_candidates.end(); ++it)
+  {
+    if (it->cur == &cur && it->ref == &ref && it->searchRange == searchRange)
+    {
+      m_candidates.splice(m_candidates.begin(), m_candidates, it);
+      return m_candidates.front();
+    }
+  }
+
+  if (m_candidates.size() >= MAX_CACHED_CANDIDATES)
+  {
+    m_candidates.pop_back();
+  }
+
+  const int lumaWidth  = cur.pic->Y().width;
+  const int lumaHeight = cur.pic->Y().height;
+  const int numBlocks  = ((lumaWidth + BLOCK_SIZE - 1) / BLOCK_SIZE) * ((lumaHeight + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  m_candidates.emplace_front();
+  CandidateSet &set = m_candidates.front();
+  set.cur           = &cur;
+  set.ref           = &ref;
+  set.searchRange   = searchRange;
+  set.widthInBlocks = (lumaWidth + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  set.mvs.resize(numBlocks);
+  set.valid.resize(numBlocks, false);
+
+  return set;
+}
+
+void EncMotionPyramid::xTestRow(const DistParam &distParam, const CPelBuf &ref, const Position &pos, int dy, int dxMin,
+                                int dxMax, int dxStep, Distortion &bestSad, Mv &bestMv) const
+{
+  const Pel *cur[8];
+  Distortion sads[8];
+
+  for (int dx = dxMin; dx <= dxMax; dx += 8 * dxStep)
+  {
+    const int num = std::min(8, (dxMax - dx) / dxStep + 1);
+    for (int i = 0; i < num; i++)
+    {
+      cur[i] = ref.bufAt(pos.x + dx + i * dxStep, pos.y + dy);
+    }
+
+    m_pcRdCost->getSADs(distParam, cur, num, sads);
+
+    for (int i = 0; i < num; i++)
+    {
+      if (sads[i] < bestSad)
+      {
+        bestSad = sads[i];
+        bestMv.set(dx + i * dxStep, dy);
+      }
+    }
+  }
+}
+
+Mv EncMotionPyramid::xSearchBlock(const PictureLevels &cur, const PictureLevels &ref, int blkX, int blkY,
+                                  int searchRange, int bitDepth)
+{
+  Mv bestMv;
+
+  for (int level = NUM_LEVELS - 1; level >= 0; level--)
+  {
+    const int     scale   = 2 << level;
+    const int     blkSize = BLOCK_SIZE / scale;
+    const CPelBuf curBuf  = cur.getBuf(level);
+    const CPelBuf refBuf  = ref.getBuf(level);
+    const Position pos(blkX * blkSize, blkY * blkSize);
+
+    if (pos.x >= curBuf.width || pos.y >= curBuf.height || curBuf.width != refBuf.width
+        || curBuf.height != refBuf.height)
+    {
+      return Mv();
+    }
+
+    const CPelBuf org = curBuf.subBuf(pos.x, pos.y, std::min<int>(blkSize, curBuf.width - pos.x),
+                                      std::min<int>(blkSize, curBuf.height - pos.y));
+
+    DistParam distParam;
+    m_pcRdCost->setDistParam(distParam, org, refBuf.buf, refBuf.stride, bitDepth, COMPONENT_Y);
+
+    // keep the displaced block inside the padded level plane and within the (scaled) search range
+    const int margin = PictureLevels::margin(level);
+    const int range  = (searchRange + scale - 1) / scale;
+    const int dxMin  = std::max(-range, -pos.x - margin);
+    const int dxMax  = std::min(range, int(refBuf.width - org.width) - pos.x + margin);
+    const int dyMin  = std::max(-range, -pos.y - margin);
+    const int dyMax  = std::min(range, int(refBuf.height - org.height) - pos.y + margin);
+
+    Distortion bestSad = std::numeric_limits<Distortion>::max();
+    Mv         center;
+
+    if (level == NUM_LEVELS - 1)
+    {
+      // coarsest level: zero vector, then a two-sample raster over the whole range
+      xTestRow(distParam, refBuf, pos, 0, 0, 0, 1, bestSad, bestMv);
+      for (int dy = dyMin; dy <= dyMax; dy += 2)
+      {
+        xTestRow(distParam, refBuf, pos, dy, dxMin, dxMax, 2, bestSad, bestMv);
+      }
+      center = bestMv;
+    }
+    else
+    {
+      center = Mv(2 * bestMv.hor, 2 * bestMv.ver);
+      xTestRow(distParam, refBuf, pos, Clip3(dyMin, dyMax, center.ver), Clip3(dxMin, dxMax, center.hor),
+               Clip3(dxMin, dxMax, center.hor), 1, bestSad, bestMv);
+      center = bestMv;
+    }
+
+    // refinement around the best match of the level
+    const int refineRange = level == NUM_LEVELS - 1 ? 1 : 2;
+    for (int dy = std::max(dyMin, center.ver - refineRange); dy <= std::min(dyMax, center.ver + refineRange); dy++)
+    {
+      xTestRow(distParam, refBuf, pos, dy, std::max(dxMin, center.hor - refineRange),
+               std::min(dxMax, center.hor + refineRange), 1, bestSad, bestMv);
+    }
+  }
+
+  return Mv(2 * bestMv.hor, 2 * bestMv.ver);
+}
+
+//! \}
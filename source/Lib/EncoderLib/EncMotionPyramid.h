@@ -0,0 +1,125 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncMotionPyramid.h
+    \brief    hierarchical motion estimation pre-pass (header)
+*/
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Mv.h"
+#include "CommonLib/Picture.h"
+#include "CommonLib/RdCost.h"
+
+#include <list>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Coarse-to-fine block matching on 2x2-averaged luma planes of 1/4 and 1/16 the picture area. The resulting
+/// per-64x64 motion vectors are used as additional start candidates of the integer motion search, so that large
+/// motion is found without scanning the whole search range at full resolution.
+class EncMotionPyramid
+{
+public:
+  static constexpr int NUM_LEVELS = 2;    ///< number of downsampled levels (1/4 and 1/16 of the picture area)
+  static constexpr int BLOCK_SIZE = 64;   ///< full resolution size of the blocks a candidate is derived for
+
+  EncMotionPyramid();
+  ~EncMotionPyramid() {}
+
+  void init(RdCost *rdCost);
+  void destroy();
+
+  /// Full-pel candidate for the 64x64 block of curPic containing pos, searched within +-searchRange in refPic.
+  /// Levels and candidates are computed on first use and cached per (picture, POC).
+  Mv   getCandidate(const Picture &curPic, const Picture &refPic, const Position &pos, int searchRange, int bitDepth);
+
+private:
+  struct PictureLevels
+  {
+    const Picture   *pic;
+    int              poc;
+    int              layerId;
+    bool             useOrig;   ///< original (current picture) or reconstructed (reference picture) samples
+    int              width[NUM_LEVELS];
+    int              height[NUM_LEVELS];
+    std::vector<Pel> plane[NUM_LEVELS];
+
+    // the planes are padded by one block of the level on each side
+    static int margin(int level) { return BLOCK_SIZE >> (level + 1); }
+
+    PelBuf getBuf(int level)
+    {
+      const int stride = width[level] + 2 * margin(level);
+      return PelBuf(plane[level].data() + margin(level) * stride + margin(level), stride, width[level], height[level]);
+    }
+    CPelBuf getBuf(int level) const
+    {
+      const int stride = width[level] + 2 * margin(level);
+      return CPelBuf(plane[level].data() + margin(level) * stride + margin(level), stride, width[level], height[level]);
+    }
+  };
+
+  struct CandidateSet
+  {
+    const PictureLevels *cur;
+    const PictureLevels *ref;
+    int                  searchRange;
+    int                  widthInBlocks;
+    std::vector<Mv>      mvs;
+    std::vector<bool>    valid;
+  };
+
+  const PictureLevels &xGetLevels(const Picture &pic, bool useOrig);
+  CandidateSet        &xGetCandidateSet(const PictureLevels &cur, const PictureLevels &ref, int searchRange);
+  Mv                   xSearchBlock(const PictureLevels &cur, const PictureLevels &ref, int blkX, int blkY,
+                                    int searchRange, int bitDepth);
+  void                 xTestRow(const DistParam &distParam, const CPelBuf &ref, const Position &pos, int dy, int dxMin,
+                                int dxMax, int dxStep, Distortion &bestSad, Mv &bestMv) const;
+
+  static constexpr size_t MAX_CACHED_LEVELS     = 12;
+  static constexpr size_t MAX_CACHED_CANDIDATES = 16;
+
+  RdCost                  *m_pcRdCost;
+  std::list<PictureLevels> m_levels;        ///< most recently used first
+  std::list<CandidateSet>  m_candidates;    ///< most recently used first
+};
+
+//! \}
@@ -41,6 +41,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -192,6 +193,7 @@ void EncSampleAdaptiveOffset::SAOProcess(CodingStructure &cs, bool *sliceEnabled
                                          const double saoEncodingRateChroma, const bool isPreDBFSamplesUsed,
                                          bool isGreedyMergeEncoding, bool usingTrueOrg)
 {
+  PROFILE_STAGE(ProfStage::LOOP_FILTER_SAO);
   PelUnitBuf org = usingTrueOrg ? cs.getTrueOrgBuf() : cs.getOrgBuf();
   PelUnitBuf res = cs.getRecoBuf();
   PelUnitBuf src = m_tempBuf;
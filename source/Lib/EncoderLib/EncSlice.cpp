@@ -55,7 +55,8 @@
 // ====================================================================================================================
 
 EncSlice::EncSlice()
- : m_encCABACTableIdx(I_SLICE)
+ : m_pcCfg(nullptr)
+ , m_encCABACTableIdx(I_SLICE)
 #if ENABLE_QPA
  , m_adaptedLumaQP(-1)
 #endif
@@ -79,7 +80,8 @@ void EncSlice::destroy()
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
 
-  if (m_pcCfg->getDPF())
+  // not initialised if the encoder was not created, e.g. after a configuration error
+  if (m_pcCfg != nullptr && m_pcCfg->getDPF())
   {
     m_lambdaWeight.clear();
     if (m_pixelRecDis)
@@ -0,0 +1,341 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncSplitPredictor.cpp
+    \brief    learned early termination of binary and ternary CU splits
+*/
+
+#include "EncSplitPredictor.h"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+//! \ingroup EncoderLib
+//! \{
+
+static const char *splitFeatureNames[NUM_SPLIT_FEATURES] = {
+  "log2_width",     "log2_height",     "qt_depth",       "mt_depth",         "qp",
+  "temporal_layer", "log_variance",    "log_grad_hor",   "log_grad_ver",     "left_depth",
+  "above_depth",    "log_best_cost",   "best_is_split",  "best_is_skip",     "best_is_intra",
+  "best_has_resid", "horz_split_gain", "vert_split_gain", "did_quad_split",
+};
+
+// ====================================================================================================================
+// Gradient boosted decision trees
+// ====================================================================================================================
+
+/// Sum of the leaf values of an ensemble of binary decision trees. Every node is given as
+///   feature threshold left right value
+/// where feature -1 marks a leaf holding value, and inner nodes continue with the left node if the feature is below
+/// the threshold and with the right node otherwise.
+class SplitTreeModel : public SplitModel
+{
+public:
+  void read(std::istream &in)
+  {
+    int numTrees = 0;
+    in >> numTrees >> m_bias;
+    CHECK(in.fail() || numTrees < 1, "Split predictor: invalid tree ensemble header");
+
+    m_trees.resize(numTrees);
+    for (auto &tree: m_trees)
+    {
+      int numNodes = 0;
+      in >> numNodes;
+      CHECK(in.fail() || numNodes < 1, "Split predictor: invalid tree size");
+
+      tree.resize(numNodes);
+      for (auto &node: tree)
+      {
+        in >> node.feature >> node.threshold >> node.left >> node.right >> node.value;
+        CHECK(in.fail(), "Split predictor: invalid tree node");
+        CHECK(node.feature < -1 || node.feature >= NUM_SPLIT_FEATURES, "Split predictor: invalid tree node feature");
+      }
+      for (int i = 0; i < numNodes; i++)
+      {
+        // children must follow their parent, which rules out cycles
+        CHECK(tree[i].feature >= 0 && (tree[i].left <= i || tree[i].left >= numNodes || tree[i].right <= i
+                                       || tree[i].right >= numNodes),
+              "Split predictor: invalid tree node link");
+      }
+    }
+  }
+
+  int logit(const SplitFeatures &features) const
+  {
+    int sum = m_bias;
+    for (const auto &tree: m_trees)
+    {
+      const Node *node = &tree[0];
+      while (node->feature >= 0)
+      {
+        node = &tree[features[node->feature] < node->threshold ? node->left : node->right];
+      }
+      sum += node->value;
+    }
+    return sum;
+  }
+
+private:
+  struct Node
+  {
+    int   feature;
+    float threshold;
+    int   left;
+    int   right;
+    int   value;
+  };
+
+  std::vector<std::vector<Node>> m_trees;
+  int                            m_bias = 0;
+};
+
+// ====================================================================================================================
+// Fixed-point multi-layer perceptron
+// ====================================================================================================================
+
+/// One hidden layer with ReLU activation. The features are normalised with the given mean and inverse standard
+/// deviation and clipped to +-8 deviations; inputs, weights, biases and activations are integers with
+/// SPLIT_LOGIT_SHIFT fractional bits, so the prediction does not depend on the floating-point environment beyond
+/// the normalisation.
+///   numHidden
+///   mean[NUM_SPLIT_FEATURES]
+///   invStd[NUM_SPLIT_FEATURES]
+///   numHidden x (weights[NUM_SPLIT_FEATURES] bias)
+///   weights[numHidden] bias
+class SplitMlpModel : public SplitModel
+{
+public:
+  static constexpr int MAX_HIDDEN = 256;
+
+  void read(std::istream &in)
+  {
+    int numHidden = 0;
+    in >> numHidden;
+    CHECK(in.fail() || numHidden < 1 || numHidden > MAX_HIDDEN, "Split predictor: invalid MLP size");
+
+    for (auto &m: m_mean)
+    {
+      in >> m;
+    }
+    for (auto &s: m_invStd)
+    {
+      in >> s;
+    }
+    m_hiddenWeights.resize(numHidden * NUM_SPLIT_FEATURES);
+    m_hiddenBias.resize(numHidden);
+    m_outWeights.resize(numHidden);
+    for (int j = 0; j < numHidden; j++)
+    {
+      for (int i = 0; i < NUM_SPLIT_FEATURES; i++)
+      {
+        in >> m_hiddenWeights[j * NUM_SPLIT_FEATURES + i];
+      }
+      in >> m_hiddenBias[j];
+    }
+    for (auto &w: m_outWeights)
+    {
+      in >> w;
+    }
+    in >> m_outBias;
+    CHECK(in.fail(), "Split predictor: invalid MLP parameters");
+  }
+
+  int logit(const SplitFeatures &features) const
+  {
+    const int maxInput = 8 << SPLIT_LOGIT_SHIFT;
+
+    int input[NUM_SPLIT_FEATURES];
+    for (int i = 0; i < NUM_SPLIT_FEATURES; i++)
+    {
+      const float norm = (features[i] - m_mean[i]) * m_invStd[i] * (1 << SPLIT_LOGIT_SHIFT);
+      input[i]         = Clip3(-maxInput, maxInput, int(std::lround(norm)));
+    }
+
+    const int numHidden = (int) m_hiddenBias.size();
+    int64_t   out       = 0;
+    for (int j = 0; j < numHidden; j++)
+    {
+      const int *w   = &m_hiddenWeights[j * NUM_SPLIT_FEATURES];
+      int64_t    acc = 0;
+      for (int i = 0; i < NUM_SPLIT_FEATURES; i++)
+      {
+        acc += int64_t(w[i]) * input[i];
+      }
+      const int64_t act = std::max<int64_t>(0, (acc >> SPLIT_LOGIT_SHIFT) + m_hiddenBias[j]);
+      out += act * m_outWeights[j];
+    }
+    const int64_t sum = (out >> SPLIT_LOGIT_SHIFT) + m_outBias;
+    return int(Clip3<int64_t>(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), sum));
+  }
+
+private:
+  float            m_mean[NUM_SPLIT_FEATURES];
+  float            m_invStd[NUM_SPLIT_FEATURES];
+  std::vector<int> m_hiddenWeights;
+  std::vector<int> m_hiddenBias;
+  std::vector<int> m_outWeights;
+  int              m_outBias = 0;
+};
+
+// ====================================================================================================================
+// Split predictor
+// ====================================================================================================================
+
+const char *EncSplitPredictor::getSplitName(const PartSplit split)
+{
+  switch (split)
+  {
+  case CU_QUAD_SPLIT: return "QT";
+  case CU_HORZ_SPLIT: return "BT_H";
+  case CU_VERT_SPLIT: return "BT_V";
+  case CU_TRIH_SPLIT: return "TT_H";
+  case CU_TRIV_SPLIT: return "TT_V";
+  default:            return "NONE";
+  }
+}
+
+void EncSplitPredictor::create(const std::string &modelFile, double threshold, const std::string &dumpFile)
+{
+  if (!modelFile.empty())
+  {
+    std::ifstream file(modelFile);
+    CHECK(!file.is_open(), "Split predictor: cannot open model file " << modelFile);
+    CHECK(threshold < 0.0 || threshold >= 1.0, "Split predictor: threshold must be in the range [0, 1)");
+
+    // skip a split if logit(p) < logit(threshold), computed once in the fixed-point domain of the models
+    m_thresholdLogit = threshold > 0.0
+                         ? int(std::lround(std::log(threshold / (1.0 - threshold)) * (1 << SplitModel::SPLIT_LOGIT_SHIFT)))
+                         : std::numeric_limits<int>::min();
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+      std::istringstream tokens(line);
+      std::string        keyword;
+      if (!(tokens >> keyword) || keyword[0] == '#')
+      {
+        continue;
+      }
+      if (keyword == "features")
+      {
+        int numFeatures = 0;
+        tokens >> numFeatures;
+        CHECK(numFeatures != NUM_SPLIT_FEATURES, "Split predictor: model uses " << numFeatures << " features, expected "
+                                                                                 << NUM_SPLIT_FEATURES);
+        continue;
+      }
+      CHECK(keyword != "model", "Split predictor: unexpected '" << keyword << "' in " << modelFile);
+
+      std::string splitName, type;
+      tokens >> splitName >> type;
+      int idx = -1;
+      for (int i = 0; i < NUM_SPLIT_MODELS; i++)
+      {
+        if (splitName == getSplitName(PartSplit(CU_HORZ_SPLIT + i)))
+        {
+          idx = i;
+        }
+      }
+      CHECK(idx < 0, "Split predictor: unknown split type '" << splitName << "'");
+
+      if (type == "trees")
+      {
+        m_models[idx].reset(new SplitTreeModel);
+      }
+      else if (type == "mlp")
+      {
+        m_models[idx].reset(new SplitMlpModel);
+      }
+      else
+      {
+        THROW("Split predictor: unknown model type '" << type << "'");
+      }
+      m_models[idx]->read(file);
+      m_hasModel = true;
+    }
+  }
+
+  if (!dumpFile.empty())
+  {
+    m_dump.open(dumpFile);
+    CHECK(!m_dump.is_open(), "Split predictor: cannot open dump file " << dumpFile);
+    m_dump.precision(9);
+    m_dump << "poc,x,y,width,height,split";
+    for (int i = 0; i < NUM_SPLIT_FEATURES; i++)
+    {
+      m_dump << ',' << splitFeatureNames[i];
+    }
+    m_dump << ",cost,best_cost,chosen\n";
+  }
+}
+
+void EncSplitPredictor::destroy()
+{
+  for (auto &model: m_models)
+  {
+    model.reset();
+  }
+  m_hasModel = false;
+  if (m_dump.is_open())
+  {
+    m_dump.close();
+  }
+}
+
+bool EncSplitPredictor::skipSplit(const PartSplit split, const SplitFeatures &features) const
+{
+  CHECKD(split < CU_HORZ_SPLIT || split > CU_TRIV_SPLIT, "Split predictor only handles BT and TT splits");
+
+  const SplitModel *model = m_models[split - CU_HORZ_SPLIT].get();
+  return model && model->logit(features) < m_thresholdLogit;
+}
+
+void EncSplitPredictor::dumpSamples(const std::vector<SplitSample> &samples, int poc, const Area &area,
+                                    const PartSplit bestSplit, double bestCost)
+{
+  for (const auto &sample: samples)
+  {
+    m_dump << poc << ',' << area.x << ',' << area.y << ',' << area.width << ',' << area.height << ','
+           << getSplitName(sample.split);
+    for (const float f: sample.features)
+    {
+      m_dump << ',' << f;
+    }
+    m_dump << ',' << (sample.cost < MAX_DOUBLE ? sample.cost : -1.0) << ',' << bestCost << ','
+           << (sample.split == bestSplit ? 1 : 0) << '\n';
+  }
+}
+
+//! \}
@@ -0,0 +1,150 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncSplitPredictor.h
+    \brief    learned early termination of binary and ternary CU splits (header)
+*/
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/UnitPartitioner.h"
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Features
+// ====================================================================================================================
+
+/// Block features a split decision is predicted from. The order is part of the model and dump file formats, so new
+/// features have to be appended.
+enum SplitFeature
+{
+  SPLIT_FT_LOG2_WIDTH = 0,
+  SPLIT_FT_LOG2_HEIGHT,
+  SPLIT_FT_QT_DEPTH,
+  SPLIT_FT_MT_DEPTH,
+  SPLIT_FT_QP,
+  SPLIT_FT_TEMPORAL_LAYER,     ///< 0 for intra slices, hierarchical prediction layer + 1 otherwise
+  SPLIT_FT_LOG_VARIANCE,       ///< log2(1 + variance) of the original luma samples, 8-bit scale
+  SPLIT_FT_LOG_GRAD_HOR,       ///< log2(1 + mean absolute horizontal difference), 8-bit scale
+  SPLIT_FT_LOG_GRAD_VER,       ///< log2(1 + mean absolute vertical difference), 8-bit scale
+  SPLIT_FT_LEFT_DEPTH,         ///< depth of the left neighbouring CU relative to the current depth, 0 if unavailable
+  SPLIT_FT_ABOVE_DEPTH,        ///< depth of the above neighbouring CU relative to the current depth, 0 if unavailable
+  SPLIT_FT_LOG_BEST_COST,      ///< log2(1 + best cost so far / (lambda * area)), -1 if nothing was coded yet
+  SPLIT_FT_BEST_IS_SPLIT,
+  SPLIT_FT_BEST_IS_SKIP,
+  SPLIT_FT_BEST_IS_INTRA,
+  SPLIT_FT_BEST_HAS_RESIDUAL,
+  SPLIT_FT_HORZ_SPLIT_GAIN,    ///< BT_H cost / best non-split cost - 1, clipped to [-1, 1], 2 if not tested
+  SPLIT_FT_VERT_SPLIT_GAIN,    ///< BT_V cost / best non-split cost - 1, clipped to [-1, 1], 2 if not tested
+  SPLIT_FT_DID_QUAD_SPLIT,
+  NUM_SPLIT_FEATURES
+};
+
+typedef std::array<float, NUM_SPLIT_FEATURES> SplitFeatures;
+
+/// Split candidate recorded for the dump file, completed with its RD cost once it has been tested.
+struct SplitSample
+{
+  PartSplit     split;
+  SplitFeatures features;
+  double        cost;
+};
+
+// ====================================================================================================================
+// Models
+// ====================================================================================================================
+
+/// Interface of a split model. A model predicts the logit of the probability that a split candidate is chosen as
+/// the best mode of its CU, in fixed point with SPLIT_LOGIT_SHIFT fractional bits. New model types implement this
+/// interface and are registered by their keyword in EncSplitPredictor::create().
+class SplitModel
+{
+public:
+  static constexpr int SPLIT_LOGIT_SHIFT = 8;
+
+  virtual ~SplitModel() {}
+
+  /// Reads the model parameters that follow the model line, throws on malformed input.
+  virtual void read(std::istream &in) = 0;
+  virtual int  logit(const SplitFeatures &features) const = 0;
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Skips BT and TT split candidates the model considers unlikely to win, and optionally dumps the features and
+/// outcomes of all tested candidates to train such models offline (see split_predictor_train.py).
+class EncSplitPredictor
+{
+public:
+  static constexpr int NUM_SPLIT_MODELS = CU_TRIV_SPLIT - CU_HORZ_SPLIT + 1;   ///< one model per BT/TT split type
+
+  EncSplitPredictor() : m_hasModel(false), m_thresholdLogit(0) {}
+  ~EncSplitPredictor() {}
+
+  /// Loads the model file (if not empty) and opens the dump file (if not empty). Candidates are skipped when the
+  /// predicted probability of the split being chosen is below threshold.
+  void create(const std::string &modelFile, double threshold, const std::string &dumpFile);
+  void destroy();
+
+  bool usePrediction() const { return m_hasModel; }
+  bool useDump()       const { return m_dump.is_open(); }
+
+  /// true if the model of the split type is loaded and rejects the candidate
+  bool skipSplit(const PartSplit split, const SplitFeatures &features) const;
+
+  /// Writes the tested candidates of a CU. bestSplit (CU_DONT_SPLIT for a non-split mode) and bestCost describe the
+  /// mode finally chosen for the CU.
+  void dumpSamples(const std::vector<SplitSample> &samples, int poc, const Area &area, const PartSplit bestSplit,
+                   double bestCost);
+
+  static const char *getSplitName(const PartSplit split);
+
+private:
+  std::unique_ptr<SplitModel> m_models[NUM_SPLIT_MODELS];
+  bool                        m_hasModel;
+  int                         m_thresholdLogit;
+  std::ofstream               m_dump;
+};
+
+//! \}
@@ -38,6 +38,9 @@
 #include "EncTemporalFilter.h"
 #include "Utilities/VideoIOYuv.h"
 #include <math.h>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
 
 
 // ====================================================================================================================
@@ -135,6 +138,45 @@ void EncTemporalFilter::init(const int frameSkip, const BitDepths &inputBitDepth
   m_ctuAdaptedQP = adaptQPmap;
 }
 
+void EncTemporalFilter::initCache(const std::string &directory)
+{
+  if (!m_cache.open(directory, cacheKey(), m_area, m_chromaFormatIdc, m_numCtu))
+  {
+    msg(WARNING, "Cannot open temporal filter cache in '%s', filtering without cache\n", directory.c_str());
+    return;
+  }
+  msg(NOTICE, "Temporal filter cache: %s\n", m_cache.getFileName().c_str());
+}
+
+uint64_t EncTemporalFilter::cacheKey() const
+{
+  // everything that has an influence on the filtered picture or on the BIM QP map, except the picture index
+  std::ostringstream key;
+  key << m_inputFileName << '|' << m_frameSkip << '|' << sizeof(Pel);
+  // size and modification time detect a different or rewritten file under the same name
+  struct stat fileStat;
+  if (stat(m_inputFileName.c_str(), &fileStat) == 0)
+  {
+    key << '|' << int64_t(fileStat.st_size) << '|' << int64_t(fileStat.st_mtime);
+  }
+  for (const auto chType: { ChannelType::LUMA, ChannelType::CHROMA })
+  {
+    key << '|' << m_inputBitDepth[chType] << '|' << m_msbExtendedBitDepth[chType] << '|' << m_internalBitDepth[chType];
+  }
+  key << '|' << int(m_chromaFormatIdc) << '|' << m_sourceWidth << 'x' << m_sourceHeight << '|' << m_pad[0] << '|'
+      << m_pad[1] << '|' << m_sourceWidthBeforeScale << 'x' << m_sourceHeightBeforeScale << '|'
+      << m_sourceHorCollocatedChromaFlag << '|' << m_sourceVerCollocatedChromaFlag << '|'
+      << m_clipInputVideoToRec709Range << '|' << int(m_inputColourSpaceConvert) << '|' << m_QP << '|' << m_pastRefs
+      << '|' << m_futureRefs << '|' << m_firstValidFrame << '|' << m_lastValidFrame << '|' << m_mctfEnabled << '|'
+      << m_bimEnabled << '|' << m_ctuSize;
+  key.precision(17);
+  for (const auto &strength: m_temporalFilterStrengths)
+  {
+    key << '|' << strength.first << ':' << strength.second;
+  }
+  return TemporalFilterCache::hash(key.str());
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -156,6 +198,23 @@ bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
     }
   }
 
+  if (isFilterThisFrame && m_cache.isOpen())
+  {
+    bool  filtered = false;
+    int  *qpMap    = m_bimEnabled ? new int[m_numCtu] : nullptr;
+    if (m_cache.read(receivedPoc, m_mctfEnabled ? orgPic : nullptr, qpMap, filtered))
+    {
+      if (filtered && qpMap != nullptr)
+      {
+        m_ctuAdaptedQP->insert({ receivedPoc, qpMap });
+        qpMap = nullptr;
+      }
+      delete[] qpMap;
+      return filtered;
+    }
+    delete[] qpMap;
+  }
+
   if (isFilterThisFrame)
   {
     const int  currentFilePoc = receivedPoc + m_frameSkip;
@@ -259,6 +318,10 @@ bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
     if (numRefs == 0)
     {
       yuvFrames.close();
+      if (m_cache.isOpen())
+      {
+        m_cache.write(receivedPoc, nullptr, nullptr, false);
+      }
       return false;
     }
 
@@ -351,12 +414,203 @@ bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
       orgPic->copyFrom(newOrgPic);
     }
 
+    if (m_cache.isOpen())
+    {
+      m_cache.write(receivedPoc, m_mctfEnabled ? orgPic : nullptr, m_bimEnabled ? m_ctuAdaptedQP->at(receivedPoc) : nullptr,
+                    true);
+    }
+
     yuvFrames.close();
     return true;
   }
   return false;
 }
 
+// ====================================================================================================================
+// Temporal filter cache
+// ====================================================================================================================
+
+uint64_t TemporalFilterCache::hash(const std::string &str)
+{
+  // 64-bit FNV-1a
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (const unsigned char c: str)
+  {
+    h ^= c;
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+bool TemporalFilterCache::open(const std::string &directory, const uint64_t key, const Area &area,
+                               const ChromaFormat chromaFormatIdc, const int numCtu)
+{
+  close();
+
+  m_key             = key;
+  m_area            = area;
+  m_numCtu          = numCtu;
+  m_chromaFormatIdc = chromaFormatIdc;
+
+  uint64_t recordSize = RECORD_HEADER + uint64_t(numCtu) * sizeof(int32_t);
+  const UnitArea unitArea(chromaFormatIdc, area);
+  for (const auto &blk: unitArea.blocks)
+  {
+    recordSize += uint64_t(blk.width) * blk.height * sizeof(Pel);
+  }
+  m_recordSize = (recordSize + RECORD_ALIGN - 1) / RECORD_ALIGN * RECORD_ALIGN;
+
+  char name[64];
+  snprintf(name, sizeof(name), "tf_%016llx.bin", (unsigned long long) key);
+  m_fileName = directory.empty() ? std::string(name) : directory + "/" + name;
+
+  m_file.open(m_fileName, std::ios::binary | std::ios::in | std::ios::out);
+  if (m_file.is_open() && xReadHeader())
+  {
+    return true;
+  }
+
+  // no (valid) cache yet, start a new one
+  m_file.close();
+  m_file.clear();
+  m_file.open(m_fileName, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+  if (!m_file.is_open())
+  {
+    return false;
+  }
+  xWriteHeader();
+  return m_file.good();
+}
+
+void TemporalFilterCache::close()
+{
+  if (m_file.is_open())
+  {
+    m_file.close();
+  }
+  m_file.clear();
+}
+
+bool TemporalFilterCache::xReadHeader()
+{
+  char     magic[8];
+  uint64_t key;
+  uint64_t recordSize;
+  int32_t  dims[4];
+
+  m_file.seekg(0);
+  m_file.read(magic, sizeof(magic));
+  m_file.read(reinterpret_cast<char *>(&key), sizeof(key));
+  m_file.read(reinterpret_cast<char *>(&recordSize), sizeof(recordSize));
+  m_file.read(reinterpret_cast<char *>(dims), sizeof(dims));
+
+  return m_file.good() && memcmp(magic, "VTMTFC01", sizeof(magic)) == 0 && key == m_key && recordSize == m_recordSize
+         && dims[0] == m_area.width && dims[1] == m_area.height && dims[2] == int(m_chromaFormatIdc)
+         && dims[3] == m_numCtu;
+}
+
+void TemporalFilterCache::xWriteHeader()
+{
+  std::vector<char> header(HEADER_SIZE, 0);
+  const int32_t     dims[4] = { int32_t(m_area.width), int32_t(m_area.height), int32_t(m_chromaFormatIdc), m_numCtu };
+
+  memcpy(&header[0], "VTMTFC01", 8);
+  memcpy(&header[8], &m_key, sizeof(m_key));
+  memcpy(&header[16], &m_recordSize, sizeof(m_recordSize));
+  memcpy(&header[24], dims, sizeof(dims));
+
+  m_file.seekp(0);
+  m_file.write(header.data(), header.size());
+  m_file.flush();
+}
+
+bool TemporalFilterCache::read(const int poc, PelStorage *pic, int *qpMap, bool &filtered)
+{
+  uint32_t flags = 0;
+  m_file.clear();
+  m_file.seekg(xRecordOffset(poc));
+  m_file.read(reinterpret_cast<char *>(&flags), sizeof(flags));
+  if (!m_file.good() || (flags & RECORD_PRESENT) == 0)
+  {
+    // picture not (yet) in cache, reading beyond the end of the file is not an error
+    m_file.clear();
+    return false;
+  }
+
+  filtered = (flags & RECORD_FILTERED) != 0;
+  if (!filtered)
+  {
+    return true;
+  }
+
+  m_file.seekg(xRecordOffset(poc) + RECORD_HEADER);
+  const UnitArea unitArea(m_chromaFormatIdc, m_area);
+  for (int comp = 0; comp < unitArea.blocks.size(); comp++)
+  {
+    const CompArea &blk = unitArea.blocks[comp];
+    if (pic == nullptr)
+    {
+      m_file.seekg(uint64_t(blk.width) * blk.height * sizeof(Pel), std::ios::cur);
+      continue;
+    }
+    PelBuf buf = pic->get(ComponentID(comp));
+    CHECK(buf.width != blk.width || buf.height != blk.height, "Picture size does not match temporal filter cache");
+    for (int y = 0; y < blk.height; y++)
+    {
+      m_file.read(reinterpret_cast<char *>(buf.bufAt(0, y)), blk.width * sizeof(Pel));
+    }
+  }
+  if (qpMap != nullptr)
+  {
+    std::vector<int32_t> map(m_numCtu);
+    m_file.read(reinterpret_cast<char *>(map.data()), m_numCtu * sizeof(int32_t));
+    std::copy(map.begin(), map.end(), qpMap);
+  }
+  CHECK(!m_file.good(), "Temporal filter cache file is truncated");
+  return true;
+}
+
+void TemporalFilterCache::write(const int poc, const PelStorage *pic, const int *qpMap, const bool filtered)
+{
+  if (filtered)
+  {
+    m_file.seekp(xRecordOffset(poc) + RECORD_HEADER);
+    const UnitArea unitArea(m_chromaFormatIdc, m_area);
+    for (int comp = 0; comp < unitArea.blocks.size(); comp++)
+    {
+      const CompArea &blk = unitArea.blocks[comp];
+      if (pic == nullptr)
+      {
+        m_file.seekp(uint64_t(blk.width) * blk.height * sizeof(Pel), std::ios::cur);
+        continue;
+      }
+      const CPelBuf buf = pic->get(ComponentID(comp));
+      for (int y = 0; y < blk.height; y++)
+      {
+        m_file.write(reinterpret_cast<const char *>(buf.bufAt(0, y)), blk.width * sizeof(Pel));
+      }
+    }
+    std::vector<int32_t> map(m_numCtu, 0);
+    if (qpMap != nullptr)
+    {
+      std::copy(qpMap, qpMap + m_numCtu, map.begin());
+    }
+    m_file.write(reinterpret_cast<const char *>(map.data()), m_numCtu * sizeof(int32_t));
+    m_file.flush();
+  }
+
+  // the record only becomes valid once its payload has been written completely
+  const uint32_t flags = RECORD_PRESENT | (filtered ? RECORD_FILTERED : 0);
+  m_file.seekp(xRecordOffset(poc));
+  m_file.write(reinterpret_cast<const char *>(&flags), sizeof(flags));
+  m_file.flush();
+  if (!m_file.good())
+  {
+    msg(WARNING, "Writing to temporal filter cache failed, cache disabled\n");
+    close();
+  }
+}
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
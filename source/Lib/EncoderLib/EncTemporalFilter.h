@@ -42,6 +42,7 @@
 #include <sstream>
 #include <map>
 #include <deque>
+#include <fstream>
 
 
 //! \ingroup EncoderLib
@@ -108,6 +109,51 @@ struct TemporalFilterSourcePicInfo
 // Class definition
 // ====================================================================================================================
 
+/// On-disk store of temporally filtered original pictures and BIM QP maps.
+/// The file starts with a page-sized header followed by one fixed-size, page-aligned record per picture, so that it can
+/// be memory mapped or read at random positions. The file name is derived from a hash of all parameters that influence
+/// the filter output, so caches for different inputs or settings can share one directory.
+class TemporalFilterCache
+{
+public:
+  TemporalFilterCache() : m_key(0), m_recordSize(0), m_numCtu(0), m_chromaFormatIdc(ChromaFormat::UNDEFINED) {}
+  ~TemporalFilterCache() { close(); }
+
+  bool open(const std::string &directory, const uint64_t key, const Area &area, const ChromaFormat chromaFormatIdc,
+            const int numCtu);
+  void close();
+  bool isOpen() const { return m_file.is_open(); }
+  const std::string &getFileName() const { return m_fileName; }
+
+  bool read(const int poc, PelStorage *pic, int *qpMap, bool &filtered);
+  void write(const int poc, const PelStorage *pic, const int *qpMap, const bool filtered);
+
+  static uint64_t hash(const std::string &str);
+
+private:
+  static constexpr uint32_t HEADER_SIZE   = 4096;
+  static constexpr uint32_t RECORD_ALIGN  = 4096;
+  static constexpr uint32_t RECORD_HEADER = 64;
+
+  enum RecordFlags : uint32_t
+  {
+    RECORD_PRESENT  = 1 << 0,
+    RECORD_FILTERED = 1 << 1,
+  };
+
+  bool     xReadHeader();
+  void     xWriteHeader();
+  uint64_t xRecordOffset(const int poc) const { return HEADER_SIZE + uint64_t(poc) * m_recordSize; }
+
+  std::fstream m_file;
+  std::string  m_fileName;
+  uint64_t     m_key;
+  uint64_t     m_recordSize;
+  Area         m_area;
+  int          m_numCtu;
+  ChromaFormat m_chromaFormatIdc;
+};
+
 class EncTemporalFilter
 {
 public:
@@ -124,6 +170,7 @@ public:
             const int firstValidFrame, const int lastValidFrame, const bool bMCTFenabled,
             std::map<int, int *> *adaptQPmap, const bool bBIMenabled, const int ctuSize);
 
+  void initCache(const std::string &directory);
   bool filter(PelStorage *orgPic, int frame);
 
 private:
@@ -171,8 +218,10 @@ private:
   int m_numCtu;
   int m_ctuSize;
   std::map<int, int*> *m_ctuAdaptedQP;
+  TemporalFilterCache  m_cache;
 
   // Private functions
+  uint64_t cacheKey() const;
   void subsampleLuma(const PelStorage &input, PelStorage &output, const int factor = 2) const;
   int64_t motionErrorLuma(const PelStorage& orig, const PelStorage& buffer, const int x, const int y, int dx, int dy,
                           const int bs, const int64_t besterror) const;
@@ -49,6 +49,7 @@
 
 #include "EncModeCtrl.h"
 #include "EncLib.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <math.h>
 #include <limits>
@@ -175,6 +176,7 @@ void InterSearch::destroy()
   }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
+  m_motionPyramid.destroy();
   m_isInitialized = false;
 }
 
@@ -209,6 +211,7 @@ void InterSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, int searchRange, in
   m_ctxPool                      = ctxPool;
   m_useCompositeRef              = useCompositeRef;
   m_pcReshape                    = pcReshape;
+  m_motionPyramid.init(pcRdCost);
 
   for (uint32_t dir = 0; dir < MAX_NUM_REF_LIST_ADAPT_SR; dir++)
   {
@@ -431,6 +434,59 @@ inline void InterSearch::xTZSearchHelp( IntTZSearchStruct& rcStruct, const int i
 
 
 
+inline void InterSearch::xTZSearchHelpPoints( IntTZSearchStruct& rcStruct, const TZSearchPoints& points )
+{
+  // the row subsampled refinement and the weighted SAD are only available point by point
+  if( 1 == rcStruct.subShiftMode || m_cDistParam.applyWeight )
+  {
+    for( int i = 0; i < points.num; i++ )
+    {
+      xTZSearchHelp( rcStruct, points.x[i], points.y[i], points.pointNr[i], points.distance[i] );
+    }
+    return;
+  }
+
+  // the SADs of up to 8 points are computed in one pass over the pattern, the decisions are taken in the original
+  // order, so the result is identical to checking the points one after another
+  for( int start = 0; start < points.num; start += 8 )
+  {
+    const int  numSad = std::min( points.num - start, 8 );
+    const Pel *piRefSrch[8];
+    Distortion uiSads[8];
+
+    for( int i = 0; i < numSad; i++ )
+    {
+      piRefSrch[i] = rcStruct.piRefY + points.y[start + i] * rcStruct.iRefStride + points.x[start + i];
+    }
+    m_pcRdCost->getSADs( m_cDistParam, piRefSrch, numSad, uiSads );
+
+    for( int i = 0; i < numSad; i++ )
+    {
+      Distortion uiSad = uiSads[i];
+
+      if( uiSad < rcStruct.uiBestSad )
+      {
+        const int iSearchX = points.x[start + i];
+        const int iSearchY = points.y[start + i];
+
+        // motion cost
+        uiSad += m_pcRdCost->getCostOfVectorWithPredictor( iSearchX, iSearchY, rcStruct.imvShift );
+
+        if( uiSad < rcStruct.uiBestSad )
+        {
+          rcStruct.uiBestSad      = uiSad;
+          rcStruct.iBestX         = iSearchX;
+          rcStruct.iBestY         = iSearchY;
+          rcStruct.uiBestDistance = points.distance[start + i];
+          rcStruct.uiBestRound    = 0;
+          rcStruct.ucPointNr      = points.pointNr[start + i];
+          m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+        }
+      }
+    }
+  }
+}
+
 inline void InterSearch::xTZ2PointSearch( IntTZSearchStruct& rcStruct )
 {
   const SearchRange& sr = rcStruct.searchRange;
@@ -472,42 +528,46 @@ inline void InterSearch::xTZ8PointSquareSearch( IntTZSearchStruct& rcStruct, con
   const int iRight      = iStartX + iDist;
   rcStruct.uiBestRound += 1;
 
+  TZSearchPoints points;
+
   if ( iTop >= sr.top ) // check top
   {
     if ( iLeft >= sr.left ) // check top left
     {
-      xTZSearchHelp( rcStruct, iLeft, iTop, 1, iDist );
+      points.add( iLeft, iTop, 1, iDist );
     }
     // top middle
-    xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+    points.add( iStartX, iTop, 2, iDist );
 
     if ( iRight <= sr.right ) // check top right
     {
-      xTZSearchHelp( rcStruct, iRight, iTop, 3, iDist );
+      points.add( iRight, iTop, 3, iDist );
     }
   } // check top
   if ( iLeft >= sr.left ) // check middle left
   {
-    xTZSearchHelp( rcStruct, iLeft, iStartY, 4, iDist );
+    points.add( iLeft, iStartY, 4, iDist );
   }
   if ( iRight <= sr.right ) // check middle right
   {
-    xTZSearchHelp( rcStruct, iRight, iStartY, 5, iDist );
+    points.add( iRight, iStartY, 5, iDist );
   }
   if ( iBottom <= sr.bottom ) // check bottom
   {
     if ( iLeft >= sr.left ) // check bottom left
     {
-      xTZSearchHelp( rcStruct, iLeft, iBottom, 6, iDist );
+      points.add( iLeft, iBottom, 6, iDist );
     }
     // check bottom middle
-    xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+    points.add( iStartX, iBottom, 7, iDist );
 
     if ( iRight <= sr.right ) // check bottom right
     {
-      xTZSearchHelp( rcStruct, iRight, iBottom, 8, iDist );
+      points.add( iRight, iBottom, 8, iDist );
     }
   } // check bottom
+
+  xTZSearchHelpPoints( rcStruct, points );
 }
 
 inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
@@ -527,6 +587,8 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
   const int iRight      = iStartX + iDist;
   rcStruct.uiBestRound += 1;
 
+  TZSearchPoints points;
+
   if ( iDist == 1 )
   {
     if ( iTop >= sr.top ) // check top
@@ -535,26 +597,26 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       {
         if ( iLeft >= sr.left) // check top-left
         {
-          xTZSearchHelp( rcStruct, iLeft, iTop, 1, iDist );
+          points.add( iLeft, iTop, 1, iDist );
         }
-        xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+        points.add( iStartX, iTop, 2, iDist );
         if ( iRight <= sr.right ) // check middle right
         {
-          xTZSearchHelp( rcStruct, iRight, iTop, 3, iDist );
+          points.add( iRight, iTop, 3, iDist );
         }
       }
       else
       {
-        xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+        points.add( iStartX, iTop, 2, iDist );
       }
     }
     if ( iLeft >= sr.left ) // check middle left
     {
-      xTZSearchHelp( rcStruct, iLeft, iStartY, 4, iDist );
+      points.add( iLeft, iStartY, 4, iDist );
     }
     if ( iRight <= sr.right ) // check middle right
     {
-      xTZSearchHelp( rcStruct, iRight, iStartY, 5, iDist );
+      points.add( iRight, iStartY, 5, iDist );
     }
     if ( iBottom <= sr.bottom ) // check bottom
     {
@@ -562,17 +624,17 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       {
         if ( iLeft >= sr.left) // check top-left
         {
-          xTZSearchHelp( rcStruct, iLeft, iBottom, 6, iDist );
+          points.add( iLeft, iBottom, 6, iDist );
         }
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+        points.add( iStartX, iBottom, 7, iDist );
         if ( iRight <= sr.right ) // check middle right
         {
-          xTZSearchHelp( rcStruct, iRight, iBottom, 8, iDist );
+          points.add( iRight, iBottom, 8, iDist );
         }
       }
       else
       {
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+        points.add( iStartX, iBottom, 7, iDist );
       }
     }
   }
@@ -588,54 +650,54 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       if (  iTop >= sr.top && iLeft >= sr.left &&
            iRight <= sr.right && iBottom <= sr.bottom ) // check border
       {
-        xTZSearchHelp( rcStruct, iStartX,  iTop,      2, iDist    );
-        xTZSearchHelp( rcStruct, iLeft_2,  iTop_2,    1, iDist>>1 );
-        xTZSearchHelp( rcStruct, iRight_2, iTop_2,    3, iDist>>1 );
-        xTZSearchHelp( rcStruct, iLeft,    iStartY,   4, iDist    );
-        xTZSearchHelp( rcStruct, iRight,   iStartY,   5, iDist    );
-        xTZSearchHelp( rcStruct, iLeft_2,  iBottom_2, 6, iDist>>1 );
-        xTZSearchHelp( rcStruct, iRight_2, iBottom_2, 8, iDist>>1 );
-        xTZSearchHelp( rcStruct, iStartX,  iBottom,   7, iDist    );
+        points.add( iStartX,  iTop,      2, iDist    );
+        points.add( iLeft_2,  iTop_2,    1, iDist>>1 );
+        points.add( iRight_2, iTop_2,    3, iDist>>1 );
+        points.add( iLeft,    iStartY,   4, iDist    );
+        points.add( iRight,   iStartY,   5, iDist    );
+        points.add( iLeft_2,  iBottom_2, 6, iDist>>1 );
+        points.add( iRight_2, iBottom_2, 8, iDist>>1 );
+        points.add( iStartX,  iBottom,   7, iDist    );
       }
       else // check border
       {
         if ( iTop >= sr.top ) // check top
         {
-          xTZSearchHelp( rcStruct, iStartX, iTop, 2, iDist );
+          points.add( iStartX, iTop, 2, iDist );
         }
         if ( iTop_2 >= sr.top ) // check half top
         {
           if ( iLeft_2 >= sr.left ) // check half left
           {
-            xTZSearchHelp( rcStruct, iLeft_2, iTop_2, 1, (iDist>>1) );
+            points.add( iLeft_2, iTop_2, 1, (iDist>>1) );
           }
           if ( iRight_2 <= sr.right ) // check half right
           {
-            xTZSearchHelp( rcStruct, iRight_2, iTop_2, 3, (iDist>>1) );
+            points.add( iRight_2, iTop_2, 3, (iDist>>1) );
           }
         } // check half top
         if ( iLeft >= sr.left ) // check left
         {
-          xTZSearchHelp( rcStruct, iLeft, iStartY, 4, iDist );
+          points.add( iLeft, iStartY, 4, iDist );
         }
         if ( iRight <= sr.right ) // check right
         {
-          xTZSearchHelp( rcStruct, iRight, iStartY, 5, iDist );
+          points.add( iRight, iStartY, 5, iDist );
         }
         if ( iBottom_2 <= sr.bottom ) // check half bottom
         {
           if ( iLeft_2 >= sr.left ) // check half left
           {
-            xTZSearchHelp( rcStruct, iLeft_2, iBottom_2, 6, (iDist>>1) );
+            points.add( iLeft_2, iBottom_2, 6, (iDist>>1) );
           }
           if ( iRight_2 <= sr.right ) // check half right
           {
-            xTZSearchHelp( rcStruct, iRight_2, iBottom_2, 8, (iDist>>1) );
+            points.add( iRight_2, iBottom_2, 8, (iDist>>1) );
           }
         } // check half bottom
         if ( iBottom <= sr.bottom ) // check bottom
         {
-          xTZSearchHelp( rcStruct, iStartX, iBottom, 7, iDist );
+          points.add( iStartX, iBottom, 7, iDist );
         }
       } // check border
     }
@@ -644,39 +706,39 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
       if ( iTop >= sr.top && iLeft >= sr.left &&
            iRight <= sr.right && iBottom <= sr.bottom ) // check border
       {
-        xTZSearchHelp( rcStruct, iStartX, iTop,    0, iDist );
-        xTZSearchHelp( rcStruct, iLeft,   iStartY, 0, iDist );
-        xTZSearchHelp( rcStruct, iRight,  iStartY, 0, iDist );
-        xTZSearchHelp( rcStruct, iStartX, iBottom, 0, iDist );
+        points.add( iStartX, iTop,    0, iDist );
+        points.add( iLeft,   iStartY, 0, iDist );
+        points.add( iRight,  iStartY, 0, iDist );
+        points.add( iStartX, iBottom, 0, iDist );
         for ( int index = 1; index < 4; index++ )
         {
           const int iPosYT = iTop    + ((iDist>>2) * index);
           const int iPosYB = iBottom - ((iDist>>2) * index);
           const int iPosXL = iStartX - ((iDist>>2) * index);
           const int iPosXR = iStartX + ((iDist>>2) * index);
-          xTZSearchHelp( rcStruct, iPosXL, iPosYT, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXR, iPosYT, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXL, iPosYB, 0, iDist );
-          xTZSearchHelp( rcStruct, iPosXR, iPosYB, 0, iDist );
+          points.add( iPosXL, iPosYT, 0, iDist );
+          points.add( iPosXR, iPosYT, 0, iDist );
+          points.add( iPosXL, iPosYB, 0, iDist );
+          points.add( iPosXR, iPosYB, 0, iDist );
         }
       }
       else // check border
       {
         if ( iTop >= sr.top ) // check top
         {
-          xTZSearchHelp( rcStruct, iStartX, iTop, 0, iDist );
+          points.add( iStartX, iTop, 0, iDist );
         }
         if ( iLeft >= sr.left ) // check left
         {
-          xTZSearchHelp( rcStruct, iLeft, iStartY, 0, iDist );
+          points.add( iLeft, iStartY, 0, iDist );
         }
         if ( iRight <= sr.right ) // check right
         {
-          xTZSearchHelp( rcStruct, iRight, iStartY, 0, iDist );
+          points.add( iRight, iStartY, 0, iDist );
         }
         if ( iBottom <= sr.bottom ) // check bottom
         {
-          xTZSearchHelp( rcStruct, iStartX, iBottom, 0, iDist );
+          points.add( iStartX, iBottom, 0, iDist );
         }
         for ( int index = 1; index < 4; index++ )
         {
@@ -689,28 +751,30 @@ inline void InterSearch::xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct,
           {
             if ( iPosXL >= sr.left ) // check left
             {
-              xTZSearchHelp( rcStruct, iPosXL, iPosYT, 0, iDist );
+              points.add( iPosXL, iPosYT, 0, iDist );
             }
             if ( iPosXR <= sr.right ) // check right
             {
-              xTZSearchHelp( rcStruct, iPosXR, iPosYT, 0, iDist );
+              points.add( iPosXR, iPosYT, 0, iDist );
             }
           } // check top
           if ( iPosYB <= sr.bottom ) // check bottom
           {
             if ( iPosXL >= sr.left ) // check left
             {
-              xTZSearchHelp( rcStruct, iPosXL, iPosYB, 0, iDist );
+              points.add( iPosXL, iPosYB, 0, iDist );
             }
             if ( iPosXR <= sr.right ) // check right
             {
-              xTZSearchHelp( rcStruct, iPosXR, iPosYB, 0, iDist );
+              points.add( iPosXR, iPosYB, 0, iDist );
             }
           } // check bottom
         } // for ...
       } // check border
     } // iDist <= 8
   } // iDist == 1
+
+  xTZSearchHelpPoints( rcStruct, points );
 }
 
 #if GDR_ENABLED
@@ -2687,6 +2751,7 @@ bool InterSearch::predInterHashSearch(CodingUnit& cu, Partitioner& partitioner,
 //! search of the best candidate for inter prediction
 void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 {
+  PROFILE_STAGE(ProfStage::ENC_INTER_SEARCH);
   CodingStructure& cs = *cu.cs;
 
   AMVPInfo     amvp[NUM_REF_PIC_LIST_01];
@@ -5062,6 +5127,21 @@ void InterSearch::xMotionEstimation(PredictionUnit &pu, PelUnitBuf &origBuf, Ref
       }
     }
 
+    if (!bBi && xGetPyramidMvCandidate(pu, eRefPicList, refIdxPred, cStruct, cTmpMv))
+    {
+      m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+
+      Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
+      uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
+      if (uiSad < uiBestSad)
+      {
+        uiBestSad = uiSad;
+        bestInitMv = cTmpMv;
+        bestInitMv.changePrecision(MvPrecision::ONE, MvPrecision::INTERNAL);
+        m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+      }
+    }
+
     if( !bQTBTMV )
     {
 #if GDR_ENABLED
@@ -5317,6 +5397,31 @@ void InterSearch::xPatternSearch( IntTZSearchStruct&    cStruct,
   return;
 }
 
+bool InterSearch::xGetPyramidMvCandidate(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred,
+                                         const IntTZSearchStruct &cStruct, Mv &rcMv)
+{
+  if (!m_pcEncCfg->getPyramidME() || cStruct.inCtuSearch || m_pcEncCfg->getMCTSEncConstraint()
+      || pu.cs->sps->getGDREnabledFlag())
+  {
+    return false;
+  }
+
+  const Picture *refPic = pu.cu->slice->getRefPic(eRefPicList, refIdxPred);
+  if (refPic->isRefScaled(pu.cs->sps, pu.cs->pps))
+  {
+    return false;
+  }
+
+  // the candidate of the 64x64 block covering the center of the PU, clipped like the other start candidates
+  const Position center = pu.Y().center();
+  rcMv = m_motionPyramid.getCandidate(*pu.cs->picture, *refPic, center, m_searchRange,
+                                      pu.cs->sps->getBitDepth(ChannelType::LUMA));
+  rcMv.changePrecision(MvPrecision::ONE, MvPrecision::INTERNAL);
+  clipMv(rcMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps);
+  rcMv.changePrecision(MvPrecision::INTERNAL, MvPrecision::ONE);
+  return true;
+}
+
 void InterSearch::xPatternSearchFast(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred,
                                      IntTZSearchStruct &cStruct, Mv &rcMv, Distortion &ruiSAD,
                                      const Mv *const pIntegerMv2Nx2NPred)
@@ -5500,6 +5605,12 @@ void InterSearch::xTZSearch(const PredictionUnit &pu, RefPicList eRefPicList, in
 #endif
   }
 
+  Mv pyramidMv;
+  if (xGetPyramidMvCandidate(pu, eRefPicList, refIdxPred, cStruct, pyramidMv))
+  {
+    xTZSearchHelp(cStruct, pyramidMv.getHor(), pyramidMv.getVer(), 0, 0);
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
@@ -5633,10 +5744,17 @@ void InterSearch::xTZSearch(const PredictionUnit &pu, RefPicList eRefPicList, in
       cStruct.uiBestDistance = iRaster;
       for ( iStartY = sr.top; iStartY <= sr.bottom; iStartY += iRaster )
       {
+        TZSearchPoints points;
         for ( iStartX = sr.left; iStartX <= sr.right; iStartX += iRaster )
         {
-          xTZSearchHelp( cStruct, iStartX, iStartY, 0, iRaster );
+          points.add( iStartX, iStartY, 0, iRaster );
+          if ( points.num == TZSearchPoints::MAX_POINTS )
+          {
+            xTZSearchHelpPoints( cStruct, points );
+            points.num = 0;
+          }
         }
+        xTZSearchHelpPoints( cStruct, points );
       }
     }
   }
@@ -5803,6 +5921,12 @@ void InterSearch::xTZSearchSelective(const PredictionUnit &pu, RefPicList eRefPi
     }
   }
 
+  Mv pyramidMv;
+  if (xGetPyramidMvCandidate(pu, eRefPicList, refIdxPred, cStruct, pyramidMv))
+  {
+    xTZSearchHelp(cStruct, pyramidMv.getHor(), pyramidMv.getVer(), 0, 0);
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
@@ -10720,6 +10844,9 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
   auto blkCache = dynamic_cast<CacheBlkInfoCtrl*>(m_modeCtrl);
   bool rootCbfFirstColorSpace = true;
 
+  // the transform decisions may use the approximate residual rate, the final CU rate below is estimated exactly
+  m_CABACEstimator->setFastResidualRate(m_pcEncCfg->getFastResidualRate());
+
   for (int iter = 0; iter < numAllowedColorSpace; iter++)
   {
     if (colorTransAllowed && !m_pcEncCfg->getRGBFormatFlag() && iter)
@@ -10889,6 +11016,7 @@ void InterSearch::encodeResAndCalcRdInterCU(CodingStructure &cs, Partitioner &pa
   }
 
   // all decisions now made. Fully encode the CU, including the headers:
+  m_CABACEstimator->setFastResidualRate(false);
   m_CABACEstimator->getCtx() = ctxStart;
 
   uint64_t finalFracBits = xGetSymbolFracBitsInter( cs, partitioner );
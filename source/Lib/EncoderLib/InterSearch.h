@@ -55,6 +55,7 @@
 #include <unordered_map>
 #include <vector>
 #include "EncReshape.h"
+#include "EncMotionPyramid.h"
 //! \ingroup EncoderLib
 //! \{
 
@@ -155,6 +156,7 @@ protected:
 
   // ME parameters
   int             m_searchRange;
+  EncMotionPyramid m_motionPyramid;
   int             m_bipredSearchRange; // Search range for bi-prediction
   MESearchMethod  m_motionEstimationSearchMethod;
   int             m_adaptSR[MAX_NUM_REF_LIST_ADAPT_SR][MAX_IDX_ADAPT_SR];
@@ -402,8 +404,30 @@ protected:
     bool        zeroMV;
   } IntTZSearchStruct;
 
+  // search points of one pattern, checked in the order they were added
+  struct TZSearchPoints
+  {
+    static constexpr int MAX_POINTS = 16;
+
+    int      num = 0;
+    int      x[MAX_POINTS];
+    int      y[MAX_POINTS];
+    uint8_t  pointNr[MAX_POINTS];
+    uint32_t distance[MAX_POINTS];
+
+    void add( const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance )
+    {
+      x[num]        = iSearchX;
+      y[num]        = iSearchY;
+      pointNr[num]  = ucPointNr;
+      distance[num] = uiDistance;
+      num++;
+    }
+  };
+
   // sub-functions for ME
   inline void xTZSearchHelp         ( IntTZSearchStruct& rcStruct, const int iSearchX, const int iSearchY, const uint8_t ucPointNr, const uint32_t uiDistance );
+  inline void xTZSearchHelpPoints   ( IntTZSearchStruct& rcStruct, const TZSearchPoints& points );
   inline void xTZ2PointSearch       ( IntTZSearchStruct& rcStruct );
   inline void xTZ8PointSquareSearch ( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist );
   inline void xTZ8PointDiamondSearch( IntTZSearchStruct& rcStruct, const int iStartX, const int iStartY, const int iDist, const bool bCheckCornersAtDist1 );
@@ -492,6 +516,9 @@ protected:
 #endif
   );
 
+  bool xGetPyramidMvCandidate(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred,
+                              const IntTZSearchStruct &cStruct, Mv &rcMv);
+
   void xPatternSearchFast(const PredictionUnit &pu, RefPicList eRefPicList, int refIdxPred, IntTZSearchStruct &cStruct,
                           Mv &rcMv, Distortion &ruiSAD, const Mv *const pIntegerMv2Nx2NPred);
 
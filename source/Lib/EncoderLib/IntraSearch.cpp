@@ -46,6 +46,7 @@
 
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <math.h>
 #include <limits>
@@ -209,6 +210,7 @@ void IntraSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, RdCost *pcRdCost, C
 
   IntraPrediction::init(cform, pcEncCfg->getBitDepth(ChannelType::LUMA));
   m_tmpStorageCtu.create(UnitArea(cform, Area(0, 0, maxCUWidth, maxCUHeight)));
+  m_modeCache.init(pcEncCfg->getIntraModeCacheSize());
   m_colorTransResiBuf.create(UnitArea(cform, Area(0, 0, maxCUWidth, maxCUHeight)));
 
   for( uint32_t ch = 0; ch < MAX_NUM_TBLOCKS; ch++ )
@@ -502,8 +504,56 @@ bool IntraSearch::isValidIntraPredChroma(PredictionUnit &pu, int lumaDirMode, in
 }
 #endif
 
+void IntraModeCache::init(size_t maxSize)
+{
+  m_entries.clear();
+  m_entries.reserve(maxSize);   // entries handed out must not be moved
+  m_maxSize    = maxSize;
+  m_useCounter = 0;
+}
+
+void IntraModeCache::reset()
+{
+  m_entries.clear();
+  m_useCounter = 0;
+}
+
+IntraModeCache::Entry *IntraModeCache::find(const Area &area, bool colorTransform)
+{
+  for (auto &entry: m_entries)
+  {
+    if (entry.area == area && entry.colorTransform == colorTransform)
+    {
+      entry.lastUse = ++m_useCounter;
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+IntraModeCache::Entry *IntraModeCache::add(const Area &area, bool colorTransform)
+{
+  Entry *entry = nullptr;
+  if (m_entries.size() < m_maxSize)
+  {
+    m_entries.emplace_back();
+    entry = &m_entries.back();
+  }
+  else
+  {
+    entry = &*std::min_element(m_entries.begin(), m_entries.end(),
+                               [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+  }
+  entry->area           = area;
+  entry->colorTransform = colorTransform;
+  std::fill_n(entry->modes, FAST_UDI_MAX_RDMODE_NUM, false);
+  entry->lastUse = ++m_useCounter;
+  return entry;
+}
+
 bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, const double bestCostSoFar, bool mtsCheckRangeFlag, int mtsFirstCheckId, int mtsLastCheckId, bool moreProbMTSIdxFirst, CodingStructure* bestCS)
 {
+  PROFILE_STAGE(ProfStage::ENC_INTRA_SEARCH);
   CodingStructure &cs  = *cu.cs;
   const SPS       &sps = *cs.sps;
 
@@ -686,6 +736,24 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
           bool satdChecked[NUM_INTRA_MODE];
           std::fill_n(satdChecked, NUM_INTRA_MODE, false);
 
+          // When the block was already tested in this CTU through a different partitioning, only the modes selected
+          // at that test are evaluated again with the current reference samples
+          IntraModeCache::Entry *modeCacheEntry   = nullptr;
+          bool                   reuseCachedModes = false;
+#if GDR_ENABLED
+          if (m_modeCache.isEnabled() && !lfnstLoadFlag && !isEncodeGdrClean)
+#else
+          if (m_modeCache.isEnabled() && !lfnstLoadFlag)
+#endif
+          {
+            modeCacheEntry   = m_modeCache.find(pu.Y(), cu.colorTransform);
+            reuseCachedModes = modeCacheEntry != nullptr;
+            if (!reuseCachedModes)
+            {
+              modeCacheEntry = m_modeCache.add(pu.Y(), cu.colorTransform);
+            }
+          }
+
           if (!lfnstLoadFlag)
           {
             for (int modeIdx = 0; modeIdx < numModesAvailable; modeIdx++)
@@ -693,8 +761,15 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               uint32_t   mode      = modeIdx;
               Distortion minSadHad = 0;
 
+              if (reuseCachedModes)
+              {
+                if (!modeCacheEntry->modes[mode])
+                {
+                  continue;
+                }
+              }
               // Skip checking extended Angular modes in the first round of SATD
-              if (mode > DC_IDX && (mode & 1))
+              else if (mode > DC_IDX && (mode & 1))
               {
                 continue;
               }
@@ -821,6 +896,17 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
               // we save the regular intra modes list
               m_ispCandList[ISPType::HOR] = rdModeList;
             }
+            if (modeCacheEntry != nullptr && !reuseCachedModes)
+            {
+              for (const auto &mi: rdModeList)
+              {
+                modeCacheEntry->modes[mi.modeId] = true;
+              }
+              for (const auto &mi: hadModeList)
+              {
+                modeCacheEntry->modes[mi.modeId] = true;
+              }
+            }
             pu.multiRefIdx    = 1;
             const int numMPMs = NUM_MOST_PROBABLE_MODES;
             unsigned  multiRefMPM[numMPMs];
@@ -925,6 +1011,12 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
                 const bool     isTransposed = (modeFull >= transpOff ? true : false);
                 const uint32_t mode         = (isTransposed ? modeFull - transpOff : modeFull);
 
+                // the costs of the first three MIP modes are always needed to reduce the candidate list
+                if (reuseCachedModes && mode > 2 && !modeCacheEntry->modes[NUM_LUMA_MODE + modeFull])
+                {
+                  continue;
+                }
+
                 pu.mipTransposedFlag           = isTransposed;
                 pu.intraDir[ChannelType::LUMA] = mode;
                 predIntraMip(COMPONENT_Y, piPred, pu);
@@ -953,6 +1045,24 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
                 }
               }
 
+              if (modeCacheEntry != nullptr && !reuseCachedModes)
+              {
+                for (const auto &mi: rdModeList)
+                {
+                  if (mi.mipFlg)
+                  {
+                    modeCacheEntry->modes[NUM_LUMA_MODE + mi.modeId + (mi.mipTrFlg ? transpOff : 0)] = true;
+                  }
+                }
+                for (const auto &mi: hadModeList)
+                {
+                  if (mi.mipFlg)
+                  {
+                    modeCacheEntry->modes[NUM_LUMA_MODE + mi.modeId + (mi.mipTrFlg ? transpOff : 0)] = true;
+                  }
+                }
+              }
+
               const double thresholdHadCost = 1.0 + 1.4 / sqrt((double) (pu.lwidth() * pu.lheight()));
               reduceHadCandList(rdModeList, candCostList, numModesForFullRD, thresholdHadCost, mipHadCost, pu, fastMip);
             }
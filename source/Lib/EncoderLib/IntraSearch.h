@@ -186,6 +186,32 @@ private:
   uint32_t cnt[MAX_NUM_COMPONENT+1];
   int shift[3], lastCnt[3], data[3], sumData[3];
 };
+// Intra modes that passed the SATD based pre-selection of a luma block in the current CTU. When the block is tested
+// again through a different partitioning, only these modes are evaluated with its new reference samples. Angular modes
+// are stored at their mode index, MIP modes after the angular ones.
+class IntraModeCache
+{
+public:
+  struct Entry
+  {
+    Area     area;
+    bool     colorTransform;
+    bool     modes[FAST_UDI_MAX_RDMODE_NUM];
+    uint64_t lastUse;
+  };
+
+private:
+  std::vector<Entry> m_entries;
+  size_t             m_maxSize    = 0;
+  uint64_t           m_useCounter = 0;
+
+public:
+  void   init(size_t maxSize);
+  void   reset();
+  bool   isEnabled() const { return m_maxSize > 0; }
+  Entry* find(const Area &area, bool colorTransform);
+  Entry* add(const Area &area, bool colorTransform);
+};
 /// encoder search class
 class IntraSearch : public IntraPrediction
 {
@@ -379,6 +405,8 @@ private:
   static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   m_savedModeCostLFNST;
   static_vector<double, FAST_UDI_MAX_RDMODE_NUM>   m_savedHadListLFNST;
 
+  IntraModeCache m_modeCache;
+
   PelStorage      m_tmpStorageCtu;
   PelStorage      m_colorTransResiBuf;
 
@@ -439,6 +467,7 @@ public:
   void PLTSearch                  ( CodingStructure &cs, Partitioner& partitioner, ComponentID compBegin, uint32_t numComp);
   uint64_t xFracModeBitsIntra(PredictionUnit &pu, const uint32_t &mode, const ChannelType &compID);
   void invalidateBestModeCost     () { for( int i = 0; i < NUM_LFNST_NUM_PER_SET; i++ ) m_bestModeCostValid[ i ] = false; };
+  void resetModeCache             () { m_modeCache.reset(); }
 
   void sortRdModeListFirstColorSpace(ModeInfo mode, double cost, BdpcmMode bdpcmMode, ModeInfo *rdModeList,
                                      double *rdCostList, BdpcmMode *bdpcmModeList, int &candNum);
@@ -551,8 +551,13 @@ void parseConfigFile(Options& opts, const std::string& filename, ErrorReporter&
     error_reporter.error(filename) << "Failed to open config file\n";
     return;
   }
-  CfgStreamParser csp(filename, opts, error_reporter);
-  csp.scanStream(cfgstream);
+  parseConfigStream(opts, cfgstream, filename, error_reporter);
+}
+
+void parseConfigStream(Options& opts, std::istream& in, const std::string& name, ErrorReporter& error_reporter)
+{
+  CfgStreamParser csp(name, opts, error_reporter);
+  csp.scanStream(in);
 }
 
 }   // namespace ProgramOptionsLite
@@ -124,6 +124,8 @@ std::list<const char*> scanArgv(Options& opts, unsigned argc, const char* argv[]
 void                   setDefaults(Options& opts);
 void                   parseConfigFile(Options& opts, const std::string& filename,
                                        ErrorReporter& error_reporter = default_error_reporter);
+void                   parseConfigStream(Options& opts, std::istream& in, const std::string& name,
+                                         ErrorReporter& error_reporter = default_error_reporter);
 
 /** OptionBase: Virtual base class for storing information relating to a
  * specific option This base class describes common elements.  Type specific
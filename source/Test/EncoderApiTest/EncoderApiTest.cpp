@@ -0,0 +1,136 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncoderApiTest.cpp
+ *  \brief    Checks of the input conversion of EncoderApi
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "EncoderApi.h"
+
+static const int WIDTH  = 64;
+static const int HEIGHT = 64;
+
+static std::string g_cfgFile;
+
+// encodes one picture with 8 bit internal bit depth, the planes hold samples with the given bit depth
+static bool encodePicture(const std::vector<uint16_t> (&planes)[3], int bitDepth, std::string &bitstream)
+{
+  EncoderApi               encoder;
+  std::vector<std::string> options = { "-c",
+                                       g_cfgFile,
+                                       "--SourceWidth=" + std::to_string(WIDTH),
+                                       "--SourceHeight=" + std::to_string(HEIGHT),
+                                       "--FrameRate=30",
+                                       "--FramesToBeEncoded=1",
+                                       "--InputBitDepth=8",
+                                       "--InternalBitDepth=8",
+                                       "--QP=22",
+                                       "--Verbosity=0" };
+  if (!encoder.init(options, [&](const uint8_t *data, size_t size) { bitstream.append((const char *) data, size); }))
+  {
+    return false;
+  }
+
+  EncoderApi::Picture picture;
+  picture.numComponents  = 3;
+  picture.bytesPerSample = 2;
+  picture.bitDepth       = bitDepth;
+  for (int comp = 0; comp < 3; comp++)
+  {
+    picture.planes[comp]  = (void *) planes[comp].data();
+    picture.widths[comp]  = comp == 0 ? WIDTH : WIDTH / 2;
+    picture.heights[comp] = comp == 0 ? HEIGHT : HEIGHT / 2;
+    picture.strides[comp] = picture.widths[comp];
+  }
+  const bool ok = encoder.pushPicture(picture) && encoder.flush();
+  encoder.close();
+  return ok;
+}
+
+// A 10 bit picture with full-scale samples pushed into an 8 bit encoder must be coded like the same picture
+// converted to 8 bit with rounding and clipping (1023 -> 255, not 256).
+static bool testDownConversionClipping()
+{
+  std::vector<uint16_t> planes10[3];
+  std::vector<uint16_t> planes8[3];
+  for (int comp = 0; comp < 3; comp++)
+  {
+    const int width  = comp == 0 ? WIDTH : WIDTH / 2;
+    const int height = comp == 0 ? HEIGHT : HEIGHT / 2;
+    planes10[comp].resize(width * height);
+    planes8[comp].resize(width * height);
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        // full-scale samples in the left half, a ramp up to full scale in the right half
+        const int value               = x < width / 2 ? 1023 : std::min(1023, 960 + 2 * (x + y));
+        planes10[comp][y * width + x] = uint16_t(value);
+        planes8[comp][y * width + x]  = uint16_t(std::min(255, (value + 2) >> 2));
+      }
+    }
+  }
+
+  std::string bitstream10;
+  std::string bitstream8;
+  if (!encodePicture(planes10, 10, bitstream10) || !encodePicture(planes8, 8, bitstream8))
+  {
+    printf("testDownConversionClipping: encoding failed\n");
+    return false;
+  }
+  if (bitstream10.empty() || bitstream10 != bitstream8)
+  {
+    printf("testDownConversionClipping: the 10 bit input is not coded like the clipped 8 bit input\n");
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 2)
+  {
+    printf("usage: %s <encoder cfg file>\n", argv[0]);
+    return 1;
+  }
+  g_cfgFile = argv[1];
+
+  bool ok = true;
+  ok &= testDownConversionClipping();
+  printf("EncoderApiTest: %s\n", ok ? "passed" : "FAILED");
+  return ok ? 0 : 1;
+}
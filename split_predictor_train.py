@@ -0,0 +1,242 @@
+import argparse
+import csv
+import sys
+
+import numpy as np
+
+# Train the models of the learned BT/TT split early termination (SplitPredictorModel) from the
+# candidates dumped by the encoder with SplitPredictorDumpFile.
+#
+# Every dumped row is one BT or TT split candidate that passed all other fast decisions, labelled
+# with whether it was finally chosen for its CU. One model per split type predicts the logit of
+# that probability; the encoder skips a candidate if the predicted probability is below
+# SplitPredictorThr. Models are either gradient boosted decision trees or a one hidden layer
+# perceptron, both written in the fixed-point form evaluated by the encoder, and the held-out
+# statistics printed at the end are computed with that same fixed-point arithmetic.
+
+SPLITS = ['BT_H', 'BT_V', 'TT_H', 'TT_V']
+LOGIT_SCALE = 1 << 8
+MAX_INPUT = 8 * LOGIT_SCALE
+
+
+def sigmoid(x):
+    return 1.0 / (1.0 + np.exp(-x))
+
+
+def read_dumps(files):
+    features, rows = None, []
+    for name in files:
+        with open(name, newline='') as f:
+            reader = csv.reader(f)
+            header = next(reader)
+            first, last = header.index('split') + 1, header.index('cost')
+            if features is None:
+                features = header[first:last]
+            elif header[first:last] != features:
+                sys.exit(f'Error: {name} has different features than {files[0]}')
+            for row in reader:
+                rows.append((row[header.index('split')], [float(v) for v in row[first:last]], int(row[-1])))
+    return features, rows
+
+
+# ---------------------------------------------------------------------------------------------------
+# gradient boosted trees with logistic loss
+
+def candidate_thresholds(column, bins):
+    values = np.unique(column)
+    if len(values) <= bins + 1:
+        return (values[:-1] + values[1:]) / 2
+    return np.unique(np.quantile(column, np.linspace(0, 1, bins + 1)[1:-1]))
+
+
+def train_trees(x, y, w, args):
+    num_features = x.shape[1]
+    thresholds = [candidate_thresholds(x[:, f], args.bins).astype(np.float32) for f in range(num_features)]
+    # bin k holds the samples with thresholds[k - 1] <= x < thresholds[k], i.e. threshold k sends bins 0..k left
+    binned = np.stack([np.searchsorted(thresholds[f], x[:, f].astype(np.float32), side='right')
+                       for f in range(num_features)], axis=1)
+
+    p = np.clip(np.average(y, weights=w), 1e-3, 1 - 1e-3)
+    bias = int(round(np.log(p / (1 - p)) * LOGIT_SCALE))
+    logit = np.full(len(y), bias, dtype=np.int64)
+    trees = []
+
+    for _ in range(args.trees):
+        prob = sigmoid(logit / LOGIT_SCALE)
+        grad = (prob - y) * w
+        hess = np.maximum(prob * (1 - prob), 1e-6) * w
+        nodes = []
+
+        def build(idx, depth):
+            node = len(nodes)
+            nodes.append(None)
+            g, h = grad[idx].sum(), hess[idx].sum()
+            best = None
+            if depth < args.depth and len(idx) >= 2 * args.min_leaf:
+                base = g * g / (h + args.l2)
+                for f in range(num_features):
+                    if len(thresholds[f]) == 0:
+                        continue
+                    nb = len(thresholds[f]) + 1
+                    gl = np.cumsum(np.bincount(binned[idx, f], weights=grad[idx], minlength=nb))[:-1]
+                    hl = np.cumsum(np.bincount(binned[idx, f], weights=hess[idx], minlength=nb))[:-1]
+                    nl = np.cumsum(np.bincount(binned[idx, f], minlength=nb))[:-1]
+                    gain = gl * gl / (hl + args.l2) + (g - gl) ** 2 / (h - hl + args.l2) - base
+                    gain[(nl < args.min_leaf) | (len(idx) - nl < args.min_leaf)] = -np.inf
+                    k = int(np.argmax(gain))
+                    if gain[k] > 0 and (best is None or gain[k] > best[0]):
+                        best = (gain[k], f, k)
+            if best is None:
+                nodes[node] = [-1, 0.0, 0, 0, int(round(-g / (h + args.l2) * args.learning_rate * LOGIT_SCALE))]
+                return node
+            _, f, k = best
+            goes_left = binned[idx, f] <= k
+            left = build(idx[goes_left], depth + 1)
+            right = build(idx[~goes_left], depth + 1)
+            nodes[node] = [f, float(thresholds[f][k]), left, right, 0]
+            return node
+
+        build(np.arange(len(y)), 0)
+        trees.append(nodes)
+        logit += predict_tree(nodes, x)
+
+    return {'type': 'trees', 'bias': bias, 'trees': trees}
+
+
+def predict_tree(nodes, x):
+    out = np.zeros(len(x), dtype=np.int64)
+    stack = [(0, np.arange(len(x)))]
+    while stack:
+        node, idx = stack.pop()
+        f, threshold, left, right, value = nodes[node]
+        if f < 0:
+            out[idx] = value
+            continue
+        goes_left = x[idx, f].astype(np.float32) < np.float32(threshold)
+        stack.append((left, idx[goes_left]))
+        stack.append((right, idx[~goes_left]))
+    return out
+
+
+# ---------------------------------------------------------------------------------------------------
+# one hidden layer perceptron, trained in floating point and quantised to the encoder's fixed point
+
+def train_mlp(x, y, w, args):
+    rng = np.random.default_rng(args.seed)
+    mean = x.mean(axis=0)
+    inv_std = 1.0 / np.maximum(x.std(axis=0), 1e-3)
+    xn = np.clip((x - mean) * inv_std, -8, 8)
+
+    params = [rng.normal(0, np.sqrt(2.0 / x.shape[1]), (x.shape[1], args.hidden)), np.zeros(args.hidden),
+              rng.normal(0, np.sqrt(1.0 / args.hidden), args.hidden), np.zeros(1)]
+    moments = [(np.zeros_like(p), np.zeros_like(p)) for p in params]
+    w = w / w.sum()
+
+    for step in range(1, args.epochs + 1):
+        w1, b1, w2, b2 = params
+        pre = xn @ w1 + b1
+        act = np.maximum(pre, 0)
+        prob = sigmoid(act @ w2 + b2[0])
+        d_out = (prob - y) * w
+        d_act = np.outer(d_out, w2) * (pre > 0)
+        grads = [xn.T @ d_act, d_act.sum(axis=0), act.T @ d_out, np.array([d_out.sum()])]
+        for i, (p, g) in enumerate(zip(params, grads)):
+            m, v = moments[i]
+            m[:] = 0.9 * m + 0.1 * g
+            v[:] = 0.999 * v + 0.001 * g * g
+            p -= args.learning_rate * (m / (1 - 0.9 ** step)) / (np.sqrt(v / (1 - 0.999 ** step)) + 1e-8)
+
+    w1, b1, w2, b2 = params
+    return {'type': 'mlp', 'mean': mean.astype(np.float32), 'inv_std': inv_std.astype(np.float32),
+            'w1': np.round(w1.T * LOGIT_SCALE).astype(np.int64), 'b1': np.round(b1 * LOGIT_SCALE).astype(np.int64),
+            'w2': np.round(w2 * LOGIT_SCALE).astype(np.int64), 'b2': int(round(b2[0] * LOGIT_SCALE))}
+
+
+def predict_mlp(model, x):
+    norm = (x.astype(np.float32) - model['mean']) * model['inv_std'] * np.float32(LOGIT_SCALE)
+    # rounding half away from zero like std::lround
+    inputs = np.clip(np.sign(norm) * np.floor(np.abs(norm) + 0.5), -MAX_INPUT, MAX_INPUT).astype(np.int64)
+    act = np.maximum(0, ((inputs @ model['w1'].T) >> 8) + model['b1'])
+    return ((act @ model['w2']) >> 8) + model['b2']
+
+
+def predict(model, x):
+    if model['type'] == 'trees':
+        return model['bias'] + sum(predict_tree(tree, x) for tree in model['trees'])
+    return predict_mlp(model, x)
+
+
+def write_model(f, split, model):
+    f.write(f'model {split} {model["type"]}\n')
+    if model['type'] == 'trees':
+        f.write(f'{len(model["trees"])} {model["bias"]}\n')
+        for tree in model['trees']:
+            f.write(f'{len(tree)}\n')
+            for feature, threshold, left, right, value in tree:
+                f.write(f'{feature} {threshold:.9g} {left} {right} {value}\n')
+    else:
+        f.write(f'{len(model["b1"])}\n')
+        f.write(' '.join(f'{v:.9g}' for v in model['mean']) + '\n')
+        f.write(' '.join(f'{v:.9g}' for v in model['inv_std']) + '\n')
+        for weights, bias in zip(model['w1'], model['b1']):
+            f.write(' '.join(str(v) for v in weights) + f' {bias}\n')
+        f.write(' '.join(str(v) for v in model['w2']) + f' {model["b2"]}\n')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Train the split predictor models from encoder dumps.')
+    parser.add_argument('dumps', nargs='+', help='CSV files written with SplitPredictorDumpFile')
+    parser.add_argument('-o', '--output', type=str, required=True, help='model file for SplitPredictorModel')
+    parser.add_argument('--type', choices=['trees', 'mlp'], default='trees', help='model type')
+    parser.add_argument('--split', type=str, action='append', default=[], help='split type(s) to train, default: all')
+    parser.add_argument('--pos-weight', type=float, default=4.0,
+                        help='weight of chosen splits, i.e. cost of missing a split relative to testing a useless one')
+    parser.add_argument('--min-samples', type=int, default=1000, help='no model is written for rarer split types')
+    parser.add_argument('--holdout', type=float, default=0.2, help='fraction of the samples used for the statistics')
+    parser.add_argument('--seed', type=int, default=1, help='seed of the hold-out selection and MLP initialisation')
+    parser.add_argument('--trees', type=int, default=30, help='number of boosted trees')
+    parser.add_argument('--depth', type=int, default=4, help='maximum tree depth')
+    parser.add_argument('--bins', type=int, default=32, help='number of threshold candidates per feature')
+    parser.add_argument('--min-leaf', type=int, default=50, help='minimum number of samples per leaf')
+    parser.add_argument('--l2', type=float, default=1.0, help='L2 regularisation of the leaf values')
+    parser.add_argument('--hidden', type=int, default=16, help='number of hidden MLP units')
+    parser.add_argument('--epochs', type=int, default=500, help='number of full-batch MLP training steps')
+    parser.add_argument('--learning-rate', type=float, default=None,
+                        help='shrinkage of the trees (default 0.3) or Adam step size of the MLP (default 0.01)')
+    parser.add_argument('--thresholds', type=float, nargs='+', default=[0.02, 0.05, 0.1, 0.2, 0.3],
+                        help='SplitPredictorThr values the hold-out statistics are printed for')
+    args = parser.parse_args()
+
+    if args.learning_rate is None:
+        args.learning_rate = 0.3 if args.type == 'trees' else 0.01
+
+    features, rows = read_dumps(args.dumps)
+    rng = np.random.default_rng(args.seed)
+
+    with open(args.output, 'w') as f:
+        f.write(f'# split predictor models, {args.type}, trained from {len(rows)} candidates\n')
+        f.write(f'# features: {" ".join(features)}\n')
+        f.write(f'features {len(features)}\n')
+
+        for split in args.split if args.split else SPLITS:
+            x = np.array([r[1] for r in rows if r[0] == split], dtype=np.float64).reshape(-1, len(features))
+            y = np.array([r[2] for r in rows if r[0] == split], dtype=np.float64)
+            if len(y) < args.min_samples:
+                print(f'{split}: {len(y)} samples, no model written')
+                continue
+
+            holdout = rng.random(len(y)) < args.holdout
+            train, test = ~holdout, holdout
+            w = np.where(y[train] > 0, args.pos_weight, 1.0)
+            model = (train_trees if args.type == 'trees' else train_mlp)(x[train], y[train], w, args)
+            write_model(f, split, model)
+
+            logit = predict(model, x[test])
+            print(f'{split}: {len(y)} samples, {y.mean() * 100:.1f}% chosen')
+            for thr in args.thresholds:
+                skip = logit < int(round(np.log(thr / (1 - thr)) * LOGIT_SCALE))
+                missed = np.sum(skip & (y[test] > 0)) / max(1, np.sum(y[test] > 0))
+                print(f'  SplitPredictorThr {thr:.2f}: {skip.mean() * 100:5.1f}% skipped, '
+                      f'{missed * 100:5.1f}% of chosen splits missed')
+
+    print(f'models written to {args.output}')